@@ -19,8 +19,28 @@
 // - Receive_Setup(): Determine whether a read or write request
 //    been received and initializes variables accordingly.
 // - Receive_File(): Receives and saves data
+// - Set_Length(): Saves the length of the file
+// - Send_Crcs(): Sends the CRC of each file page to the host
+// - Page_Crc(): Computes the CRC of a page of FLASH
 // - Page_Erase(): Erases a page of FLASH
 // - Page_Write(): Writes to a page of FLASH
+// - Page_Blank(): Checks whether a page of FLASH is erased
+// - Temp_Clear(): Fills the page buffer with 0xFF
+// - File_Pages(): Number of storage pages that hold the stored file
+// - Erase_Idle(): Erases the unused storage pages while the device is idle
+//
+// Besides the file read and write messages, the host can ask for the CRC
+// of each file page (CRC_MSG), rewrite a single page (PAGE_MSG) and set the
+// length of the file (LENGTH_MSG). With these, the host updates only the
+// pages that differ from a new image, see WriteDeltaData() in the host
+// application.
+//
+// The storage pages past the stored file are erased from the main loop by
+// Erase_Idle() while the device is idle, so that a longer file written
+// later does not wait for their erase in the USB ISR. The pages of the
+// stored file are erased only when the host writes them again, since the
+// host can read them back until then. A page that already reads blank is
+// not erased again.
 //
 //
 // How To Test:    See Readme.txt
@@ -98,6 +118,13 @@ typedef unsigned char BYTE;
 #define READ_MSG    0x00    // Message types for communication with host
 #define WRITE_MSG   0x01
 #define SIZE_MSG    0x02
+#define CRC_MSG     0x03    // Request the CRC of each file page
+#define PAGE_MSG    0x04    // {PAGE_MSG, page index, 0} then one page of data
+#define LENGTH_MSG  0x05    // {LENGTH_MSG, length low byte, length high byte}
+
+#define CRC_MSG_SIZE (4 + 2*NUM_STG_PAGES)
+//  {CRC_MSG, NUM_STG_PAGES, Length(Low Byte), Length(High Byte),
+//   CRC(High Byte), CRC(Low Byte) of each page}
 
 //  Machine States
 #define ST_WAIT_DEV 0x01    // Wait for application to open a device instance
@@ -108,6 +135,9 @@ typedef unsigned char BYTE;
 #define ST_TX_ACK   0x20    // Transmit ACK 0xFF to host after every 8 packets
 #define ST_ERROR    0x80    // Error state
 
+// No transfer in progress, Erase_Idle() may erase
+#define DEVICE_IDLE ((M_State == ST_IDLE_DEV) || (M_State == ST_WAIT_DEV))
+
 
 typedef struct {            //  Structure definition of a block of data
     BYTE Piece[MAX_BLOCK_SIZE];
@@ -157,6 +187,16 @@ data    BYTE    PageIndex;      //  Index of Current Page in File
 data    BYTE    BlocksRead;     //  Total Number of Blocks Read
 data    BYTE    BlocksWrote;    //  Total Number of Blocks Written
 data    BYTE*   ReadIndex;
+data    BYTE    ErasePage;      //  Next page for Erase_Idle() to check
+
+xdata   BYTE    CrcReply[CRC_MSG_SIZE];
+
+// CRC-16 (polynomial 0x1021, initial value 0) of each 4-bit value, as
+// computed by the CRC0 engine of other C8051 devices
+code    UINT    CrcTable[16] = {0x0000, 0x1021, 0x2042, 0x3063,
+                                0x4084, 0x50A5, 0x60C6, 0x70E7,
+                                0x8108, 0x9129, 0xA14A, 0xB16B,
+                                0xC18C, 0xD1AD, 0xE1CE, 0xF1EF};
 
 // code const   BYTE    Serial1[0x0A] = {0x0A,0x03,'A',0,'B',0,'C',0,'D',0};
 // Serial Number Defintion
@@ -174,6 +214,12 @@ sbit Led2 = P2^3; // These blink to indicate data transmission
 void    State_Machine(void);        
 void    Receive_Setup(void);        
 void    Receive_File(void);        
+BYTE    File_Pages(void);
+BYTE    Page_Blank(BYTE*);
+void    Temp_Clear(void);
+BYTE    Set_Length(void);
+void    Send_Crcs(void);
+UINT    Page_Crc(BYTE*);
 
 //-----------------------------------------------------------------------------
 // Interrupt Service Routines
@@ -206,6 +252,7 @@ void USB_ISR () interrupt 8
       // Call reset handler
      USBReset();
       M_State = ST_WAIT_DEV;
+      ErasePage = File_Pages();
    }
 
    // Check for Endpoint0 interrupt
@@ -757,33 +804,53 @@ void Receive_Setup(void)
       ReadIndex = PageIndices[0];
       Led2 = 1;
    }
+   else if (Buffer[0] == CRC_MSG)      // Send the CRC of each page
+   {
+      Send_Crcs();
+      M_State = ST_IDLE_DEV;
+   }
+   else if (Buffer[0] == PAGE_MSG)     // Receive one page of the file
+   {
+      if (Buffer[1] >= NUM_STG_PAGES)
+      {
+         M_State = ST_ERROR;
+      }
+      else
+      {
+         PageIndex = Buffer[1];        // Receive_File() writes this page
+         NumBlocks = BLOCKS_PR_PAGE;   // after one page of blocks
+         ErasePage = NUM_STG_PAGES;    // The page may be past the stored
+                                       // file until LENGTH_MSG
+         Temp_Clear();
+         BlockIndex = 0;
+         BlocksRead = 0;
+         Led1 = 1;
+         M_State = ST_RX_FILE;
+      }
+   }
+   else if (Buffer[0] == LENGTH_MSG)   // Set the file length only
+   {
+      if (!Set_Length())
+      {
+         M_State = ST_ERROR;
+      }
+      else
+      {
+         Buffer[0] = 0xFF;             // Handshake after the FLASH write
+         BulkOrInterruptIn (&gEp1InStatus, (BYTE*)&Buffer, 1);
+         M_State = ST_IDLE_DEV;
+      }
+   }
    else                                // Otherwise assume Write Setup Packet
    {
-      BytesToRead = Buffer[1] + 256*Buffer[2];
-      NumBlocks = (BYTE)(BytesToRead/MAX_BLOCK_SIZE);    // Find NumBlocks
-
-      if (NumBlocks > MAX_NUM_BLOCKS)  // State Error if transfer too big
+      if (!Set_Length())               // State Error if transfer too big
       {
          M_State = ST_ERROR;
       }
       else
       {
-
-         if (BytesToRead % MAX_BLOCK_SIZE) 
-         {
-            NumBlocks++;                // Increment NumBlocks 
-			                            // for last partial block
-         }                  
-
-         TempStorage[0].Piece[0] = Buffer[2];
-         TempStorage[0].Piece[1] = Buffer[1];
-         TempStorage[0].Piece[2] = NumBlocks;
-
-         // Write Values to Flash
-         Page_Erase(LengthFile);    // Store file data to flash
-         Page_Write(LengthFile);
-
          PageIndex = 0;             // Reset Index
+         Temp_Clear();              // Bytes past the file stay 0xFF
          BlockIndex = 0;
          BlocksRead = 0;
          Led1 = 1;
@@ -793,7 +860,7 @@ void Receive_Setup(void)
 }
 
 //-----------------------------------------------------------------------------
-// Receive_Setup
+// Receive_File
 //-----------------------------------------------------------------------------
 //
 // Return Value : None
@@ -815,8 +882,12 @@ void Receive_File(void)
    // Send handshake packet 0xFF to host after FLASH write
    if ((BlockIndex == (BLOCKS_PR_PAGE)) || (BlocksRead == NumBlocks))
    {
-      Page_Erase((BYTE*)(PageIndices[PageIndex]));
+      if (!Page_Blank((BYTE*)(PageIndices[PageIndex])))
+      {
+         Page_Erase((BYTE*)(PageIndices[PageIndex]));
+      }
       Page_Write((BYTE*)(PageIndices[PageIndex]));
+      Temp_Clear();
       PageIndex++;
       Led1 = ~Led1;
       BlockIndex = 0;
@@ -834,6 +905,225 @@ void Receive_File(void)
    }
 }
 
+//-----------------------------------------------------------------------------
+// Set_Length
+//-----------------------------------------------------------------------------
+//
+// Return Value : 0 if the length is too large, 1 otherwise
+// Parameters   : None
+//
+// Reads the file length from the Setup Message in Buffer, finds NumBlocks
+// and stores both to flash
+//
+//-----------------------------------------------------------------------------
+
+BYTE Set_Length(void)
+{
+   BytesToRead = Buffer[1] + 256*Buffer[2];
+   NumBlocks = (BYTE)(BytesToRead/MAX_BLOCK_SIZE);    // Find NumBlocks
+
+   if (NumBlocks > MAX_NUM_BLOCKS)
+   {
+      return 0;
+   }
+
+   if (BytesToRead % MAX_BLOCK_SIZE) 
+   {
+      NumBlocks++;                     // Increment NumBlocks 
+                                       // for last partial block
+   }                  
+
+   TempStorage[0].Piece[0] = Buffer[2];
+   TempStorage[0].Piece[1] = Buffer[1];
+   TempStorage[0].Piece[2] = NumBlocks;
+
+   // Write Values to Flash
+   Page_Erase(LengthFile);             // Store file data to flash
+   Page_Write(LengthFile);
+
+   ErasePage = File_Pages();           // Pages past the file are unused
+
+   return 1;
+}
+
+//-----------------------------------------------------------------------------
+// Send_Crcs
+//-----------------------------------------------------------------------------
+//
+// Return Value : None
+// Parameters   : None
+//
+// Sends the file length and the CRC of each of the NUM_STG_PAGES pages to
+// the host in one packet. The host compares them with the CRC of each page
+// of a new image, and sends only the pages that differ.
+//
+//-----------------------------------------------------------------------------
+
+void Send_Crcs(void)
+{
+   BYTE i;
+   UINT crc;
+
+   CrcReply[0] = CRC_MSG;
+   CrcReply[1] = NUM_STG_PAGES;
+   CrcReply[2] = LengthFile[1];
+   CrcReply[3] = LengthFile[0];
+
+   for (i = 0; i < NUM_STG_PAGES; i++)
+   {
+      crc = Page_Crc(PageIndices[i]);
+      CrcReply[4 + 2*i] = (BYTE)(crc >> 8);
+      CrcReply[5 + 2*i] = (BYTE)crc;
+   }
+
+   BulkOrInterruptIn(&gEp1InStatus, CrcReply, CRC_MSG_SIZE);
+}
+
+//-----------------------------------------------------------------------------
+// Page_Crc
+//-----------------------------------------------------------------------------
+//
+// Return Value : CRC-16 of the page
+// Parameters   :
+// 1) BYTE* PageAddress
+//
+// Computes the CRC-16 of the page of FLASH located at PageAddress, one
+// nibble at a time
+//
+//-----------------------------------------------------------------------------
+
+UINT Page_Crc(BYTE* PageAddress)
+{
+   UINT x;                             // Counter for 0-512 bytes
+   UINT crc = 0;
+
+   for (x = 0; x < FLASH_PAGE_SIZE; x++)
+   {
+      crc ^= (UINT)(*PageAddress++) << 8;
+      crc = (crc << 4) ^ CrcTable[crc >> 12];
+      crc = (crc << 4) ^ CrcTable[crc >> 12];
+   }
+
+   return crc;
+}
+
+//-----------------------------------------------------------------------------
+// File_Pages
+//-----------------------------------------------------------------------------
+//
+// Return Value : Number of storage pages that hold the stored file
+// Parameters   : None
+//
+// Reads the number of blocks stored at LengthFile. A blank LengthFile
+// counts as a file in every page, so nothing is erased.
+//
+//-----------------------------------------------------------------------------
+
+BYTE File_Pages(void)
+{
+   UINT Pages;
+
+   Pages = (LengthFile[2] + (BLOCKS_PR_PAGE) - 1) / (BLOCKS_PR_PAGE);
+
+   return (Pages > NUM_STG_PAGES) ? NUM_STG_PAGES : (BYTE)Pages;
+}
+
+//-----------------------------------------------------------------------------
+// Page_Blank
+//-----------------------------------------------------------------------------
+//
+// Return Value : 1 if every byte of the page is 0xFF, 0 otherwise
+// Parameters   :
+// 1) BYTE* PageAddress
+//
+//-----------------------------------------------------------------------------
+
+BYTE Page_Blank(BYTE* PageAddress)
+{
+   UINT x;                             // Counter for 0-512 bytes
+
+   for (x = 0; x < FLASH_PAGE_SIZE; x++)
+   {
+      if (*PageAddress++ != 0xFF)
+      {
+         return 0;
+      }
+   }
+
+   return 1;
+}
+
+//-----------------------------------------------------------------------------
+// Temp_Clear
+//-----------------------------------------------------------------------------
+//
+// Return Value : None
+// Parameters   : None
+//
+// Fills TempStorage with 0xFF before a page is received, so the bytes of
+// the last page past the end of the file are written as erased FLASH. The
+// host computes its page CRCs over an image padded with 0xFF, so the CRC
+// of the last page then matches Page_Crc().
+//
+//-----------------------------------------------------------------------------
+
+void Temp_Clear(void)
+{
+   BYTE xdata *pclear = (BYTE xdata *)(TempStorage);
+   UINT x;                             // Counter for 0-512 bytes
+
+   for (x = 0; x < FLASH_PAGE_SIZE; x++)
+   {
+      *pclear++ = 0xFF;
+   }
+}
+
+//-----------------------------------------------------------------------------
+// Erase_Idle
+//-----------------------------------------------------------------------------
+//
+// Return Value : None
+// Parameters   : None
+//
+// Called from the main loop. While no transfer is in progress, erases the
+// storage page at ErasePage unless it reads blank, and moves on to the
+// next page. The CPU still stops for the erase, but between transfers
+// instead of in the middle of one.
+//
+// The page is checked with interrupts enabled. It is erased only if, with
+// interrupts disabled, the device is still idle and ErasePage has not been
+// moved by a new file length.
+//
+//-----------------------------------------------------------------------------
+
+void Erase_Idle(void)
+{
+   BYTE Page;
+   BYTE Blank;
+
+   Page = ErasePage;
+
+   if ((Page >= NUM_STG_PAGES) || !DEVICE_IDLE)
+   {
+      return;
+   }
+
+   Blank = Page_Blank(PageIndices[Page]);
+
+   EA = 0;                             // Turn off interrupts
+
+   if ((ErasePage == Page) && DEVICE_IDLE)
+   {
+      if (!Blank)
+      {
+         Page_Erase(PageIndices[Page]);
+      }
+      ErasePage++;
+   }
+
+   EA = 1;                             // Turn on interrupts
+}
+
 //-----------------------------------------------------------------------------
 // End Of File
 //-----------------------------------------------------------------------------
\ No newline at end of file
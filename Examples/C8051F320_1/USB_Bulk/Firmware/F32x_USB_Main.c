@@ -102,7 +102,10 @@ void main (void)
 
    USB0_Enable ();                     // Enable USB0
 
-   while (1);
+   while (1)
+   {
+      Erase_Idle();                    // Erase unused pages between transfers
+   }
 }
 
 //-----------------------------------------------------------------------------
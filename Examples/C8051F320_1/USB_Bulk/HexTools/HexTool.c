@@ -0,0 +1,872 @@
+//-----------------------------------------------------------------------------
+// HexTool.c
+//-----------------------------------------------------------------------------
+//
+// Program Description:
+//
+// Command line front end of IntelHex.c, for preparing the firmware images
+// sent by the delta update of the bulk file transfer example:
+//
+//    info FILE...                 pages, bytes used, address range and
+//                                 start address of each file
+//    crc [-32] FILE               CRC of each page, CRC-16 of CRC0, or
+//                                 CRC-32 of CRC0 with -32 (initial value
+//                                 0xFFFFFFFF)
+//    merge [-r] -o OUT FILE...    files combined, a byte set differently
+//                                 by two files is an error unless -r,
+//                                 then the later file wins
+//    align [-f FILL] -o OUT FILE  pages filled out with FILL, default 0xFF
+//    diff OLD NEW                 address and CRCs of each page that
+//                                 differs
+//    patch -o OUT OLD NEW         binary patch from OLD to NEW
+//    apply -o OUT OLD PATCH       OLD with PATCH applied, as a HEX file
+//    bench [-n COUNT] FILE...     parses, writes, patches and applies the
+//                                 files COUNT times (default 1000), checks
+//                                 each round trip and reports images per
+//                                 second
+//
+// Every command takes -p SIZE for the page size, default 512 as on the
+// C8051F32x. Pages are compared as Flash: a byte not in a file is 0xFF.
+//
+// Exits with 1 on an error, or if a bench round trip does not match.
+//
+// Build (from this directory):
+//
+//    gcc -O2 -Wall -o HexTool HexTool.c IntelHex.c
+//
+// Target:         Linux host
+// Tool chain:     GCC
+// Command Line:   See above
+//
+// Release 1.0
+//    -Initial Revision
+//
+
+//-----------------------------------------------------------------------------
+// Includes
+//-----------------------------------------------------------------------------
+
+#include "IntelHex.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+//-----------------------------------------------------------------------------
+// Global Constants
+//-----------------------------------------------------------------------------
+
+#define MAX_FILES          64
+#define DEFAULT_COUNT      1000
+
+//-----------------------------------------------------------------------------
+// Structures, Unions, Enumerations, and Type Definitions
+//-----------------------------------------------------------------------------
+
+typedef struct OPTIONS
+{
+   uint32_t PageSize;                  // -p
+   uint8_t Crc32;                      // -32
+   uint8_t Overwrite;                  // -r
+   uint8_t Fill;                       // -f
+   const char *Output;                 // -o
+   uint32_t Count;                     // -n
+   int Files;
+   const char *File[MAX_FILES];
+} OPTIONS;
+
+//-----------------------------------------------------------------------------
+// Function Prototypes
+//-----------------------------------------------------------------------------
+
+static int Options_Parse (OPTIONS *options, int argc, char **argv);
+static int Load (IHEX_IMAGE *image, const char *path, uint32_t page_size,
+                 uint8_t overwrite);
+static int Save (const IHEX_IMAGE *image, const char *path);
+static int Read_File (const char *path, uint8_t **data, size_t *length);
+static uint32_t Page_Union (const IHEX_IMAGE *a, const IHEX_IMAGE *b);
+static double Seconds (void);
+static void Usage (void);
+
+static int Info (const OPTIONS *options);
+static int Crc (const OPTIONS *options);
+static int Merge (const OPTIONS *options);
+static int Align (const OPTIONS *options);
+static int Diff (const OPTIONS *options);
+static int Patch (const OPTIONS *options);
+static int Apply (const OPTIONS *options);
+static int Bench (const OPTIONS *options);
+
+//-----------------------------------------------------------------------------
+// MAIN Routine
+//-----------------------------------------------------------------------------
+
+int main (int argc, char **argv)
+{
+   OPTIONS options;
+
+   if ((argc < 2) || (Options_Parse (&options, argc - 2, argv + 2) != 0))
+   {
+      Usage ();
+      return 1;
+   }
+
+   if (strcmp (argv[1], "info") == 0)
+   {
+      return Info (&options);
+   }
+   else if (strcmp (argv[1], "crc") == 0)
+   {
+      return Crc (&options);
+   }
+   else if (strcmp (argv[1], "merge") == 0)
+   {
+      return Merge (&options);
+   }
+   else if (strcmp (argv[1], "align") == 0)
+   {
+      return Align (&options);
+   }
+   else if (strcmp (argv[1], "diff") == 0)
+   {
+      return Diff (&options);
+   }
+   else if (strcmp (argv[1], "patch") == 0)
+   {
+      return Patch (&options);
+   }
+   else if (strcmp (argv[1], "apply") == 0)
+   {
+      return Apply (&options);
+   }
+   else if (strcmp (argv[1], "bench") == 0)
+   {
+      return Bench (&options);
+   }
+
+   Usage ();
+
+   return 1;
+}
+
+//-----------------------------------------------------------------------------
+// Commands
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// Info
+//-----------------------------------------------------------------------------
+
+static int Info (const OPTIONS *options)
+{
+   IHEX_IMAGE image;
+   const IHEX_PAGE *last;
+   int i;
+
+   if (options->Files < 1)
+   {
+      Usage ();
+      return 1;
+   }
+
+   for (i = 0; i < options->Files; i++)
+   {
+      if (Load (&image, options->File[i], options->PageSize, 0) != IHEX_OK)
+      {
+         return 1;
+      }
+
+      printf ("%s: %lu bytes in %lu pages", options->File[i],
+              (unsigned long) IHex_Used (&image),
+              (unsigned long) image.Count);
+
+      if (image.Count)
+      {
+         last = &image.Pages[image.Count - 1];
+         printf (", 0x%06lX-0x%06lX",
+                 (unsigned long) image.Pages[0].Address,
+                 (unsigned long) (last->Address + image.PageSize - 1));
+      }
+
+      if (image.HasStart)
+      {
+         printf (", start 0x%06lX", (unsigned long) image.Start);
+      }
+
+      printf ("\n");
+
+      IHex_Free (&image);
+   }
+
+   return 0;
+}
+
+//-----------------------------------------------------------------------------
+// Crc
+//-----------------------------------------------------------------------------
+
+static int Crc (const OPTIONS *options)
+{
+   IHEX_IMAGE image;
+   uint32_t i;
+
+   if (options->Files != 1)
+   {
+      Usage ();
+      return 1;
+   }
+
+   if (Load (&image, options->File[0], options->PageSize, 0) != IHEX_OK)
+   {
+      return 1;
+   }
+
+   for (i = 0; i < image.Count; i++)
+   {
+      if (options->Crc32)
+      {
+         printf ("0x%06lX 0x%08lX\n", (unsigned long) image.Pages[i].Address,
+                 (unsigned long) IHex_Crc32 (0xFFFFFFFF, image.Pages[i].Data,
+                                             image.PageSize));
+      }
+      else
+      {
+         printf ("0x%06lX 0x%04X\n", (unsigned long) image.Pages[i].Address,
+                 IHex_Crc16 (0, image.Pages[i].Data, image.PageSize));
+      }
+   }
+
+   IHex_Free (&image);
+
+   return 0;
+}
+
+//-----------------------------------------------------------------------------
+// Merge
+//-----------------------------------------------------------------------------
+
+static int Merge (const OPTIONS *options)
+{
+   IHEX_IMAGE image;
+   int status = IHEX_OK;
+   int i;
+
+   if ((options->Files < 1) || (options->Output == NULL))
+   {
+      Usage ();
+      return 1;
+   }
+
+   IHex_Init (&image, options->PageSize);
+
+   for (i = 0; (i < options->Files) && (status == IHEX_OK); i++)
+   {
+      status = IHex_Load (&image, options->File[i], options->Overwrite);
+
+      if (status == IHEX_ERR_CONFLICT)
+      {
+         fprintf (stderr, "HexTool: %s: %s at 0x%06lX\n", options->File[i],
+                  IHex_Error (status), (unsigned long) image.ErrorAddress);
+      }
+      else if (status != IHEX_OK)
+      {
+         fprintf (stderr, "HexTool: %s: line %lu: %s\n", options->File[i],
+                  (unsigned long) image.ErrorLine, IHex_Error (status));
+      }
+   }
+
+   if (status == IHEX_OK)
+   {
+      status = Save (&image, options->Output);
+   }
+
+   IHex_Free (&image);
+
+   return (status == IHEX_OK) ? 0 : 1;
+}
+
+//-----------------------------------------------------------------------------
+// Align
+//-----------------------------------------------------------------------------
+
+static int Align (const OPTIONS *options)
+{
+   IHEX_IMAGE image;
+   int status;
+
+   if ((options->Files != 1) || (options->Output == NULL))
+   {
+      Usage ();
+      return 1;
+   }
+
+   if (Load (&image, options->File[0], options->PageSize, 0) != IHEX_OK)
+   {
+      return 1;
+   }
+
+   IHex_Align (&image, options->Fill);
+   status = Save (&image, options->Output);
+
+   IHex_Free (&image);
+
+   return (status == IHEX_OK) ? 0 : 1;
+}
+
+//-----------------------------------------------------------------------------
+// Diff
+//-----------------------------------------------------------------------------
+
+static int Diff (const OPTIONS *options)
+{
+   IHEX_IMAGE from;
+   IHEX_IMAGE to;
+   uint32_t *addresses;
+   uint32_t pages;
+   uint32_t i;
+   uint8_t *page;
+
+   if (options->Files != 2)
+   {
+      Usage ();
+      return 1;
+   }
+
+   if (Load (&from, options->File[0], options->PageSize, 0) != IHEX_OK)
+   {
+      return 1;
+   }
+
+   if (Load (&to, options->File[1], options->PageSize, 0) != IHEX_OK)
+   {
+      IHex_Free (&from);
+      return 1;
+   }
+
+   pages = IHex_Diff (&from, &to, NULL, 0);
+   addresses = malloc ((pages + 1) * sizeof (uint32_t));
+   page = malloc (options->PageSize);
+
+   if ((addresses == NULL) || (page == NULL))
+   {
+      fprintf (stderr, "HexTool: %s\n", IHex_Error (IHEX_ERR_MEMORY));
+      pages = 0;
+   }
+   else
+   {
+      IHex_Diff (&from, &to, addresses, pages);
+   }
+
+   for (i = 0; i < pages; i++)
+   {
+      IHex_Read (&from, addresses[i], page, options->PageSize);
+      printf ("0x%06lX 0x%04X", (unsigned long) addresses[i],
+              IHex_Crc16 (0, page, options->PageSize));
+
+      IHex_Read (&to, addresses[i], page, options->PageSize);
+      printf (" -> 0x%04X\n", IHex_Crc16 (0, page, options->PageSize));
+   }
+
+   printf ("%lu of %lu pages differ\n", (unsigned long) pages,
+           (unsigned long) Page_Union (&from, &to));
+
+   free (page);
+   free (addresses);
+   IHex_Free (&from);
+   IHex_Free (&to);
+
+   return 0;
+}
+
+//-----------------------------------------------------------------------------
+// Patch
+//-----------------------------------------------------------------------------
+
+static int Patch (const OPTIONS *options)
+{
+   IHEX_IMAGE from;
+   IHEX_IMAGE to;
+   uint8_t *patch = NULL;
+   size_t length = 0;
+   FILE *file;
+   int status;
+
+   if ((options->Files != 2) || (options->Output == NULL))
+   {
+      Usage ();
+      return 1;
+   }
+
+   if (Load (&from, options->File[0], options->PageSize, 0) != IHEX_OK)
+   {
+      return 1;
+   }
+
+   if (Load (&to, options->File[1], options->PageSize, 0) != IHEX_OK)
+   {
+      IHex_Free (&from);
+      return 1;
+   }
+
+   status = IHex_MakePatch (&from, &to, &patch, &length);
+
+   if (status == IHEX_OK)
+   {
+      file = fopen (options->Output, "wb");
+
+      if ((file == NULL) || (fwrite (patch, 1, length, file) != length) ||
+          (fclose (file) != 0))
+      {
+         status = IHEX_ERR_FILE;
+      }
+   }
+
+   if (status == IHEX_OK)
+   {
+      printf ("%lu pages, %lu bytes (%lu bytes used in %s)\n",
+              (unsigned long) IHex_Diff (&from, &to, NULL, 0),
+              (unsigned long) length, (unsigned long) IHex_Used (&to),
+              options->File[1]);
+   }
+   else
+   {
+      fprintf (stderr, "HexTool: %s: %s\n", options->Output,
+               IHex_Error (status));
+   }
+
+   free (patch);
+   IHex_Free (&from);
+   IHex_Free (&to);
+
+   return (status == IHEX_OK) ? 0 : 1;
+}
+
+//-----------------------------------------------------------------------------
+// Apply
+//-----------------------------------------------------------------------------
+
+static int Apply (const OPTIONS *options)
+{
+   IHEX_IMAGE image;
+   uint8_t *patch;
+   size_t length;
+   int status;
+
+   if ((options->Files != 2) || (options->Output == NULL))
+   {
+      Usage ();
+      return 1;
+   }
+
+   if (Load (&image, options->File[0], options->PageSize, 0) != IHEX_OK)
+   {
+      return 1;
+   }
+
+   status = Read_File (options->File[1], &patch, &length);
+
+   if (status == IHEX_OK)
+   {
+      status = IHex_ApplyPatch (&image, patch, length);
+      free (patch);
+
+      if (status == IHEX_ERR_PATCH)
+      {
+         fprintf (stderr, "HexTool: %s: %s at page 0x%06lX\n",
+                  options->File[1], IHex_Error (status),
+                  (unsigned long) image.ErrorAddress);
+      }
+      else if (status == IHEX_OK)
+      {
+         status = Save (&image, options->Output);
+      }
+   }
+   else
+   {
+      fprintf (stderr, "HexTool: %s: %s\n", options->File[1],
+               IHex_Error (status));
+   }
+
+   IHex_Free (&image);
+
+   return (status == IHEX_OK) ? 0 : 1;
+}
+
+//-----------------------------------------------------------------------------
+// Bench
+//-----------------------------------------------------------------------------
+//
+// The files are read into memory once. Each pass parses every file,
+// writes it back and parses the text again, then patches each file into
+// the next one and applies the patch. A round trip that does not give the
+// same image is counted as a failure.
+//
+//-----------------------------------------------------------------------------
+
+static int Bench (const OPTIONS *options)
+{
+   static IHEX_IMAGE image[MAX_FILES];
+   IHEX_IMAGE check;
+   uint8_t *text[MAX_FILES];
+   size_t text_length[MAX_FILES];
+   char *output;
+   size_t output_length;
+   uint8_t *patch;
+   size_t patch_length;
+   uint32_t failures = 0;
+   uint64_t bytes = 0;
+   uint64_t patch_bytes = 0;
+   double parse_time = 0;
+   double format_time = 0;
+   double patch_time = 0;
+   double apply_time = 0;
+   double start;
+   uint32_t pass;
+   int next;
+   int i;
+
+   if (options->Files < 1)
+   {
+      Usage ();
+      return 1;
+   }
+
+   for (i = 0; i < options->Files; i++)
+   {
+      if ((Read_File (options->File[i], &text[i], &text_length[i]) !=
+           IHEX_OK) ||
+          (Load (&image[i], options->File[i], options->PageSize, 0) !=
+           IHEX_OK))
+      {
+         fprintf (stderr, "HexTool: %s: %s\n", options->File[i],
+                  IHex_Error (IHEX_ERR_FILE));
+         return 1;
+      }
+
+      bytes += IHex_Used (&image[i]);
+   }
+
+   IHex_Init (&check, options->PageSize);
+
+   for (pass = 0; pass < options->Count; pass++)
+   {
+      for (i = 0; i < options->Files; i++)
+      {
+         // Parse
+         IHex_Clear (&check);
+         start = Seconds ();
+         if (IHex_Parse (&check, (char *) text[i], text_length[i], 0) !=
+             IHEX_OK)
+         {
+            failures++;
+         }
+         parse_time += Seconds () - start;
+
+         // Write and parse again
+         start = Seconds ();
+         if (IHex_Format (&check, IHEX_RECORD_SIZE, &output, &output_length)
+             != IHEX_OK)
+         {
+            failures++;
+            continue;
+         }
+         format_time += Seconds () - start;
+
+         IHex_Clear (&check);
+         if ((IHex_Parse (&check, output, output_length, 0) != IHEX_OK) ||
+             (IHex_Diff (&check, &image[i], NULL, 0) != 0) ||
+             (IHex_Used (&check) != IHex_Used (&image[i])))
+         {
+            failures++;
+         }
+         free (output);
+
+         // Patch into the next file and apply
+         next = (i + 1) % options->Files;
+
+         start = Seconds ();
+         if (IHex_MakePatch (&image[i], &image[next], &patch, &patch_length)
+             != IHEX_OK)
+         {
+            failures++;
+            continue;
+         }
+         patch_time += Seconds () - start;
+         patch_bytes += patch_length;
+
+         start = Seconds ();
+         if (IHex_ApplyPatch (&check, patch, patch_length) != IHEX_OK)
+         {
+            failures++;
+         }
+         apply_time += Seconds () - start;
+
+         if (IHex_Diff (&check, &image[next], NULL, 0) != 0)
+         {
+            failures++;
+         }
+         free (patch);
+      }
+   }
+
+   printf ("%d files, %lu bytes used, %lu passes\n\n", options->Files,
+           (unsigned long) bytes, (unsigned long) options->Count);
+   printf ("%-8s %12s %12s\n", "Step", "Images/s", "MB/s");
+   printf ("%-8s %12.0f %12.1f\n", "parse",
+           options->Count * options->Files / parse_time,
+           options->Count * bytes / parse_time / 1e6);
+   printf ("%-8s %12.0f %12.1f\n", "format",
+           options->Count * options->Files / format_time,
+           options->Count * bytes / format_time / 1e6);
+   printf ("%-8s %12.0f %12s\n", "patch",
+           options->Count * options->Files / patch_time, "");
+   printf ("%-8s %12.0f %12s\n", "apply",
+           options->Count * options->Files / apply_time, "");
+   printf ("\nMean patch %lu bytes\n", (unsigned long)
+           (patch_bytes / ((uint64_t) options->Count * options->Files)));
+   printf ("\n%s\n", failures ? "FAIL" : "PASS");
+
+   for (i = 0; i < options->Files; i++)
+   {
+      free (text[i]);
+      IHex_Free (&image[i]);
+   }
+   IHex_Free (&check);
+
+   return failures ? 1 : 0;
+}
+
+//-----------------------------------------------------------------------------
+// Local Routines
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// Options_Parse
+//-----------------------------------------------------------------------------
+//
+// Reads the options and file names after the command. Returns non-zero if
+// an option is unknown or its value is missing.
+//
+//-----------------------------------------------------------------------------
+
+static int Options_Parse (OPTIONS *options, int argc, char **argv)
+{
+   int i;
+
+   memset (options, 0, sizeof (OPTIONS));
+   options->PageSize = IHEX_PAGE_SIZE;
+   options->Fill = IHEX_ERASED;
+   options->Count = DEFAULT_COUNT;
+
+   for (i = 0; i < argc; i++)
+   {
+      if (strcmp (argv[i], "-32") == 0)
+      {
+         options->Crc32 = 1;
+      }
+      else if (strcmp (argv[i], "-r") == 0)
+      {
+         options->Overwrite = 1;
+      }
+      else if ((argv[i][0] == '-') && argv[i][1] && !argv[i][2])
+      {
+         if (i + 1 == argc)
+         {
+            return 1;
+         }
+
+         switch (argv[i][1])
+         {
+            case 'p': options->PageSize = strtoul (argv[++i], NULL, 0); break;
+            case 'f': options->Fill = strtoul (argv[++i], NULL, 0); break;
+            case 'n': options->Count = strtoul (argv[++i], NULL, 0); break;
+            case 'o': options->Output = argv[++i]; break;
+            default:  return 1;
+         }
+      }
+      else if (options->Files < MAX_FILES)
+      {
+         options->File[options->Files++] = argv[i];
+      }
+      else
+      {
+         return 1;
+      }
+   }
+
+   return (options->Count == 0);
+}
+
+//-----------------------------------------------------------------------------
+// Load
+//-----------------------------------------------------------------------------
+//
+// Initializes <image> and loads <path> into it. Reports an error on stderr.
+//
+//-----------------------------------------------------------------------------
+
+static int Load (IHEX_IMAGE *image, const char *path, uint32_t page_size,
+                 uint8_t overwrite)
+{
+   int status;
+
+   status = IHex_Init (image, page_size);
+   if (status != IHEX_OK)
+   {
+      fprintf (stderr, "HexTool: page size %lu: %s\n",
+               (unsigned long) page_size, IHex_Error (status));
+      return status;
+   }
+
+   status = IHex_Load (image, path, overwrite);
+   if (status != IHEX_OK)
+   {
+      if (image->ErrorLine)
+      {
+         fprintf (stderr, "HexTool: %s: line %lu: %s\n", path,
+                  (unsigned long) image->ErrorLine, IHex_Error (status));
+      }
+      else
+      {
+         fprintf (stderr, "HexTool: %s: %s\n", path, IHex_Error (status));
+      }
+
+      IHex_Free (image);
+   }
+
+   return status;
+}
+
+//-----------------------------------------------------------------------------
+// Save
+//-----------------------------------------------------------------------------
+
+static int Save (const IHEX_IMAGE *image, const char *path)
+{
+   int status;
+
+   status = IHex_Save (image, path, IHEX_RECORD_SIZE);
+   if (status != IHEX_OK)
+   {
+      fprintf (stderr, "HexTool: %s: %s\n", path, IHex_Error (status));
+   }
+
+   return status;
+}
+
+//-----------------------------------------------------------------------------
+// Read_File
+//-----------------------------------------------------------------------------
+//
+// Reads the whole of <path> into a buffer to free() by the caller.
+//
+//-----------------------------------------------------------------------------
+
+static int Read_File (const char *path, uint8_t **data, size_t *length)
+{
+   FILE *file;
+   long size;
+
+   file = fopen (path, "rb");
+   if (file == NULL)
+   {
+      return IHEX_ERR_FILE;
+   }
+
+   if ((fseek (file, 0, SEEK_END) != 0) || ((size = ftell (file)) < 0) ||
+       (fseek (file, 0, SEEK_SET) != 0))
+   {
+      fclose (file);
+      return IHEX_ERR_FILE;
+   }
+
+   *data = malloc (size ? size : 1);
+   if (*data == NULL)
+   {
+      fclose (file);
+      return IHEX_ERR_MEMORY;
+   }
+
+   if (fread (*data, 1, size, file) != (size_t) size)
+   {
+      free (*data);
+      fclose (file);
+      return IHEX_ERR_FILE;
+   }
+
+   fclose (file);
+   *length = size;
+
+   return IHEX_OK;
+}
+
+//-----------------------------------------------------------------------------
+// Page_Union
+//-----------------------------------------------------------------------------
+//
+// Returns the number of page addresses used by <a>, <b> or both. The pages
+// of both images are sorted by address, so they are merged in one pass.
+//
+//-----------------------------------------------------------------------------
+
+static uint32_t Page_Union (const IHEX_IMAGE *a, const IHEX_IMAGE *b)
+{
+   uint32_t i = 0;
+   uint32_t j = 0;
+   uint32_t count = 0;
+
+   while ((i < a->Count) && (j < b->Count))
+   {
+      if (a->Pages[i].Address < b->Pages[j].Address)
+      {
+         i++;
+      }
+      else if (b->Pages[j].Address < a->Pages[i].Address)
+      {
+         j++;
+      }
+      else
+      {
+         i++;
+         j++;
+      }
+      count++;
+   }
+
+   return count + (a->Count - i) + (b->Count - j);
+}
+
+//-----------------------------------------------------------------------------
+// Seconds
+//-----------------------------------------------------------------------------
+
+static double Seconds (void)
+{
+   struct timespec now;
+
+   clock_gettime (CLOCK_MONOTONIC, &now);
+
+   return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+//-----------------------------------------------------------------------------
+// Usage
+//-----------------------------------------------------------------------------
+
+static void Usage (void)
+{
+   fprintf (stderr,
+      "Usage: HexTool COMMAND [-p PAGE_SIZE] ...\n"
+      "   info FILE...\n"
+      "   crc [-32] FILE\n"
+      "   merge [-r] -o OUT FILE...\n"
+      "   align [-f FILL] -o OUT FILE\n"
+      "   diff OLD NEW\n"
+      "   patch -o OUT OLD NEW\n"
+      "   apply -o OUT OLD PATCH\n"
+      "   bench [-n COUNT] FILE...\n");
+}
+
+//-----------------------------------------------------------------------------
+// End Of File
+//-----------------------------------------------------------------------------
@@ -0,0 +1,1567 @@
+//-----------------------------------------------------------------------------
+// IntelHex.c
+//-----------------------------------------------------------------------------
+//
+// Program Description:
+//
+// This library reads Intel HEX files into a sparse image of Flash pages,
+// merges and aligns images, writes them back as HEX files, and builds and
+// applies binary patches between two images.
+//
+// The parser decodes the text in place, one record at a time, with a
+// table of hex digit values. Records are mostly in address order, so the
+// page of the previous record is tried before the binary search of the
+// page table. A 64 KB image of 16-byte records loads in well under a
+// millisecond.
+//
+// The page CRCs are the CRC-16 of CRC0 (polynomial 0x1021, initial value
+// 0) and, for devices with a 32-bit CRC0 mode, the bit-reflected CRC-32
+// (polynomial 0x04C11DB7) with the initial value chosen by the caller.
+// Both are computed a byte at a time with 256-entry tables.
+//
+// A patch lists, for each page that differs, the runs of bytes to change
+// and the CRC of the page before and after. IHex_ApplyPatch() checks
+// every page of the patch before it changes any, so a patch is applied
+// completely or not at all.
+//
+// Target:         Linux host
+// Tool chain:     GCC
+// Command Line:   None
+//
+// Release 1.0
+//    -Initial Revision
+//
+
+//-----------------------------------------------------------------------------
+// Includes
+//-----------------------------------------------------------------------------
+
+#include "IntelHex.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+//-----------------------------------------------------------------------------
+// Global Constants
+//-----------------------------------------------------------------------------
+
+#define MIN_PAGE_SIZE      16
+#define MAX_PAGE_SIZE      32768       // Patch offsets and lengths are U16
+
+#define PATCH_HEADER       12          // Magic, version, page size, count
+#define PATCH_PAGE         10          // Address, CRCs, run count
+#define PATCH_RUN          4           // Offset, length
+
+//-----------------------------------------------------------------------------
+// Structures, Unions, Enumerations, and Type Definitions
+//-----------------------------------------------------------------------------
+
+typedef struct OUTPUT                  // Growing output buffer
+{
+   uint8_t *Data;
+   size_t Length;
+   size_t Capacity;
+   int Status;
+} OUTPUT;
+
+//-----------------------------------------------------------------------------
+// Function Prototypes
+//-----------------------------------------------------------------------------
+
+static void Tables_Init (void);
+static uint32_t Page_Search (const IHEX_IMAGE *image, uint32_t address,
+                             uint8_t *found);
+static IHEX_PAGE *Page_Get (IHEX_IMAGE *image, uint32_t address,
+                            uint8_t create);
+static const uint8_t *Page_Data (const IHEX_IMAGE *image,
+                                 const IHEX_PAGE *page);
+static void Out_Reserve (OUTPUT *out, size_t length);
+static void Out_Record (OUTPUT *out, uint8_t type, uint16_t address,
+                        const uint8_t *data, uint8_t count);
+static void Out_U16 (OUTPUT *out, uint16_t value);
+static void Out_U32 (OUTPUT *out, uint32_t value);
+static uint16_t Get_U16 (const uint8_t *p);
+static uint32_t Get_U32 (const uint8_t *p);
+
+//-----------------------------------------------------------------------------
+// Global Variables
+//-----------------------------------------------------------------------------
+
+static int8_t Hex_Value[256];          // Value of a hex digit, -1 if none
+static uint16_t Crc16_Table[256];
+static uint32_t Crc32_Table[256];
+static uint8_t Tables_Ready;
+
+static const char Hex_Digit[] = "0123456789ABCDEF";
+
+static uint8_t Erased_Page[MAX_PAGE_SIZE]; // Page not in an image
+
+//-----------------------------------------------------------------------------
+// IHex_Init
+//-----------------------------------------------------------------------------
+//
+// Return Value :
+//   IHEX_OK, or IHEX_ERR_ARGUMENT if <page_size> is not a power of 2 from
+//   16 to 32768
+// Parameters   :
+//   1) IHEX_IMAGE *image - image to initialize, empty
+//   2) uint32_t page_size - bytes per page, the Flash page size of the
+//                           target
+//
+//-----------------------------------------------------------------------------
+
+int IHex_Init (IHEX_IMAGE *image, uint32_t page_size)
+{
+   memset (image, 0, sizeof (IHEX_IMAGE));
+
+   if ((page_size < MIN_PAGE_SIZE) || (page_size > MAX_PAGE_SIZE) ||
+       (page_size & (page_size - 1)))
+   {
+      return IHEX_ERR_ARGUMENT;
+   }
+
+   Tables_Init ();
+
+   image->PageSize = page_size;
+
+   return IHEX_OK;
+}
+
+//-----------------------------------------------------------------------------
+// IHex_Free
+//-----------------------------------------------------------------------------
+//
+// Return Value : None
+// Parameters   :
+//   1) IHEX_IMAGE *image - image to free, left empty
+//
+// This routine frees the pages and the page table. The image can be used
+// again.
+//
+//-----------------------------------------------------------------------------
+
+void IHex_Free (IHEX_IMAGE *image)
+{
+   IHex_Clear (image);
+
+   free (image->Pages);
+   image->Pages = NULL;
+   image->Capacity = 0;
+}
+
+//-----------------------------------------------------------------------------
+// IHex_Clear
+//-----------------------------------------------------------------------------
+//
+// Return Value : None
+// Parameters   :
+//   1) IHEX_IMAGE *image - image to empty
+//
+// This routine frees the pages but keeps the page table, so loading many
+// files into one image does not reallocate it.
+//
+//-----------------------------------------------------------------------------
+
+void IHex_Clear (IHEX_IMAGE *image)
+{
+   uint32_t i;
+
+   for (i = 0; i < image->Count; i++)
+   {
+      free (image->Pages[i].Data);
+   }
+
+   image->Count = 0;
+   image->Hint = 0;
+   image->Start = 0;
+   image->HasStart = 0;
+}
+
+//-----------------------------------------------------------------------------
+// IHex_Error
+//-----------------------------------------------------------------------------
+//
+// Return Value :
+//   1) const char * - description of <status>
+// Parameters   :
+//   1) int status - IHEX_OK or an IHEX_ERR_ code
+//
+//-----------------------------------------------------------------------------
+
+const char *IHex_Error (int status)
+{
+   switch (status)
+   {
+      case IHEX_OK:           return "no error";
+      case IHEX_ERR_ARGUMENT: return "invalid argument";
+      case IHEX_ERR_SYNTAX:   return "not an Intel HEX record";
+      case IHEX_ERR_CHECKSUM: return "record checksum error";
+      case IHEX_ERR_RECORD:   return "unsupported record";
+      case IHEX_ERR_CONFLICT: return "conflicting data";
+      case IHEX_ERR_MEMORY:   return "out of memory";
+      case IHEX_ERR_FILE:     return "file error";
+      case IHEX_ERR_PATCH:    return "patch does not apply";
+      default:                return "unknown error";
+   }
+}
+
+//-----------------------------------------------------------------------------
+// IHex_Parse
+//-----------------------------------------------------------------------------
+//
+// Return Value :
+//   IHEX_OK or an IHEX_ERR_ code, with the line in image->ErrorLine
+// Parameters   :
+//   1) IHEX_IMAGE *image - image to add the data to
+//   2) const char *text - Intel HEX text, need not be terminated
+//   3) size_t length - length of <text>
+//   4) uint8_t overwrite - 0 to fail with IHEX_ERR_CONFLICT if a record
+//                          changes a byte already in the image
+//
+// This routine adds the data records of <text> to <image>. Records 02 and
+// 04 set the upper address bits, records 03 and 05 set the start address,
+// and record 01 ends the file. Blank lines are skipped.
+//
+//-----------------------------------------------------------------------------
+
+int IHex_Parse (IHEX_IMAGE *image, const char *text, size_t length,
+                uint8_t overwrite)
+{
+   const uint8_t *p = (const uint8_t *) text;
+   const uint8_t *end = p + length;
+   uint8_t record[255 + 5];            // Count, address, type, data, sum
+   uint32_t base = 0;
+   uint32_t line = 1;
+   uint8_t sum;
+   uint8_t count;
+   uint8_t type;
+   uint16_t offset;
+   int status;
+   int value;
+   int i;
+
+   while (p < end)
+   {
+      if (*p == '\n')
+      {
+         line++;
+         p++;
+         continue;
+      }
+
+      if ((*p == '\r') || (*p == ' ') || (*p == '\t'))
+      {
+         p++;
+         continue;
+      }
+
+      image->ErrorLine = line;
+
+      if ((*p != ':') || ((end - p) < 11))
+      {
+         return IHEX_ERR_SYNTAX;
+      }
+
+      p++;
+
+      if ((Hex_Value[p[0]] | Hex_Value[p[1]]) < 0)
+      {
+         return IHEX_ERR_SYNTAX;
+      }
+      value = (Hex_Value[p[0]] << 4) | Hex_Value[p[1]];
+
+      count = (uint8_t) value;
+
+      if ((end - p) < ((count + 5) * 2))
+      {
+         return IHEX_ERR_SYNTAX;
+      }
+
+      sum = 0;
+
+      for (i = 0; i < (count + 5); i++, p += 2)
+      {
+         if ((Hex_Value[p[0]] | Hex_Value[p[1]]) < 0)
+         {
+            return IHEX_ERR_SYNTAX;
+         }
+
+         record[i] = (uint8_t) ((Hex_Value[p[0]] << 4) | Hex_Value[p[1]]);
+         sum += record[i];
+      }
+
+      if ((p < end) && (*p != '\r') && (*p != '\n') && (*p != ' ') &&
+          (*p != '\t'))
+      {
+         return IHEX_ERR_SYNTAX;       // Record longer than its count
+      }
+
+      if (sum != 0)
+      {
+         return IHEX_ERR_CHECKSUM;
+      }
+
+      offset = (uint16_t) ((record[1] << 8) | record[2]);
+      type = record[3];
+
+      switch (type)
+      {
+         case 0x00:                    // Data
+            status = IHex_Put (image, base + offset, record + 4, count,
+                               overwrite);
+            if (status != IHEX_OK)
+            {
+               return status;
+            }
+            break;
+
+         case 0x01:                    // End of file
+            return (count == 0) ? IHEX_OK : IHEX_ERR_RECORD;
+
+         case 0x02:                    // Extended segment address
+         case 0x04:                    // Extended linear address
+            if (count != 2)
+            {
+               return IHEX_ERR_RECORD;
+            }
+
+            base = (uint32_t) ((record[4] << 8) | record[5]);
+            base <<= (type == 0x02) ? 4 : 16;
+            break;
+
+         case 0x03:                    // Start segment address (CS:IP)
+         case 0x05:                    // Start linear address
+            if (count != 4)
+            {
+               return IHEX_ERR_RECORD;
+            }
+
+            if (type == 0x03)
+            {
+               image->Start = ((uint32_t) ((record[4] << 8) | record[5]) << 4)
+                            + (uint32_t) ((record[6] << 8) | record[7]);
+            }
+            else
+            {
+               image->Start = ((uint32_t) record[4] << 24) |
+                              ((uint32_t) record[5] << 16) |
+                              ((uint32_t) record[6] << 8) | record[7];
+            }
+            image->HasStart = 1;
+            break;
+
+         default:
+            return IHEX_ERR_RECORD;
+      }
+   }
+
+   image->ErrorLine = 0;
+
+   return IHEX_OK;
+}
+
+//-----------------------------------------------------------------------------
+// IHex_Load
+//-----------------------------------------------------------------------------
+//
+// Return Value :
+//   IHEX_OK or an IHEX_ERR_ code
+// Parameters   :
+//   1) IHEX_IMAGE *image - image to add the data to
+//   2) const char *path - Intel HEX file
+//   3) uint8_t overwrite - see IHex_Parse()
+//
+//-----------------------------------------------------------------------------
+
+int IHex_Load (IHEX_IMAGE *image, const char *path, uint8_t overwrite)
+{
+   FILE *file;
+   char *text;
+   long length;
+   int status;
+
+   image->ErrorLine = 0;
+
+   file = fopen (path, "rb");
+   if (file == NULL)
+   {
+      return IHEX_ERR_FILE;
+   }
+
+   if ((fseek (file, 0, SEEK_END) != 0) || ((length = ftell (file)) < 0) ||
+       (fseek (file, 0, SEEK_SET) != 0))
+   {
+      fclose (file);
+      return IHEX_ERR_FILE;
+   }
+
+   text = malloc (length ? length : 1);
+   if (text == NULL)
+   {
+      fclose (file);
+      return IHEX_ERR_MEMORY;
+   }
+
+   if (fread (text, 1, length, file) != (size_t) length)
+   {
+      status = IHEX_ERR_FILE;
+   }
+   else
+   {
+      status = IHex_Parse (image, text, length, overwrite);
+   }
+
+   free (text);
+   fclose (file);
+
+   return status;
+}
+
+//-----------------------------------------------------------------------------
+// IHex_Format
+//-----------------------------------------------------------------------------
+//
+// Return Value :
+//   IHEX_OK or an IHEX_ERR_ code
+// Parameters   :
+//   1) const IHEX_IMAGE *image - image to write
+//   2) uint8_t record_size - data bytes per record, 1 to 255
+//   3) char **text - returns the Intel HEX text, to free() by the caller
+//   4) size_t *length - returns the length of <text>
+//
+// This routine writes the used bytes of <image> as data records of up to
+// <record_size> bytes. A record does not cross a gap or a 64 KB boundary.
+// An extended linear address record (04) is written before the first
+// record of each 64 KB bank other than bank 0, and a start linear address
+// record (05) at the end if the image has a start address.
+//
+//-----------------------------------------------------------------------------
+
+int IHex_Format (const IHEX_IMAGE *image, uint8_t record_size,
+                 char **text, size_t *length)
+{
+   OUTPUT out = { NULL, 0, 0, IHEX_OK };
+   uint8_t record[255];
+   uint8_t bank[4];
+   uint32_t record_address = 0;
+   uint32_t upper = 0;
+   uint32_t address = 0;
+   uint32_t i;
+   uint32_t j;
+   uint8_t count = 0;
+   const IHEX_PAGE *page;
+
+   if (record_size == 0)
+   {
+      return IHEX_ERR_ARGUMENT;
+   }
+
+   Out_Reserve (&out, (IHex_Used (image) / record_size + 16) *
+                (13 + 2 * record_size));
+
+   for (i = 0; i <= image->Count; i++)
+   {
+      page = (i < image->Count) ? &image->Pages[i] : NULL;
+
+      for (j = 0; j < image->PageSize; j++)
+      {
+         if (page)
+         {
+            if (!(page->Used[j >> 3] & (1 << (j & 7))))
+            {
+               continue;
+            }
+
+            address = page->Address + j;
+         }
+
+         // Write the pending record if this byte cannot be added to it
+         if (count && ((page == NULL) ||
+                       (address != record_address + count) ||
+                       (count == record_size) ||
+                       ((address >> 16) != (record_address >> 16))))
+         {
+            if ((record_address >> 16) != upper)
+            {
+               upper = record_address >> 16;
+               bank[0] = (uint8_t) (upper >> 8);
+               bank[1] = (uint8_t) upper;
+               Out_Record (&out, 0x04, 0, bank, 2);
+            }
+
+            Out_Record (&out, 0x00, (uint16_t) record_address, record,
+                        count);
+            count = 0;
+         }
+
+         if (page == NULL)
+         {
+            break;
+         }
+
+         if (count == 0)
+         {
+            record_address = address;
+         }
+
+         record[count++] = page->Data[j];
+      }
+   }
+
+   if (image->HasStart)
+   {
+      bank[0] = (uint8_t) (image->Start >> 24);
+      bank[1] = (uint8_t) (image->Start >> 16);
+      bank[2] = (uint8_t) (image->Start >> 8);
+      bank[3] = (uint8_t) image->Start;
+      Out_Record (&out, 0x05, 0, bank, 4);
+   }
+
+   Out_Record (&out, 0x01, 0, NULL, 0);
+
+   if (out.Status != IHEX_OK)
+   {
+      free (out.Data);
+      return out.Status;
+   }
+
+   *text = (char *) out.Data;
+   *length = out.Length;
+
+   return IHEX_OK;
+}
+
+//-----------------------------------------------------------------------------
+// IHex_Save
+//-----------------------------------------------------------------------------
+//
+// Return Value :
+//   IHEX_OK or an IHEX_ERR_ code
+// Parameters   :
+//   1) const IHEX_IMAGE *image - image to write
+//   2) const char *path - Intel HEX file to create
+//   3) uint8_t record_size - data bytes per record, 1 to 255
+//
+//-----------------------------------------------------------------------------
+
+int IHex_Save (const IHEX_IMAGE *image, const char *path,
+               uint8_t record_size)
+{
+   FILE *file;
+   char *text;
+   size_t length;
+   int status;
+
+   status = IHex_Format (image, record_size, &text, &length);
+   if (status != IHEX_OK)
+   {
+      return status;
+   }
+
+   file = fopen (path, "wb");
+   if (file == NULL)
+   {
+      free (text);
+      return IHEX_ERR_FILE;
+   }
+
+   if (fwrite (text, 1, length, file) != length)
+   {
+      status = IHEX_ERR_FILE;
+   }
+
+   if (fclose (file) != 0)
+   {
+      status = IHEX_ERR_FILE;
+   }
+
+   free (text);
+
+   return status;
+}
+
+//-----------------------------------------------------------------------------
+// IHex_Put
+//-----------------------------------------------------------------------------
+//
+// Return Value :
+//   IHEX_OK or an IHEX_ERR_ code, with the address in image->ErrorAddress
+//   for IHEX_ERR_CONFLICT
+// Parameters   :
+//   1) IHEX_IMAGE *image - image to write
+//   2) uint32_t address - address of the first byte
+//   3) const uint8_t *src - bytes to write
+//   4) uint32_t length - number of bytes
+//   5) uint8_t overwrite - 0 to fail if a byte already in the image has
+//                          another value
+//
+// Bytes before a conflict are written.
+//
+//-----------------------------------------------------------------------------
+
+int IHex_Put (IHEX_IMAGE *image, uint32_t address, const uint8_t *src,
+              uint32_t length, uint8_t overwrite)
+{
+   IHEX_PAGE *page;
+   uint32_t offset;
+   uint32_t chunk;
+   uint32_t i;
+
+   while (length)
+   {
+      page = Page_Get (image, address & ~(image->PageSize - 1), 1);
+      if (page == NULL)
+      {
+         return IHEX_ERR_MEMORY;
+      }
+
+      offset = address & (image->PageSize - 1);
+      chunk = image->PageSize - offset;
+      if (chunk > length)
+      {
+         chunk = length;
+      }
+
+      for (i = offset; i < (offset + chunk); i++, src++)
+      {
+         if (page->Used[i >> 3] & (1 << (i & 7)))
+         {
+            if ((page->Data[i] != *src) && !overwrite)
+            {
+               image->ErrorAddress = page->Address + i;
+               return IHEX_ERR_CONFLICT;
+            }
+         }
+         else
+         {
+            page->Used[i >> 3] |= (uint8_t) (1 << (i & 7));
+         }
+
+         page->Data[i] = *src;
+      }
+
+      address += chunk;
+      length -= chunk;
+   }
+
+   return IHEX_OK;
+}
+
+//-----------------------------------------------------------------------------
+// IHex_Read
+//-----------------------------------------------------------------------------
+//
+// Return Value :
+//   1) uint32_t - number of bytes read that are used in the image
+// Parameters   :
+//   1) const IHEX_IMAGE *image - image to read
+//   2) uint32_t address - address of the first byte
+//   3) uint8_t *dest - destination bytes
+//   4) uint32_t length - number of bytes
+//
+// Bytes not in the image read as IHEX_ERASED.
+//
+//-----------------------------------------------------------------------------
+
+uint32_t IHex_Read (const IHEX_IMAGE *image, uint32_t address,
+                    uint8_t *dest, uint32_t length)
+{
+   const IHEX_PAGE *page;
+   uint32_t offset;
+   uint32_t chunk;
+   uint32_t used = 0;
+   uint32_t i;
+
+   while (length)
+   {
+      page = IHex_Find (image, address);
+
+      offset = address & (image->PageSize - 1);
+      chunk = image->PageSize - offset;
+      if (chunk > length)
+      {
+         chunk = length;
+      }
+
+      if (page)
+      {
+         memcpy (dest, page->Data + offset, chunk);
+
+         for (i = offset; i < (offset + chunk); i++)
+         {
+            used += (page->Used[i >> 3] >> (i & 7)) & 1;
+         }
+      }
+      else
+      {
+         memset (dest, IHEX_ERASED, chunk);
+      }
+
+      address += chunk;
+      dest += chunk;
+      length -= chunk;
+   }
+
+   return used;
+}
+
+//-----------------------------------------------------------------------------
+// IHex_Merge
+//-----------------------------------------------------------------------------
+//
+// Return Value :
+//   IHEX_OK or an IHEX_ERR_ code, see IHex_Put()
+// Parameters   :
+//   1) IHEX_IMAGE *dest - image to add to
+//   2) const IHEX_IMAGE *src - image to add, any page size
+//   3) uint8_t overwrite - 0 to fail if the images set a byte differently
+//
+// The start address of <src> is used if <dest> has none.
+//
+//-----------------------------------------------------------------------------
+
+int IHex_Merge (IHEX_IMAGE *dest, const IHEX_IMAGE *src, uint8_t overwrite)
+{
+   const IHEX_PAGE *page;
+   uint32_t i;
+   uint32_t j;
+   uint32_t run;
+   int status;
+
+   for (i = 0; i < src->Count; i++)
+   {
+      page = &src->Pages[i];
+
+      for (j = 0; j < src->PageSize; j = run)
+      {
+         if (!(page->Used[j >> 3] & (1 << (j & 7))))
+         {
+            run = j + 1;
+            continue;
+         }
+
+         for (run = j + 1; run < src->PageSize; run++)
+         {
+            if (!(page->Used[run >> 3] & (1 << (run & 7))))
+            {
+               break;
+            }
+         }
+
+         status = IHex_Put (dest, page->Address + j, page->Data + j, run - j,
+                            overwrite);
+         if (status != IHEX_OK)
+         {
+            return status;
+         }
+      }
+   }
+
+   if (!dest->HasStart && src->HasStart)
+   {
+      dest->Start = src->Start;
+      dest->HasStart = 1;
+   }
+
+   return IHEX_OK;
+}
+
+//-----------------------------------------------------------------------------
+// IHex_Align
+//-----------------------------------------------------------------------------
+//
+// Return Value : None
+// Parameters   :
+//   1) IHEX_IMAGE *image - image to align
+//   2) uint8_t fill - value of the bytes added
+//
+// This routine sets every unused byte of each page to <fill> and marks it
+// used, so the image covers whole pages.
+//
+//-----------------------------------------------------------------------------
+
+void IHex_Align (IHEX_IMAGE *image, uint8_t fill)
+{
+   IHEX_PAGE *page;
+   uint32_t i;
+   uint32_t j;
+
+   for (i = 0; i < image->Count; i++)
+   {
+      page = &image->Pages[i];
+
+      for (j = 0; j < image->PageSize; j++)
+      {
+         if (!(page->Used[j >> 3] & (1 << (j & 7))))
+         {
+            page->Data[j] = fill;
+         }
+      }
+
+      memset (page->Used, 0xFF, image->PageSize / 8);
+   }
+}
+
+//-----------------------------------------------------------------------------
+// IHex_Used
+//-----------------------------------------------------------------------------
+//
+// Return Value :
+//   1) uint32_t - number of bytes used in <image>
+// Parameters   :
+//   1) const IHEX_IMAGE *image - image to count
+//
+//-----------------------------------------------------------------------------
+
+uint32_t IHex_Used (const IHEX_IMAGE *image)
+{
+   uint32_t used = 0;
+   uint32_t i;
+   uint32_t j;
+
+   for (i = 0; i < image->Count; i++)
+   {
+      for (j = 0; j < image->PageSize / 8; j++)
+      {
+         used += __builtin_popcount (image->Pages[i].Used[j]);
+      }
+   }
+
+   return used;
+}
+
+//-----------------------------------------------------------------------------
+// IHex_Find
+//-----------------------------------------------------------------------------
+//
+// Return Value :
+//   1) const IHEX_PAGE * - page holding <address>, NULL if none
+// Parameters   :
+//   1) const IHEX_IMAGE *image - image to search
+//   2) uint32_t address - any address in the page
+//
+//-----------------------------------------------------------------------------
+
+const IHEX_PAGE *IHex_Find (const IHEX_IMAGE *image, uint32_t address)
+{
+   uint32_t i;
+   uint8_t found;
+
+   i = Page_Search (image, address & ~(image->PageSize - 1), &found);
+
+   return found ? &image->Pages[i] : NULL;
+}
+
+//-----------------------------------------------------------------------------
+// IHex_Crc16
+//-----------------------------------------------------------------------------
+//
+// Return Value :
+//   1) uint16_t - <crc> updated with <data>
+// Parameters   :
+//   1) uint16_t crc - 0 for the first call, as CRC0
+//   2) const uint8_t *data - bytes to add
+//   3) size_t length - number of bytes
+//
+// CRC-16 of CRC0: polynomial 0x1021, msb first, no final inversion. The
+// CRC of "123456789" is 0x31C3.
+//
+//-----------------------------------------------------------------------------
+
+uint16_t IHex_Crc16 (uint16_t crc, const uint8_t *data, size_t length)
+{
+   Tables_Init ();
+
+   while (length--)
+   {
+      crc = (uint16_t) ((crc << 8) ^ Crc16_Table[(crc >> 8) ^ *data++]);
+   }
+
+   return crc;
+}
+
+//-----------------------------------------------------------------------------
+// IHex_Crc32
+//-----------------------------------------------------------------------------
+//
+// Return Value :
+//   1) uint32_t - <crc> updated with <data>
+// Parameters   :
+//   1) uint32_t crc - 0 or 0xFFFFFFFF for the first call, as set in CRC0
+//   2) const uint8_t *data - bytes to add
+//   3) size_t length - number of bytes
+//
+// 32-bit CRC of CRC0: polynomial 0x04C11DB7, bit-reflected, no final
+// inversion. With an initial value of 0xFFFFFFFF, the inverted result is
+// the usual CRC-32.
+//
+//-----------------------------------------------------------------------------
+
+uint32_t IHex_Crc32 (uint32_t crc, const uint8_t *data, size_t length)
+{
+   Tables_Init ();
+
+   while (length--)
+   {
+      crc = (crc >> 8) ^ Crc32_Table[(crc ^ *data++) & 0xFF];
+   }
+
+   return crc;
+}
+
+//-----------------------------------------------------------------------------
+// IHex_Diff
+//-----------------------------------------------------------------------------
+//
+// Return Value :
+//   1) uint32_t - number of pages that differ
+// Parameters   :
+//   1) const IHEX_IMAGE *from - old image
+//   2) const IHEX_IMAGE *to - new image, same page size as <from>
+//   3) uint32_t *addresses - returns the address of each page that
+//                            differs, may be NULL
+//   4) uint32_t max - size of <addresses>
+//
+// The pages are compared as Flash: a byte not in an image is IHEX_ERASED,
+// so a page missing from one image differs only if the other holds a byte
+// that is not IHEX_ERASED.
+//
+//-----------------------------------------------------------------------------
+
+uint32_t IHex_Diff (const IHEX_IMAGE *from, const IHEX_IMAGE *to,
+                    uint32_t *addresses, uint32_t max)
+{
+   const IHEX_PAGE *a;
+   const IHEX_PAGE *b;
+   uint32_t i = 0;
+   uint32_t j = 0;
+   uint32_t count = 0;
+   uint32_t address;
+
+   while ((i < from->Count) || (j < to->Count))
+   {
+      a = (i < from->Count) ? &from->Pages[i] : NULL;
+      b = (j < to->Count) ? &to->Pages[j] : NULL;
+
+      if (a && (!b || (a->Address < b->Address)))
+      {
+         b = NULL;
+         i++;
+      }
+      else if (b && (!a || (b->Address < a->Address)))
+      {
+         a = NULL;
+         j++;
+      }
+      else
+      {
+         i++;
+         j++;
+      }
+
+      address = a ? a->Address : b->Address;
+
+      if (memcmp (Page_Data (from, a), Page_Data (to, b), from->PageSize))
+      {
+         if (addresses && (count < max))
+         {
+            addresses[count] = address;
+         }
+         count++;
+      }
+   }
+
+   return count;
+}
+
+//-----------------------------------------------------------------------------
+// IHex_MakePatch
+//-----------------------------------------------------------------------------
+//
+// Return Value :
+//   IHEX_OK or an IHEX_ERR_ code
+// Parameters   :
+//   1) const IHEX_IMAGE *from - image on the target
+//   2) const IHEX_IMAGE *to - new image, same page size as <from>
+//   3) uint8_t **patch - returns the patch, to free() by the caller
+//   4) size_t *length - returns the length of <patch>
+//
+// This routine writes a patch that changes <from> into <to>, for the pages
+// that IHex_Diff() reports. Within a page, changed bytes less than a run
+// header apart are sent in one run.
+//
+//-----------------------------------------------------------------------------
+
+int IHex_MakePatch (const IHEX_IMAGE *from, const IHEX_IMAGE *to,
+                    uint8_t **patch, size_t *length)
+{
+   OUTPUT out = { NULL, 0, 0, IHEX_OK };
+   uint32_t *addresses;
+   uint32_t pages;
+   uint32_t size = from->PageSize;
+   const uint8_t *old_data;
+   const uint8_t *new_data;
+   size_t runs_at;
+   uint16_t runs;
+   uint32_t start;
+   uint32_t stop;
+   uint32_t gap;
+   uint32_t i;
+
+   if (from->PageSize != to->PageSize)
+   {
+      return IHEX_ERR_ARGUMENT;
+   }
+
+   pages = IHex_Diff (from, to, NULL, 0);
+
+   addresses = malloc ((pages ? pages : 1) * sizeof (uint32_t));
+   if (addresses == NULL)
+   {
+      return IHEX_ERR_MEMORY;
+   }
+
+   IHex_Diff (from, to, addresses, pages);
+
+   Out_Reserve (&out, PATCH_HEADER + pages * (PATCH_PAGE + size / 2));
+   Out_Reserve (&out, 4);
+   if (out.Status == IHEX_OK)
+   {
+      memcpy (out.Data, "IHXP", 4);
+      out.Length = 4;
+   }
+   Out_Reserve (&out, 2);
+   if (out.Status == IHEX_OK)
+   {
+      out.Data[out.Length++] = IHEX_PATCH_VERSION;
+      out.Data[out.Length++] = 0;
+   }
+   Out_U16 (&out, (uint16_t) size);
+   Out_U32 (&out, pages);
+
+   for (i = 0; (i < pages) && (out.Status == IHEX_OK); i++)
+   {
+      old_data = Page_Data (from, IHex_Find (from, addresses[i]));
+      new_data = Page_Data (to, IHex_Find (to, addresses[i]));
+
+      Out_U32 (&out, addresses[i]);
+      Out_U16 (&out, IHex_Crc16 (0, old_data, size));
+      Out_U16 (&out, IHex_Crc16 (0, new_data, size));
+
+      runs_at = out.Length;
+      runs = 0;
+      Out_U16 (&out, 0);
+
+      for (start = 0; start < size; start = stop)
+      {
+         if (old_data[start] == new_data[start])
+         {
+            stop = start + 1;
+            continue;
+         }
+
+         stop = start + 1;
+
+         while (stop < size)
+         {
+            if (old_data[stop] != new_data[stop])
+            {
+               stop++;
+               continue;
+            }
+
+            // Join the next run if the gap is shorter than a run header
+            for (gap = stop; (gap < size) && (gap - stop < PATCH_RUN) &&
+                 (old_data[gap] == new_data[gap]); gap++);
+
+            if ((gap < size) && (gap - stop < PATCH_RUN))
+            {
+               stop = gap;
+            }
+            else
+            {
+               break;
+            }
+         }
+
+         Out_U16 (&out, (uint16_t) start);
+         Out_U16 (&out, (uint16_t) (stop - start));
+         Out_Reserve (&out, stop - start);
+         if (out.Status == IHEX_OK)
+         {
+            memcpy (out.Data + out.Length, new_data + start, stop - start);
+            out.Length += stop - start;
+         }
+         runs++;
+      }
+
+      if (out.Status == IHEX_OK)
+      {
+         out.Data[runs_at] = (uint8_t) runs;
+         out.Data[runs_at + 1] = (uint8_t) (runs >> 8);
+      }
+   }
+
+   free (addresses);
+
+   if (out.Status != IHEX_OK)
+   {
+      free (out.Data);
+      return out.Status;
+   }
+
+   *patch = out.Data;
+   *length = out.Length;
+
+   return IHEX_OK;
+}
+
+//-----------------------------------------------------------------------------
+// IHex_ApplyPatch
+//-----------------------------------------------------------------------------
+//
+// Return Value :
+//   IHEX_OK or an IHEX_ERR_ code, with the page address in
+//   image->ErrorAddress for IHEX_ERR_PATCH
+// Parameters   :
+//   1) IHEX_IMAGE *image - image to change
+//   2) const uint8_t *patch - patch from IHex_MakePatch()
+//   3) size_t length - length of <patch>
+//
+// This routine checks the CRC of every page of <image> named in the patch,
+// and the CRC of the page after the change, before it changes any byte.
+//
+//-----------------------------------------------------------------------------
+
+int IHex_ApplyPatch (IHEX_IMAGE *image, const uint8_t *patch, size_t length)
+{
+   uint8_t *page;
+   uint32_t size = image->PageSize;
+   uint32_t pages;
+   uint32_t address;
+   uint32_t offset;
+   uint32_t count;
+   uint16_t crc_after;
+   uint16_t runs;
+   size_t at;
+   uint8_t pass;
+   uint32_t i;
+   uint16_t r;
+   int status = IHEX_OK;
+
+   if ((length < PATCH_HEADER) || memcmp (patch, "IHXP", 4) ||
+       (patch[4] != IHEX_PATCH_VERSION) || (Get_U16 (patch + 6) != size))
+   {
+      return IHEX_ERR_PATCH;
+   }
+
+   pages = Get_U32 (patch + 8);
+
+   page = malloc (size);
+   if (page == NULL)
+   {
+      return IHEX_ERR_MEMORY;
+   }
+
+   // Pass 0 checks the whole patch, pass 1 applies it
+   for (pass = 0; (pass < 2) && (status == IHEX_OK); pass++)
+   {
+      at = PATCH_HEADER;
+
+      for (i = 0; (i < pages) && (status == IHEX_OK); i++)
+      {
+         if ((length - at) < PATCH_PAGE)
+         {
+            status = IHEX_ERR_PATCH;
+            break;
+         }
+
+         address = Get_U32 (patch + at);
+         crc_after = Get_U16 (patch + at + 6);
+         runs = Get_U16 (patch + at + 8);
+         image->ErrorAddress = address;
+
+         IHex_Read (image, address, page, size);
+
+         if ((address & (size - 1)) ||
+             (IHex_Crc16 (0, page, size) != Get_U16 (patch + at + 4)))
+         {
+            status = IHEX_ERR_PATCH;
+            break;
+         }
+
+         at += PATCH_PAGE;
+
+         for (r = 0; r < runs; r++)
+         {
+            if ((length - at) < PATCH_RUN)
+            {
+               status = IHEX_ERR_PATCH;
+               break;
+            }
+
+            offset = Get_U16 (patch + at);
+            count = Get_U16 (patch + at + 2);
+            at += PATCH_RUN;
+
+            if (((offset + count) > size) || ((length - at) < count))
+            {
+               status = IHEX_ERR_PATCH;
+               break;
+            }
+
+            if (pass == 0)
+            {
+               memcpy (page + offset, patch + at, count);
+            }
+            else
+            {
+               status = IHex_Put (image, address + offset, patch + at, count,
+                                  1);
+               if (status != IHEX_OK)
+               {
+                  break;
+               }
+            }
+
+            at += count;
+         }
+
+         if ((status == IHEX_OK) && (pass == 0) &&
+             (IHex_Crc16 (0, page, size) != crc_after))
+         {
+            status = IHEX_ERR_PATCH;
+         }
+      }
+   }
+
+   free (page);
+
+   return status;
+}
+
+//-----------------------------------------------------------------------------
+// Local Routines
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// Tables_Init
+//-----------------------------------------------------------------------------
+//
+// Builds the hex digit and CRC tables on the first call.
+//
+//-----------------------------------------------------------------------------
+
+static void Tables_Init (void)
+{
+   uint32_t crc32;
+   uint16_t crc16;
+   int i;
+   int bit;
+
+   if (Tables_Ready)
+   {
+      return;
+   }
+
+   memset (Hex_Value, -1, sizeof (Hex_Value));
+
+   for (i = 0; i < 10; i++)
+   {
+      Hex_Value['0' + i] = (int8_t) i;
+   }
+
+   for (i = 0; i < 6; i++)
+   {
+      Hex_Value['A' + i] = (int8_t) (10 + i);
+      Hex_Value['a' + i] = (int8_t) (10 + i);
+   }
+
+   for (i = 0; i < 256; i++)
+   {
+      crc16 = (uint16_t) (i << 8);
+      crc32 = (uint32_t) i;
+
+      for (bit = 0; bit < 8; bit++)
+      {
+         crc16 = (uint16_t) ((crc16 & 0x8000) ? ((crc16 << 1) ^ 0x1021)
+                                              : (crc16 << 1));
+         crc32 = (crc32 & 1) ? ((crc32 >> 1) ^ 0xEDB88320) : (crc32 >> 1);
+      }
+
+      Crc16_Table[i] = crc16;
+      Crc32_Table[i] = crc32;
+   }
+
+   memset (Erased_Page, IHEX_ERASED, sizeof (Erased_Page));
+
+   Tables_Ready = 1;
+}
+
+//-----------------------------------------------------------------------------
+// Page_Search
+//-----------------------------------------------------------------------------
+//
+// Returns the index of the page at <address>, or the index to insert it
+// at, and sets <found>. The page after the last one used is tried first.
+//
+//-----------------------------------------------------------------------------
+
+static uint32_t Page_Search (const IHEX_IMAGE *image, uint32_t address,
+                             uint8_t *found)
+{
+   uint32_t low = 0;
+   uint32_t high = image->Count;
+   uint32_t middle;
+   uint32_t hint = image->Hint;
+
+   *found = 0;
+
+   if (hint < image->Count)
+   {
+      if (image->Pages[hint].Address == address)
+      {
+         *found = 1;
+         return hint;
+      }
+
+      if (image->Pages[hint].Address < address)
+      {
+         if ((hint + 1 == image->Count) ||
+             (image->Pages[hint + 1].Address > address))
+         {
+            return hint + 1;
+         }
+
+         if (image->Pages[hint + 1].Address == address)
+         {
+            *found = 1;
+            return hint + 1;
+         }
+
+         low = hint + 2;
+      }
+      else
+      {
+         high = hint;
+      }
+   }
+
+   while (low < high)
+   {
+      middle = low + (high - low) / 2;
+
+      if (image->Pages[middle].Address < address)
+      {
+         low = middle + 1;
+      }
+      else
+      {
+         high = middle;
+      }
+   }
+
+   *found = (low < image->Count) && (image->Pages[low].Address == address);
+
+   return low;
+}
+
+//-----------------------------------------------------------------------------
+// Page_Get
+//-----------------------------------------------------------------------------
+//
+// Returns the page at <address>, which must be page aligned. If there is
+// none, a page is added if <create> is set, or NULL is returned.
+//
+//-----------------------------------------------------------------------------
+
+static IHEX_PAGE *Page_Get (IHEX_IMAGE *image, uint32_t address,
+                            uint8_t create)
+{
+   IHEX_PAGE *pages;
+   uint32_t i;
+   uint8_t found;
+
+   i = Page_Search (image, address, &found);
+
+   if (!found)
+   {
+      if (!create)
+      {
+         return NULL;
+      }
+
+      if (image->Count == image->Capacity)
+      {
+         pages = realloc (image->Pages, (image->Capacity ? 2 * image->Capacity
+                                         : 64) * sizeof (IHEX_PAGE));
+         if (pages == NULL)
+         {
+            return NULL;
+         }
+
+         image->Pages = pages;
+         image->Capacity = image->Capacity ? 2 * image->Capacity : 64;
+      }
+
+      memmove (&image->Pages[i + 1], &image->Pages[i],
+               (image->Count - i) * sizeof (IHEX_PAGE));
+
+      // Data and the used bitmap share one allocation
+      image->Pages[i].Data = malloc (image->PageSize + image->PageSize / 8);
+      if (image->Pages[i].Data == NULL)
+      {
+         memmove (&image->Pages[i], &image->Pages[i + 1],
+                  (image->Count - i) * sizeof (IHEX_PAGE));
+         return NULL;
+      }
+
+      image->Pages[i].Address = address;
+      image->Pages[i].Used = image->Pages[i].Data + image->PageSize;
+      memset (image->Pages[i].Data, IHEX_ERASED, image->PageSize);
+      memset (image->Pages[i].Used, 0, image->PageSize / 8);
+      image->Count++;
+   }
+
+   image->Hint = i;
+
+   return &image->Pages[i];
+}
+
+//-----------------------------------------------------------------------------
+// Page_Data
+//-----------------------------------------------------------------------------
+//
+// Returns the bytes of <page>, or a page of IHEX_ERASED if <page> is NULL.
+//
+//-----------------------------------------------------------------------------
+
+static const uint8_t *Page_Data (const IHEX_IMAGE *image,
+                                 const IHEX_PAGE *page)
+{
+   (void) image;
+
+   return page ? page->Data : Erased_Page;
+}
+
+//-----------------------------------------------------------------------------
+// Out_Reserve
+//-----------------------------------------------------------------------------
+//
+// Makes room for <length> more bytes in <out>, or sets out->Status.
+//
+//-----------------------------------------------------------------------------
+
+static void Out_Reserve (OUTPUT *out, size_t length)
+{
+   uint8_t *data;
+   size_t capacity;
+
+   if ((out->Status != IHEX_OK) || ((out->Length + length) <= out->Capacity))
+   {
+      return;
+   }
+
+   capacity = out->Capacity ? out->Capacity : 256;
+   while (capacity < (out->Length + length))
+   {
+      capacity *= 2;
+   }
+
+   data = realloc (out->Data, capacity);
+   if (data == NULL)
+   {
+      out->Status = IHEX_ERR_MEMORY;
+      return;
+   }
+
+   out->Data = data;
+   out->Capacity = capacity;
+}
+
+//-----------------------------------------------------------------------------
+// Out_Record
+//-----------------------------------------------------------------------------
+//
+// Appends one Intel HEX record to <out>.
+//
+//-----------------------------------------------------------------------------
+
+static void Out_Record (OUTPUT *out, uint8_t type, uint16_t address,
+                        const uint8_t *data, uint8_t count)
+{
+   uint8_t *p;
+   uint8_t sum;
+   uint8_t i;
+
+   Out_Reserve (out, 12 + 2 * count);
+   if (out->Status != IHEX_OK)
+   {
+      return;
+   }
+
+   p = out->Data + out->Length;
+   sum = (uint8_t) (count + (address >> 8) + address + type);
+
+   *p++ = ':';
+   *p++ = Hex_Digit[count >> 4];
+   *p++ = Hex_Digit[count & 0x0F];
+   *p++ = Hex_Digit[(address >> 12) & 0x0F];
+   *p++ = Hex_Digit[(address >> 8) & 0x0F];
+   *p++ = Hex_Digit[(address >> 4) & 0x0F];
+   *p++ = Hex_Digit[address & 0x0F];
+   *p++ = Hex_Digit[type >> 4];
+   *p++ = Hex_Digit[type & 0x0F];
+
+   for (i = 0; i < count; i++)
+   {
+      *p++ = Hex_Digit[data[i] >> 4];
+      *p++ = Hex_Digit[data[i] & 0x0F];
+      sum += data[i];
+   }
+
+   sum = (uint8_t) -sum;
+   *p++ = Hex_Digit[sum >> 4];
+   *p++ = Hex_Digit[sum & 0x0F];
+   *p++ = '\n';
+
+   out->Length = p - out->Data;
+}
+
+//-----------------------------------------------------------------------------
+// Out_U16, Out_U32, Get_U16, Get_U32
+//-----------------------------------------------------------------------------
+//
+// Little endian values of the patch format.
+//
+//-----------------------------------------------------------------------------
+
+static void Out_U16 (OUTPUT *out, uint16_t value)
+{
+   Out_Reserve (out, 2);
+   if (out->Status == IHEX_OK)
+   {
+      out->Data[out->Length++] = (uint8_t) value;
+      out->Data[out->Length++] = (uint8_t) (value >> 8);
+   }
+}
+
+static void Out_U32 (OUTPUT *out, uint32_t value)
+{
+   Out_U16 (out, (uint16_t) value);
+   Out_U16 (out, (uint16_t) (value >> 16));
+}
+
+static uint16_t Get_U16 (const uint8_t *p)
+{
+   return (uint16_t) (p[0] | (p[1] << 8));
+}
+
+static uint32_t Get_U32 (const uint8_t *p)
+{
+   return (uint32_t) Get_U16 (p) | ((uint32_t) Get_U16 (p + 2) << 16);
+}
+
+//-----------------------------------------------------------------------------
+// End Of File
+//-----------------------------------------------------------------------------
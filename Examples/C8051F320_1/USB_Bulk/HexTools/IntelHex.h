@@ -0,0 +1,136 @@
+//-----------------------------------------------------------------------------
+// IntelHex.h
+//-----------------------------------------------------------------------------
+//
+// Program Description:
+//
+// Header for the Intel HEX image library in IntelHex.c.
+//
+// An image holds the bytes of one or more HEX files in pages of PageSize
+// bytes, sorted by address. Only the pages that hold data are allocated.
+// The bytes of a page that are not in any file read as IHEX_ERASED, the
+// value of erased Flash, and are marked unused so they are not written
+// back to a HEX file.
+//
+// Target:         Linux host
+// Tool chain:     GCC
+// Command Line:   None
+//
+// Release 1.0
+//    -Initial Revision
+//
+
+//-----------------------------------------------------------------------------
+// Open Header #define
+//-----------------------------------------------------------------------------
+
+#ifndef _INTELHEX_H_
+#define _INTELHEX_H_
+
+//-----------------------------------------------------------------------------
+// Includes
+//-----------------------------------------------------------------------------
+
+#include <stddef.h>
+#include <stdint.h>
+
+//-----------------------------------------------------------------------------
+// Global Constants
+//-----------------------------------------------------------------------------
+
+#define IHEX_ERASED        0xFF        // Value of bytes not in the image
+#define IHEX_PAGE_SIZE     512         // Default page size
+#define IHEX_RECORD_SIZE   16          // Default data bytes per record
+
+// Status codes
+#define IHEX_OK            0
+#define IHEX_ERR_ARGUMENT  1           // Bad page size or record size
+#define IHEX_ERR_SYNTAX    2           // Not a HEX record
+#define IHEX_ERR_CHECKSUM  3           // Record checksum does not match
+#define IHEX_ERR_RECORD    4           // Unknown record type or length
+#define IHEX_ERR_CONFLICT  5           // Two files set a byte differently
+#define IHEX_ERR_MEMORY    6
+#define IHEX_ERR_FILE      7
+#define IHEX_ERR_PATCH     8           // Patch malformed or does not apply
+
+// Patch format, all values little endian:
+//
+//    "IHXP" [version] [0] [page size U16] [page count U32]
+//    for each page:
+//       [address U32] [CRC before U16] [CRC after U16] [run count U16]
+//       for each run: [offset U16] [length U16] [data ...]
+//
+// The CRCs are IHex_Crc16() of the whole page, unused bytes as
+// IHEX_ERASED, so the target can check a page before and after it
+// programs it.
+#define IHEX_PATCH_VERSION 1
+
+//-----------------------------------------------------------------------------
+// Structures, Unions, Enumerations, and Type Definitions
+//-----------------------------------------------------------------------------
+
+typedef struct IHEX_PAGE
+{
+   uint32_t Address;                   // First address of the page
+   uint8_t *Data;                      // PageSize bytes
+   uint8_t *Used;                      // One bit per byte of Data
+} IHEX_PAGE;
+
+typedef struct IHEX_IMAGE
+{
+   uint32_t PageSize;                  // Power of 2, 16 to 32768
+   uint32_t Count;                     // Pages allocated
+   uint32_t Capacity;
+   IHEX_PAGE *Pages;                   // Sorted by Address
+   uint32_t Hint;                      // Index of the last page used
+   uint32_t Start;                     // Start address, record 03 or 05
+   uint8_t HasStart;
+   uint32_t ErrorLine;                 // Line of the last parse error
+   uint32_t ErrorAddress;              // Address of the last conflict
+} IHEX_IMAGE;
+
+//-----------------------------------------------------------------------------
+// Exported Function Prototypes
+//-----------------------------------------------------------------------------
+
+int  IHex_Init (IHEX_IMAGE *image, uint32_t page_size);
+void IHex_Free (IHEX_IMAGE *image);
+void IHex_Clear (IHEX_IMAGE *image);
+const char *IHex_Error (int status);
+
+int  IHex_Parse (IHEX_IMAGE *image, const char *text, size_t length,
+                 uint8_t overwrite);
+int  IHex_Load (IHEX_IMAGE *image, const char *path, uint8_t overwrite);
+int  IHex_Format (const IHEX_IMAGE *image, uint8_t record_size,
+                  char **text, size_t *length);
+int  IHex_Save (const IHEX_IMAGE *image, const char *path,
+                uint8_t record_size);
+
+int  IHex_Put (IHEX_IMAGE *image, uint32_t address, const uint8_t *src,
+               uint32_t length, uint8_t overwrite);
+uint32_t IHex_Read (const IHEX_IMAGE *image, uint32_t address,
+                    uint8_t *dest, uint32_t length);
+int  IHex_Merge (IHEX_IMAGE *dest, const IHEX_IMAGE *src, uint8_t overwrite);
+void IHex_Align (IHEX_IMAGE *image, uint8_t fill);
+uint32_t IHex_Used (const IHEX_IMAGE *image);
+const IHEX_PAGE *IHex_Find (const IHEX_IMAGE *image, uint32_t address);
+
+uint16_t IHex_Crc16 (uint16_t crc, const uint8_t *data, size_t length);
+uint32_t IHex_Crc32 (uint32_t crc, const uint8_t *data, size_t length);
+
+uint32_t IHex_Diff (const IHEX_IMAGE *from, const IHEX_IMAGE *to,
+                    uint32_t *addresses, uint32_t max);
+int  IHex_MakePatch (const IHEX_IMAGE *from, const IHEX_IMAGE *to,
+                     uint8_t **patch, size_t *length);
+int  IHex_ApplyPatch (IHEX_IMAGE *image, const uint8_t *patch,
+                      size_t length);
+
+//-----------------------------------------------------------------------------
+// Close Header #define
+//-----------------------------------------------------------------------------
+
+#endif    // _INTELHEX_H_
+
+//-----------------------------------------------------------------------------
+// End Of File
+//-----------------------------------------------------------------------------
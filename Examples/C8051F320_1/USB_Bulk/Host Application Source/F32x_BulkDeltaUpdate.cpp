@@ -0,0 +1,191 @@
+// F32x_BulkDeltaUpdate.cpp : Intel HEX image and page CRC routines used by
+// CF32x_BulkFileTransferDlg::WriteDeltaData()
+//
+
+#include "stdafx.h"
+#include "F32x_BulkDeltaUpdate.h"
+#include <stdio.h>
+
+// CRC-16 (polynomial 0x1021, initial value 0) of each 4-bit value, the
+// same table as the firmware and the CRC0 engine of other C8051 devices
+static const WORD sgCrcTable[16] =
+{
+	0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+	0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF
+};
+
+static int HexDigit(char c);
+static int HexByte(const char* s);
+
+
+//------------------------------------------------------------------------
+// HexImage_Load()
+//
+// Read an Intel HEX file into image, which holds dwSize bytes of Flash
+// starting at address dwBase.  Bytes not in the file are 0xFF.  Data
+// records (00), extended segment (02) and extended linear (04) address
+// records and the end of file record (01) are supported.
+//
+// lpdwLength returns the offset after the last byte in the file.  Returns
+// FALSE if a record is malformed, has a bad checksum or falls outside
+// the image.
+//------------------------------------------------------------------------
+BOOL
+HexImage_Load(LPCTSTR lpszFileName, BYTE* image, DWORD dwBase, DWORD dwSize, LPDWORD lpdwLength)
+{
+	FILE*	file;
+	char	line[600];
+	BYTE	rec[256 + 5];
+	DWORD	dwUpper		= 0;
+	BOOL	success		= TRUE;
+	BOOL	end			= FALSE;
+
+	*lpdwLength = 0;
+	memset(image, 0xFF, dwSize);
+
+	file = fopen(lpszFileName, "rt");
+
+	if (file == NULL)
+	{
+		return FALSE;
+	}
+
+	while (success && !end && fgets(line, sizeof(line), file))
+	{
+		int		count;
+		int		i;
+		BYTE	sum		= 0;
+		DWORD	dwAddr;
+
+		if (line[0] != ':')
+		{
+			continue;					// Blank line or comment
+		}
+
+		count = HexByte(line + 1);
+
+		if (count < 0 || (int)strlen(line) < 11 + 2 * count)
+		{
+			success = FALSE;
+			break;
+		}
+
+		// Byte count, address, type, data and checksum
+		for (i = 0; i < count + 5; i++)
+		{
+			int b = HexByte(line + 1 + 2 * i);
+
+			if (b < 0)
+			{
+				success = FALSE;
+				break;
+			}
+
+			rec[i] = (BYTE)b;
+			sum += (BYTE)b;
+		}
+
+		if (!success || sum != 0)
+		{
+			success = FALSE;
+			break;
+		}
+
+		switch (rec[3])
+		{
+			case 0x00:
+				dwAddr = dwUpper + ((rec[1] << 8) | rec[2]);
+
+				if (dwAddr < dwBase || dwAddr + count > dwBase + dwSize)
+				{
+					success = FALSE;
+					break;
+				}
+
+				memcpy(image + (dwAddr - dwBase), rec + 4, count);
+
+				if (dwAddr + count - dwBase > *lpdwLength)
+				{
+					*lpdwLength = dwAddr + count - dwBase;
+				}
+				break;
+
+			case 0x01:
+				end = TRUE;
+				break;
+
+			case 0x02:
+				dwUpper = ((rec[4] << 8) | rec[5]) << 4;
+				break;
+
+			case 0x04:
+				dwUpper = ((rec[4] << 8) | rec[5]) << 16;
+				break;
+
+			default:
+				break;					// Start address records
+		}
+	}
+
+	fclose(file);
+
+	return success;
+}
+
+
+//------------------------------------------------------------------------
+// Page_Crc()
+//
+// CRC-16 of dwSize bytes, computed as Page_Crc() in the firmware.
+//------------------------------------------------------------------------
+WORD
+Page_Crc(const BYTE* data, DWORD dwSize)
+{
+	WORD crc = 0;
+
+	for (DWORD i = 0; i < dwSize; i++)
+	{
+		crc ^= (WORD)(data[i] << 8);
+		crc = (WORD)((crc << 4) ^ sgCrcTable[crc >> 12]);
+		crc = (WORD)((crc << 4) ^ sgCrcTable[crc >> 12]);
+	}
+
+	return crc;
+}
+
+
+//------------------------------------------------------------------------
+// HexDigit()
+//
+// Value of a hexadecimal digit, or -1.
+//------------------------------------------------------------------------
+static int HexDigit(char c)
+{
+	if (c >= '0' && c <= '9')
+		return c - '0';
+	if (c >= 'A' && c <= 'F')
+		return c - 'A' + 10;
+	if (c >= 'a' && c <= 'f')
+		return c - 'a' + 10;
+
+	return -1;
+}
+
+
+//------------------------------------------------------------------------
+// HexByte()
+//
+// Value of two hexadecimal digits, or -1.
+//------------------------------------------------------------------------
+static int HexByte(const char* s)
+{
+	int hi = HexDigit(s[0]);
+	int lo = HexDigit(s[1]);
+
+	if (hi < 0 || lo < 0)
+	{
+		return -1;
+	}
+
+	return (hi << 4) | lo;
+}
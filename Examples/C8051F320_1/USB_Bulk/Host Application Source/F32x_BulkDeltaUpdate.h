@@ -0,0 +1,31 @@
+// F32x_BulkDeltaUpdate.h : Intel HEX image and page CRC routines used by
+// CF32x_BulkFileTransferDlg::WriteDeltaData()
+//
+
+#if !defined(F32X_BULKDELTAUPDATE_H)
+#define F32X_BULKDELTAUPDATE_H
+
+#if _MSC_VER > 1000
+#pragma once
+#endif // _MSC_VER > 1000
+
+// File storage of the bulk firmware (see F32x_USB_ISR.c)
+#define FT_STG_START		0x1400		// Flash address of the first page
+#define FT_STG_PAGES		20			// NUM_STG_PAGES
+#define FT_PAGE_SIZE		512			// FLASH_PAGE_SIZE
+#define FT_STG_SIZE			(FT_STG_PAGES * FT_PAGE_SIZE)
+
+BOOL HexImage_Load(
+	LPCTSTR lpszFileName,
+	BYTE* image,
+	DWORD dwBase,
+	DWORD dwSize,
+	LPDWORD lpdwLength
+	);
+
+WORD Page_Crc(
+	const BYTE* data,
+	DWORD dwSize
+	);
+
+#endif // !defined(F32X_BULKDELTAUPDATE_H)
@@ -90,6 +90,10 @@ LINK32=link.exe
 # PROP Default_Filter "cpp;c;cxx;rc;def;r;odl;idl;hpj;bat"
 # Begin Source File
 
+SOURCE=.\F32x_BulkDeltaUpdate.cpp
+# End Source File
+# Begin Source File
+
 SOURCE=.\F32x_BulkFileTransfer.cpp
 # End Source File
 # Begin Source File
@@ -115,6 +119,10 @@ SOURCE=.\UsbIF.cpp
 # PROP Default_Filter "h;hpp;hxx;hm;inl"
 # Begin Source File
 
+SOURCE=.\F32x_BulkDeltaUpdate.h
+# End Source File
+# Begin Source File
+
 SOURCE=.\F32x_BulkFileTransfer.h
 # End Source File
 # Begin Source File
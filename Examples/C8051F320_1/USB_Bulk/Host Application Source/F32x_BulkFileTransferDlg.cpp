@@ -96,6 +96,7 @@ BEGIN_MESSAGE_MAP(CF32x_BulkFileTransferDlg, CDialog)
 	ON_BN_CLICKED(IDC_BROWSE_TX_FILE, OnBrowseTxFile)
 	ON_BN_CLICKED(IDC_BROWSE_RX_FILE, OnBrowseRxFile)
 	ON_BN_CLICKED(IDC_UPDATE_DEVICE_LIST, OnUpdateDeviceList)
+	ON_BN_CLICKED(IDC_DELTA_DATA, OnDeltaData)
 	//}}AFX_MSG_MAP
 END_MESSAGE_MAP()
 
@@ -266,6 +267,19 @@ void CF32x_BulkFileTransferDlg::OnReceiveData()
 	EndWaitCursor();	
 }
 
+void CF32x_BulkFileTransferDlg::OnDeltaData() 
+{
+	BeginWaitCursor();
+
+	if (m_hUSBDevice != INVALID_HANDLE_VALUE)
+	{
+		// Write only the pages that differ from the Intel HEX file.
+		WriteDeltaData();
+	}
+
+	EndWaitCursor();
+}
+
 void CF32x_BulkFileTransferDlg::OnBrowseTxFile() 
 {
 	CFileDialog fileDlg(TRUE);
@@ -562,6 +576,148 @@ BOOL CF32x_BulkFileTransferDlg::ReadFileData()
 }
 
 
+// Updates the file stored by the firmware to the Intel HEX image in the
+// Transfer File.  The addresses in the HEX file are Flash addresses within
+// the file storage (FT_STG_START).  The firmware returns the CRC of each
+// page, and only the pages whose CRC differs from the image are sent,
+// erased and programmed.  The CRCs are read again at the end to verify
+// the update.
+BOOL CF32x_BulkFileTransferDlg::WriteDeltaData()
+{
+	BOOL		success			= TRUE;
+	BYTE		image[FT_STG_SIZE];
+	BYTE		crcs[FT_CRC_MSG_SIZE];
+	BYTE		msg[FT_MSG_SIZE];
+	DWORD		length			= 0;
+	DWORD		numPages		= 0;
+	DWORD		pagesWritten	= 0;
+	DWORD		dwBytesWritten	= 0;
+
+	UpdateData(TRUE);
+
+	if (m_sTXFileName.GetLength() == 0)
+	{
+		AfxMessageBox("Error:  No file selected.");
+		return FALSE;
+	}
+
+	if (!HexImage_Load(m_sTXFileName, image, FT_STG_START, FT_STG_SIZE, &length) || length == 0)
+	{
+		CString err;
+		err.Format("Failed reading Intel HEX file:\n%s\n\nThe data must be within 0x%04X to 0x%04X.",
+			m_sTXFileName, FT_STG_START, FT_STG_START + FT_STG_SIZE - 1);
+		AfxMessageBox(err);
+		return FALSE;
+	}
+
+	if (!ReadPageCrcs(crcs))
+	{
+		AfxMessageBox("Failed reading page CRCs from target device.");
+		return FALSE;
+	}
+
+	numPages = (length + FT_PAGE_SIZE - 1) / FT_PAGE_SIZE;
+
+	// Send the pages that differ
+	for (DWORD page = 0; page < numPages && success; page++)
+	{
+		BYTE*	data	= image + page * FT_PAGE_SIZE;
+		WORD	crc		= (crcs[4 + 2 * page] << 8) | crcs[5 + 2 * page];
+
+		if (Page_Crc(data, FT_PAGE_SIZE) != crc)
+		{
+			msg[0] = FT_PAGE_MSG;
+			msg[1] = (BYTE)page;
+			msg[2] = 0;
+
+			success = DeviceWrite(msg, FT_MSG_SIZE, &dwBytesWritten) &&
+					  DeviceWrite(data, FT_PAGE_SIZE, &dwBytesWritten) &&
+					  ReadAck();
+			pagesWritten++;
+		}
+	}
+
+	// Update the file length if it changed
+	if (success && (crcs[2] | (crcs[3] << 8)) != length)
+	{
+		msg[0] = FT_LENGTH_MSG;
+		msg[1] = (BYTE)(length & 0x000000FF);
+		msg[2] = (BYTE)((length & 0x0000FF00) >> 8);
+
+		success = DeviceWrite(msg, FT_MSG_SIZE, &dwBytesWritten) && ReadAck();
+	}
+
+	if (!success)
+	{
+		AfxMessageBox("Target device failure while sending page data.");
+		return FALSE;
+	}
+
+	// Verify
+	success = ReadPageCrcs(crcs) && (crcs[2] | (crcs[3] << 8)) == length;
+
+	for (DWORD page = 0; page < numPages && success; page++)
+	{
+		WORD crc = (crcs[4 + 2 * page] << 8) | crcs[5 + 2 * page];
+
+		success = (Page_Crc(image + page * FT_PAGE_SIZE, FT_PAGE_SIZE) == crc);
+	}
+
+	CString result;
+
+	if (success)
+	{
+		result.Format("%lu of %lu pages written.  All pages verified.", pagesWritten, numPages);
+	}
+	else
+	{
+		result.Format("%lu of %lu pages written.  Verification failed.", pagesWritten, numPages);
+	}
+
+	AfxMessageBox(result);
+
+	return success;
+}
+
+
+// Sends the CRC message and reads the reply:
+// {FT_CRC_MSG, FT_STG_PAGES, length low, length high, CRC high/low of each page}
+BOOL CF32x_BulkFileTransferDlg::ReadPageCrcs(BYTE* crcs)
+{
+	BYTE	msg[FT_MSG_SIZE];
+	DWORD	dwBytesWritten	= 0;
+	DWORD	dwBytesRead		= 0;
+
+	msg[0] = FT_CRC_MSG;
+	msg[1] = 0;
+	msg[2] = 0;
+
+	memset(crcs, 0, FT_CRC_MSG_SIZE);
+
+	return DeviceWrite(msg, FT_MSG_SIZE, &dwBytesWritten) &&
+		   DeviceRead(crcs, FT_CRC_MSG_SIZE, &dwBytesRead) &&
+		   dwBytesRead == FT_CRC_MSG_SIZE &&
+		   crcs[0] == FT_CRC_MSG &&
+		   crcs[1] == FT_STG_PAGES;
+}
+
+
+// Waits for the ACK packet (0xFF) sent after each Flash write.
+BOOL CF32x_BulkFileTransferDlg::ReadAck()
+{
+	BOOL	success		= TRUE;
+	BYTE	buf[1]		= {0};
+	DWORD	dwBytesRead	= 0;
+
+	while ((buf[0] != 0xFF) && success)
+	{
+		success = DeviceRead(buf, 1, &dwBytesRead);
+	}
+
+	return success;
+}
+
+
 BOOL CF32x_BulkFileTransferDlg::DeviceRead(BYTE* buffer, DWORD dwSize, DWORD* lpdwBytesRead, DWORD dwTimeout)
 {
 	F32x_STATUS	status			= F32x_SUCCESS;
@@ -8,6 +8,8 @@
 #pragma once
 #endif // _MSC_VER > 1000
 
+#include "F32x_BulkDeltaUpdate.h"
+
 //#define MAX_PACKET_SIZE_READ		64
 #define MAX_PACKET_SIZE_READ		(64 *1024 )
 //#define MAX_PACKET_SIZE_WRITE		64
@@ -19,8 +21,12 @@
 #define FT_READ_MSG			0x00
 #define FT_WRITE_MSG		0x01
 #define FT_READ_ACK			0x02
+#define FT_CRC_MSG			0x03
+#define FT_PAGE_MSG			0x04
+#define FT_LENGTH_MSG		0x05
 
 #define FT_MSG_SIZE			0x03
+#define FT_CRC_MSG_SIZE		(4 + 2 * FT_STG_PAGES)
 
 /////////////////////////////////////////////////////////////////////////////
 // CF32x_BulkFileTransferDlg dialog
@@ -60,6 +66,7 @@ protected:
 	afx_msg void OnBrowseRxFile();
 	virtual void OnOK();
 	afx_msg void OnUpdateDeviceList();
+	afx_msg void OnDeltaData();
 	//}}AFX_MSG
 	DECLARE_MESSAGE_MAP()
 
@@ -67,6 +74,9 @@ private:
 	void FillDeviceList();
 	BOOL WriteFileData();
 	BOOL ReadFileData();
+	BOOL WriteDeltaData();
+	BOOL ReadPageCrcs(BYTE* crcs);
+	BOOL ReadAck();
 	BOOL DeviceRead(BYTE* buffer, DWORD dwSize, DWORD* lpdwBytesRead, DWORD dwTimeout = 0);
 	BOOL DeviceWrite(BYTE* buffer, DWORD dwSize, DWORD* lpdwBytesWritten, DWORD dwTimeout = 0);
 
@@ -16,6 +16,7 @@
 #define IDC_RX_FILE_NAME                1005
 #define IDC_BROWSE_RX_FILE              1006
 #define IDC_UPDATE_DEVICE_LIST          1007
+#define IDC_DELTA_DATA                  1008
 
 // Next default values for new objects
 // 
@@ -135,6 +135,7 @@ void SynchFrameRequest (void);            //
 
 void Page_Erase(BYTE*);
 void Page_Write(BYTE*);
+void Erase_Idle(void);                   // Called from the main loop
 
 #endif                                 // F326_USB_MAIN_H
 
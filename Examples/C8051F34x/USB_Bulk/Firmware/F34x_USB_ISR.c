@@ -21,6 +21,16 @@
 // - Receive_File(): Receives and saves data
 // - Page_Erase(): Erases a page of FLASH
 // - Page_Write(): Writes to a page of FLASH
+// - Page_Blank(): Checks whether a page of FLASH is erased
+// - File_Pages(): Number of storage pages that hold the stored file
+// - Erase_Idle(): Erases the unused storage pages while the device is idle
+//
+// The storage pages past the stored file are erased from the main loop by
+// Erase_Idle() while the device is idle, so that a longer file written
+// later does not wait for their erase in the USB ISR. The pages of the
+// stored file are erased only when the host writes them again, since the
+// host can read them back until then. A page that already reads blank is
+// not erased again.
 //
 //
 // How To Test:    See Readme.txt
@@ -108,6 +118,9 @@ typedef unsigned char BYTE;
 #define ST_TX_ACK   0x20    // Transmit ACK 0xFF to host after every 8 packets
 #define ST_ERROR    0x80    // Error state
 
+// No transfer in progress, Erase_Idle() may erase
+#define DEVICE_IDLE ((M_State == ST_IDLE_DEV) || (M_State == ST_WAIT_DEV))
+
 
 typedef struct {            //  Structure definition of a block of data
     BYTE Piece[MAX_BLOCK_SIZE];
@@ -157,6 +170,7 @@ data    BYTE    PageIndex;      //  Index of Current Page in File
 data    BYTE    BlocksRead;     //  Total Number of Blocks Read
 data    BYTE    BlocksWrote;    //  Total Number of Blocks Written
 data    BYTE*   ReadIndex;
+data    BYTE    ErasePage;      //  Next page for Erase_Idle() to check
 
 // code const   BYTE    Serial1[0x0A] = {0x0A,0x03,'A',0,'B',0,'C',0,'D',0};
 // Serial Number Defintion
@@ -174,6 +188,8 @@ sbit Led2 = P2^3; // These blink to indicate data transmission
 void    State_Machine(void);        
 void    Receive_Setup(void);        
 void    Receive_File(void);        
+BYTE    File_Pages(void);
+BYTE    Page_Blank(BYTE*);
 
 //-----------------------------------------------------------------------------
 // Interrupt Service Routines
@@ -206,6 +222,7 @@ void USB_ISR () interrupt 8
       // Call reset handler
      USBReset();
       M_State = ST_WAIT_DEV;
+      ErasePage = File_Pages();
    }
 
    // Check for Endpoint0 interrupt
@@ -785,6 +802,7 @@ void Receive_Setup(void)
          // Write Values to Flash
          Page_Erase(LengthFile);    // Store file data to flash
          Page_Write(LengthFile);
+         ErasePage = File_Pages();  // Pages past the file are unused
 
          PageIndex = 0;             // Reset Index
          BlockIndex = 0;
@@ -818,7 +836,10 @@ void Receive_File(void)
    // Send handshake packet 0xFF to host after FLASH write
    if ((BlockIndex == (BLOCKS_PR_PAGE)) || (BlocksRead == NumBlocks))
    {
-      Page_Erase((BYTE*)(PageIndices[PageIndex]));
+      if (!Page_Blank((BYTE*)(PageIndices[PageIndex])))
+      {
+         Page_Erase((BYTE*)(PageIndices[PageIndex]));
+      }
       Page_Write((BYTE*)(PageIndices[PageIndex]));
       PageIndex++;
       Led1 = ~Led1;
@@ -837,6 +858,98 @@ void Receive_File(void)
    }
 }
 
+//-----------------------------------------------------------------------------
+// File_Pages
+//-----------------------------------------------------------------------------
+//
+// Return Value : Number of storage pages that hold the stored file
+// Parameters   : None
+//
+// Reads the number of blocks stored at LengthFile. A blank LengthFile
+// counts as a file in every page, so nothing is erased.
+//
+//-----------------------------------------------------------------------------
+
+BYTE File_Pages(void)
+{
+   UINT Pages;
+
+   Pages = (LengthFile[2] + (BLOCKS_PR_PAGE) - 1) / (BLOCKS_PR_PAGE);
+
+   return (Pages > NUM_STG_PAGES) ? NUM_STG_PAGES : (BYTE)Pages;
+}
+
+//-----------------------------------------------------------------------------
+// Page_Blank
+//-----------------------------------------------------------------------------
+//
+// Return Value : 1 if every byte of the page is 0xFF, 0 otherwise
+// Parameters   :
+// 1) BYTE* PageAddress
+//
+//-----------------------------------------------------------------------------
+
+BYTE Page_Blank(BYTE* PageAddress)
+{
+   UINT x;                             // Counter for 0-512 bytes
+
+   for (x = 0; x < FLASH_PAGE_SIZE; x++)
+   {
+      if (*PageAddress++ != 0xFF)
+      {
+         return 0;
+      }
+   }
+
+   return 1;
+}
+
+//-----------------------------------------------------------------------------
+// Erase_Idle
+//-----------------------------------------------------------------------------
+//
+// Return Value : None
+// Parameters   : None
+//
+// Called from the main loop. While no transfer is in progress, erases the
+// storage page at ErasePage unless it reads blank, and moves on to the
+// next page. The CPU still stops for the erase, but between transfers
+// instead of in the middle of one.
+//
+// The page is checked with interrupts enabled. It is erased only if, with
+// interrupts disabled, the device is still idle and ErasePage has not been
+// moved by a new file length.
+//
+//-----------------------------------------------------------------------------
+
+void Erase_Idle(void)
+{
+   BYTE Page;
+   BYTE Blank;
+
+   Page = ErasePage;
+
+   if ((Page >= NUM_STG_PAGES) || !DEVICE_IDLE)
+   {
+      return;
+   }
+
+   Blank = Page_Blank(PageIndices[Page]);
+
+   EA = 0;                             // Turn off interrupts
+
+   if ((ErasePage == Page) && DEVICE_IDLE)
+   {
+      if (!Blank)
+      {
+         Page_Erase(PageIndices[Page]);
+      }
+      ErasePage++;
+   }
+
+   EA = 1;                             // Turn on interrupts
+}
+
 //-----------------------------------------------------------------------------
 // End Of File
 //-----------------------------------------------------------------------------
\ No newline at end of file
@@ -163,6 +163,7 @@ void SynchFrameRequest (void);            //
 
 void Page_Erase(BYTE*);
 void Page_Write(BYTE*);
+void Erase_Idle(void);                   // Called from the main loop
 
 #endif                               
 
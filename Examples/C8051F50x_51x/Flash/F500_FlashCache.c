@@ -0,0 +1,379 @@
+//-----------------------------------------------------------------------------
+// F500_FlashCache.c
+//-----------------------------------------------------------------------------
+// Copyright 2010 Silicon Laboratories, Inc.
+// http://www.silabs.com
+//
+// Program Description:
+//
+// This program contains a one page write-back cache in front of the Flash.
+// FlashCache_Write() can be used in place of FLASH_Update() for fields that
+// change often, such as calibration values. Writes to the same page are
+// merged in xdata and the page is written back once:
+//
+//    - on FlashCache_Flush()
+//    - when a write to another page evicts the cached page
+//    - after FLASH_CACHE_DEADLINE calls to FlashCache_Tick()
+//
+// When the page is written back, it is compared with the Flash. If every
+// changed bit goes from 1 to 0, only the changed bytes are written and the
+// page is not erased. Otherwise the page is erased and written from the
+// cache, so FLASH_TEMP is not used.
+//
+// The changes in the cache are lost if a reset occurs before they are
+// written back, and the page is lost if a reset occurs between its erase
+// and the end of the write.
+//
+// Target:         C8051F500/1/2/3/4/5/6/7/8/9/10/11
+// Tool chain:     Raisonance / Keil / SDCC
+// Command Line:   None
+//
+// Release 1.0
+//    -Initial Revision
+//
+
+//-----------------------------------------------------------------------------
+// Includes
+//-----------------------------------------------------------------------------
+
+#include <compiler_defs.h>
+#include <c8051F500_defs.h>
+#include "F500_FlashPrimitives.h"
+#include "F500_FlashUtils.h"
+#include "F500_FlashCache.h"
+
+//-----------------------------------------------------------------------------
+// Function Prototypes
+//-----------------------------------------------------------------------------
+
+void FlashCache_Init (void);
+U8   FlashCache_Write (FLADDR dest, U8 *src, U16 numbytes);
+U8 * FlashCache_Read (U8 *dest, FLADDR src, U16 numbytes);
+U8   FlashCache_Flush (void);
+U8   FlashCache_Tick (void);
+
+U8   Cache_Commit (void);
+U8   Cache_WriteRuns (bit erased);
+
+//-----------------------------------------------------------------------------
+// Global Variables
+//-----------------------------------------------------------------------------
+
+SEGMENT_VARIABLE (Cache_Page[FLASH_PAGESIZE], U8, xdata);
+
+FLADDR Cache_Address;                  // First address of the cached page
+bit Cache_Valid;                       // Cache_Page holds a page
+bit Cache_Dirty;                       // Cache_Page differs from the Flash
+U8  Cache_Countdown;                   // Ticks left to the commit
+
+U16 FlashCache_Writes;
+U16 FlashCache_Commits;
+U16 FlashCache_Erases;
+U16 FlashCache_ErasesAvoided;
+
+//-----------------------------------------------------------------------------
+// FlashCache_Init
+//-----------------------------------------------------------------------------
+//
+// Return Value : None
+// Parameters   : None
+//
+// This routine empties the cache and clears the counters.
+//
+//-----------------------------------------------------------------------------
+
+void FlashCache_Init (void)
+{
+   Cache_Valid = 0;
+   Cache_Dirty = 0;
+   Cache_Countdown = 0;
+
+   FlashCache_Writes = 0;
+   FlashCache_Commits = 0;
+   FlashCache_Erases = 0;
+   FlashCache_ErasesAvoided = 0;
+}
+
+//-----------------------------------------------------------------------------
+// FlashCache_Write
+//-----------------------------------------------------------------------------
+//
+// Return Value :
+//   0 if a page written back could not be written, 1 if successful
+// Parameters   :
+//   1) FLADDR dest - starting address of the byte(s) to write to
+//                    valid range is 0x0000 to 0xF9FF for 64K Flash devices
+//                    valid range is 0x0000 to 0x7DFF for 32K Flash devices
+//   2) U8 *src - pointer to source bytes
+//   3) U16 numbytes - the number of bytes to write
+//
+// This routine replaces <numbytes> at <dest> with the bytes at <src>, as
+// FLASH_Update() does, but in the cache. A page other than the cached page
+// is first written back and then read into the cache. The deadline starts
+// with the first change after a write back.
+//
+//-----------------------------------------------------------------------------
+
+U8 FlashCache_Write (FLADDR dest, U8 *src, U16 numbytes)
+{
+   FLADDR page;
+   U16 offset;
+
+   FlashCache_Writes++;
+
+   while (numbytes)
+   {
+      page = dest & ~(FLASH_PAGESIZE - 1);
+
+      if (!Cache_Valid || (page != Cache_Address))
+      {
+         if (!FlashCache_Flush ())
+         {
+            return 0;
+         }
+
+         FLASH_Read (Cache_Page, page, FLASH_PAGESIZE);
+         Cache_Address = page;
+         Cache_Valid = 1;
+      }
+
+      offset = dest - page;
+
+      while (numbytes && (offset < FLASH_PAGESIZE))
+      {
+         if (Cache_Page[offset] != *src)
+         {
+            Cache_Page[offset] = *src;
+
+            if (!Cache_Dirty)
+            {
+               Cache_Dirty = 1;
+               Cache_Countdown = FLASH_CACHE_DEADLINE;
+            }
+         }
+
+         src++;
+         offset++;
+         dest++;
+         numbytes--;
+      }
+   }
+
+   return 1;
+}
+
+//-----------------------------------------------------------------------------
+// FlashCache_Read
+//-----------------------------------------------------------------------------
+//
+// Return Value :
+//   1) U8 *dest - pointer past the last destination byte
+// Parameters   :
+//   1) U8 *dest - pointer to destination bytes
+//   2) FLADDR src - address of source bytes in Flash
+//   3) U16 numbytes - the number of bytes to read
+//
+// This routine copies <numbytes> from <src> to <dest>, as FLASH_Read()
+// does, with the bytes of the cached page read from the cache.
+//
+//-----------------------------------------------------------------------------
+
+U8 * FlashCache_Read (U8 *dest, FLADDR src, U16 numbytes)
+{
+   while (numbytes--)
+   {
+      if (Cache_Valid && ((src & ~(FLASH_PAGESIZE - 1)) == Cache_Address))
+      {
+         *dest++ = Cache_Page[src - Cache_Address];
+      }
+      else
+      {
+         *dest++ = FLASH_ByteRead (src);
+      }
+
+      src++;
+   }
+
+   return dest;
+}
+
+//-----------------------------------------------------------------------------
+// FlashCache_Flush
+//-----------------------------------------------------------------------------
+//
+// Return Value :
+//   0 if the page could not be written, 1 if successful
+// Parameters   : None
+//
+// This routine writes the cached page back to the Flash if it was changed.
+// The page stays in the cache.
+//
+//-----------------------------------------------------------------------------
+
+U8 FlashCache_Flush (void)
+{
+   if (!Cache_Dirty)
+   {
+      return 1;
+   }
+
+   if (!Cache_Commit ())
+   {
+      return 0;
+   }
+
+   Cache_Dirty = 0;
+   Cache_Countdown = 0;
+
+   return 1;
+}
+
+//-----------------------------------------------------------------------------
+// FlashCache_Tick
+//-----------------------------------------------------------------------------
+//
+// Return Value :
+//   1 if the page was written back by this call, 0 otherwise
+// Parameters   : None
+//
+// This routine should be called from the main loop at a fixed interval,
+// for example on each overflow of a timer. The changed page is written
+// back on the FLASH_CACHE_DEADLINE call after its first change. It must
+// not be called from an interrupt routine, since Flash is written.
+//
+//-----------------------------------------------------------------------------
+
+U8 FlashCache_Tick (void)
+{
+   if (!Cache_Dirty)
+   {
+      return 0;
+   }
+
+   if (Cache_Countdown > 1)
+   {
+      Cache_Countdown--;
+      return 0;
+   }
+
+   return FlashCache_Flush ();
+}
+
+//-----------------------------------------------------------------------------
+// Local Routines
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// Cache_Commit
+//-----------------------------------------------------------------------------
+//
+// Compares the cached page with the Flash. The page is erased only if a
+// bit must go from 0 to 1.
+//
+//-----------------------------------------------------------------------------
+
+U8 Cache_Commit (void)
+{
+   U16 i;
+   U8 old;
+   bit changed = 0;
+   bit erase = 0;
+
+   for (i = 0; i < FLASH_PAGESIZE; i++)
+   {
+      old = FLASH_ByteRead (Cache_Address + i);
+
+      if (old != Cache_Page[i])
+      {
+         changed = 1;
+
+         if ((old & Cache_Page[i]) != Cache_Page[i])
+         {
+            erase = 1;
+            break;
+         }
+      }
+   }
+
+   if (!changed)
+   {
+      return 1;                        // Changed back to the Flash value
+   }
+
+   FlashCache_Commits++;
+
+   if (erase)
+   {
+      if (!FLASH_PageErase (Cache_Address))
+      {
+         return 0;
+      }
+
+      FlashCache_Erases++;
+   }
+   else
+   {
+      FlashCache_ErasesAvoided++;
+   }
+
+   return Cache_WriteRuns (erase);
+}
+
+//-----------------------------------------------------------------------------
+// Cache_WriteRuns
+//-----------------------------------------------------------------------------
+//
+// Writes each run of cached bytes that differ from the Flash with one
+// FLASH_BlockWrite() call. After an erase, the Flash bytes are all 0xFF.
+//
+//-----------------------------------------------------------------------------
+
+U8 Cache_WriteRuns (bit erased)
+{
+   U16 start;
+   U16 end;
+   U8 old;
+
+   start = 0;
+
+   while (start < FLASH_PAGESIZE)
+   {
+      // Find the next byte to write
+      old = erased ? 0xFF : FLASH_ByteRead (Cache_Address + start);
+
+      if (Cache_Page[start] == old)
+      {
+         start++;
+         continue;
+      }
+
+      // Extend the run to the next byte that is already correct
+      end = start + 1;
+
+      while (end < FLASH_PAGESIZE)
+      {
+         old = erased ? 0xFF : FLASH_ByteRead (Cache_Address + end);
+
+         if (Cache_Page[end] == old)
+         {
+            break;
+         }
+
+         end++;
+      }
+
+      if (!FLASH_BlockWrite (Cache_Address + start, Cache_Page + start,
+                             end - start))
+      {
+         return 0;
+      }
+
+      start = end;
+   }
+
+   return 1;
+}
+
+//-----------------------------------------------------------------------------
+// End Of File
+//-----------------------------------------------------------------------------
@@ -0,0 +1,67 @@
+//-----------------------------------------------------------------------------
+// F500_FlashCache.h
+//-----------------------------------------------------------------------------
+// Copyright 2010 Silicon Laboratories, Inc.
+// http://www.silabs.com
+//
+// Program Description:
+//
+// Header for the Flash page write-back cache in F500_FlashCache.c.
+//
+// Target:         C8051F500/1/2/3/4/5/6/7/8/9/10/11
+// Tool chain:     Raisonance / Keil / SDCC
+// Command Line:   None
+//
+// Release 1.0
+//    -Initial Revision
+//
+
+//-----------------------------------------------------------------------------
+// Open Header #define
+//-----------------------------------------------------------------------------
+
+#ifndef _F500_FLASHCACHE_H_
+#define _F500_FLASHCACHE_H_
+
+//-----------------------------------------------------------------------------
+// Includes
+//-----------------------------------------------------------------------------
+
+#include "F500_FlashPrimitives.h"
+
+//-----------------------------------------------------------------------------
+// Global Constants
+//-----------------------------------------------------------------------------
+
+#ifndef FLASH_CACHE_DEADLINE
+#define FLASH_CACHE_DEADLINE 100       // FlashCache_Tick() calls from the
+#endif                                 // first write to the commit
+
+//-----------------------------------------------------------------------------
+// Global Variables
+//-----------------------------------------------------------------------------
+
+extern U16 FlashCache_Writes;          // FlashCache_Write() calls
+extern U16 FlashCache_Commits;         // Pages written back with changes
+extern U16 FlashCache_Erases;          // Page erases done by the commits
+extern U16 FlashCache_ErasesAvoided;   // Commits that needed no erase
+
+//-----------------------------------------------------------------------------
+// Exported Function Prototypes
+//-----------------------------------------------------------------------------
+
+void FlashCache_Init (void);
+U8   FlashCache_Write (FLADDR dest, U8 *src, U16 numbytes);
+U8 * FlashCache_Read (U8 *dest, FLADDR src, U16 numbytes);
+U8   FlashCache_Flush (void);
+U8   FlashCache_Tick (void);
+
+//-----------------------------------------------------------------------------
+// Close Header #define
+//-----------------------------------------------------------------------------
+
+#endif    // _F500_FLASHCACHE_H_
+
+//-----------------------------------------------------------------------------
+// End Of File
+//-----------------------------------------------------------------------------
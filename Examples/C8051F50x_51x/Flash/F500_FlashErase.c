@@ -0,0 +1,275 @@
+//-----------------------------------------------------------------------------
+// F500_FlashErase.c
+//-----------------------------------------------------------------------------
+// Copyright 2010 Silicon Laboratories, Inc.
+// http://www.silabs.com
+//
+// Program Description:
+//
+// This program contains a scheduler that erases Flash pages ahead of the
+// writes that need them. A page erase stops the CPU for about 20 ms and
+// the interrupts are disabled for all of it, so an erase started by a
+// foreground write delays every interrupt by that much.
+//
+// A writer that no longer needs a page gives it back with
+// FlashErase_Release(). The page is erased later, by FlashErase_Service(),
+// which the application calls only where a 20 ms stall is allowed: in an
+// idle window, or from a low priority tick in the main loop. A writer that
+// needs a new page takes an erased one with FlashErase_Take(), so it never
+// waits for an erase as long as the idle windows keep up with the writes.
+//
+// Pages are erased in the order they are released and taken in the order
+// they are erased, so the erases are spread over all the pages given to
+// the scheduler. A page that is already erased is not erased again.
+//
+// Nothing is kept in Flash. After a reset, the application releases the
+// pages it does not use again.
+//
+// Target:         C8051F500/1/2/3/4/5/6/7/8/9/10/11
+// Tool chain:     Raisonance / Keil / SDCC
+// Command Line:   None
+//
+// Release 1.0
+//    -Initial Revision
+//
+
+//-----------------------------------------------------------------------------
+// Includes
+//-----------------------------------------------------------------------------
+
+#include <compiler_defs.h>
+#include <c8051F500_defs.h>
+#include "F500_FlashPrimitives.h"
+#include "F500_FlashErase.h"
+
+//-----------------------------------------------------------------------------
+// Function Prototypes
+//-----------------------------------------------------------------------------
+
+void   FlashErase_Init (void);
+U8     FlashErase_Release (FLADDR addr);
+FLADDR FlashErase_Take (void);
+U8     FlashErase_Service (void);
+U8     FlashErase_Ready (void);
+U8     FlashErase_Pending (void);
+
+U8     Erase_Blank (FLADDR page);
+
+//-----------------------------------------------------------------------------
+// Global Variables
+//-----------------------------------------------------------------------------
+
+SEGMENT_VARIABLE (Erase_PendingPage[FLASH_ERASE_QUEUE], FLADDR, xdata);
+SEGMENT_VARIABLE (Erase_ReadyPage[FLASH_ERASE_QUEUE], FLADDR, xdata);
+
+U8 Erase_PendingFirst;                 // Oldest page waiting to be erased
+U8 Erase_PendingCount;
+U8 Erase_ReadyFirst;                   // Oldest erased page
+U8 Erase_ReadyCount;
+
+//-----------------------------------------------------------------------------
+// FlashErase_Init
+//-----------------------------------------------------------------------------
+//
+// Return Value : None
+// Parameters   : None
+//
+// This routine empties both queues.
+//
+//-----------------------------------------------------------------------------
+
+void FlashErase_Init (void)
+{
+   Erase_PendingFirst = 0;
+   Erase_PendingCount = 0;
+   Erase_ReadyFirst = 0;
+   Erase_ReadyCount = 0;
+}
+
+//-----------------------------------------------------------------------------
+// FlashErase_Release
+//-----------------------------------------------------------------------------
+//
+// Return Value :
+//   0 if the queue is full, 1 if successful
+// Parameters   :
+//   1) FLADDR addr - an address in the page to erase
+//                    valid range is 0x0200 to 0xF9FF for 64K Flash devices
+//                    valid range is 0x0200 to 0x7DFF for 32K Flash devices
+//
+// This routine queues the page holding <addr> to be erased by
+// FlashErase_Service(). Page 0 holds the reset vector and is not accepted.
+//
+//-----------------------------------------------------------------------------
+
+U8 FlashErase_Release (FLADDR addr)
+{
+   U8 slot;
+
+   addr &= ~(FLASH_PAGESIZE - 1);
+
+   if ((addr == 0) || (Erase_PendingCount == FLASH_ERASE_QUEUE))
+   {
+      return 0;
+   }
+
+   slot = Erase_PendingFirst + Erase_PendingCount;
+   if (slot >= FLASH_ERASE_QUEUE)
+   {
+      slot -= FLASH_ERASE_QUEUE;
+   }
+
+   Erase_PendingPage[slot] = addr;
+   Erase_PendingCount++;
+
+   return 1;
+}
+
+//-----------------------------------------------------------------------------
+// FlashErase_Take
+//-----------------------------------------------------------------------------
+//
+// Return Value :
+//   1) FLADDR - first address of an erased page, 0 if none is ready
+// Parameters   : None
+//
+// This routine hands out the page erased first. The caller owns the page
+// until it gives it back with FlashErase_Release().
+//
+//-----------------------------------------------------------------------------
+
+FLADDR FlashErase_Take (void)
+{
+   FLADDR addr;
+
+   if (Erase_ReadyCount == 0)
+   {
+      return 0;
+   }
+
+   addr = Erase_ReadyPage[Erase_ReadyFirst];
+
+   Erase_ReadyFirst++;
+   if (Erase_ReadyFirst == FLASH_ERASE_QUEUE)
+   {
+      Erase_ReadyFirst = 0;
+   }
+   Erase_ReadyCount--;
+
+   return addr;
+}
+
+//-----------------------------------------------------------------------------
+// FlashErase_Service
+//-----------------------------------------------------------------------------
+//
+// Return Value :
+//   0 if there was nothing to do, 1 if a page was made ready
+// Parameters   : None
+//
+// This routine erases the oldest queued page, unless it is already erased,
+// and moves it to the ready queue. It erases at most one page per call.
+// It must be called only where the CPU may stop for a page erase, with
+// interrupts disabled, and not from an interrupt routine.
+//
+//-----------------------------------------------------------------------------
+
+U8 FlashErase_Service (void)
+{
+   FLADDR addr;
+   U8 slot;
+
+   if ((Erase_PendingCount == 0) || (Erase_ReadyCount == FLASH_ERASE_QUEUE))
+   {
+      return 0;
+   }
+
+   addr = Erase_PendingPage[Erase_PendingFirst];
+
+   if (!Erase_Blank (addr))
+   {
+      if (!FLASH_PageErase (addr))
+      {
+         return 0;                     // VDD too low, try again later
+      }
+   }
+
+   Erase_PendingFirst++;
+   if (Erase_PendingFirst == FLASH_ERASE_QUEUE)
+   {
+      Erase_PendingFirst = 0;
+   }
+   Erase_PendingCount--;
+
+   slot = Erase_ReadyFirst + Erase_ReadyCount;
+   if (slot >= FLASH_ERASE_QUEUE)
+   {
+      slot -= FLASH_ERASE_QUEUE;
+   }
+
+   Erase_ReadyPage[slot] = addr;
+   Erase_ReadyCount++;
+
+   return 1;
+}
+
+//-----------------------------------------------------------------------------
+// FlashErase_Ready
+//-----------------------------------------------------------------------------
+//
+// Return Value :
+//   1) U8 - number of erased pages that FlashErase_Take() can hand out
+// Parameters   : None
+//
+//-----------------------------------------------------------------------------
+
+U8 FlashErase_Ready (void)
+{
+   return Erase_ReadyCount;
+}
+
+//-----------------------------------------------------------------------------
+// FlashErase_Pending
+//-----------------------------------------------------------------------------
+//
+// Return Value :
+//   1) U8 - number of pages waiting for FlashErase_Service()
+// Parameters   : None
+//
+//-----------------------------------------------------------------------------
+
+U8 FlashErase_Pending (void)
+{
+   return Erase_PendingCount;
+}
+
+//-----------------------------------------------------------------------------
+// Local Routines
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// Erase_Blank
+//-----------------------------------------------------------------------------
+//
+// Returns 1 if every byte of the page at <page> is 0xFF.
+//
+//-----------------------------------------------------------------------------
+
+U8 Erase_Blank (FLADDR page)
+{
+   U16 i;
+
+   for (i = 0; i < FLASH_PAGESIZE; i++)
+   {
+      if (FLASH_ByteRead (page + i) != 0xFF)
+      {
+         return 0;
+      }
+   }
+
+   return 1;
+}
+
+//-----------------------------------------------------------------------------
+// End Of File
+//-----------------------------------------------------------------------------
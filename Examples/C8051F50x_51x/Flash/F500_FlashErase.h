@@ -0,0 +1,59 @@
+//-----------------------------------------------------------------------------
+// F500_FlashErase.h
+//-----------------------------------------------------------------------------
+// Copyright 2010 Silicon Laboratories, Inc.
+// http://www.silabs.com
+//
+// Program Description:
+//
+// Header for the background page erase scheduler in F500_FlashErase.c.
+//
+// Target:         C8051F500/1/2/3/4/5/6/7/8/9/10/11
+// Tool chain:     Raisonance / Keil / SDCC
+// Command Line:   None
+//
+// Release 1.0
+//    -Initial Revision
+//
+
+//-----------------------------------------------------------------------------
+// Open Header #define
+//-----------------------------------------------------------------------------
+
+#ifndef _F500_FLASHERASE_H_
+#define _F500_FLASHERASE_H_
+
+//-----------------------------------------------------------------------------
+// Includes
+//-----------------------------------------------------------------------------
+
+#include "F500_FlashPrimitives.h"
+
+//-----------------------------------------------------------------------------
+// Global Constants
+//-----------------------------------------------------------------------------
+
+#ifndef FLASH_ERASE_QUEUE
+#define FLASH_ERASE_QUEUE 4            // Pages waiting to be erased, and
+#endif                                 // erased pages waiting to be taken
+
+//-----------------------------------------------------------------------------
+// Exported Function Prototypes
+//-----------------------------------------------------------------------------
+
+void   FlashErase_Init (void);
+U8     FlashErase_Release (FLADDR addr);
+FLADDR FlashErase_Take (void);
+U8     FlashErase_Service (void);
+U8     FlashErase_Ready (void);
+U8     FlashErase_Pending (void);
+
+//-----------------------------------------------------------------------------
+// Close Header #define
+//-----------------------------------------------------------------------------
+
+#endif    // _F500_FLASHERASE_H_
+
+//-----------------------------------------------------------------------------
+// End Of File
+//-----------------------------------------------------------------------------
@@ -0,0 +1,706 @@
+//-----------------------------------------------------------------------------
+// F500_FlashKV.c
+//-----------------------------------------------------------------------------
+// Copyright 2010 Silicon Laboratories, Inc.
+// http://www.silabs.com
+//
+// Program Description:
+//
+// This program contains a log structured key/value store for small
+// parameters in Flash. It is an alternative to FLASH_Update(), which erases
+// two pages and rewrites about 1 KB of Flash to change a single byte.
+//
+// A value is changed by appending a record to the page being written:
+//
+//    offset 0     length of the value, 0 for a deleted key
+//    offset 1     key, written last so that a record cut short by a reset
+//                 is ignored
+//    offset 2     value bytes
+//
+// Each page of the pool starts with a 4 byte header holding a 16-bit
+// sequence number. Pages are used in turn around the pool, so the erases
+// are spread over all pages. When few erased pages are left, the records
+// still in use in the oldest page are copied to the page being written and
+// the oldest page is erased. FlashKV_Service() does this one record or one
+// erase at a time from the main loop.
+//
+// A RAM index holds the address of the latest record of each key, so a
+// read does not search the Flash. The index is rebuilt from the pool by
+// FlashKV_Init() after a reset.
+//
+// Target:         C8051F500/1/2/3/4/5/6/7/8/9/10/11
+// Tool chain:     Raisonance / Keil / SDCC
+// Command Line:   None
+//
+// Release 1.0
+//    -Initial Revision
+//
+
+//-----------------------------------------------------------------------------
+// Includes
+//-----------------------------------------------------------------------------
+
+#include <compiler_defs.h>
+#include <c8051F500_defs.h>
+#include "F500_FlashPrimitives.h"
+#include "F500_FlashUtils.h"
+#include "F500_FlashKV.h"
+
+//-----------------------------------------------------------------------------
+// Global Constants
+//-----------------------------------------------------------------------------
+
+#define KV_HEADER_SIZE 4               // Bytes at the start of each page
+#define KV_MAGIC       0x4B            // First header byte of a used page
+#define KV_ERASED      0xFF
+
+//-----------------------------------------------------------------------------
+// Function Prototypes
+//-----------------------------------------------------------------------------
+
+U8  FlashKV_Init (void);
+U8  FlashKV_Read (U8 key, U8 *value, U8 size);
+U8  FlashKV_Write (U8 key, U8 *value, U8 length);
+U8  FlashKV_Delete (U8 key);
+U8  FlashKV_Service (void);
+
+FLADDR KV_PageAddress (U8 page);
+U8  KV_NextPage (U8 page);
+U8  KV_PageValid (U8 page);
+U16 KV_PageSequence (U8 page);
+U16 KV_ScanPage (U8 page);
+void KV_SetIndex (U8 key, FLADDR record, U8 length);
+U8  KV_Append (U8 key, U8 *value, U8 length);
+U8  KV_Reserve (U8 size);
+U8  KV_CollectStep (void);
+
+//-----------------------------------------------------------------------------
+// Global Variables
+//-----------------------------------------------------------------------------
+
+SEGMENT_VARIABLE (KV_Index[FLASH_KV_KEYS], FLADDR, xdata);
+SEGMENT_VARIABLE (KV_Live[FLASH_KV_PAGES], U16, xdata);
+SEGMENT_VARIABLE (KV_Buffer[FLASH_KV_MAX_VALUE], U8, xdata);
+
+U8  KV_Head;                           // Page being written
+U8  KV_Tail;                           // Oldest page in use
+U8  KV_Used;                           // Pages from KV_Tail to KV_Head
+U16 KV_Offset;                         // Next free byte in KV_Head
+U16 KV_Sequence;                       // Sequence number of KV_Head
+U16 KV_CollectOffset;                  // Next record to check in KV_Tail
+
+//-----------------------------------------------------------------------------
+// FlashKV_Init
+//-----------------------------------------------------------------------------
+//
+// Return Value :
+//   0 if the pool could not be started, 1 if successful
+// Parameters   : None
+//
+// This routine finds the pages in use, rebuilds the RAM index from their
+// records and erases the other pages of the pool. The page being written
+// is the one whose next page does not carry the next sequence number.
+// A pool without any used page is started at its first page.
+//
+//-----------------------------------------------------------------------------
+
+U8 FlashKV_Init (void)
+{
+   U8 page;
+   U8 i;
+   U16 j;
+   FLADDR addr;
+
+   for (i = 0; i < FLASH_KV_KEYS; i++)
+   {
+      KV_Index[i] = 0;
+   }
+
+   for (i = 0; i < FLASH_KV_PAGES; i++)
+   {
+      KV_Live[i] = 0;
+   }
+
+   // 1. Find the page being written
+   KV_Used = 0;
+
+   for (page = 0; page < FLASH_KV_PAGES; page++)
+   {
+      if (KV_PageValid (page))
+      {
+         i = KV_NextPage (page);
+
+         if (!KV_PageValid (i) ||
+             (KV_PageSequence (i) != (U16) (KV_PageSequence (page) + 1)))
+         {
+            KV_Head = page;
+            KV_Used = 1;
+            break;
+         }
+      }
+   }
+
+   // 2. Follow the sequence numbers back to the oldest page
+   if (KV_Used)
+   {
+      KV_Tail = KV_Head;
+      KV_Sequence = KV_PageSequence (KV_Head);
+
+      while (KV_Used < FLASH_KV_PAGES)
+      {
+         page = KV_Tail ? (KV_Tail - 1) : (FLASH_KV_PAGES - 1);
+
+         if (!KV_PageValid (page) ||
+             (KV_PageSequence (page) != (U16) (KV_PageSequence (KV_Tail) - 1)))
+         {
+            break;
+         }
+
+         KV_Tail = page;
+         KV_Used++;
+      }
+   }
+   else
+   {
+      KV_Head = FLASH_KV_PAGES - 1;    // Next page is the first page
+      KV_Tail = 0;
+      KV_Sequence = 0xFFFF;
+   }
+
+   // 3. Erase the pages that are not in use
+   page = KV_NextPage (KV_Head);
+
+   for (i = KV_Used; i < FLASH_KV_PAGES; i++)
+   {
+      addr = KV_PageAddress (page);
+
+      for (j = 0; j < FLASH_PAGESIZE; j++)
+      {
+         if (FLASH_ByteRead (addr + j) != KV_ERASED)
+         {
+            if (!FLASH_PageErase (addr))
+            {
+               return 0;
+            }
+            break;
+         }
+      }
+
+      page = KV_NextPage (page);
+   }
+
+   // 4. Rebuild the index from the oldest record to the newest
+   if (KV_Used == 0)
+   {
+      KV_Offset = FLASH_PAGESIZE;      // First write starts a page
+
+      KV_CollectOffset = KV_HEADER_SIZE;
+
+      return 1;
+   }
+
+   page = KV_Tail;
+
+   for (i = 0; i < KV_Used; i++)
+   {
+      KV_Offset = KV_ScanPage (page);
+      page = KV_NextPage (page);
+   }
+
+   KV_CollectOffset = KV_HEADER_SIZE;
+
+   return 1;
+}
+
+//-----------------------------------------------------------------------------
+// FlashKV_Read
+//-----------------------------------------------------------------------------
+//
+// Return Value :
+//   U8 - length of the value, 0 if the key has no value
+// Parameters   :
+//   1) U8 key - key to read, 0 to FLASH_KV_KEYS - 1
+//   2) U8 *value - buffer for the value
+//   3) U8 size - size of the buffer, at most this many bytes are copied
+//
+// This routine copies the latest value of <key> to <value>.
+//
+//-----------------------------------------------------------------------------
+
+U8 FlashKV_Read (U8 key, U8 *value, U8 size)
+{
+   U8 length;
+   FLADDR record;
+
+   if (key >= FLASH_KV_KEYS)
+   {
+      return 0;
+   }
+
+   record = KV_Index[key];
+
+   if (record == 0)
+   {
+      return 0;
+   }
+
+   length = FLASH_ByteRead (record);
+
+   FLASH_Read (value, record + 2, (length < size) ? length : size);
+
+   return length;
+}
+
+//-----------------------------------------------------------------------------
+// FlashKV_Write
+//-----------------------------------------------------------------------------
+//
+// Return Value :
+//   0 if Write unsuccessful, 1 if Write successful
+// Parameters   :
+//   1) U8 key - key to write, 0 to FLASH_KV_KEYS - 1
+//   2) U8 *value - pointer to the value
+//   3) U8 length - length of the value, 1 to FLASH_KV_MAX_VALUE
+//
+// This routine stores a new value for <key>. Nothing is written if the
+// value is unchanged. Otherwise the cost is length + 2 byte writes, plus
+// the collection of the oldest page if no erased page would be left for
+// FlashKV_Service().
+//
+//-----------------------------------------------------------------------------
+
+U8 FlashKV_Write (U8 key, U8 *value, U8 length)
+{
+   FLADDR record;
+   U8 i;
+
+   if ((key >= FLASH_KV_KEYS) || (length == 0) ||
+       (length > FLASH_KV_MAX_VALUE))
+   {
+      return 0;
+   }
+
+   // Skip the write if the latest record holds the same value
+   record = KV_Index[key];
+
+   if (record && (FLASH_ByteRead (record) == length))
+   {
+      for (i = 0; i < length; i++)
+      {
+         if (FLASH_ByteRead (record + 2 + i) != value[i])
+         {
+            break;
+         }
+      }
+
+      if (i == length)
+      {
+         return 1;
+      }
+   }
+
+   if (!KV_Reserve (length + 2))
+   {
+      return 0;
+   }
+
+   return KV_Append (key, value, length);
+}
+
+//-----------------------------------------------------------------------------
+// FlashKV_Delete
+//-----------------------------------------------------------------------------
+//
+// Return Value :
+//   0 if Write unsuccessful, 1 if Write successful
+// Parameters   :
+//   1) U8 key - key to delete, 0 to FLASH_KV_KEYS - 1
+//
+// This routine removes the value of <key> by appending a record with a
+// length of 0.
+//
+//-----------------------------------------------------------------------------
+
+U8 FlashKV_Delete (U8 key)
+{
+   if (key >= FLASH_KV_KEYS)
+   {
+      return 0;
+   }
+
+   if (KV_Index[key] == 0)
+   {
+      return 1;
+   }
+
+   if (!KV_Reserve (2))
+   {
+      return 0;
+   }
+
+   return KV_Append (key, 0, 0);
+}
+
+//-----------------------------------------------------------------------------
+// FlashKV_Service
+//-----------------------------------------------------------------------------
+//
+// Return Value :
+//   0 if there was nothing to do, 1 if a record was copied or a page erased
+// Parameters   : None
+//
+// This routine should be called from the main loop. While fewer than
+// FLASH_KV_FREE_PAGES pages are erased, it copies one record from the
+// oldest page or erases the oldest page once all its records are copied.
+// It only starts on a page whose records fit in the page being written, so
+// each page collected gives one erased page.
+//
+//-----------------------------------------------------------------------------
+
+U8 FlashKV_Service (void)
+{
+   if ((FLASH_KV_PAGES - KV_Used) >= FLASH_KV_FREE_PAGES)
+   {
+      return 0;
+   }
+
+   if ((KV_CollectOffset == KV_HEADER_SIZE) &&
+       (KV_Live[KV_Tail] > (FLASH_PAGESIZE - KV_Offset)))
+   {
+      return 0;                        // Wait for the next page
+   }
+
+   return KV_CollectStep ();
+}
+
+//-----------------------------------------------------------------------------
+// Local Routines
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// KV_PageAddress
+//-----------------------------------------------------------------------------
+//
+// Returns the Flash address of page <page> of the pool.
+//
+//-----------------------------------------------------------------------------
+
+FLADDR KV_PageAddress (U8 page)
+{
+   return FLASH_KV_START + ((FLADDR) page * FLASH_PAGESIZE);
+}
+
+//-----------------------------------------------------------------------------
+// KV_NextPage
+//-----------------------------------------------------------------------------
+//
+// Returns the page after <page> around the pool.
+//
+//-----------------------------------------------------------------------------
+
+U8 KV_NextPage (U8 page)
+{
+   page++;
+
+   if (page == FLASH_KV_PAGES)
+   {
+      page = 0;
+   }
+
+   return page;
+}
+
+//-----------------------------------------------------------------------------
+// KV_PageValid
+//-----------------------------------------------------------------------------
+//
+// Returns 1 if page <page> has a complete header.
+//
+//-----------------------------------------------------------------------------
+
+U8 KV_PageValid (U8 page)
+{
+   FLADDR addr = KV_PageAddress (page);
+
+   return ((FLASH_ByteRead (addr) == KV_MAGIC) &&
+           (FLASH_ByteRead (addr + 3) == 0x00));
+}
+
+//-----------------------------------------------------------------------------
+// KV_PageSequence
+//-----------------------------------------------------------------------------
+//
+// Returns the sequence number in the header of page <page>.
+//
+//-----------------------------------------------------------------------------
+
+U16 KV_PageSequence (U8 page)
+{
+   FLADDR addr = KV_PageAddress (page);
+
+   return ((U16) FLASH_ByteRead (addr + 1) << 8) | FLASH_ByteRead (addr + 2);
+}
+
+//-----------------------------------------------------------------------------
+// KV_ScanPage
+//-----------------------------------------------------------------------------
+//
+// Enters the records of page <page> in the index, in the order they were
+// written, and returns the offset of the first free byte. A record with
+// an invalid length ends the page.
+//
+//-----------------------------------------------------------------------------
+
+U16 KV_ScanPage (U8 page)
+{
+   FLADDR addr = KV_PageAddress (page);
+   U16 offset = KV_HEADER_SIZE;
+   U8 length;
+   U8 key;
+
+   while (offset <= (FLASH_PAGESIZE - 2))
+   {
+      length = FLASH_ByteRead (addr + offset);
+
+      if (length == KV_ERASED)
+      {
+         break;
+      }
+
+      if ((length > FLASH_KV_MAX_VALUE) ||
+          ((offset + 2 + length) > FLASH_PAGESIZE))
+      {
+         return FLASH_PAGESIZE;
+      }
+
+      key = FLASH_ByteRead (addr + offset + 1);
+
+      if (key < FLASH_KV_KEYS)         // Key not written for a cut record
+      {
+         KV_SetIndex (key, addr + offset, length);
+      }
+
+      offset += 2 + length;
+   }
+
+   return offset;
+}
+
+//-----------------------------------------------------------------------------
+// KV_SetIndex
+//-----------------------------------------------------------------------------
+//
+// Points the index entry of <key> at <record> and keeps the count of bytes
+// in use in each page. A record with a length of 0 deletes the key.
+//
+//-----------------------------------------------------------------------------
+
+void KV_SetIndex (U8 key, FLADDR record, U8 length)
+{
+   FLADDR old = KV_Index[key];
+
+   if (old)
+   {
+      KV_Live[(old - FLASH_KV_START) / FLASH_PAGESIZE] -=
+         FLASH_ByteRead (old) + 2;
+   }
+
+   if (length)
+   {
+      KV_Live[(record - FLASH_KV_START) / FLASH_PAGESIZE] += length + 2;
+      KV_Index[key] = record;
+   }
+   else
+   {
+      KV_Index[key] = 0;
+   }
+}
+
+//-----------------------------------------------------------------------------
+// KV_Append
+//-----------------------------------------------------------------------------
+//
+// Writes a record at the end of the page being written, starting the next
+// erased page if the record does not fit. The key is written last.
+// Returns 0 if no erased page is left or a write fails.
+//
+//-----------------------------------------------------------------------------
+
+U8 KV_Append (U8 key, U8 *value, U8 length)
+{
+   FLADDR addr;
+   U8 header[KV_HEADER_SIZE - 1];
+
+   if ((KV_Offset + 2 + length) > FLASH_PAGESIZE)
+   {
+      if (KV_Used == FLASH_KV_PAGES)
+      {
+         return 0;
+      }
+
+      // The last header byte marks the header as complete. The page
+      // becomes the head only once its header is written.
+      header[0] = KV_MAGIC;
+      header[1] = (U8) ((KV_Sequence + 1) >> 8);
+      header[2] = (U8) (KV_Sequence + 1);
+
+      addr = KV_PageAddress (KV_NextPage (KV_Head));
+
+      if (!FLASH_BlockWrite (addr, header, sizeof (header)) ||
+          !FLASH_ByteWrite (addr + 3, 0x00))
+      {
+         return 0;
+      }
+
+      KV_Head = KV_NextPage (KV_Head);
+      KV_Sequence++;
+      KV_Used++;
+      KV_Offset = KV_HEADER_SIZE;
+   }
+
+   addr = KV_PageAddress (KV_Head) + KV_Offset;
+
+   if (!FLASH_ByteWrite (addr, length))
+   {
+      return 0;
+   }
+
+   KV_Offset += 2 + length;            // Skipped if cut from here on
+
+   if (length && !FLASH_BlockWrite (addr + 2, value, length))
+   {
+      return 0;
+   }
+
+   if (!FLASH_ByteWrite (addr + 1, key))
+   {
+      return 0;
+   }
+
+   KV_SetIndex (key, addr, length);
+
+   return 1;
+}
+
+//-----------------------------------------------------------------------------
+// KV_Reserve
+//-----------------------------------------------------------------------------
+//
+// Makes room for a record of <size> bytes. If the record starts a new
+// page, at least one other erased page must be left for collecting, so
+// the oldest pages are collected here until two pages are erased.
+// Returns 0 if the pool is full.
+//
+//-----------------------------------------------------------------------------
+
+U8 KV_Reserve (U8 size)
+{
+   U8 pages = 0;
+   U8 tail;
+
+   if ((KV_Offset + size) <= FLASH_PAGESIZE)
+   {
+      return 1;
+   }
+
+   while ((FLASH_KV_PAGES - KV_Used) < 2)
+   {
+      if (++pages > FLASH_KV_PAGES)
+      {
+         return 0;                     // Values do not fit in the pool
+      }
+
+      // Collect the whole oldest page
+      tail = KV_Tail;
+
+      while (KV_Tail == tail)
+      {
+         if (!KV_CollectStep ())
+         {
+            return 0;
+         }
+      }
+   }
+
+   return 1;
+}
+
+//-----------------------------------------------------------------------------
+// KV_CollectStep
+//-----------------------------------------------------------------------------
+//
+// Copies the next record of the oldest page that is still in the index to
+// the page being written. Records that were replaced and deleted keys are
+// dropped. Once all records are checked and none of them is left in the
+// index, the oldest page is erased. Returns 0 if there is no page to
+// collect or a write fails, in which case the same record is tried again.
+//
+//-----------------------------------------------------------------------------
+
+U8 KV_CollectStep (void)
+{
+   FLADDR addr;
+   FLADDR record;
+   U8 length;
+   U8 key;
+
+   if (KV_Tail == KV_Head)
+   {
+      return 0;
+   }
+
+   addr = KV_PageAddress (KV_Tail);
+
+   if (KV_CollectOffset <= (FLASH_PAGESIZE - 2))
+   {
+      record = addr + KV_CollectOffset;
+      length = FLASH_ByteRead (record);
+
+      if ((length != KV_ERASED) && (length <= FLASH_KV_MAX_VALUE))
+      {
+         key = FLASH_ByteRead (record + 1);
+
+         if ((key < FLASH_KV_KEYS) && (KV_Index[key] == record))
+         {
+            FLASH_Read (KV_Buffer, record + 2, length);
+
+            if (!KV_Append (key, KV_Buffer, length))
+            {
+               return 0;               // Copy the record again next step
+            }
+         }
+
+         KV_CollectOffset += 2 + length;
+
+         return 1;
+      }
+   }
+
+   // A record still in the index is checked again from the first record
+   for (key = 0; key < FLASH_KV_KEYS; key++)
+   {
+      if ((KV_Index[key] >= addr) &&
+          (KV_Index[key] < (addr + FLASH_PAGESIZE)))
+      {
+         KV_CollectOffset = KV_HEADER_SIZE;
+
+         return 0;
+      }
+   }
+
+   if (!FLASH_PageErase (addr))
+   {
+      return 0;
+   }
+
+   KV_Live[KV_Tail] = 0;
+   KV_Tail = KV_NextPage (KV_Tail);
+   KV_Used--;
+   KV_CollectOffset = KV_HEADER_SIZE;
+
+   return 1;
+}
+
+//-----------------------------------------------------------------------------
+// End Of File
+//-----------------------------------------------------------------------------
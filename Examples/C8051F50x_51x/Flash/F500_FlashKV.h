@@ -0,0 +1,78 @@
+//-----------------------------------------------------------------------------
+// F500_FlashKV.h
+//-----------------------------------------------------------------------------
+// Copyright 2010 Silicon Laboratories, Inc.
+// http://www.silabs.com
+//
+// Program Description:
+//
+// Header for the log structured key/value store in F500_FlashKV.c.
+//
+// Target:         C8051F500/1/2/3/4/5/6/7/8/9/10/11
+// Tool chain:     Raisonance / Keil / SDCC
+// Command Line:   None
+//
+// Release 1.0
+//    -Initial Revision
+//
+
+//-----------------------------------------------------------------------------
+// Open Header #define
+//-----------------------------------------------------------------------------
+
+#ifndef _F500_FLASHKV_H_
+#define _F500_FLASHKV_H_
+
+//-----------------------------------------------------------------------------
+// Includes
+//-----------------------------------------------------------------------------
+
+#include "F500_FlashPrimitives.h"
+
+//-----------------------------------------------------------------------------
+// Global Constants
+//-----------------------------------------------------------------------------
+
+#ifndef FLASH_KV_START
+#define FLASH_KV_START 0xF000L         // For 64K Flash devices
+//#define FLASH_KV_START 0x7400L       // For 32K Flash devices
+#endif
+
+#ifndef FLASH_KV_PAGES
+#define FLASH_KV_PAGES 4               // Pages in the pool, at least 3
+#endif
+
+#ifndef FLASH_KV_KEYS
+#define FLASH_KV_KEYS 32               // Keys are 0 to FLASH_KV_KEYS - 1
+#endif
+
+#ifndef FLASH_KV_MAX_VALUE
+#define FLASH_KV_MAX_VALUE 16          // Largest value in bytes
+#endif
+
+#ifndef FLASH_KV_FREE_PAGES
+#define FLASH_KV_FREE_PAGES 2          // Erased pages kept by FlashKV_Service
+#endif
+
+// All values together, with two bytes each of record overhead, must fit in
+// FLASH_KV_PAGES - 2 pages less the 4 byte page headers.
+
+//-----------------------------------------------------------------------------
+// Exported Function Prototypes
+//-----------------------------------------------------------------------------
+
+U8   FlashKV_Init (void);
+U8   FlashKV_Read (U8 key, U8 *value, U8 size);
+U8   FlashKV_Write (U8 key, U8 *value, U8 length);
+U8   FlashKV_Delete (U8 key);
+U8   FlashKV_Service (void);
+
+//-----------------------------------------------------------------------------
+// Close Header #define
+//-----------------------------------------------------------------------------
+
+#endif    // _F500_FLASHKV_H_
+
+//-----------------------------------------------------------------------------
+// End Of File
+//-----------------------------------------------------------------------------
@@ -0,0 +1,324 @@
+//-----------------------------------------------------------------------------
+// F500_FlashKV_Test.c
+//-----------------------------------------------------------------------------
+// Copyright 2010 Silicon Laboratories, Inc.
+// http://www.silabs.com
+//
+// Program Description:
+//
+// This program tests the key/value store in F500_FlashKV.c. It writes a
+// set of parameters many times, as an application saving calibration
+// values would, and checks them against a copy in RAM, also after the
+// index is rebuilt by FlashKV_Init(). FlashKV_Service() is called between
+// the writes. While the test is running, the LED is on. If the test fails,
+// the LED will turn off. If the test passes, the LED will blink.
+//
+// Pinout:
+//
+//    P1.3 -> LED
+//
+//    all other port pins unused
+//
+// How To Test:
+//
+// 1) Load the F500_FlashKV_Test.c, F500_FlashKV.c, F500_FlashPrimitives.c
+//    and F500_FlashUtils.c files in the Silicon Labs IDE.
+// 2) Compile and download code to a 'F50x device.
+// 3) Verify the LED pin of J19 are populated on the 'F50x TB.
+// 4) Run the code
+// 5) Check that the LED is blinking, indicating a passing test.
+//
+// Target:         C8051F50x
+// Tool chain:     Raisonance / Keil / SDCC
+// Command Line:   None
+//
+// Release 1.0
+//    -Initial Revision
+//
+
+//-----------------------------------------------------------------------------
+// Includes
+//-----------------------------------------------------------------------------
+
+#include <compiler_defs.h>
+#include <C8051F500_defs.h>            // SFR declarations
+#include "F500_FlashPrimitives.h"
+#include "F500_FlashKV.h"
+
+//-----------------------------------------------------------------------------
+// Pin Declarations
+//-----------------------------------------------------------------------------
+
+SBIT (LED, SFR_P1, 3);                 // LED == 1 means ON
+
+//-----------------------------------------------------------------------------
+// Global Constants
+//-----------------------------------------------------------------------------
+
+#define TEST_KEYS    8                 // Keys written by the test
+#define TEST_LENGTH  4                 // Bytes in each value
+#define TEST_WRITES  2000              // Writes, enough to wrap the pool
+
+//-----------------------------------------------------------------------------
+// Global Variables
+//-----------------------------------------------------------------------------
+
+SEGMENT_VARIABLE (Expected[TEST_KEYS][TEST_LENGTH], U8, xdata);
+
+//-----------------------------------------------------------------------------
+// Function Prototypes
+//-----------------------------------------------------------------------------
+
+void OSCILLATOR_Init (void);           // Oscillator initialization routine
+void VDDMon_Init (void);               // VDD Monitor initialization routine
+void PORT_Init (void);                 // Port initialization routine
+bit  Check_Values (void);              // Compares the store with Expected
+
+//-----------------------------------------------------------------------------
+// main() Routine
+//-----------------------------------------------------------------------------
+
+void main (void)
+{
+   U8 value[TEST_LENGTH];
+   U8 key;
+   U8 i;
+   U16 n;
+   U16 j, k;
+
+   bit error_flag = 0;
+
+   SFRPAGE = ACTIVE_PAGE;              // Set for PCA0MD and RSTSRC
+
+   PCA0MD &= ~0x40;                    // Disable the watchdog timer
+
+   OSCILLATOR_Init();                  // Initialize the internal oscillator
+   VDDMon_Init();                      // Initialize the VDD monitor
+   PORT_Init();                        // Initialize the crossbar
+
+   LED = 1;
+
+   //BEGIN TEST================================================================
+
+   if (!FlashKV_Init())
+   {
+      error_flag = 1;
+   }
+
+   // Start from a known state: delete the keys left by an earlier run
+   for (key = 0; key < TEST_KEYS; key++)
+   {
+      FlashKV_Delete(key);
+
+      for (i = 0; i < TEST_LENGTH; i++)
+      {
+         Expected[key][i] = 0;
+      }
+   }
+
+   // Write a changing counter to each key in turn
+   for (n = 0; n < TEST_WRITES; n++)
+   {
+      key = (U8) (n % TEST_KEYS);
+
+      for (i = 0; i < TEST_LENGTH; i++)
+      {
+         value[i] = (U8) (n + i);
+      }
+
+      if (!FlashKV_Write(key, value, TEST_LENGTH))
+      {
+         error_flag = 1;
+      }
+
+      for (i = 0; i < TEST_LENGTH; i++)
+      {
+         Expected[key][i] = value[i];
+      }
+
+      while (FlashKV_Service());       // Collect pages between writes
+
+      if (Check_Values())
+      {
+         error_flag = 1;
+      }
+   }
+
+   // Rebuild the index as after a reset
+   if (!FlashKV_Init() || Check_Values())
+   {
+      error_flag = 1;
+   }
+
+   //END OF TEST===============================================================
+
+   while (1)                           // Loop forever
+   {
+      // Blink LED to indicate success
+      if (error_flag == 0)
+      {
+         LED = !LED;
+
+         // Simple delay loop
+         for (j = 65000; j > 0; j--) {
+            for (k = 10; k > 0; k--) {} }
+      }
+      else
+      {
+         LED = 0;
+      }
+   }
+}
+
+//-----------------------------------------------------------------------------
+// Check_Values
+//-----------------------------------------------------------------------------
+//
+// Return Value :
+//   bit - 1 if any key does not hold its expected value
+// Parameters   : None
+//
+// Reads each test key from the store and compares it with Expected. A key
+// that was only deleted must read as absent.
+//
+//-----------------------------------------------------------------------------
+
+bit Check_Values (void)
+{
+   U8 value[TEST_LENGTH];
+   U8 key;
+   U8 i;
+   U8 length;
+   bit written;
+
+   for (key = 0; key < TEST_KEYS; key++)
+   {
+      length = FlashKV_Read(key, value, TEST_LENGTH);
+
+      written = 0;
+
+      for (i = 0; i < TEST_LENGTH; i++)
+      {
+         if (Expected[key][i])
+         {
+            written = 1;
+         }
+      }
+
+      if (length == 0)
+      {
+         if (written)
+         {
+            return 1;
+         }
+         continue;
+      }
+
+      if (length != TEST_LENGTH)
+      {
+         return 1;
+      }
+
+      for (i = 0; i < TEST_LENGTH; i++)
+      {
+         if (value[i] != Expected[key][i])
+         {
+            return 1;
+         }
+      }
+   }
+
+   return 0;
+}
+
+//-----------------------------------------------------------------------------
+// Initialization Subroutines
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// OSCILLATOR_Init
+//-----------------------------------------------------------------------------
+//
+// Return Value : None
+// Parameters   : None
+//
+// This function initializes the system clock to use the internal oscillator
+// at its maximum frequency / 8.
+//
+//-----------------------------------------------------------------------------
+
+void OSCILLATOR_Init (void)
+{
+   U8 SFRPAGE_save = SFRPAGE;
+   SFRPAGE = CONFIG_PAGE;
+
+   OSCICN = 0x84;                      // Configure internal oscillator for
+                                       // 24 MHz / 8
+
+   SFRPAGE = SFRPAGE_save;
+}
+
+//-----------------------------------------------------------------------------
+// VDDMon_Init
+//-----------------------------------------------------------------------------
+//
+// Return Value : None
+// Parameters   : None
+//
+// This function initializes the VDD Monitor and enables it as a reset source.
+// The VDD Monitor is enabled following a power-on reset, but this routine
+// explicitly enables the VDD Monitor.
+//
+// Note: If the VDD Monitor is not enabled or not enabled as a reset source,
+// any attempt to write or erase Flash will cause a Flash Error Device Reset.
+//-----------------------------------------------------------------------------
+void VDDMon_Init(void)
+{
+   U8 SFRPAGE_save = SFRPAGE;
+   SFRPAGE = ACTIVE_PAGE;
+
+   // Step 1. Enable the VDD Monitor and set it to the high threshold
+   VDM0CN = 0xA0;
+
+   // Step 2. Wait for the VDD Monitor to stabilize (approximately 5 s).
+   // Note: This delay should be omitted if software contains routines which
+   // erase or write Flash memory.
+   // Omitted in this code
+
+   // Step 3. Select the VDD Monitor as a reset source (PORSF bit in
+   // RSTSRC = 1).
+
+   RSTSRC = 0x02;
+
+   SFRPAGE = SFRPAGE_save;
+}
+
+//-----------------------------------------------------------------------------
+// PORT_Init
+//-----------------------------------------------------------------------------
+//
+// Return Value : None
+// Parameters   : None
+//
+// This function configures the crossbar and ports pins.
+//
+// P1.3   digital   push-pull     LED
+//
+//-----------------------------------------------------------------------------
+void PORT_Init (void)
+{
+   U8 SFRPAGE_save = SFRPAGE;
+   SFRPAGE = CONFIG_PAGE;
+
+   P1MDIN |= 0x08;                     // P1.3 is digital
+   P1MDOUT |= 0x08;                    // P1.3 is push-pull
+
+   XBR2    = 0x40;                     // Enable crossbar and enable
+                                       // weak pull-ups
+
+   SFRPAGE = SFRPAGE_save;
+}
+
+//-----------------------------------------------------------------------------
+// End Of File
+//-----------------------------------------------------------------------------
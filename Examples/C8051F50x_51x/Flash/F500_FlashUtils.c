@@ -198,14 +198,30 @@ void FLASH_Update (FLADDR dest, U8 *src, U16 numbytes)
 // <dest>.  The bytes must be erased to 0xFF before writing.
 // <dest> + <numbytes> must be less than 0xFBFF/0x7FFF
 //
+// The bytes are written with one FLASH_BlockWrite() call for each Flash
+// page that they cover.
+//
 //-----------------------------------------------------------------------------
 
 void FLASH_Write (FLADDR dest, U8 *src, U16 numbytes)
 {
-   FLADDR i;
+   U16 length;
+
+   while (numbytes)
+   {
+      // Bytes from <dest> to the end of its page
+      length = FLASH_PAGESIZE - (dest & (FLASH_PAGESIZE - 1));
 
-   for (i = dest; i < dest+numbytes; i++) {
-      FLASH_ByteWrite (i, *src++);
+      if (length > numbytes)
+      {
+         length = numbytes;
+      }
+
+      FLASH_BlockWrite (dest, src, length);
+
+      dest += length;
+      src += length;
+      numbytes -= length;
    }
 }
 
@@ -258,16 +274,14 @@ U8 * FLASH_Read (U8 *dest, FLADDR src, U16 numbytes)
 // <dest>.  The destination bytes must be erased to 0xFF before writing.
 // <dest>/<src> + <numbytes> must be less than 0xFBFF/0x7FFF.
 //
+// The source is read by FLASH_Write() through the code pointer returned
+// by FLASH_CodeRead().
+//
 //-----------------------------------------------------------------------------
 
 void FLASH_Copy (FLADDR dest, FLADDR src, U16 numbytes)
 {
-   FLADDR i;
-
-   for (i = 0; i < numbytes; i++) 
-   {
-      FLASH_ByteWrite ((FLADDR) dest+i, FLASH_ByteRead((FLADDR) src+i));
-   }
+   FLASH_Write (dest, FLASH_CodeRead (src), numbytes);
 }
 
 //-----------------------------------------------------------------------------
@@ -287,14 +301,27 @@ void FLASH_Copy (FLADDR dest, FLADDR src, U16 numbytes)
 // The target bytes must be erased before writing to them.
 // <addr> + <length> must be less than 0xFBFF/0x7FFF.
 //
+// The bytes are written with one FLASH_BlockFill() call for each Flash
+// page that they cover.
+//
 //-----------------------------------------------------------------------------
 
 void FLASH_Fill (FLADDR addr, U16 length, U8 fill)
 {
-   FLADDR i;
+   U16 count;
+
+   while (length) {
+      // Bytes from <addr> to the end of its page
+      count = FLASH_PAGESIZE - (addr & (FLASH_PAGESIZE - 1));
+
+      if (count > length) {
+         count = length;
+      }
+
+      FLASH_BlockFill (addr, fill, count);
 
-   for (i = 0; i < length; i++) {
-      FLASH_ByteWrite (addr+i, fill);
+      addr += count;
+      length -= count;
    }
 }
 
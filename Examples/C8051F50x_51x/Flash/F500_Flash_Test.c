@@ -40,6 +40,13 @@
 //        45 46 47 00 5A 5A
 //        5A 5A 5A 5A 5A 5A
 //
+// Option 3:
+// 1) Run the code as in Option 1 until the LED blinks.
+// 2) Halt and view <ByteWriteTicks> and <BlockWriteTicks> in the Watch
+//    window. They are the Timer2 ticks (SYSCLK / 12) taken to copy one
+//    512-byte page with FLASH_ByteWrite() for each byte and with
+//    FLASH_Copy(), which uses FLASH_BlockWrite().
+//
 // Target:         C8051F50x
 // Tool chain:     Raisonance / Keil / SDCC
 // Command Line:   None
@@ -68,6 +75,21 @@
 
 SBIT (LED, SFR_P1, 3);                 // LED == 1 means ON
 
+//-----------------------------------------------------------------------------
+// Global Constants
+//-----------------------------------------------------------------------------
+
+#define TIMING_PAGE 0x6200             // Two pages used to time page writes
+
+//-----------------------------------------------------------------------------
+// Global Variables
+//-----------------------------------------------------------------------------
+
+U32 ByteWriteTicks;                    // Timer2 ticks to write one page
+U32 BlockWriteTicks;                   // with each routine
+
+U16 Timer2_Overflows;                  // Upper 16 bits of the tick count
+
 //-----------------------------------------------------------------------------
 // Function Prototypes
 //-----------------------------------------------------------------------------
@@ -75,6 +97,11 @@ SBIT (LED, SFR_P1, 3);                 // LED == 1 means ON
 void OSCILLATOR_Init (void);           // Oscillator initialization routine
 void VDDMon_Init (void);               // VDD Monitor initialization routine
 void PORT_Init (void);                 // Port initialization routine
+void TIMER2_Init (void);               // Timer2 initialization routine
+void Timer2_Start (void);
+U32  Timer2_Stop (void);
+
+INTERRUPT_PROTO (TIMER2_ISR, INTERRUPT_TIMER2);
 
 //-----------------------------------------------------------------------------
 // main() Routine
@@ -91,6 +118,7 @@ void main (void)
    U8 test_compare_buff[8] = "ABCDEFG";
 
    U8 i, j;
+   U16 k;
 
    bit error_flag = 0;
 
@@ -113,6 +141,9 @@ void main (void)
    OSCILLATOR_Init();                  // Initialize the internal oscillator
    VDDMon_Init();                      // Initialize the VDD monitor
    PORT_Init();                        // Initialize the crossbar
+   TIMER2_Init();                      // Initialize the tick counter
+
+   EA = 1;                             // Enable global interrupts
 
    LED = 1;
 
@@ -228,6 +259,39 @@ void main (void)
    }
    //--------------------------------------------------------------------------
 
+   // Compare the time to write a whole page----------------------------------
+   FLASH_PageErase(TIMING_PAGE);
+   FLASH_PageErase(TIMING_PAGE+FLASH_PAGESIZE);
+
+   // Copy the first page of code one byte at a time
+   Timer2_Start();
+
+   for (k = 0; k < FLASH_PAGESIZE; k++)
+   {
+      FLASH_ByteWrite(TIMING_PAGE+k, FLASH_ByteRead(k));
+   }
+
+   ByteWriteTicks = Timer2_Stop();
+
+   // Copy the same page with FLASH_BlockWrite()
+   Timer2_Start();
+
+   FLASH_Copy(TIMING_PAGE+FLASH_PAGESIZE, 0x0000, FLASH_PAGESIZE);
+
+   BlockWriteTicks = Timer2_Stop();
+
+   for (k = 0; k < FLASH_PAGESIZE; k++)
+   {
+      temp_byte = FLASH_ByteRead(k);
+
+      if ((FLASH_ByteRead(TIMING_PAGE+k) != temp_byte) ||
+          (FLASH_ByteRead(TIMING_PAGE+FLASH_PAGESIZE+k) != temp_byte))
+      {
+         error_flag = 1;
+      }
+   }
+   //--------------------------------------------------------------------------
+
    //END OF TEST===============================================================
 
    while (1)                           // Loop forever
@@ -336,6 +400,109 @@ void PORT_Init (void)
    SFRPAGE = SFRPAGE_save;
 }
 
+//-----------------------------------------------------------------------------
+// TIMER2_Init
+//-----------------------------------------------------------------------------
+//
+// Return Value : None
+// Parameters   : None
+//
+// This function configures Timer2 as a 16-bit free running timer clocked by
+// SYSCLK / 12, with an interrupt on each overflow to extend the count.
+//
+//-----------------------------------------------------------------------------
+void TIMER2_Init (void)
+{
+   U8 SFRPAGE_save = SFRPAGE;
+   SFRPAGE = ACTIVE_PAGE;
+
+   CKCON &= ~0x30;                     // Timer2 uses SYSCLK/12
+   TMR2CN = 0x00;                      // 16-bit auto-reload, stopped
+
+   TMR2RL = 0x0000;                    // Reload to zero on overflow
+   TMR2 = 0x0000;
+
+   ET2 = 1;                            // Enable Timer2 interrupts
+
+   SFRPAGE = SFRPAGE_save;
+}
+
+//-----------------------------------------------------------------------------
+// Timer2_Start
+//-----------------------------------------------------------------------------
+//
+// Return Value : None
+// Parameters   : None
+//
+// Clears the tick count and starts Timer2.
+//
+//-----------------------------------------------------------------------------
+void Timer2_Start (void)
+{
+   U8 SFRPAGE_save = SFRPAGE;
+   SFRPAGE = ACTIVE_PAGE;
+
+   TMR2 = 0x0000;
+   Timer2_Overflows = 0;
+   TR2 = 1;
+
+   SFRPAGE = SFRPAGE_save;
+}
+
+//-----------------------------------------------------------------------------
+// Timer2_Stop
+//-----------------------------------------------------------------------------
+//
+// Return Value :
+//   U32 - Timer2 ticks since Timer2_Start()
+// Parameters   : None
+//
+// Stops Timer2 and returns the tick count, including any overflow that is
+// still pending.
+//
+//-----------------------------------------------------------------------------
+U32 Timer2_Stop (void)
+{
+   U32 ticks;
+   U8 SFRPAGE_save = SFRPAGE;
+   SFRPAGE = ACTIVE_PAGE;
+
+   TR2 = 0;
+
+   EA = 0;
+
+   if (TF2H)
+   {
+      TF2H = 0;
+      Timer2_Overflows++;
+   }
+
+   ticks = ((U32) Timer2_Overflows << 16) | TMR2;
+
+   EA = 1;
+
+   SFRPAGE = SFRPAGE_save;
+
+   return ticks;
+}
+
+//-----------------------------------------------------------------------------
+// Interrupt Service Routines
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// TIMER2_ISR
+//-----------------------------------------------------------------------------
+//
+// Counts Timer2 overflows.
+//
+//-----------------------------------------------------------------------------
+INTERRUPT (TIMER2_ISR, INTERRUPT_TIMER2)
+{
+   TF2H = 0;                           // Clear Timer2 interrupt flag
+   Timer2_Overflows++;
+}
+
 //-----------------------------------------------------------------------------
 // End Of File
 //-----------------------------------------------------------------------------
\ No newline at end of file
@@ -0,0 +1,80 @@
+//-----------------------------------------------------------------------------
+// C8051F700_defs.h
+//-----------------------------------------------------------------------------
+//
+// Host (Linux/GCC) replacement for the C8051F700 register definitions.
+//
+// Used to build ../../../C8051F70x_71x/EEPROM/F70x_EEPROM.c on the host.
+// The EEPROM SFRs and SFRPAGE are lvalues returned by EepromSfr() in
+// FlashModel.c, which models the 32-byte EEPROM and its RAM buffer. The
+// other SFRs used by the example share one unmodeled register.
+//
+// The example main() is renamed so that FlashBench.c provides the program
+// entry.
+//
+// Target:         Linux host
+// Tool chain:     GCC
+// Command Line:   See FlashBench.c
+//
+//-----------------------------------------------------------------------------
+#ifndef C8051F700_DEFS_H
+#define C8051F700_DEFS_H
+
+#ifndef COMPILER_DEFS_H
+#include <compiler_defs.h>
+#endif
+
+#define main F70x_EEPROM_Main
+
+//-----------------------------------------------------------------------------
+// Modeled SFRs
+//-----------------------------------------------------------------------------
+enum MODEL_EE_SFR_Enum
+{
+   MODEL_EE_SFRPAGE = 0,
+   MODEL_EE_EEADDR,
+   MODEL_EE_EEDATA,
+   MODEL_EE_EECNTL,
+   MODEL_EE_EEKEY,
+   MODEL_EE_OTHER,                     // Not modeled
+   MODEL_EE_SFR_COUNT
+};
+
+volatile U8 *EepromSfr (U8 sfr);
+
+#define SFRPAGE   (*EepromSfr(MODEL_EE_SFRPAGE))
+#define EEADDR    (*EepromSfr(MODEL_EE_EEADDR))
+#define EEDATA    (*EepromSfr(MODEL_EE_EEDATA))
+#define EECNTL    (*EepromSfr(MODEL_EE_EECNTL))
+#define EEKEY     (*EepromSfr(MODEL_EE_EEKEY))
+
+#define CONFIG_PAGE  0x0F
+#define LEGACY_PAGE  0x00
+
+#define SFR_P1    0x90
+
+//-----------------------------------------------------------------------------
+// Unmodeled SFRs used by the example initialization and delay routines
+//-----------------------------------------------------------------------------
+#define PCA0MD    (*EepromSfr(MODEL_EE_OTHER))
+#define OSCICN    (*EepromSfr(MODEL_EE_OTHER))
+#define RSTSRC    (*EepromSfr(MODEL_EE_OTHER))
+#define CLKSEL    (*EepromSfr(MODEL_EE_OTHER))
+#define P0MDOUT   (*EepromSfr(MODEL_EE_OTHER))
+#define P1MDOUT   (*EepromSfr(MODEL_EE_OTHER))
+#define P1SKIP    (*EepromSfr(MODEL_EE_OTHER))
+#define XBR0      (*EepromSfr(MODEL_EE_OTHER))
+#define XBR1      (*EepromSfr(MODEL_EE_OTHER))
+#define CKCON     (*EepromSfr(MODEL_EE_OTHER))
+#define SCON0     (*EepromSfr(MODEL_EE_OTHER))
+#define TH1       (*EepromSfr(MODEL_EE_OTHER))
+#define TL1       (*EepromSfr(MODEL_EE_OTHER))
+#define TMOD      (*EepromSfr(MODEL_EE_OTHER))
+#define TMR2      (*EepromSfr(MODEL_EE_OTHER))
+#define WDTCN     (*EepromSfr(MODEL_EE_OTHER))
+#define TR1       (*EepromSfr(MODEL_EE_OTHER))
+#define TI0       (*EepromSfr(MODEL_EE_OTHER))
+#define TR2       (*EepromSfr(MODEL_EE_OTHER))
+#define TF2H      (*EepromSfr(MODEL_EE_OTHER))
+
+#endif                                 // #define C8051F700_DEFS_H
@@ -0,0 +1,908 @@
+//-----------------------------------------------------------------------------
+// FlashBench.c
+//-----------------------------------------------------------------------------
+//
+// Program Description:
+//
+// Replays one parameter update trace through each storage strategy of the
+// examples, on the memories modeled by FlashModel.c, and reports the write
+// amplification, latency and wear of each:
+//
+//    F50x FLASH_Update   - F500_FlashUtils.c, page copied through FLASH_TEMP
+//    F50x FlashCache     - F500_FlashCache.c, FlashCache_Tick() every step
+//    F50x FlashKV        - F500_FlashKV.c, FlashKV_Service() every step
+//    F50x FlashErase     - block images appended to a page, new pages taken
+//                          from F500_FlashErase.c, FlashErase_Service()
+//                          every step
+//    F70x EEPROM         - F70x_EEPROM.c, RAM buffer written and committed
+//                          with EEPROM_CopyRAMToEEPROM()
+//    F70x EEPROM_Sync    - committed with EEPROM_Sync(), skipped if no
+//                          byte changed
+//    F70x EEPROM_Tick    - committed by EEPROM_Tick() every step
+//    T62x EPROM raw      - T620_EPROM_Utils.c, each update appended as
+//                          [param][value]
+//    T62x EPROMLog       - T620_EPROM_Log.c, each changed value appended as
+//                          a record with a CRC
+//    F91x scratchpad     - ring of 4-byte CRC records in the scratchpad, as
+//                          for the calibration value in
+//                          F91x_CapTouchSense_Switch.c, one record for
+//                          each 16-bit word of an update, erased only
+//                          when the ring is full
+//
+// The trace updates a 32-byte block of 12 parameters, one update per step.
+// A few parameters take most of the updates and some updates write the
+// value already stored. Each strategy first stores the initial values, then
+// the statistics are cleared and the trace is replayed. At the end, the
+// values are read back as after a reset and compared with the trace.
+//
+// Write amplification is the number of bytes written to the memory for
+// each byte of parameter updated. The latency of the update itself (Fg)
+// and of the work done in the step after it (Bg) are reported apart, since
+// the step stands for an idle window of the application. The lifetime is the number of updates
+// until the most erased page reaches the endurance of the memory, or until
+// the EPROM is full.
+//
+// Exits with a non-zero status if a strategy programs a bit from 0 to 1 or
+// reads back a wrong value.
+//
+// Build (from this directory):
+//
+//    gcc -O2 -Wall -I. -I.. -I../../../C8051T620_1_T320_3/EPROM
+//        -o FlashBench FlashBench.c FlashModel.c
+//        ../F500_FlashUtils.c ../F500_FlashKV.c ../F500_FlashCache.c
+//        ../F500_FlashErase.c
+//        ../../../C8051T620_1_T320_3/EPROM/T620_EPROM_Utils.c
+//        ../../../C8051T620_1_T320_3/EPROM/T620_EPROM_Log.c
+//        ../../../C8051F70x_71x/EEPROM/F70x_EEPROM.c
+//
+// Usage:
+//
+//    FlashBench [-v] [updates]   -v lists the erases of each page
+//                                updates is the trace length, default 2000
+//
+// Target:         Linux host
+// Tool chain:     GCC
+// Command Line:   See above
+//
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// Includes
+//-----------------------------------------------------------------------------
+
+#include <compiler_defs.h>
+#include "F500_FlashPrimitives.h"
+#include "F500_FlashUtils.h"
+#include "F500_FlashCache.h"
+#include "F500_FlashKV.h"
+#include "F500_FlashErase.h"
+#include "T620_EPROM_Utils.h"
+#include "T620_EPROM_Log.h"
+#include "FlashModel.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+//-----------------------------------------------------------------------------
+// Global Constants
+//-----------------------------------------------------------------------------
+
+#define PARAMS             12
+#define BLOCK_SIZE         32          // Bytes of all parameters together
+#define MAX_PARAM          4
+#define DEFAULT_UPDATES    2000
+
+#define F500_BLOCK         0xE000L     // Parameter block for FLASH_Update
+                                       // and FlashCache
+
+#define ERASE_PAGES        4           // Pages of the FlashErase log, from
+                                       // F500_BLOCK
+#define ERASE_SLOT         (BLOCK_SIZE + 1)
+#define ERASE_SLOTS        ((FLASH_PAGESIZE - 2) / ERASE_SLOT)
+
+#define TOUCH_RING_SIZE    512         // SCRATCHPAD_SIZE of the example
+#define TOUCH_RECORD_SIZE  4           // CAL_RECORD_SIZE of the example
+#define TOUCH_WORDS        (BLOCK_SIZE / 2)
+
+//-----------------------------------------------------------------------------
+// Structures, Unions, Enumerations, and Type Definitions
+//-----------------------------------------------------------------------------
+
+typedef struct UPDATE
+{
+   U8 Param;
+   U8 Value[MAX_PARAM];
+} UPDATE;
+
+typedef struct STRATEGY
+{
+   const char *Name;
+   FLASH_MODEL *Model;
+   void (*Setup) (void);
+   U8   (*Update) (U8 param, U8 *value);
+   void (*Step) (void);
+   void (*Finish) (void);
+   void (*Restore) (U8 *block);        // Reads all values after a reset
+} STRATEGY;
+
+//-----------------------------------------------------------------------------
+// Global Variables
+//-----------------------------------------------------------------------------
+
+static const U8 Param_Size[PARAMS] = { 4, 4, 2, 2, 2, 2, 4, 4, 2, 2, 2, 2 };
+static U8 Param_Offset[PARAMS];
+
+static UPDATE *Trace;
+static U32 Trace_Length = DEFAULT_UPDATES;
+
+static U8 Initial[BLOCK_SIZE];         // Values stored before the trace
+static U8 Expected[BLOCK_SIZE];        // Values after the accepted updates
+
+static U8 Touch_Image[BLOCK_SIZE];
+static U16 Touch_Next;                 // Offset of the first erased record
+
+static U8 Erase_Image[BLOCK_SIZE];
+static FLADDR Erase_Page;
+static U16 Erase_Sequence;
+static U8 Erase_Slot;
+static U16 Raw_Next;
+
+static U32 Seed = 1;
+
+//-----------------------------------------------------------------------------
+// Trace
+//-----------------------------------------------------------------------------
+
+static U32 Rand (void)
+{
+   Seed = Seed * 1103515245L + 12345L;
+   return (Seed >> 16) & 0x7FFF;
+}
+
+//-----------------------------------------------------------------------------
+// Trace_Build
+//-----------------------------------------------------------------------------
+//
+// Half of the updates go to parameters 0 to 2 and the others are spread
+// over all parameters. One update in six writes the current value. The
+// other updates change the low byte by a small step, or the whole value
+// one time in eight.
+//
+//-----------------------------------------------------------------------------
+static void Trace_Build (void)
+{
+   U8 current[BLOCK_SIZE];
+   U8 *value;
+   U32 i;
+   U8 p;
+   U8 j;
+
+   Trace = malloc (Trace_Length * sizeof (UPDATE));
+
+   for (i = 0, j = 0; i < PARAMS; j += Param_Size[i], i++)
+   {
+      Param_Offset[i] = j;
+   }
+
+   for (i = 0; i < BLOCK_SIZE; i++)
+   {
+      Initial[i] = Rand ();
+   }
+   memcpy (current, Initial, BLOCK_SIZE);
+
+   for (i = 0; i < Trace_Length; i++)
+   {
+      p = Rand () % PARAMS;
+      if (Rand () & 1)
+      {
+         p %= 3;
+      }
+
+      value = current + Param_Offset[p];
+
+      if ((Rand () % 6) != 0)
+      {
+         if ((Rand () % 8) == 0)
+         {
+            for (j = 0; j < Param_Size[p]; j++)
+            {
+               value[j] = Rand ();
+            }
+         }
+         else
+         {
+            value[Param_Size[p] - 1] += (Rand () % 7) - 3;
+         }
+      }
+
+      Trace[i].Param = p;
+      memcpy (Trace[i].Value, value, Param_Size[p]);
+   }
+}
+
+//-----------------------------------------------------------------------------
+// F50x FLASH_Update
+//-----------------------------------------------------------------------------
+
+static void Update_Setup (void) { }
+
+static U8 Update_Update (U8 param, U8 *value)
+{
+   FLASH_Update (F500_BLOCK + Param_Offset[param], value, Param_Size[param]);
+   return 1;
+}
+
+static void Update_Step (void) { }
+
+static void Update_Finish (void) { }
+
+static void Update_Restore (U8 *block)
+{
+   FLASH_Read (block, F500_BLOCK, BLOCK_SIZE);
+}
+
+//-----------------------------------------------------------------------------
+// F50x FlashCache
+//-----------------------------------------------------------------------------
+
+static void Cache_Setup (void)
+{
+   FlashCache_Init ();
+}
+
+static U8 Cache_Update (U8 param, U8 *value)
+{
+   return FlashCache_Write (F500_BLOCK + Param_Offset[param], value,
+                            Param_Size[param]);
+}
+
+static void Cache_Step (void)
+{
+   FlashCache_Tick ();
+}
+
+static void Cache_Finish (void)
+{
+   FlashCache_Flush ();
+}
+
+static void Cache_Restore (U8 *block)
+{
+   FLASH_Read (block, F500_BLOCK, BLOCK_SIZE);
+}
+
+//-----------------------------------------------------------------------------
+// F50x FlashKV
+//-----------------------------------------------------------------------------
+
+static void KV_Setup (void)
+{
+   FlashKV_Init ();
+}
+
+static U8 KV_Update (U8 param, U8 *value)
+{
+   return FlashKV_Write (param, value, Param_Size[param]);
+}
+
+static void KV_Step (void)
+{
+   FlashKV_Service ();
+}
+
+static void KV_Finish (void) { }
+
+static void KV_Restore (U8 *block)
+{
+   U8 i;
+
+   FlashKV_Init ();
+
+   for (i = 0; i < PARAMS; i++)
+   {
+      FlashKV_Read (i, block + Param_Offset[i], Param_Size[i]);
+   }
+}
+
+//-----------------------------------------------------------------------------
+// F50x FlashErase
+//-----------------------------------------------------------------------------
+//
+// Each changed block is appended to the current page as [image][0x00],
+// after a 2-byte page sequence number. A full page is given back to
+// F500_FlashErase.c and the next block starts an erased page taken from it.
+// The update erases only if no erased page is ready.
+//
+//-----------------------------------------------------------------------------
+
+static void Erase_Setup (void)
+{
+   U8 i;
+
+   FlashErase_Init ();
+
+   for (i = 0; i < ERASE_PAGES; i++)
+   {
+      FlashErase_Release (F500_BLOCK + (FLADDR) i * FLASH_PAGESIZE);
+   }
+
+   while (FlashErase_Service ());
+
+   memset (Erase_Image, 0xFF, BLOCK_SIZE);
+   Erase_Page = 0;
+   Erase_Sequence = 0;
+   Erase_Slot = ERASE_SLOTS;
+}
+
+static U8 Erase_Update (U8 param, U8 *value)
+{
+   FLADDR addr;
+   U8 marker = 0x00;
+
+   if (memcmp (Erase_Image + Param_Offset[param], value,
+               Param_Size[param]) == 0)
+   {
+      return 1;
+   }
+
+   if (Erase_Slot == ERASE_SLOTS)
+   {
+      // Erase in the foreground only if the idle windows fell behind
+      while (!FlashErase_Ready ())
+      {
+         if (!FlashErase_Service ())
+         {
+            return 0;
+         }
+      }
+
+      if (Erase_Page)
+      {
+         FlashErase_Release (Erase_Page);
+      }
+
+      Erase_Page = FlashErase_Take ();
+      Erase_Sequence++;
+      FLASH_Write (Erase_Page, (U8 *) &Erase_Sequence, 2);
+      Erase_Slot = 0;
+   }
+
+   memcpy (Erase_Image + Param_Offset[param], value, Param_Size[param]);
+
+   addr = Erase_Page + 2 + (FLADDR) Erase_Slot * ERASE_SLOT;
+   FLASH_Write (addr, Erase_Image, BLOCK_SIZE);
+   FLASH_Write (addr + BLOCK_SIZE, &marker, 1);
+   Erase_Slot++;
+
+   return 1;
+}
+
+static void Erase_Step (void)
+{
+   FlashErase_Service ();
+}
+
+static void Erase_Finish (void) { }
+
+static void Erase_Restore (U8 *block)
+{
+   FLADDR page;
+   FLADDR last = 0;
+   U16 sequence;
+   U16 newest = 0;
+   U8 i;
+
+   for (i = 0; i < ERASE_PAGES; i++)
+   {
+      page = F500_BLOCK + (FLADDR) i * FLASH_PAGESIZE;
+      FLASH_Read ((U8 *) &sequence, page, 2);
+
+      if ((sequence != 0xFFFF) && (sequence >= newest))
+      {
+         newest = sequence;
+         last = page;
+      }
+   }
+
+   for (i = 0; (i < ERASE_SLOTS) && last; i++)
+   {
+      page = last + 2 + (FLADDR) i * ERASE_SLOT;
+
+      if (FLASH_ByteRead (page + BLOCK_SIZE) != 0x00)
+      {
+         break;
+      }
+
+      FLASH_Read (block, page, BLOCK_SIZE);
+   }
+}
+
+//-----------------------------------------------------------------------------
+// F70x EEPROM
+//-----------------------------------------------------------------------------
+
+extern void EEPROM_Init (void);
+extern void EEPROM_RAMWrite (U8 address, U8 value);
+extern U8   EEPROM_RAMRead (U8 address);
+extern U8   EEPROM_CopyRAMToEEPROM (void);
+extern U8   EEPROM_CopyEEPROMToRAM (void);
+extern U8   EEPROM_Sync (void);
+extern U8   EEPROM_Tick (void);
+
+static void Eeprom_Setup (void)
+{
+   EEPROM_Init ();
+   EEPROM_CopyEEPROMToRAM ();
+}
+
+static void Eeprom_RAMWrite (U8 param, U8 *value)
+{
+   U8 i;
+
+   for (i = 0; i < Param_Size[param]; i++)
+   {
+      EEPROM_RAMWrite (Param_Offset[param] + i, value[i]);
+   }
+}
+
+static U8 Eeprom_Update (U8 param, U8 *value)
+{
+   Eeprom_RAMWrite (param, value);
+   EEPROM_CopyRAMToEEPROM ();
+   return 1;
+}
+
+static U8 Eeprom_SyncUpdate (U8 param, U8 *value)
+{
+   Eeprom_RAMWrite (param, value);
+   EEPROM_Sync ();
+   return 1;
+}
+
+static U8 Eeprom_TickUpdate (U8 param, U8 *value)
+{
+   Eeprom_RAMWrite (param, value);
+   return 1;
+}
+
+static void Eeprom_Step (void) { }
+
+static void Eeprom_TickStep (void)
+{
+   EEPROM_Tick ();
+}
+
+static void Eeprom_Finish (void)
+{
+   EEPROM_Sync ();
+}
+
+static void Eeprom_Restore (U8 *block)
+{
+   U8 i;
+
+   EepromModel_Reset ();
+   EEPROM_Init ();
+   EEPROM_CopyEEPROMToRAM ();
+
+   for (i = 0; i < BLOCK_SIZE; i++)
+   {
+      block[i] = EEPROM_RAMRead (i);
+   }
+}
+
+//-----------------------------------------------------------------------------
+// T62x EPROM raw
+//-----------------------------------------------------------------------------
+//
+// Each update is appended as [param][value], in the same EPROM space as
+// T620_EPROM_Log.c. The last record of each parameter holds its value.
+//
+//-----------------------------------------------------------------------------
+
+static void Raw_Setup (void)
+{
+   Raw_Next = EPROM_LOG_START;
+}
+
+static U8 Raw_Update (U8 param, U8 *value)
+{
+   if ((Raw_Next + 1 + Param_Size[param]) > EPROM_LOG_END)
+   {
+      return 0;                        // EPROM full
+   }
+
+   EPROM_Write (Raw_Next, (char *) &param, 1);
+   EPROM_Write (Raw_Next + 1, (char *) value, Param_Size[param]);
+
+   Raw_Next += 1 + Param_Size[param];
+   return 1;
+}
+
+static void Raw_Step (void) { }
+
+static void Raw_Finish (void) { }
+
+static void Raw_Restore (U8 *block)
+{
+   EPROMADDR addr = EPROM_LOG_START;
+   char param;
+
+   while (addr < EPROM_LOG_END)
+   {
+      EPROM_Read (&param, addr, 1);
+
+      if ((U8) param >= PARAMS)
+      {
+         break;                        // Unwritten
+      }
+
+      EPROM_Read ((char *) block + Param_Offset[(U8) param], addr + 1,
+                  Param_Size[(U8) param]);
+      addr += 1 + Param_Size[(U8) param];
+   }
+}
+
+//-----------------------------------------------------------------------------
+// T62x EPROMLog
+//-----------------------------------------------------------------------------
+
+static void EPROMLog_Setup (void)
+{
+   EPROMLog_Init ();
+}
+
+static U8 EPROMLog_Update (U8 param, U8 *value)
+{
+   return EPROMLog_Append (param, value, Param_Size[param]);
+}
+
+static void EPROMLog_Restore (U8 *block)
+{
+   U8 i;
+
+   EPROMLog_Init ();
+
+   for (i = 0; i < PARAMS; i++)
+   {
+      EPROMLog_Read (i, block + Param_Offset[i], Param_Size[i]);
+   }
+}
+
+//-----------------------------------------------------------------------------
+// F91x scratchpad
+//-----------------------------------------------------------------------------
+//
+// The calibration ring of F91x_CapTouchSense_Switch.c holds one 16-bit
+// value in 4-byte records, [value MSB][value LSB][CRC MSB][CRC LSB], and
+// erases the scratchpad only when the ring is full. Here the block is kept
+// as TOUCH_WORDS such values, and an update appends one record for each
+// word of the parameter.
+//
+// The record does not hold the index of its word. Instead the CRC covers
+// [index][value MSB][value LSB], so a record only checks against the index
+// it was written for. When the ring is full, it is erased and the latest
+// value of every word is written again.
+//
+//-----------------------------------------------------------------------------
+
+// CRC-16 with polynomial 0x1021 and initial value 0, as CRC0
+static U16 Touch_Crc (U8 index, U8 *value)
+{
+   U8 bytes[3];
+   U16 crc = 0;
+   U8 i;
+   U8 bit;
+
+   bytes[0] = index;
+   bytes[1] = value[0];
+   bytes[2] = value[1];
+
+   for (i = 0; i < 3; i++)
+   {
+      crc ^= (U16) bytes[i] << 8;
+
+      for (bit = 0; bit < 8; bit++)
+      {
+         crc = (crc & 0x8000) ? (U16) ((crc << 1) ^ 0x1021) : (U16) (crc << 1);
+      }
+   }
+
+   return crc;
+}
+
+static void Touch_Append (U8 index)
+{
+   U8 *value = Touch_Image + 2 * index;
+   U16 crc = Touch_Crc (index, value);
+
+   F91x_FLASH_ByteWrite (Touch_Next, value[0], 1);
+   F91x_FLASH_ByteWrite (Touch_Next + 1, value[1], 1);
+   F91x_FLASH_ByteWrite (Touch_Next + 2, (U8) (crc >> 8), 1);
+   F91x_FLASH_ByteWrite (Touch_Next + 3, (U8) crc, 1);
+
+   Touch_Next += TOUCH_RECORD_SIZE;
+}
+
+static void Touch_Setup (void)
+{
+   memset (Touch_Image, 0xFF, BLOCK_SIZE);
+   Touch_Next = 0;
+}
+
+static U8 Touch_Update (U8 param, U8 *value)
+{
+   U8 first = Param_Offset[param] / 2;
+   U8 words = Param_Size[param] / 2;
+   U8 i;
+
+   memcpy (Touch_Image + Param_Offset[param], value, Param_Size[param]);
+
+   if ((Touch_Next + words * TOUCH_RECORD_SIZE) > TOUCH_RING_SIZE)
+   {
+      F91x_FLASH_PageErase (0, 1);
+      Touch_Next = 0;
+
+      for (i = 0; i < TOUCH_WORDS; i++)
+      {
+         Touch_Append (i);
+      }
+
+      return 1;
+   }
+
+   for (i = first; i < (first + words); i++)
+   {
+      Touch_Append (i);
+   }
+
+   return 1;
+}
+
+static void Touch_Step (void) { }
+
+static void Touch_Finish (void) { }
+
+// Scans the ring up to the first erased record, as Calibration_Init()
+static void Touch_Restore (U8 *block)
+{
+   U8 record[TOUCH_RECORD_SIZE];
+   U16 offset;
+   U8 index;
+   U8 i;
+
+   for (offset = 0; offset <= (TOUCH_RING_SIZE - TOUCH_RECORD_SIZE);
+        offset += TOUCH_RECORD_SIZE)
+   {
+      for (i = 0; i < TOUCH_RECORD_SIZE; i++)
+      {
+         record[i] = FlashModel_Read (&ModelF91xSP, offset + i);
+      }
+
+      if ((record[0] & record[1] & record[2] & record[3]) == 0xFF)
+      {
+         break;                        // End of the ring
+      }
+
+      for (index = 0; index < TOUCH_WORDS; index++)
+      {
+         if (Touch_Crc (index, record) == ((record[2] << 8) | record[3]))
+         {
+            block[2 * index] = record[0];
+            block[2 * index + 1] = record[1];
+            break;
+         }
+      }
+   }
+}
+
+//-----------------------------------------------------------------------------
+// Strategies
+//-----------------------------------------------------------------------------
+
+static const STRATEGY Strategies[] =
+{
+   { "F50x FLASH_Update", &ModelF500, Update_Setup, Update_Update,
+     Update_Step, Update_Finish, Update_Restore },
+   { "F50x FlashCache", &ModelF500, Cache_Setup, Cache_Update,
+     Cache_Step, Cache_Finish, Cache_Restore },
+   { "F50x FlashKV", &ModelF500, KV_Setup, KV_Update,
+     KV_Step, KV_Finish, KV_Restore },
+   { "F50x FlashErase", &ModelF500, Erase_Setup, Erase_Update,
+     Erase_Step, Erase_Finish, Erase_Restore },
+   { "F70x EEPROM", &ModelF70x, Eeprom_Setup, Eeprom_Update,
+     Eeprom_Step, Eeprom_Finish, Eeprom_Restore },
+   { "F70x EEPROM_Sync", &ModelF70x, Eeprom_Setup, Eeprom_SyncUpdate,
+     Eeprom_Step, Eeprom_Finish, Eeprom_Restore },
+   { "F70x EEPROM_Tick", &ModelF70x, Eeprom_Setup, Eeprom_TickUpdate,
+     Eeprom_TickStep, Eeprom_Finish, Eeprom_Restore },
+   { "T62x EPROM raw", &ModelT620, Raw_Setup, Raw_Update,
+     Raw_Step, Raw_Finish, Raw_Restore },
+   { "T62x EPROMLog", &ModelT620, EPROMLog_Setup, EPROMLog_Update,
+     Raw_Step, Raw_Finish, EPROMLog_Restore },
+   { "F91x scratchpad", &ModelF91xSP, Touch_Setup, Touch_Update,
+     Touch_Step, Touch_Finish, Touch_Restore },
+};
+
+#define STRATEGIES (sizeof (Strategies) / sizeof (Strategies[0]))
+
+//-----------------------------------------------------------------------------
+// Run
+//-----------------------------------------------------------------------------
+//
+// Replays the trace through <s> and prints one line of results. Returns the
+// number of failures.
+//
+//-----------------------------------------------------------------------------
+static U32 Run (const STRATEGY *s, U8 verbose)
+{
+   FLASH_MODEL *m = s->Model;
+   U8 block[BLOCK_SIZE];
+   uint64_t start;
+   uint64_t latency;
+   uint64_t total;
+   uint64_t worst = 0;
+   uint64_t worst_step = 0;
+   U32 payload = 0;
+   U32 accepted = 0;
+   U32 max_erases;
+   U32 failures = 0;
+   U32 i;
+   U8 p;
+
+   FlashModel_Init ();
+   s->Setup ();
+
+   // Store the initial values
+   for (p = 0; p < PARAMS; p++)
+   {
+      s->Update (p, Initial + Param_Offset[p]);
+   }
+   s->Finish ();
+   memcpy (Expected, Initial, BLOCK_SIZE);
+
+   FlashModel_Clear (m);
+   ModelMicros = 0;
+
+   for (i = 0; i < Trace_Length; i++)
+   {
+      p = Trace[i].Param;
+      start = ModelMicros;
+
+      if (s->Update (p, Trace[i].Value))
+      {
+         memcpy (Expected + Param_Offset[p], Trace[i].Value, Param_Size[p]);
+         payload += Param_Size[p];
+         accepted++;
+      }
+
+      latency = ModelMicros - start;
+      if (latency > worst)
+      {
+         worst = latency;
+      }
+
+      start = ModelMicros;
+      s->Step ();
+
+      latency = ModelMicros - start;
+      if (latency > worst_step)
+      {
+         worst_step = latency;
+      }
+   }
+
+   s->Finish ();
+   total = ModelMicros;
+
+   memset (block, 0, BLOCK_SIZE);
+   s->Restore (block);
+
+   if (memcmp (block, Expected, BLOCK_SIZE) != 0)
+   {
+      printf ("%-18s values read back do not match the trace\n", s->Name);
+      failures++;
+   }
+
+   if (m->Violations)
+   {
+      printf ("%-18s %lu writes programmed a bit from 0 to 1\n", s->Name,
+              (unsigned long) m->Violations);
+      failures++;
+   }
+
+   max_erases = FlashModel_MaxPageErases (m);
+
+   printf ("%-18s %8lu %6.2f %7lu %6lu %9.1f %9.1f %9.1f %7lu ",
+           s->Name,
+           (unsigned long) m->BytesWritten,
+           payload ? (double) m->BytesWritten / payload : 0.0,
+           (unsigned long) m->Erases,
+           (unsigned long) max_erases,
+           accepted ? (double) total / accepted / 1000.0 : 0.0,
+           worst / 1000.0,
+           worst_step / 1000.0,
+           (unsigned long) m->Rewrites);
+
+   if (!m->Erasable)
+   {
+      if (accepted < Trace_Length)
+      {
+         printf ("full at %lu\n", (unsigned long) accepted);
+      }
+      else
+      {
+         printf ("%.0f (EPROM)\n", (double) accepted *
+                 (EPROM_LOG_END - EPROM_LOG_START) / m->BytesWritten);
+      }
+   }
+   else if (max_erases)
+   {
+      printf ("%.0f\n", (double) m->Endurance * accepted / max_erases);
+   }
+   else
+   {
+      printf ("no erase\n");
+   }
+
+   if (verbose)
+   {
+      for (i = 0; i < m->Size / m->PageSize; i++)
+      {
+         if (m->PageErases[i])
+         {
+            printf ("   page 0x%05lX  %lu erases\n",
+                    (unsigned long) i * m->PageSize,
+                    (unsigned long) m->PageErases[i]);
+         }
+      }
+   }
+
+   return failures;
+}
+
+//-----------------------------------------------------------------------------
+// main
+//-----------------------------------------------------------------------------
+int main (int argc, char **argv)
+{
+   U8 verbose = 0;
+   U32 failures = 0;
+   U8 i;
+
+   for (i = 1; i < argc; i++)
+   {
+      if (strcmp (argv[i], "-v") == 0)
+      {
+         verbose = 1;
+      }
+      else if (atol (argv[i]) > 0)
+      {
+         Trace_Length = atol (argv[i]);
+      }
+   }
+
+   Trace_Build ();
+
+   printf ("%lu updates of a %u-byte block of %u parameters\n\n",
+           (unsigned long) Trace_Length, BLOCK_SIZE, PARAMS);
+   printf ("%-18s %8s %6s %7s %6s %9s %9s %9s %7s %s\n",
+           "Strategy", "Written", "WA", "Erases", "MaxPg",
+           "Mean ms", "Max Fg ms", "Max Bg ms", "Rewrite",
+           "Lifetime (updates)");
+
+   for (i = 0; i < STRATEGIES; i++)
+   {
+      failures += Run (&Strategies[i], verbose);
+   }
+
+   printf ("\n%s\n", failures ? "FAIL" : "PASS");
+
+   free (Trace);
+
+   return failures ? 1 : 0;
+}
+
+//-----------------------------------------------------------------------------
+// End Of File
+//-----------------------------------------------------------------------------
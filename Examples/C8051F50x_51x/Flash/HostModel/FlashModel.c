@@ -0,0 +1,490 @@
+//-----------------------------------------------------------------------------
+// FlashModel.c
+//-----------------------------------------------------------------------------
+//
+// Program Description:
+//
+// Host model of the F50x Flash, F70x EEPROM, T62x EPROM and F91x Flash.
+// See FlashModel.h.
+//
+// This file replaces F500_FlashPrimitives.c and T620_EPROM_Primitives.c in
+// the host build. The modules above the primitives (F500_FlashUtils.c,
+// F500_FlashKV.c, F500_FlashCache.c, T620_EPROM_Utils.c) are built
+// unchanged. F70x_EEPROM.c is built unchanged against the EEPROM SFR model
+// below.
+//
+// Modeled timing (typical values of the order given in the data sheets):
+//
+//    F50x   VDD monitor settle loop  85 us  per primitive call
+//           byte write               20 us
+//           page erase (512 bytes)   20 ms
+//    F70x   commit of 32 bytes       erase 2 ms + 20 us per byte
+//    T62x   byte write              105 us, no erase
+//    F91x   byte write               20 us
+//           page erase (512 bytes)   20 ms
+//
+// Endurance is taken as 20k erase cycles for every erasable memory.
+//
+// Target:         Linux host
+// Tool chain:     GCC
+// Command Line:   See FlashBench.c
+//
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// Includes
+//-----------------------------------------------------------------------------
+
+#include <compiler_defs.h>
+#include <C8051F700_defs.h>
+#include "F500_FlashPrimitives.h"
+#include "T620_EPROM_Primitives.h"
+#include "FlashModel.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+//-----------------------------------------------------------------------------
+// Global Constants
+//-----------------------------------------------------------------------------
+
+#define F500_SIZE          0x10000L
+#define F70X_SIZE          32
+#define T620_SIZE          0x4000L
+#define F91X_SIZE          0x4000L
+#define F91X_SP_SIZE       512
+
+#define ENDURANCE          20000L
+
+#define EECNTL_EEEN        0x80        // EEPROM enabled
+#define EECNTL_WRITE       0x02        // Copy the RAM buffer to the EEPROM
+#define EECNTL_READ        0x04        // Copy the EEPROM to the RAM buffer
+
+//-----------------------------------------------------------------------------
+// Global Variables
+//-----------------------------------------------------------------------------
+
+static U8  F500_Array[F500_SIZE];
+static U8  F500_Written[F500_SIZE];
+static U32 F500_PageErases[F500_SIZE / 512];
+static U8  F70x_Array[F70X_SIZE];
+static U8  F70x_Written[F70X_SIZE];
+static U32 F70x_PageErases[1];
+static U8  T620_Array[T620_SIZE];
+static U8  T620_Written[T620_SIZE];
+static U32 T620_PageErases[T620_SIZE / 512];
+static U8  F91x_Array[F91X_SIZE];
+static U8  F91x_Written[F91X_SIZE];
+static U32 F91x_PageErases[F91X_SIZE / 512];
+static U8  F91xSP_Array[F91X_SP_SIZE];
+static U8  F91xSP_Written[F91X_SP_SIZE];
+static U32 F91xSP_PageErases[1];
+
+// Size, page size, erasable, setup, write and erase times, endurance
+FLASH_MODEL ModelF500   = { "F50x Flash", F500_Array, F500_Written,
+                            F500_PageErases,
+                            F500_SIZE, 512, 1, 85, 20, 20000L, ENDURANCE };
+FLASH_MODEL ModelF70x   = { "F70x EEPROM", F70x_Array, F70x_Written,
+                            F70x_PageErases,
+                            F70X_SIZE, 32, 1, 0, 20, 2000L, ENDURANCE };
+FLASH_MODEL ModelT620   = { "T62x EPROM", T620_Array, T620_Written,
+                            T620_PageErases,
+                            T620_SIZE, 512, 0, 0, 105, 0L, 1L };
+FLASH_MODEL ModelF91x   = { "F91x Flash", F91x_Array, F91x_Written,
+                            F91x_PageErases,
+                            F91X_SIZE, 512, 1, 0, 20, 20000L, ENDURANCE };
+FLASH_MODEL ModelF91xSP = { "F91x scratchpad", F91xSP_Array, F91xSP_Written,
+                            F91xSP_PageErases,
+                            F91X_SP_SIZE, 512, 1, 0, 20, 20000L, ENDURANCE };
+
+uint64_t ModelMicros;
+
+// F70x EEPROM SFR model
+static U8 Eeprom_Sfr[MODEL_EE_SFR_COUNT];
+static U8 Eeprom_Ram[F70X_SIZE];
+static U8 Eeprom_State;                // EESTATE, read in EEKEY bits 0 and 1
+static S8 Eeprom_Last;                 // SFR returned by the last access
+static U8 Eeprom_Loaded;               // Its value when it was returned
+
+//-----------------------------------------------------------------------------
+// Model Routines
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// FlashModel_Init
+//-----------------------------------------------------------------------------
+//
+// Erases every memory, clears the statistics and resets the EEPROM SFRs.
+//
+//-----------------------------------------------------------------------------
+void FlashModel_Init (void)
+{
+   FlashModel_Erase (&ModelF500);
+   FlashModel_Erase (&ModelF70x);
+   FlashModel_Erase (&ModelT620);
+   FlashModel_Erase (&ModelF91x);
+   FlashModel_Erase (&ModelF91xSP);
+
+   EepromModel_Reset ();
+
+   ModelMicros = 0;
+}
+
+//-----------------------------------------------------------------------------
+// FlashModel_Erase
+//-----------------------------------------------------------------------------
+//
+// Returns <model> to its unprogrammed state, with every byte 0xFF, and
+// clears its statistics. This is not charged or counted as an erase.
+//
+//-----------------------------------------------------------------------------
+void FlashModel_Erase (FLASH_MODEL *model)
+{
+   memset (model->Array, 0xFF, model->Size);
+   memset (model->Written, 0, model->Size);
+
+   FlashModel_Clear (model);
+}
+
+//-----------------------------------------------------------------------------
+// FlashModel_Clear
+//-----------------------------------------------------------------------------
+//
+// Clears the statistics and the erase counters of <model>. The contents are
+// kept.
+//
+//-----------------------------------------------------------------------------
+void FlashModel_Clear (FLASH_MODEL *model)
+{
+   memset (model->PageErases, 0,
+           (model->Size / model->PageSize) * sizeof (U32));
+
+   model->BytesWritten = 0;
+   model->Erases = 0;
+   model->Violations = 0;
+   model->Rewrites = 0;
+}
+
+//-----------------------------------------------------------------------------
+// FlashModel_Program
+//-----------------------------------------------------------------------------
+//
+// Writes <byte> at <addr> of <model>. Returns 0 if the write needed a bit to
+// go from 0 to 1 or <addr> is outside of the memory.
+//
+//-----------------------------------------------------------------------------
+U8 FlashModel_Program (FLASH_MODEL *model, U32 addr, U8 byte)
+{
+   U8 old;
+
+   if (addr >= model->Size)
+   {
+      model->Violations++;
+      return 0;
+   }
+
+   ModelMicros += model->WriteMicros;
+   model->BytesWritten++;
+
+   if (model->Written[addr])
+   {
+      model->Rewrites++;
+   }
+   model->Written[addr] = 1;
+
+   old = model->Array[addr];
+   model->Array[addr] = old & byte;
+
+   if ((old & byte) != byte)
+   {
+      model->Violations++;
+      return 0;
+   }
+
+   return 1;
+}
+
+//-----------------------------------------------------------------------------
+// FlashModel_PageErase
+//-----------------------------------------------------------------------------
+//
+// Erases the page of <model> that holds <addr>.
+//
+//-----------------------------------------------------------------------------
+void FlashModel_PageErase (FLASH_MODEL *model, U32 addr)
+{
+   U32 page;
+
+   if ((addr >= model->Size) || !model->Erasable)
+   {
+      model->Violations++;
+      return;
+   }
+
+   page = addr / model->PageSize;
+
+   ModelMicros += model->EraseMicros;
+   model->Erases++;
+   model->PageErases[page]++;
+
+   memset (model->Array + page * model->PageSize, 0xFF, model->PageSize);
+   memset (model->Written + page * model->PageSize, 0, model->PageSize);
+}
+
+//-----------------------------------------------------------------------------
+// FlashModel_Read
+//-----------------------------------------------------------------------------
+U8 FlashModel_Read (FLASH_MODEL *model, U32 addr)
+{
+   if (addr >= model->Size)
+   {
+      model->Violations++;
+      return 0xFF;
+   }
+
+   return model->Array[addr];
+}
+
+//-----------------------------------------------------------------------------
+// FlashModel_MaxPageErases
+//-----------------------------------------------------------------------------
+//
+// Returns the erase count of the most erased page of <model>.
+//
+//-----------------------------------------------------------------------------
+U32 FlashModel_MaxPageErases (FLASH_MODEL *model)
+{
+   U32 page;
+   U32 max = 0;
+
+   for (page = 0; page < model->Size / model->PageSize; page++)
+   {
+      if (model->PageErases[page] > max)
+      {
+         max = model->PageErases[page];
+      }
+   }
+
+   return max;
+}
+
+//-----------------------------------------------------------------------------
+// F500_FlashPrimitives.h
+//-----------------------------------------------------------------------------
+//
+// The VDD monitor and the FLKEY sequence are not modeled. Each call is
+// charged the VDD monitor settle loop, once for FLASH_BlockWrite() and
+// FLASH_BlockFill() as in F500_FlashPrimitives.c.
+//
+//-----------------------------------------------------------------------------
+U8 FLASH_ByteWrite (FLADDR addr, U8 byte)
+{
+   ModelMicros += ModelF500.SetupMicros;
+
+   FlashModel_Program (&ModelF500, addr, byte);
+
+   return 1;
+}
+
+U8 FLASH_BlockWrite (FLADDR addr, U8 *src, U16 numbytes)
+{
+   ModelMicros += ModelF500.SetupMicros;
+
+   while (numbytes--)
+   {
+      FlashModel_Program (&ModelF500, addr++, *src++);
+   }
+
+   return 1;
+}
+
+U8 FLASH_BlockFill (FLADDR addr, U8 fill, U16 numbytes)
+{
+   ModelMicros += ModelF500.SetupMicros;
+
+   while (numbytes--)
+   {
+      FlashModel_Program (&ModelF500, addr++, fill);
+   }
+
+   return 1;
+}
+
+U8 FLASH_ByteRead (FLADDR addr)
+{
+   return FlashModel_Read (&ModelF500, addr);
+}
+
+U8 * FLASH_CodeRead (FLADDR addr)
+{
+   return F500_Array + addr;
+}
+
+U8 FLASH_PageErase (FLADDR addr)
+{
+   ModelMicros += ModelF500.SetupMicros;
+
+   FlashModel_PageErase (&ModelF500, addr);
+
+   return 1;
+}
+
+//-----------------------------------------------------------------------------
+// T620_EPROM_Primitives.h
+//-----------------------------------------------------------------------------
+void EPROM_ByteWrite (EPROMADDR addr, char byte)
+{
+   FlashModel_Program (&ModelT620, addr, (U8) byte);
+}
+
+unsigned char EPROM_ByteRead (EPROMADDR addr)
+{
+   return FlashModel_Read (&ModelT620, addr);
+}
+
+//-----------------------------------------------------------------------------
+// CapTouchSense Flash routines
+//-----------------------------------------------------------------------------
+//
+// <SFLE> selects the scratchpad page, as in F91x_CapTouchSense_Switch.c.
+//
+//-----------------------------------------------------------------------------
+void F91x_FLASH_ByteWrite (U16 addr, U8 byte, U8 SFLE)
+{
+   FlashModel_Program (SFLE ? &ModelF91xSP : &ModelF91x, addr, byte);
+}
+
+void F91x_FLASH_PageErase (U16 addr, U8 SFLE)
+{
+   FlashModel_PageErase (SFLE ? &ModelF91xSP : &ModelF91x, addr);
+}
+
+//-----------------------------------------------------------------------------
+// F70x EEPROM SFR model
+//-----------------------------------------------------------------------------
+//
+// EEADDR and EEDATA access the 32-byte RAM buffer. The key sequence 0x55,
+// 0xAA written to EEKEY enables one write, and any other value written to
+// EEKEY locks the EEPROM until EepromModel_Reset(). Setting the write bit
+// of EECNTL with the EEPROM enabled erases the EEPROM and writes the 32
+// bytes of the buffer. Setting the read bit copies the EEPROM to the
+// buffer. Both bits clear themselves. Address auto-increment is not
+// modeled.
+//
+// An SFR is returned as an lvalue, so a write is seen at the next access.
+// Every access in F70x_EEPROM.c is followed by an access to SFRPAGE.
+//
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// EepromModel_Reset
+//-----------------------------------------------------------------------------
+//
+// Models a device reset. The RAM buffer is cleared, so it must be read
+// from the EEPROM again.
+//
+//-----------------------------------------------------------------------------
+void EepromModel_Reset (void)
+{
+   memset (Eeprom_Sfr, 0, sizeof (Eeprom_Sfr));
+   memset (Eeprom_Ram, 0, sizeof (Eeprom_Ram));
+   Eeprom_State = 0;
+   Eeprom_Last = -1;
+}
+
+//-----------------------------------------------------------------------------
+// Eeprom_Settle
+//-----------------------------------------------------------------------------
+//
+// Applies a value written to the SFR returned by the last access.
+//
+//-----------------------------------------------------------------------------
+static void Eeprom_Settle (void)
+{
+   U8 value;
+   U8 i;
+
+   if (Eeprom_Last < 0)
+   {
+      return;
+   }
+
+   value = Eeprom_Sfr[Eeprom_Last];
+
+   switch (Eeprom_Last)
+   {
+      case MODEL_EE_EEDATA:
+         Eeprom_Ram[Eeprom_Sfr[MODEL_EE_EEADDR] % F70X_SIZE] = value;
+         break;
+
+      case MODEL_EE_EEKEY:
+         if (value == Eeprom_Loaded)
+         {
+            break;                     // Read of EESTATE
+         }
+
+         if ((Eeprom_State == 0) && (value == 0x55))
+         {
+            Eeprom_State = 1;
+         }
+         else if ((Eeprom_State == 1) && (value == 0xAA))
+         {
+            Eeprom_State = 2;
+         }
+         else
+         {
+            Eeprom_State = 3;
+         }
+         break;
+
+      case MODEL_EE_EECNTL:
+         if ((value & EECNTL_WRITE) && (value & EECNTL_EEEN) &&
+             (Eeprom_State == 2))
+         {
+            FlashModel_PageErase (&ModelF70x, 0);
+
+            for (i = 0; i < F70X_SIZE; i++)
+            {
+               FlashModel_Program (&ModelF70x, i, Eeprom_Ram[i]);
+            }
+
+            Eeprom_State = 0;
+         }
+
+         if ((value & EECNTL_READ) && (value & EECNTL_EEEN))
+         {
+            memcpy (Eeprom_Ram, ModelF70x.Array, F70X_SIZE);
+         }
+
+         Eeprom_Sfr[MODEL_EE_EECNTL] &= ~(EECNTL_WRITE | EECNTL_READ);
+         break;
+   }
+
+   Eeprom_Last = -1;
+}
+
+//-----------------------------------------------------------------------------
+// EepromSfr
+//-----------------------------------------------------------------------------
+volatile U8 *EepromSfr (U8 sfr)
+{
+   Eeprom_Settle ();
+
+   if (sfr == MODEL_EE_EEDATA)
+   {
+      Eeprom_Sfr[sfr] = Eeprom_Ram[Eeprom_Sfr[MODEL_EE_EEADDR] % F70X_SIZE];
+   }
+   else if (sfr == MODEL_EE_EEKEY)
+   {
+      Eeprom_Sfr[sfr] = Eeprom_State;
+   }
+
+   Eeprom_Last = sfr;
+   Eeprom_Loaded = Eeprom_Sfr[sfr];
+
+   return &Eeprom_Sfr[sfr];
+}
+
+//-----------------------------------------------------------------------------
+// End Of File
+//-----------------------------------------------------------------------------
@@ -0,0 +1,112 @@
+//-----------------------------------------------------------------------------
+// FlashModel.h
+//-----------------------------------------------------------------------------
+//
+// Program Description:
+//
+// Host model of the nonvolatile memories written by the storage examples,
+// so that they can be run and measured on Linux:
+//
+//    ModelF500   - C8051F50x Flash, written through F500_FlashPrimitives.h
+//    ModelF70x   - C8051F70x 32-byte EEPROM, written through its SFRs
+//    ModelT620   - C8051T62x EPROM, written through T620_EPROM_Primitives.h
+//    ModelF91x   - C8051F91x Flash, and ModelF91xSP its scratchpad page,
+//                  written as in the CapTouchSense examples
+//
+// Every memory enforces the same programming rules:
+//
+//    - A write can only change bits from 1 to 0. Writing a byte that needs
+//      a bit to go from 0 to 1 is counted as a violation, and the byte is
+//      programmed to (old & new) as the hardware would.
+//    - Only a page erase sets bits back to 1. An erase of a memory that
+//      cannot be erased (EPROM) is counted as a violation.
+//    - A byte written more than once between erases is counted as a
+//      rewrite.
+//
+// Every write, erase and VDD monitor setup advances ModelMicros by the
+// timing of the memory. The timings are typical values of the order given
+// in the data sheets, not measurements; see FlashModel.c. Reads are not
+// charged.
+//
+// Target:         Linux host
+// Tool chain:     GCC
+// Command Line:   See FlashBench.c
+//
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// Open Header #define
+//-----------------------------------------------------------------------------
+
+#ifndef _FLASHMODEL_H_
+#define _FLASHMODEL_H_
+
+//-----------------------------------------------------------------------------
+// Includes
+//-----------------------------------------------------------------------------
+
+#include <compiler_defs.h>
+
+//-----------------------------------------------------------------------------
+// Structures, Unions, Enumerations, and Type Definitions
+//-----------------------------------------------------------------------------
+
+typedef struct FLASH_MODEL
+{
+   const char *Name;
+   U8  *Array;                         // Memory contents
+   U8  *Written;                       // Byte written since its last erase
+   U32 *PageErases;                    // Erases of each page
+   U32 Size;                           // Bytes
+   U16 PageSize;                       // Bytes per erase page
+   U8  Erasable;                       // 0 for one-time programmable
+   U16 SetupMicros;                    // VDD monitor setup per primitive call
+   U16 WriteMicros;                    // Per byte written
+   U32 EraseMicros;                    // Per page erased
+   U32 Endurance;                      // Erase cycles per page
+
+   U32 BytesWritten;                   // Statistics since FlashModel_Clear()
+   U32 Erases;
+   U32 Violations;
+   U32 Rewrites;
+} FLASH_MODEL;
+
+//-----------------------------------------------------------------------------
+// Global Variables
+//-----------------------------------------------------------------------------
+
+extern FLASH_MODEL ModelF500;
+extern FLASH_MODEL ModelF70x;
+extern FLASH_MODEL ModelT620;
+extern FLASH_MODEL ModelF91x;
+extern FLASH_MODEL ModelF91xSP;
+
+extern uint64_t ModelMicros;           // Simulated time
+
+//-----------------------------------------------------------------------------
+// Exported Function Prototypes
+//-----------------------------------------------------------------------------
+
+void FlashModel_Init (void);
+void FlashModel_Erase (FLASH_MODEL *model);
+void FlashModel_Clear (FLASH_MODEL *model);
+U8   FlashModel_Program (FLASH_MODEL *model, U32 addr, U8 byte);
+void FlashModel_PageErase (FLASH_MODEL *model, U32 addr);
+U8   FlashModel_Read (FLASH_MODEL *model, U32 addr);
+U32  FlashModel_MaxPageErases (FLASH_MODEL *model);
+
+void EepromModel_Reset (void);
+
+// F91x Flash routines with the CapTouchSense example signatures
+void F91x_FLASH_ByteWrite (U16 addr, U8 byte, U8 SFLE);
+void F91x_FLASH_PageErase (U16 addr, U8 SFLE);
+
+//-----------------------------------------------------------------------------
+// Close Header #define
+//-----------------------------------------------------------------------------
+
+#endif    // _FLASHMODEL_H_
+
+//-----------------------------------------------------------------------------
+// End Of File
+//-----------------------------------------------------------------------------
@@ -0,0 +1,23 @@
+//-----------------------------------------------------------------------------
+// c8051F500_defs.h
+//-----------------------------------------------------------------------------
+//
+// Host (Linux/GCC) replacement for the C8051F500 register definitions.
+//
+// The F500 Flash modules built on the host access the Flash only through
+// the primitives in F500_FlashPrimitives.h, which FlashModel.c provides,
+// so no SFRs are needed.
+//
+// Target:         Linux host
+// Tool chain:     GCC
+// Command Line:   See FlashBench.c
+//
+//-----------------------------------------------------------------------------
+#ifndef C8051F500_DEFS_H
+#define C8051F500_DEFS_H
+
+#ifndef COMPILER_DEFS_H
+#include <compiler_defs.h>
+#endif
+
+#endif                                 // #define C8051F500_DEFS_H
@@ -0,0 +1,78 @@
+//-----------------------------------------------------------------------------
+// compiler_defs.h
+//-----------------------------------------------------------------------------
+//
+// Host (Linux/GCC) replacement for the C8051 compiler_defs.h.
+//
+// Used only by the Flash host model build. Memory space keywords and
+// pointer target segments are removed. SFRs are declared in the host
+// c8051F500_defs.h and C8051F700_defs.h.
+//
+// Code pointers are plain pointers here. FLASH_Copy() (F500_FlashUtils.c)
+// gets its code pointer from FLASH_CodeRead(), which FlashModel.c
+// implements as a pointer into the modeled F500 Flash.
+//
+// Target:         Linux host
+// Tool chain:     GCC
+// Command Line:   See FlashBench.c
+//
+//-----------------------------------------------------------------------------
+#ifndef COMPILER_DEFS_H
+#define COMPILER_DEFS_H
+
+#include <stdint.h>
+
+# define SEG_GENERIC
+# define SEG_FAR
+# define SEG_DATA
+# define SEG_NEAR
+# define SEG_IDATA
+# define SEG_XDATA
+# define SEG_PDATA
+# define SEG_CODE  const
+# define SEG_BDATA
+
+// Keil memory space keywords used directly in the example sources
+# define xdata
+# define data
+# define idata
+# define code
+
+# define INTERRUPT(name, vector) void name (void)
+# define INTERRUPT_USING(name, vector, regnum) void name (void)
+# define INTERRUPT_PROTO(name, vector) void name (void)
+# define INTERRUPT_PROTO_USING(name, vector, regnum) void name (void)
+
+# define SEGMENT_VARIABLE(name, vartype, locsegment) vartype locsegment name
+# define VARIABLE_SEGMENT_POINTER(name, vartype, targsegment) vartype * name
+# define SEGMENT_VARIABLE_SEGMENT_POINTER(name, vartype, targsegment, locsegment) vartype * locsegment name
+# define SEGMENT_POINTER(name, vartype, locsegment) vartype * locsegment name
+
+# define SBIT(name, addr, bitnum) U8 name
+# define SFR(name, addr) U8 name
+
+// used with UU16 (host is little endian)
+# define LSB 0
+# define MSB 1
+
+typedef uint8_t  U8;
+typedef uint16_t U16;
+typedef uint32_t U32;
+
+typedef int8_t  S8;
+typedef int16_t S16;
+typedef int32_t S32;
+
+typedef U8 bit;
+
+typedef union UU16
+{
+   U16 U16;
+   S16 S16;
+   U8 U8[2];
+   S8 S8[2];
+} UU16;
+
+#define NOP()
+
+#endif                                 // #define COMPILER_DEFS_H
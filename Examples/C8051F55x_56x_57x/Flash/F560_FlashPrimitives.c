@@ -34,6 +34,8 @@
 //-----------------------------------------------------------------------------
 
 U8  FLASH_ByteWrite (FLADDR addr, U8 byte);
+U8  FLASH_BlockWrite (FLADDR addr, U8 *src, U16 numbytes);
+U8  FLASH_BlockFill (FLADDR addr, U8 fill, U16 numbytes);
 U8  FLASH_ByteRead  (FLADDR addr);
 U8  FLASH_PageErase (FLADDR addr);
 
@@ -112,6 +114,149 @@ U8 FLASH_ByteWrite (FLADDR addr, U8 byte)
    return 1;                           // Write completed successfully
 }
 
+//-----------------------------------------------------------------------------
+// FLASH_BlockRun
+//-----------------------------------------------------------------------------
+//
+// Writes <numbytes> to the linear FLASH address <addr>, within one page,
+// for FLASH_BlockWrite() and FLASH_BlockFill(). Each byte is read from
+// <src>, and <src> then moves on by <step>: 1 to write a run of bytes, 0
+// to write the same byte <numbytes> times.
+//
+// FLKEY locks again after each write, so the key sequence is written before
+// every byte. Interrupts must stay disabled while PSWE is set, because a
+// MOVX write in an interrupt would write to Flash. Interrupts are enabled
+// again for a few cycles after every FLASH_BURST bytes, so the interrupt
+// latency does not grow with <numbytes>. Interrupt routines must not write
+// or erase Flash.
+//
+// If the VDD voltage is not high enough before a burst, the write stops and
+// the bytes of the earlier bursts remain written.
+//-----------------------------------------------------------------------------
+
+static U8 FLASH_BlockRun (FLADDR addr, U8 *src, U8 step, U16 numbytes)
+{
+   bit EA_SAVE = EA;                   // Preserve EA
+   U8 xdata * data pwrite;             // FLASH write pointer
+   U8 i;
+   U8 burst;                           // Bytes left in this burst
+   U8 status = 1;
+
+   U8 SFRPAGE_save = SFRPAGE;
+
+   if (numbytes == 0)
+      return 1;
+
+   SFRPAGE = ACTIVE_PAGE;
+
+   EA = 0;                             // Disable interrupts
+
+   RSTSRC = 0x00;                      // 1. Disable VDD monitor as a reset source
+
+   VDM0CN = 0xA0;                      // 2. Enable VDD monitor and high threshold
+
+   for (i = 0; i < 255; i++) {}        // 3. Wait for VDD monitor to stabilize
+
+   pwrite = (U8 xdata *) addr;
+
+   while (numbytes)
+   {
+      if (!(VDM0CN & 0x40))            // 4. If the VDD voltage is not high
+      {                                //    enough don't write to Flash
+         status = 0;
+         break;
+      }
+
+      RSTSRC = 0x02;                   // 5. Safe to enable VDD Monitor as a
+                                       //    reset source
+
+      burst = FLASH_BURST;
+      if (numbytes < FLASH_BURST)
+         burst = (U8) numbytes;
+      numbytes -= burst;
+
+      PSCTL |= 0x01;                   // 6. PSWE = 1 which enables writes
+
+      do
+      {
+         FLKEY  = 0xA5;                // Key Sequence 1
+         FLKEY  = 0xF1;                // Key Sequence 2
+
+         *pwrite++ = *src;             // 9. Write the byte
+         src += step;
+      } while (--burst);
+
+      PSCTL &= ~0x01;                  // PSWE = 0 which disable writes
+
+      EA = EA_SAVE;                    // Let pending interrupts run
+      NOP();
+      NOP();
+      EA = 0;
+   }
+
+   RSTSRC = 0x00;                      // 10. Disable the VDD monitor as reset
+                                       //     source
+   VDM0CN = 0x80;                      // 11. Change VDD Monitor to low threshold
+   RSTSRC = 0x02;                      // 12. Re-enable the VDD monitor as a
+                                       //     reset source
+
+   EA = EA_SAVE;                       // Restore interrupts
+
+   SFRPAGE = SFRPAGE_save;
+
+   return status;
+}
+
+//-----------------------------------------------------------------------------
+// FLASH_BlockWrite
+//-----------------------------------------------------------------------------
+//
+// Return Value :
+//   0 if Write unsuccessful, 1 if Write successful
+//
+// Parameters   :
+//   1) FLADDR addr - address of the first byte to write to
+//                    valid range is 0x0000 to 0x7BFF for 32K Flash devices
+//                    valid range is 0x0000 to 0x3FFF for 16K Flash devices
+//   2) U8 *src - pointer to the source bytes, may point to code memory
+//   3) U16 numbytes - the number of bytes to write
+//                    <addr> + <numbytes> must not cross a page boundary
+//
+// This routine writes <numbytes> from <src> to the linear FLASH address
+// <addr>. The result is the same as calling FLASH_ByteWrite() for each
+// byte, but the VDD monitor is set up and allowed to settle once for the
+// whole run instead of once per byte. See FLASH_BlockRun().
+//-----------------------------------------------------------------------------
+
+U8 FLASH_BlockWrite (FLADDR addr, U8 *src, U16 numbytes)
+{
+   return FLASH_BlockRun (addr, src, 1, numbytes);
+}
+
+//-----------------------------------------------------------------------------
+// FLASH_BlockFill
+//-----------------------------------------------------------------------------
+//
+// Return Value :
+//   0 if Write unsuccessful, 1 if Write successful
+//
+// Parameters   :
+//   1) FLADDR addr - address of the first byte to write to
+//                    valid range is 0x0000 to 0x7BFF for 32K Flash devices
+//                    valid range is 0x0000 to 0x3FFF for 16K Flash devices
+//   2) U8 fill - the value written to every byte
+//   3) U16 numbytes - the number of bytes to write
+//                    <addr> + <numbytes> must not cross a page boundary
+//
+// This routine writes <fill> to <numbytes> bytes from the linear FLASH
+// address <addr>, with one VDD monitor setup as FLASH_BlockWrite().
+//-----------------------------------------------------------------------------
+
+U8 FLASH_BlockFill (FLADDR addr, U8 fill, U16 numbytes)
+{
+   return FLASH_BlockRun (addr, &fill, 0, numbytes);
+}
+
 //-----------------------------------------------------------------------------
 // FLASH_ByteRead
 //-----------------------------------------------------------------------------
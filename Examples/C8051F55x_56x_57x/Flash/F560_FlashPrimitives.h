@@ -55,11 +55,17 @@ typedef U16 FLADDR;
 //#define FLASH_LAST 0x3E00L           // For 16K Flash devices
 #endif
 
+#ifndef FLASH_BURST
+#define FLASH_BURST 16                 // Bytes written by FLASH_BlockWrite
+#endif                                 // with interrupts disabled
+
 //-----------------------------------------------------------------------------
 // Exported Function Prototypes
 //-----------------------------------------------------------------------------
 
 U8   FLASH_ByteWrite (FLADDR addr, U8 byte);
+U8   FLASH_BlockWrite (FLADDR addr, U8 *src, U16 numbytes);
+U8   FLASH_BlockFill (FLADDR addr, U8 fill, U16 numbytes);
 U8   FLASH_ByteRead  (FLADDR addr);
 U8   FLASH_PageErase (FLADDR addr);
 
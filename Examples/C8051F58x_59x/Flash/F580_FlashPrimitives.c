@@ -34,12 +34,21 @@
 // Global Constants
 //-----------------------------------------------------------------------------
 
+// Source of the bytes written by FLASH_BlockRun()
+#define BLOCK_WRITE 0                  // <src> points to the bytes
+#define BLOCK_FILL  1                  // <src> points to one byte, repeated
+#define BLOCK_COPY  2                  // Read from Flash at <from>
+
 //-----------------------------------------------------------------------------
 // Function Prototypes
 //-----------------------------------------------------------------------------
 
 // FLASH read/write/erase routines
 U8   FLASH_ByteWrite (FLADDR addr, U8 byte, bit SFLE);
+U8   FLASH_BlockWrite (FLADDR addr, U8 *src, U16 numbytes, bit SFLE);
+U8   FLASH_BlockFill (FLADDR addr, U8 fill, U16 numbytes, bit SFLE);
+U8   FLASH_BlockCopy (FLADDR dest, bit destSFLE, FLADDR src, bit srcSFLE,
+                      U16 numbytes);
 U8   FLASH_ByteRead  (FLADDR addr, bit SFLE);
 U8   FLASH_PageErase (FLADDR addr, bit SFLE);
 
@@ -143,6 +152,188 @@ U8 FLASH_ByteWrite (FLADDR addr, U8 byte, bit SFLE)
    return 1;
 }
 
+//-----------------------------------------------------------------------------
+// FLASH_BlockRun
+//-----------------------------------------------------------------------------
+//
+// Writes <numbytes> to the linear FLASH address <addr>, within one page,
+// for FLASH_BlockWrite(), FLASH_BlockFill() and FLASH_BlockCopy(). <mode>
+// selects the source of the bytes:
+//
+//    BLOCK_WRITE - the bytes at <src>
+//    BLOCK_FILL  - the byte at <src>, <numbytes> times
+//    BLOCK_COPY  - the bytes at the linear FLASH address <from> (in the
+//                  scratchpad if <fromSFLE>). Each burst is read into a
+//                  buffer of FLASH_BURST bytes before it is written.
+//
+// The VDD monitor is set up and allowed to settle once for the whole run.
+// FLKEY locks again after each write, so the key sequence is written before
+// every byte. Interrupts must stay disabled while PSWE is set, because a
+// MOVX write in an interrupt would write to Flash. Interrupts are enabled
+// again for a few cycles after every FLASH_BURST bytes, with PSBANK and
+// SFLE restored, so the interrupt latency does not grow with <numbytes>.
+// Interrupt routines must not write or erase Flash.
+//-----------------------------------------------------------------------------
+static U8 FLASH_BlockRun (FLADDR addr, U8 *src, U16 numbytes, bit SFLE,
+                          U8 mode, FLADDR from, bit fromSFLE)
+{
+   S8 SFRPAGE_SAVE = SFRPAGE;          // Preserve SFRPAGE
+   bit EA_SAVE = EA;                   // Preserve EA
+   S8 PSBANK_SAVE = PSBANK;            // Preserve PSBANK
+   S8 PSBANK_WRITE;                    // PSBANK for the bank written
+   S8 xdata * data pwrite;             // FLASH write pointer
+   U8 i;
+   U8 burst;                           // Bytes left in this burst
+   U8 step = 1;                        // Source bytes per byte written
+   U8 buffer[FLASH_BURST];             // Source bytes of a BLOCK_COPY burst
+   U8 status = 1;
+
+   if (numbytes == 0) {
+      return 1;
+   }
+
+   EA = 0;                             // Disable interrupts
+
+   SFRPAGE = ACTIVE_PAGE;
+
+   if (mode == BLOCK_FILL) {
+      step = 0;
+   }
+
+   PSBANK_WRITE = PSBANK_SAVE;
+
+   if (addr < 0x10000) {               // 64K linear address
+      pwrite = (S8 xdata *) addr;
+   } else if (addr < 0x18000) {        // BANK 2
+      addr |= 0x8000;
+      pwrite = (S8 xdata *) addr;
+      PSBANK_WRITE &= ~0x30;           // COBANK = 0x2
+      PSBANK_WRITE |=  0x20;
+   } else {                            // BANK 3
+      pwrite = (S8 xdata *) addr;
+      PSBANK_WRITE &= ~0x30;           // COBANK = 0x3
+      PSBANK_WRITE |=  0x30;
+   }
+
+   RSTSRC = 0x00;                      // 1. Disable VDD monitor as a reset source
+
+   VDM0CN = 0xA0;                      // 2. Enable VDD monitor and high threshold
+
+   for (i = 0; i < 255; i++) {}        // 3. Wait for VDD monitor to stabilize
+
+   while (numbytes) {
+
+      burst = FLASH_BURST;
+      if (numbytes < FLASH_BURST) {
+         burst = (U8) numbytes;
+      }
+      numbytes -= burst;
+
+      if (mode == BLOCK_COPY) {        // Read the burst while PSBANK and
+         for (i = 0; i < burst; i++) { // SFLE are restored
+            buffer[i] = FLASH_ByteRead (from++, fromSFLE);
+         }
+         src = buffer;
+      }
+
+      if (!(VDM0CN & 0x40)) {          // 4. If the VDD voltage is not high
+         status = 0;                   //    enough don't write to Flash
+         break;
+      }
+
+      RSTSRC = 0x02;                   // 5. Safe to enable VDD Monitor as a
+                                       //    reset source
+
+      PSBANK = PSBANK_WRITE;
+
+      PSCTL |= 0x01;                   // 6. PSWE = 1
+
+      if (SFLE) {
+         PSCTL |= 0x04;                // Set SFLE
+      }
+
+      do {
+         FLKEY  = 0xA5;                // Key Sequence 1
+         FLKEY  = 0xF1;                // Key Sequence 2
+
+         *pwrite++ = *src;             // 9. Write the byte
+         src += step;
+      } while (--burst);
+
+      if (SFLE) {
+         PSCTL &= ~0x04;               // Clear SFLE
+      }
+      PSCTL &= ~0x01;                  // PSWE = 0
+
+      PSBANK = PSBANK_SAVE;
+
+      EA = EA_SAVE;                    // Let pending interrupts run
+      NOP();
+      NOP();
+      EA = 0;
+   }
+
+   RSTSRC = 0x00;                      // 10. Disable the VDD monitor as reset
+                                       //     source
+   VDM0CN = 0x80;                      // 11. Change VDD Monitor to low threshold
+   RSTSRC = 0x02;                      // 12. Re-enable the VDD monitor as a
+                                       //     reset source
+
+   SFRPAGE = SFRPAGE_SAVE;             // Restore SFRPAGE
+   EA      = EA_SAVE;                  // Restore interrupts
+
+   return status;
+}
+
+//-----------------------------------------------------------------------------
+// FLASH_BlockWrite
+//-----------------------------------------------------------------------------
+//
+// This routine writes <numbytes> from <src> to the linear FLASH address
+// <addr>, with the same address decoding as FLASH_ByteWrite(). The bytes
+// must not cross a page boundary, so they are all in one bank. The
+// result is the same as calling FLASH_ByteWrite() for each byte, but the
+// VDD monitor is set up and allowed to settle once for the whole run
+// instead of once per byte. Returns 0 if the VDD voltage is too low.
+//
+// <src> must not point to the banked code area or to the scratchpad, as
+// PSBANK and SFLE are changed while the bytes are read. Use
+// FLASH_BlockCopy() for those.
+//-----------------------------------------------------------------------------
+U8 FLASH_BlockWrite (FLADDR addr, U8 *src, U16 numbytes, bit SFLE)
+{
+   return FLASH_BlockRun (addr, src, numbytes, SFLE, BLOCK_WRITE, 0, 0);
+}
+
+//-----------------------------------------------------------------------------
+// FLASH_BlockFill
+//-----------------------------------------------------------------------------
+//
+// This routine writes <fill> to <numbytes> bytes from the linear FLASH
+// address <addr>, within one page, as FLASH_BlockWrite().
+//
+//-----------------------------------------------------------------------------
+U8 FLASH_BlockFill (FLADDR addr, U8 fill, U16 numbytes, bit SFLE)
+{
+   return FLASH_BlockRun (addr, &fill, numbytes, SFLE, BLOCK_FILL, 0, 0);
+}
+
+//-----------------------------------------------------------------------------
+// FLASH_BlockCopy
+//-----------------------------------------------------------------------------
+//
+// This routine copies <numbytes> from the linear FLASH address <src> to
+// <dest>, as FLASH_BlockWrite(). The destination bytes must not cross a
+// page boundary. The source may be in any bank or in the scratchpad.
+//
+//-----------------------------------------------------------------------------
+U8 FLASH_BlockCopy (FLADDR dest, bit destSFLE, FLADDR src, bit srcSFLE,
+                    U16 numbytes)
+{
+   return FLASH_BlockRun (dest, 0, numbytes, destSFLE, BLOCK_COPY, src,
+                          srcSFLE);
+}
+
 //-----------------------------------------------------------------------------
 // FLASH_ByteRead
 //-----------------------------------------------------------------------------
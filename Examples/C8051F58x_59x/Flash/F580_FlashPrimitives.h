@@ -41,6 +41,10 @@
 #define FLASH_SCRATCHSIZE 256
 #endif
 
+#ifndef FLASH_BURST
+#define FLASH_BURST 16                 // Bytes written by FLASH_BlockWrite
+#endif                                 // with interrupts disabled
+
 //---------------------
 
 #if (FLASH_SIZE == 128)
@@ -81,6 +85,10 @@ typedef U32 FLADDR;                    // Allows for 17-bit address
 // FLASH read/write/erase routines
 
 U8   FLASH_ByteWrite (FLADDR addr, U8 byte, bit SFLE);
+U8   FLASH_BlockWrite (FLADDR addr, U8 *src, U16 numbytes, bit SFLE);
+U8   FLASH_BlockFill (FLADDR addr, U8 fill, U16 numbytes, bit SFLE);
+U8   FLASH_BlockCopy (FLADDR dest, bit destSFLE, FLADDR src, bit srcSFLE,
+                      U16 numbytes);
 U8   FLASH_ByteRead  (FLADDR addr, bit SFLE);
 U8   FLASH_PageErase (FLADDR addr, bit SFLE);
 
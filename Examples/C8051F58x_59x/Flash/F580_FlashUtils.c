@@ -198,15 +198,35 @@ void FLASH_Update (FLADDR dest, U8 *src, U16 numbytes, bit SFLE)
 //-----------------------------------------------------------------------------
 //
 // This routine copies <numbytes> from <src> to the linear FLASH address
-// <dest>.
+// <dest>, with one FLASH_BlockWrite() call for each Flash page (or the
+// scratchpad) that the bytes cover.
 //
 //-----------------------------------------------------------------------------
 void FLASH_Write (FLADDR dest, U8 *src, U16 numbytes, bit SFLE)
 {
-   U32 i;
+   U16 FLASH_pagesize;                 // Size of FLASH page to write
+   U16 length;
+
+   FLASH_pagesize = FLASH_PAGESIZE;
+
+   if (SFLE) {                         // Scratchpad sector
+      FLASH_pagesize = FLASH_SCRATCHSIZE;
+   }
+
+   while (numbytes) {
 
-   for (i = dest; i < dest+numbytes; i++) {
-      FLASH_ByteWrite (i, *src++, SFLE);
+      // Bytes from <dest> to the end of its page
+      length = FLASH_pagesize - (U16) (dest & (FLASH_pagesize - 1));
+
+      if (length > numbytes) {
+         length = numbytes;
+      }
+
+      FLASH_BlockWrite (dest, src, length, SFLE);
+
+      dest += length;
+      src += length;
+      numbytes -= length;
    }
 }
 
@@ -233,19 +253,37 @@ U8 * FLASH_Read (U8 *dest, FLADDR src, U16 numbytes, bit SFLE)
 //-----------------------------------------------------------------------------
 //
 // This routine copies <numbytes> from <src> to the linear FLASH address
-// <dest>.
+// <dest>, with one FLASH_BlockCopy() call for each Flash page (or the
+// scratchpad) that the destination bytes cover. The source may be in
+// another bank or in the scratchpad.
 //
 //-----------------------------------------------------------------------------
 void FLASH_Copy (FLADDR dest, bit destSFLE, FLADDR src, bit srcSFLE,
                  U16 numbytes)
 {
-   U32 i;
+   U16 FLASH_pagesize;                 // Size of FLASH page to write
+   U16 length;
 
-   for (i = 0; i < numbytes; i++) {
+   FLASH_pagesize = FLASH_PAGESIZE;
 
-      FLASH_ByteWrite ((FLADDR) dest+i,
-                       FLASH_ByteRead((FLADDR) src+i, srcSFLE),
-                       destSFLE);
+   if (destSFLE) {                     // Scratchpad sector
+      FLASH_pagesize = FLASH_SCRATCHSIZE;
+   }
+
+   while (numbytes) {
+
+      // Bytes from <dest> to the end of its page
+      length = FLASH_pagesize - (U16) (dest & (FLASH_pagesize - 1));
+
+      if (length > numbytes) {
+         length = numbytes;
+      }
+
+      FLASH_BlockCopy (dest, destSFLE, src, srcSFLE, length);
+
+      dest += length;
+      src += length;
+      numbytes -= length;
    }
 }
 
@@ -254,15 +292,35 @@ void FLASH_Copy (FLADDR dest, bit destSFLE, FLADDR src, bit srcSFLE,
 // FLASH_Fill
 //-----------------------------------------------------------------------------
 //
-// This routine fills the FLASH beginning at <addr> with <lenght> bytes.
+// This routine fills the FLASH beginning at <addr> with <lenght> bytes,
+// with one FLASH_BlockFill() call for each Flash page (or the scratchpad)
+// that the bytes cover.
 //
 //-----------------------------------------------------------------------------
 void FLASH_Fill (FLADDR addr, U32 length, U8 fill, bit SFLE)
 {
-   U32 i;
+   U16 FLASH_pagesize;                 // Size of FLASH page to write
+   U16 count;
+
+   FLASH_pagesize = FLASH_PAGESIZE;
+
+   if (SFLE) {                         // Scratchpad sector
+      FLASH_pagesize = FLASH_SCRATCHSIZE;
+   }
+
+   while (length) {
+
+      // Bytes from <addr> to the end of its page
+      count = FLASH_pagesize - (U16) (addr & (FLASH_pagesize - 1));
+
+      if (count > length) {
+         count = (U16) length;
+      }
+
+      FLASH_BlockFill (addr, fill, count, SFLE);
 
-   for (i = 0; i < length; i++) {
-      FLASH_ByteWrite (addr+i, fill, SFLE);
+      addr += count;
+      length -= count;
    }
 }
 
@@ -14,6 +14,15 @@
 // out of reset, the EEPROM is read.  The UART outputs the bytes written to
 // or read from the EEPROM.
 //
+// EEPROM_RAMWrite() marks the bytes it changes in a dirty bitmap.
+// EEPROM_Sync() commits the RAM buffer only if a byte changed since the
+// last commit, and EEPROM_Tick() commits it EEPROM_COMMIT_DEADLINE calls
+// after the first change, so that frequent updates of the same values are
+// combined into one commit. The device always writes all 32 bytes in a
+// commit, so the bitmap saves whole commits, not bytes. The RAM is compared
+// with its own contents, so it must be loaded from the EEPROM with
+// EEPROM_CopyEEPROMToRAM() before it is written.
+//
 // How to test:
 //
 // 1) Connect a USB cable from the development board to a PC
@@ -50,6 +59,10 @@
 
 #define EEPROM_CAPACITY    32
 
+#ifndef EEPROM_COMMIT_DEADLINE
+#define EEPROM_COMMIT_DEADLINE 100     // EEPROM_Tick() calls from the first
+#endif                                 // change to the commit
+
 #define  LED_ON             0
 #define  LED_OFF            1
 
@@ -77,6 +90,16 @@ void EEPROM_RAMWrite (U8 address, U8 value);
 U8 EEPROM_RAMRead (U8 address);
 U8 EEPROM_CopyRAMToEEPROM (void);
 U8 EEPROM_CopyEEPROMToRAM (void);
+U8 EEPROM_Sync (void);
+U8 EEPROM_Tick (void);
+
+//-----------------------------------------------------------------------------
+// Global Variables
+//-----------------------------------------------------------------------------
+
+U8 EEPROM_Dirty[EEPROM_CAPACITY / 8];  // One bit per byte changed in RAM
+                                       // since the last commit
+U8 EEPROM_Countdown;                   // EEPROM_Tick() calls to the commit
 
 
 //-----------------------------------------------------------------------------
@@ -110,6 +133,8 @@ void main (void)
 
    Delay_ms (200);
 
+   EEPROM_CopyEEPROMToRAM();        // Start from the EEPROM contents
+
    for (address = 0; address < EEPROM_CAPACITY; address++)
    {
       test_byte = address;
@@ -125,7 +150,7 @@ void main (void)
          printf ("%02bx ", (U8)test_byte);
 
    }
-   EEPROM_CopyRAMToEEPROM();        // Writes RAM values to EEPROM
+   EEPROM_Sync();                   // Writes changed RAM values to EEPROM
 
 
    EEPROM_CopyEEPROMToRAM();        // Moves EEPROM values into RAM
@@ -424,7 +449,9 @@ void Delay_ms (U8 time_ms)
 //                2. value - the value to write.
 //                   range: 0x00 to 0xFF
 //
-// 
+// Writes one byte to the EEPROM-space RAM. If the byte changes, it is
+// marked in EEPROM_Dirty and, for the first change after a commit, the
+// EEPROM_Tick() deadline is started.
 //
 //-----------------------------------------------------------------------------
 void EEPROM_RAMWrite (U8 address, U8 value)
@@ -435,7 +462,19 @@ void EEPROM_RAMWrite (U8 address, U8 value)
    SFRPAGE = LEGACY_PAGE;
 
    EEADDR = address;
-   EEDATA = value;
+
+   if (EEDATA != value)
+   {
+      EEADDR = address;                // Again, in case the read advanced it
+      EEDATA = value;
+
+      if (EEPROM_Countdown == 0)
+      {
+         EEPROM_Countdown = EEPROM_COMMIT_DEADLINE;
+      }
+
+      EEPROM_Dirty[address >> 3] |= (U8) (1 << (address & 0x07));
+   }
 
    SFRPAGE = SFRPAGE_save;
 }
@@ -478,12 +517,14 @@ U8 EEPROM_RAMRead (U8 address)
 //                11b = Write/Erase locked
 // Parameters   : None
 //
-// Writes 32 bytes of EEPROM-space RAM to non-volatile EEPROM.
+// Writes 32 bytes of EEPROM-space RAM to non-volatile EEPROM. The dirty
+// bitmap is cleared unless the EEPROM is locked.
 //
 //-----------------------------------------------------------------------------
 U8 EEPROM_CopyRAMToEEPROM (void)
 {
    U8 retval;
+   U8 i;
    // Save the current SFRPAGE
    U8 SFRPAGE_save = SFRPAGE;
 
@@ -515,6 +556,16 @@ U8 EEPROM_CopyRAMToEEPROM (void)
 
    SFRPAGE = SFRPAGE_save;
 
+   if (retval != 0x03)
+   {
+      for (i = 0; i < sizeof (EEPROM_Dirty); i++)
+      {
+         EEPROM_Dirty[i] = 0;
+      }
+
+      EEPROM_Countdown = 0;
+   }
+
    return retval;
 }
 
@@ -527,13 +578,15 @@ U8 EEPROM_CopyRAMToEEPROM (void)
 //                11b = Write/Erase locked
 // Parameters   : None
 //
-// Copies non-volatile 32-byte on-chip EEPROM into EEPROM-space RAM.
+// Copies non-volatile 32-byte on-chip EEPROM into EEPROM-space RAM and
+// clears the dirty bitmap.
 //
 //-----------------------------------------------------------------------------
 U8 EEPROM_CopyEEPROMToRAM (void)
 {
 
    U8 retval;
+   U8 i;
    // Save the current SFRPAGE
    U8 SFRPAGE_save = SFRPAGE;
 
@@ -545,8 +598,73 @@ U8 EEPROM_CopyEEPROMToRAM (void)
 
    SFRPAGE = SFRPAGE_save;
 
+   for (i = 0; i < sizeof (EEPROM_Dirty); i++)
+   {
+      EEPROM_Dirty[i] = 0;             // RAM matches the EEPROM again
+   }
+
+   EEPROM_Countdown = 0;
+
    return retval;
 }
+
+//-----------------------------------------------------------------------------
+// EEPROM_Sync
+//-----------------------------------------------------------------------------
+//
+// Return Value : 1 if the RAM was written to EEPROM, 0 if no byte changed
+//                since the last commit or the EEPROM is locked
+// Parameters   : None
+//
+// Writes the EEPROM-space RAM to non-volatile EEPROM if EEPROM_RAMWrite()
+// changed a byte since the last commit.
+//
+//-----------------------------------------------------------------------------
+U8 EEPROM_Sync (void)
+{
+   U8 i;
+   U8 dirty = 0;
+
+   for (i = 0; i < sizeof (EEPROM_Dirty); i++)
+   {
+      dirty |= EEPROM_Dirty[i];
+   }
+
+   if (dirty == 0)
+   {
+      return 0;                        // Nothing to commit
+   }
+
+   return (EEPROM_CopyRAMToEEPROM () != 0x03);
+}
+
+//-----------------------------------------------------------------------------
+// EEPROM_Tick
+//-----------------------------------------------------------------------------
+//
+// Return Value : 1 if the RAM was written to EEPROM by this call, 0 otherwise
+// Parameters   : None
+//
+// This routine should be called at a fixed interval, for example on each
+// Timer2 overflow polled in the main loop. The changed RAM is written to
+// EEPROM on the EEPROM_COMMIT_DEADLINE call after its first change, so
+// all the changes made in that time take one commit.
+//
+//-----------------------------------------------------------------------------
+U8 EEPROM_Tick (void)
+{
+   if (EEPROM_Countdown == 0)
+   {
+      return 0;                        // Nothing changed
+   }
+
+   if (--EEPROM_Countdown)
+   {
+      return 0;
+   }
+
+   return EEPROM_Sync ();
+}
 //-----------------------------------------------------------------------------
 // End Of File
 //-----------------------------------------------------------------------------
@@ -18,6 +18,15 @@
 // Depending on the count, it can be determined whether SW3 is being touched
 // or not. 
 //
+// The calibration value is kept in a ring of 4-byte records in the
+// scratchpad: [value MSB][value LSB][CRC MSB][CRC LSB], with the CRC-16 of
+// the value computed by CRC0. Each calibration appends a record after the
+// last one, so the scratchpad is erased only once every 128 calibrations,
+// when the ring is full. At reset, Calibration_Init() finds the latest
+// record with a valid CRC and caches its offset and value; a record torn
+// by a reset during the write fails the CRC and is skipped.
+// Get_Calibration() returns the cached value without reading Flash.
+//
 //
 // How To Test:
 //
@@ -89,8 +98,13 @@ SBIT (SW3,        SFR_P0, 3);          // SW3 == 0 means switch pressed
                                        // Touch Sense switches. Larger values
                                        // make the switches more sensitive
 
-#define CAL_ADDRESS         0          // Address in the scratchpad to store
-                                       // the calibrated switch value
+#define CAL_ADDRESS         0          // Address in the scratchpad of the
+                                       // calibration record ring
+
+#define SCRATCHPAD_SIZE   512          // Bytes in the scratchpad page
+#define CAL_RECORD_SIZE     4          // Value and CRC-16, MSB first
+#define CAL_NONE       0xFFFF          // Offset and value when no valid
+                                       // calibration record is found
 
 #define SCRATCHPAD          1          // Passed to the Flash access routines
                                        // to indicate that the calibration
@@ -108,6 +122,12 @@ UU16 SW11_Timer_Count;
 U8 SW10_Status;     
 U8 SW11_Status; 
 
+// Calibration record ring
+U16 Cal_Record;                        // Offset of the latest valid record,
+                                       // CAL_NONE if none
+U16 Cal_Next;                          // Offset of the first erased record
+UU16 Cal_Value;                        // Value of the latest valid record
+
 //-----------------------------------------------------------------------------
 // Function PROTOTYPES
 //-----------------------------------------------------------------------------
@@ -121,6 +141,12 @@ void TouchSense_Update(void);
 void Calibrate (void);
 U16 Get_Calibration(void);
 
+// Calibration record ring routines
+void Calibration_Init (void);
+void Calibration_Write (U16 value);
+U8   Calibration_Read (U16 offset, UU16 *value);
+U16  Calibration_Crc (UU16 value);
+
 // FLASH read/write/erase routines
 void FLASH_ByteWrite (U16 addr, U8 byte, U8 SFLE);
 U8   FLASH_ByteRead  (U16 addr, U8 SFLE);
@@ -142,6 +168,9 @@ void main (void)
    TouchSense_Init();                  // Initialize Comparator0 and 
                                        // Timer2 for use with TouchSense
    
+   Calibration_Init();                 // Find the latest calibration
+                                       // record in the scratchpad
+
    if( Get_Calibration() == 0xFFFF)
    {
       Calibrate ();
@@ -184,6 +213,7 @@ void TouchSense_Update (void)
 {  
    
    UU16 timer_count_A, timer_count_B;
+   U16 threshold;
 
    // Prepare Timer2 for the first TouchSense reading
    TMR2CN &= ~0x80;                    // Clear overflow flag
@@ -219,8 +249,10 @@ void TouchSense_Update (void)
    CPT0MX = 0xC4;                      // Positive Mux: P2.0 - TouchSense Switch
                                        // Negative Mux: TouchSense Compare
 
+   threshold = Get_Calibration() - SW11_SENSITIVITY;
+
    // Update the status variable for SW20
-   if(SW10_Timer_Count.U16 > (Get_Calibration() - SW11_SENSITIVITY))
+   if(SW10_Timer_Count.U16 > threshold)
    {
       SW10_Status = 0;
    
@@ -229,7 +261,7 @@ void TouchSense_Update (void)
       SW10_Status = 1;
    }
    // Update the status variable for SW21   
-   if(SW11_Timer_Count.U16 > (Get_Calibration() - SW11_SENSITIVITY))
+   if(SW11_Timer_Count.U16 > threshold)
    {
       SW11_Status = 0;
    
@@ -327,22 +359,14 @@ void Calibrate (void)
    
    TouchSense_Update();                // Update switch variables
    
-   // Erase the scratchpad
-   FLASH_PageErase (CAL_ADDRESS, SCRATCHPAD);   
-
-   
+   // Append the expected switch value to the scratchpad
    if(switch_number == 0)
    {
-      // Write the expected switch value to the scratchpad
-      FLASH_ByteWrite ((U16)(CAL_ADDRESS+MSB), SW10_Timer_Count.U8[MSB], SCRATCHPAD);
-      FLASH_ByteWrite ((U16)(CAL_ADDRESS+LSB), SW10_Timer_Count.U8[LSB], SCRATCHPAD);
+      Calibration_Write (SW10_Timer_Count.U16);
    
    } else
    {
-
-      // Write the expected switch value to the scratchpad
-      FLASH_ByteWrite ((U16)(CAL_ADDRESS+MSB), SW11_Timer_Count.U8[MSB], SCRATCHPAD);
-      FLASH_ByteWrite ((U16)(CAL_ADDRESS+LSB), SW11_Timer_Count.U8[LSB], SCRATCHPAD);
+      Calibration_Write (SW11_Timer_Count.U16);
    }
    
    if ((EA_Save & 0x80) != 0)          // Restore EA
@@ -360,17 +384,169 @@ void Calibrate (void)
 //                        range is full range of integer: 0 to 65335
 // Parameters: None
 //
-// This routine reads the calibration value from Flash
+// This routine returns the value of the latest calibration record, cached
+// by Calibration_Init() and Calibration_Write(). It returns 0xFFFF if the
+// scratchpad holds no valid record.
 //-----------------------------------------------------------------------------
 U16 Get_Calibration(void)
 {
-   UU16 cal_value;   
+   return Cal_Value.U16;
+}
 
-   cal_value.U8[MSB] = FLASH_ByteRead ((U16)(CAL_ADDRESS+MSB),  SCRATCHPAD);
-   cal_value.U8[LSB] = FLASH_ByteRead ((U16)(CAL_ADDRESS+LSB),  SCRATCHPAD);
-   
-   return cal_value.U16;
 
+//-----------------------------------------------------------------------------
+// Calibration Record Subroutines
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// Calibration_Init
+//-----------------------------------------------------------------------------
+//
+// Return Value : None
+// Parameters   : None
+//
+// This routine scans the record ring up to the first erased record and
+// caches the offset and value of the last record with a valid CRC, and the
+// offset where the next record will be written.
+//-----------------------------------------------------------------------------
+void Calibration_Init (void)
+{
+   UU16 value;
+   U16 offset;
+   U8 i;
+   U8 erased;
+
+   Cal_Record = CAL_NONE;
+   Cal_Value.U16 = CAL_NONE;
+
+   for (offset = 0; offset <= (SCRATCHPAD_SIZE - CAL_RECORD_SIZE);
+        offset += CAL_RECORD_SIZE)
+   {
+      erased = 1;
+
+      for (i = 0; i < CAL_RECORD_SIZE; i++)
+      {
+         if (FLASH_ByteRead ((U16)(CAL_ADDRESS+offset+i), SCRATCHPAD) != 0xFF)
+         {
+            erased = 0;
+         }
+      }
+
+      if (erased)
+      {
+         break;                        // End of the ring
+      }
+
+      if (Calibration_Read (offset, &value))
+      {
+         Cal_Record = offset;
+         Cal_Value.U16 = value.U16;
+      }
+   }
+
+   Cal_Next = offset;
+}
+
+//-----------------------------------------------------------------------------
+// Calibration_Write
+//-----------------------------------------------------------------------------
+//
+// Return Value : None
+// Parameters   :
+//   1) U16 value - calibration value to store
+//
+// This routine appends a record holding <value> to the ring. If the ring is
+// full, the scratchpad is erased first and the record is written at the
+// start. The cached value is updated only if the record reads back with a
+// valid CRC.
+//-----------------------------------------------------------------------------
+void Calibration_Write (U16 value)
+{
+   UU16 record;
+   UU16 crc;
+
+   if (Cal_Next > (SCRATCHPAD_SIZE - CAL_RECORD_SIZE))
+   {
+      FLASH_PageErase (CAL_ADDRESS, SCRATCHPAD);
+      Cal_Next = 0;
+      Cal_Record = CAL_NONE;
+      Cal_Value.U16 = CAL_NONE;
+   }
+
+   record.U16 = value;
+   crc.U16 = Calibration_Crc (record);
+
+   FLASH_ByteWrite ((U16)(CAL_ADDRESS+Cal_Next), record.U8[MSB], SCRATCHPAD);
+   FLASH_ByteWrite ((U16)(CAL_ADDRESS+Cal_Next+1), record.U8[LSB], SCRATCHPAD);
+   FLASH_ByteWrite ((U16)(CAL_ADDRESS+Cal_Next+2), crc.U8[MSB], SCRATCHPAD);
+   FLASH_ByteWrite ((U16)(CAL_ADDRESS+Cal_Next+3), crc.U8[LSB], SCRATCHPAD);
+
+   if (Calibration_Read (Cal_Next, &record))
+   {
+      Cal_Record = Cal_Next;
+      Cal_Value.U16 = record.U16;
+   }
+
+   Cal_Next += CAL_RECORD_SIZE;
+}
+
+//-----------------------------------------------------------------------------
+// Calibration_Read
+//-----------------------------------------------------------------------------
+//
+// Return Value :
+//   1) U8 - 1 if the record has a valid CRC, 0 if not
+// Parameters   :
+//   1) U16 offset - offset of the record in the ring
+//   2) UU16 *value - returns the value of the record
+//
+// This routine reads the record at <offset> and checks its CRC.
+//-----------------------------------------------------------------------------
+U8 Calibration_Read (U16 offset, UU16 *value)
+{
+   UU16 crc;
+
+   (*value).U8[MSB] = FLASH_ByteRead ((U16)(CAL_ADDRESS+offset), SCRATCHPAD);
+   (*value).U8[LSB] = FLASH_ByteRead ((U16)(CAL_ADDRESS+offset+1), SCRATCHPAD);
+   crc.U8[MSB] = FLASH_ByteRead ((U16)(CAL_ADDRESS+offset+2), SCRATCHPAD);
+   crc.U8[LSB] = FLASH_ByteRead ((U16)(CAL_ADDRESS+offset+3), SCRATCHPAD);
+
+   return (crc.U16 == Calibration_Crc (*value));
+}
+
+//-----------------------------------------------------------------------------
+// Calibration_Crc
+//-----------------------------------------------------------------------------
+//
+// Return Value :
+//   1) U16 - CRC-16 of the two bytes of <value>, MSB first
+// Parameters   :
+//   1) UU16 value - calibration value
+//
+// This routine computes the CRC with CRC0 in 16-bit mode, with an initial
+// value of 0. An erased record (0xFFFF, 0xFFFF) does not have a valid CRC.
+//-----------------------------------------------------------------------------
+U16 Calibration_Crc (UU16 value)
+{
+   UU16 crc;
+   U8 SFRPAGE_SAVE = SFRPAGE;          // Save Current SFR page
+
+   SFRPAGE = CRC0_PAGE;                // Set to CRC Page
+
+   CRC0CN = 0x18;                      // CRC0SEL = 1 (16-bit calc);
+                                       // initialize the result to 0x0000
+
+   CRC0IN = value.U8[MSB];
+   CRC0IN = value.U8[LSB];
+
+   CRC0CN &= ~0x03;                    // Access bits 7-0 of the result;
+                                       // CRC0PNT increments on each read
+   crc.U8[LSB] = CRC0DAT;
+   crc.U8[MSB] = CRC0DAT;
+
+   SFRPAGE = SFRPAGE_SAVE;             // Restore SFRPAGE
+
+   return crc.U16;
 }
 
 
@@ -0,0 +1,473 @@
+//-----------------------------------------------------------------------------
+// F96x_CRC0_Background.c
+//-----------------------------------------------------------------------------
+// Copyright (C) 2011 Silicon Laboratories, Inc.
+// http://www.silabs.com
+//
+// Program Description:
+//
+// This program shows how to verify the code Flash image in the background
+// using the CRC engine in the manual mode. The image is checked a few
+// bytes at a time, so the self test never stalls the main loop for longer
+// than one step.
+//
+// The image covers IMAGE_PAGES Flash pages starting at address 0. The last
+// two bytes of the image hold the 16-bit CRC of the rest of the image, MSB
+// first. As in F96x_CRC0.c, the CRC of the whole image including these two
+// bytes is then 0.
+//
+// FlashCheck_Step() is called once per Timer2 tick from the main loop. Each
+// call feeds FLASH_CHECK_BYTES_PER_STEP bytes to the CRC engine and saves
+// the partial result, so the CRC engine may be used for other work between
+// steps. When the whole image has been covered the step returns the
+// verdict and the next step starts a new pass.
+//
+// If the signature bytes are still erased when the program starts, the
+// signature is computed and written once, as a programmer would do after
+// downloading the image. The last page must not hold code or constants
+// other than the signature.
+//
+// NOTE: The worst case time of one step is set by
+//       FLASH_CHECK_BYTES_PER_STEP. Each byte takes about 10 SYSCLK cycles
+//       plus about 60 cycles per step. With 64 bytes per step this is
+//       about 700 cycles, or 280 us at 2.5 MHz, and a 16 kB image is
+//       checked in 256 steps.
+//
+// How To Test:
+//
+// 1) Check that hardware definitions match the actual hardware.
+// 2) Download code to the target board
+// 3) Run the program.  LED1 toggles after each pass that is correct.
+//                      If the  LED2 is ON, a CRC error was detected.
+//
+//
+// Target:         F96x
+// Tool chain:     Keil ,Raisonance, SDCC
+// Command Line:   None
+//
+// Release 1.0
+//    -Initial Revision
+//
+//-----------------------------------------------------------------------------
+// Includes
+//-----------------------------------------------------------------------------
+#include <compiler_defs.h>             // compiler declarations
+#include <C8051F960_defs.h>               // SFR declarations
+//-----------------------------------------------------------------------------
+// Define Hardware
+//-----------------------------------------------------------------------------
+#define UDP_F960_MCU_MUX_LCD
+//#define UDP_F960_MCU_EMIF
+//-----------------------------------------------------------------------------
+// Hardware Dependent definitions
+//-----------------------------------------------------------------------------
+#ifdef UDP_F960_MCU_MUX_LCD
+SBIT (LED1, SFR_P0, 0);
+SBIT (LED2, SFR_P0, 1);
+#endif
+
+#ifdef UDP_F960_MCU_EMIF
+SBIT (LED1, SFR_P3, 0);
+SBIT (LED2, SFR_P3, 1);
+#endif
+
+//-----------------------------------------------------------------------------
+// Global CONSTANTS
+//-----------------------------------------------------------------------------
+
+#define SYSCLK            20000000/8   // SYSCLK frequency in Hz
+
+#define TIMER_PRESCALER   12           // Based on Timer2 CKCON and TMR2CN
+                                       // settings
+
+#define TICK_RATE         10           // Main loop tick in milliseconds
+
+#define TIMER2_RELOAD     -(SYSCLK/TIMER_PRESCALER/1000*TICK_RATE)
+
+#define LED_ON            0
+#define LED_OFF           1
+
+#define FLASH_PAGE_SIZE   1024         // Flash page size in Bytes
+
+#define IMAGE_PAGES       16           // Flash pages in the checked image,
+                                       // starting at address 0. The last
+                                       // page holds the signature.
+
+#define IMAGE_SIZE        (FLASH_PAGE_SIZE * IMAGE_PAGES)
+
+#define SIGNATURE_ADDRESS (IMAGE_SIZE - 2)
+
+#define FLASH_CHECK_BYTES_PER_STEP 64  // Bytes checked per call. This sets
+                                       // the worst case time of one step.
+
+// Return values of FlashCheck_Step()
+#define FLASH_CHECK_BUSY  0
+#define FLASH_CHECK_PASS  1
+#define FLASH_CHECK_FAIL  2
+
+//-----------------------------------------------------------------------------
+// Global VARIABLES
+//-----------------------------------------------------------------------------
+
+U16 FlashCheck_Address;                // Next byte of the image to check
+UU16 FlashCheck_CRC;                   // Partial result between steps
+
+//-----------------------------------------------------------------------------
+// Function PROTOTYPES
+//-----------------------------------------------------------------------------
+void PORT_Init (void);
+void Timer2_Init (void);
+
+void FlashCheck_Start (void);
+U8   FlashCheck_Step (void);
+
+void Byte_CRC16 (U8* Start_Byte, U16 Num_Bytes);
+void Read_CRC16 (UU16* Result);
+
+void Write_Signature (void);
+void FLASH_ByteWrite (U16 addr, U8 byte);
+void FLASH_SetKeys (void);
+
+//-----------------------------------------------------------------------------
+// MAIN Routine
+//-----------------------------------------------------------------------------
+void main (void)
+{
+   U8 verdict;
+
+   PCA0MD &= ~0x40;                    // WDTE = 0 (clear watchdog timer
+                                       // enable)
+   PORT_Init ();
+   Timer2_Init ();
+
+   LED1 = LED_OFF;
+   LED2 = LED_OFF;
+
+   Write_Signature ();
+
+   FlashCheck_Start ();
+
+   while (1)
+   {
+      if (TF2H)                        // Wait for the next tick
+      {
+         TF2H = 0;
+
+         // The control loop work for this tick goes here.
+
+         verdict = FlashCheck_Step ();
+
+         if (verdict == FLASH_CHECK_PASS)
+         {
+            LED1 = !LED1;
+         }
+         else if (verdict == FLASH_CHECK_FAIL)
+         {
+            LED1 = LED_OFF;
+            LED2 = LED_ON;
+         }
+      }
+   }
+}
+
+//-----------------------------------------------------------------------------
+// PORT_Init
+//-----------------------------------------------------------------------------
+//
+// Return Value : None
+// Parameters   : None
+//
+// This function configures the crossbar and ports pins.
+//
+//-----------------------------------------------------------------------------
+void PORT_Init (void)
+{
+   SFRPAGE = LEGACY_PAGE;
+
+   XBR2    = 0x40;                     // Enable crossbar and enable
+                                       // weak pull-ups
+}
+
+//-----------------------------------------------------------------------------
+// Timer2_Init
+//-----------------------------------------------------------------------------
+//
+// Return Value : None
+// Parameters   : None
+//
+// This function configures Timer2 as a 16-bit reload timer that sets TF2H
+// every TICK_RATE milliseconds. The interrupt is not used.
+//
+//-----------------------------------------------------------------------------
+void Timer2_Init (void)
+{
+   SFRPAGE = LEGACY_PAGE;
+   CKCON &= ~0x60;                     // Timer2 uses SYSCLK/12
+   TMR2CN &= ~0x01;
+
+   TMR2RL = TIMER2_RELOAD;             // Reload value to be used in Timer2
+   TMR2 = TMR2RL;                      // Init the Timer2 register
+
+   TMR2CN = 0x04;                      // Enable Timer2 in auto-reload mode
+}
+
+//-----------------------------------------------------------------------------
+// FlashCheck_Start
+//-----------------------------------------------------------------------------
+//
+// Return Value : None
+// Parameters   : None
+//
+// Starts a new pass over the image. The CRC result is initialized to 0 as
+// in Byte_CRC16().
+//
+//-----------------------------------------------------------------------------
+void FlashCheck_Start (void)
+{
+   FlashCheck_Address = 0;
+   FlashCheck_CRC.U16 = 0x0000;
+}
+
+//-----------------------------------------------------------------------------
+// FlashCheck_Step
+//-----------------------------------------------------------------------------
+//
+// Return Value : U8 - FLASH_CHECK_BUSY until the whole image is covered,
+//                     then FLASH_CHECK_PASS or FLASH_CHECK_FAIL
+// Parameters   : None
+//
+// Feeds the next FLASH_CHECK_BYTES_PER_STEP bytes of the image to the CRC
+// engine. The partial result is written back to CRC0DAT before the bytes
+// and read out after them, so other code may use the CRC engine between
+// steps. After the verdict the next call starts a new pass.
+//
+//-----------------------------------------------------------------------------
+U8 FlashCheck_Step (void)
+{
+   VARIABLE_SEGMENT_POINTER (codePtr, U8, SEG_CODE);
+   U16 bytes;
+   U8 restore;
+
+   bytes = IMAGE_SIZE - FlashCheck_Address;
+
+   if (bytes > FLASH_CHECK_BYTES_PER_STEP)
+   {
+      bytes = FLASH_CHECK_BYTES_PER_STEP;
+   }
+
+   codePtr = FlashCheck_Address;
+   FlashCheck_Address += bytes;
+
+   restore = SFRPAGE;
+
+   SFRPAGE = CONFIG_PAGE;
+
+   // set CRC0SEL to 1 (16-bit calc)
+   CRC0CN |= 0x10;
+
+   // Restore the partial result. CRC0PNT auto-increments with each write.
+   CRC0CN &= ~0x03;
+   CRC0DAT = FlashCheck_CRC.U8[LSB];
+   CRC0DAT = FlashCheck_CRC.U8[MSB];
+
+   while (bytes--)
+   {
+      CRC0IN = *codePtr++;
+   }
+
+   SFRPAGE = restore;
+
+   Read_CRC16 (&FlashCheck_CRC);
+
+   if (FlashCheck_Address < IMAGE_SIZE)
+   {
+      return FLASH_CHECK_BUSY;
+   }
+
+   // The CRC of the image including the signature must be 0.
+   bytes = FlashCheck_CRC.U16;
+
+   FlashCheck_Start ();
+
+   if (bytes == 0x0000)
+   {
+      return FLASH_CHECK_PASS;
+   }
+   else
+   {
+      return FLASH_CHECK_FAIL;
+   }
+}
+
+//-----------------------------------------------------------------------------
+// Byte_CRC16
+//-----------------------------------------------------------------------------
+//
+// Return Value:  None
+//   1) U8* Start_Byte - Pointer to first byte of data to CRC
+//   2) U16 Num_Bytes - Number of consecutive bytes to include in the CRC
+//
+//   After this function completes, the result is kept in CRC0DAT
+//-----------------------------------------------------------------------------
+void Byte_CRC16 (U8* Start_Byte, U16 Num_Bytes)
+{
+   U16 i;
+
+   U8 restore;
+
+   restore = SFRPAGE;
+
+   SFRPAGE = CONFIG_PAGE;
+
+
+   // set CRC0SEL to 1 (16-bit calc),
+   CRC0CN |= 0x10;
+   // initialize CRC result to 0x00 and clear the current result.
+   // If the result should be initialized to 0xFF, CRC0CN |= 0x0C;
+   CRC0CN |= 0x08;
+
+   for (i = 0; i < Num_Bytes; i++)
+   {
+      CRC0IN = Start_Byte[i];
+   }
+
+   SFRPAGE = restore;
+}
+
+//-----------------------------------------------------------------------------
+// Read_CRC16
+//-----------------------------------------------------------------------------
+//
+// Return Value : None.
+// Parameters   :
+//   1) U8* Result - Stores CRC into 2 bytes starting at this location
+//
+// Copies CRC result to two bytes starting at location passed into function
+//-----------------------------------------------------------------------------
+void Read_CRC16 (UU16* Result)
+{
+   U8 restore;
+
+   restore = SFRPAGE;
+
+   SFRPAGE = CONFIG_PAGE;
+
+
+   // Initialize CRC0PNT to access bits 7-0 of the CRC result
+   CRC0CN &= ~0x03;
+
+   // With each read of CRC0DAT, the value in CRC0PNT will auto-increment
+   (*Result).U8[LSB] = CRC0DAT;
+   (*Result).U8[MSB] = CRC0DAT;
+
+   SFRPAGE = restore;
+}
+
+//-----------------------------------------------------------------------------
+// Write_Signature
+//-----------------------------------------------------------------------------
+//
+// Return Value:  None.
+// Parameters:    None
+//
+// Writes the CRC of the image to the last two bytes of the image if they
+// are still erased. No page erase is needed, since erased bytes may be
+// written once.
+//
+//-----------------------------------------------------------------------------
+void Write_Signature (void)
+{
+   VARIABLE_SEGMENT_POINTER (signature, U8, SEG_CODE);
+   UU16 result;
+
+   signature = SIGNATURE_ADDRESS;
+
+   if ((signature[0] != 0xFF) || (signature[1] != 0xFF))
+   {
+      return;                          // already programmed
+   }
+
+   signature = 0x0000;                 // start of the image
+   Byte_CRC16 (signature, SIGNATURE_ADDRESS);
+   Read_CRC16 (&result);
+
+   FLASH_SetKeys ();
+   FLASH_ByteWrite (SIGNATURE_ADDRESS, result.U8[MSB]);
+   FLASH_SetKeys ();
+   FLASH_ByteWrite (SIGNATURE_ADDRESS + 1, result.U8[LSB]);
+}
+
+//-----------------------------------------------------------------------------
+// FLASH_ByteWrite
+//-----------------------------------------------------------------------------
+//
+// Return Value : None
+// Parameters   :
+//   1) U16 addr - address of the byte to write to
+//   2) U8 byte - byte to write to Flash.
+//
+// This routine writes <byte> to the linear FLASH address <addr>.
+//-----------------------------------------------------------------------------
+
+void FLASH_ByteWrite (U16 addr, U8 byte)
+{
+
+   bit EA_save;                    // Preserve EA
+   U8 SFRPAGE_save;
+   SEGMENT_VARIABLE_SEGMENT_POINTER (pwrite, U8, SEG_XDATA, SEG_DATA);
+
+   EA_save = EA;
+   EA = 0;                             // Disable interrupts
+
+   SFRPAGE_save = SFRPAGE;
+   SFRPAGE = LEGACY_PAGE;
+
+   VDM0CN = 0x80;                      // Enable VDD monitor
+
+
+   RSTSRC = 0x06;                      // Enable VDD monitor as a reset source
+                                       // Leave missing clock detector enabled
+
+   pwrite = (char xdata *) addr;
+
+   // Keys are set in Flash_SetKeys();
+
+   PSCTL |= 0x01;                      // PSWE = 1
+
+   VDM0CN = 0x80;                      // Enable VDD monitor
+
+   RSTSRC = 0x02;                      // Enable VDD monitor as a reset source
+
+   *pwrite = byte;                     // Write the byte
+
+   PSCTL &= ~0x05;                     // SFLE = 0; PSWE = 0
+
+   SFRPAGE = SFRPAGE_save;             // Restore SFRPAGE
+   EA = EA_save;                       // Restore EA
+}
+
+//-----------------------------------------------------------------------------
+// FLASH_SetKeys
+//-----------------------------------------------------------------------------
+//
+// Return Value : None
+// Parameters   : None
+//
+// This routine erases sets the two required Flash keys for writes and erases.
+//-----------------------------------------------------------------------------
+
+void FLASH_SetKeys (void)
+{
+   U8 SFRPAGE_save;
+
+   SFRPAGE_save = SFRPAGE;
+   SFRPAGE = LEGACY_PAGE;
+   FLKEY  = 0xA5;                      // Key Sequence 1
+   FLKEY  = 0xF1;                      // Key Sequence 2
+
+   SFRPAGE = SFRPAGE_save;             // Restore SFRPAGE
+}
+
+//-----------------------------------------------------------------------------
+// End Of File
+//-----------------------------------------------------------------------------
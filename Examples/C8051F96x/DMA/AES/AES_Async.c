@@ -0,0 +1,464 @@
+//=============================================================================
+// AES_Async.c
+//=============================================================================
+// Copyright 2010 Silicon Laboratories, Inc.
+// http://www.silabs.com
+//
+// C File Description:
+//
+//    Non-blocking ECB, CBC and CTR operations. Requests are placed in a
+//    small queue and each DMA pass is started from the DMA ISR, so the
+//    core is free while the AES block is busy.
+//
+// Target:
+//    C8051F960
+//
+// IDE:
+//    Silicon Laboratories IDE
+//
+// Tool Chains:
+//    Keil
+//    SDCC
+//    Raisonance
+//
+// Project Name:
+//    C8051F960 AES Code Examples
+//
+// This software must be used in accordance with the End User License Agreement.
+//
+//=============================================================================
+//-----------------------------------------------------------------------------
+// uncomment pragma SRC to generate assembly code
+//-----------------------------------------------------------------------------
+//#pragma SRC
+//=============================================================================
+// Includes
+//=============================================================================
+#include <compiler_defs.h>
+#include <C8051F960_defs.h>
+#include "AES_Async.h"
+#include "DMA_defs.h"
+#include "AES_defs.h"
+//=============================================================================
+// Global Variables
+//=============================================================================
+volatile U8 AES_AsyncCompleted;        // incremented for each finished request
+//=============================================================================
+// File Global Variables
+//=============================================================================
+VARIABLE_SEGMENT_POINTER(AES_Queue[AES_ASYNC_QUEUE_SIZE], AES_REQUEST, SEG_XDATA);
+VARIABLE_SEGMENT_POINTER(AES_Active, AES_REQUEST, SEG_XDATA);
+U8 AES_QueueHead;
+volatile U8 AES_QueueCount;
+U16 AES_ActiveBlocks;                  // blocks left after the current pass
+//-----------------------------------------------------------------------------
+// Unions used by AES_AsyncStart() and AES_AsyncNext(). These are globals
+// rather than locals so that AES_AsyncStart() has no overlayable data.
+//-----------------------------------------------------------------------------
+UU16 AES_Length;
+UU16 AES_Addr;
+//=============================================================================
+// Function Prototypes (Internal)
+//=============================================================================
+void AES_AsyncStart (void);
+void AES_AsyncNext (void);
+void AES_AsyncIncrementCounter (VARIABLE_SEGMENT_POINTER(counter, U8, SEG_XDATA));
+//=============================================================================
+// API Functions
+//=============================================================================
+//-----------------------------------------------------------------------------
+// AES_AsyncSubmit()
+//
+// parameters:
+//    request         - xdata pointer to a filled in AES_REQUEST
+//
+// returns:
+//    status         - 0 for success
+//                   - 1 for ERROR - Invalid mode, operation or block count.
+//                   - 2 for ERROR - Queue full.
+//
+// description:
+//
+// This function adds a request to the queue and returns at once. If the AES
+// block is idle the first DMA pass is started before returning.
+//
+// The request fields have the same meaning as the parameters of the
+// AES_BlockCipher(), CBC_EncryptDecrypt() and CTR_EncryptDecrypt() functions
+// and the same restrictions on the buffers apply. The state field is set to
+// AES_REQUEST_QUEUED here, to AES_REQUEST_ACTIVE when the request is started
+// and to AES_REQUEST_DONE when the output has been written. The application
+// may poll the state of each request or the AES_AsyncCompleted counter.
+//
+// The DMA ISR in the main module must call AES_AsyncService() in place of
+// disabling EIE2 bit 5. AES_AsyncService() disables EIE2 bit 5 when no
+// request is queued, so the blocking functions can still be used when the
+// queue is empty. Global interrupts must be enabled.
+//
+// The ENC0 channels are shared with the AES key and block input channels,
+// so EncodeDecode() must not be used while AES_AsyncBusy() is non-zero.
+//
+// With Keil, AES_AsyncStart() is called from here and from the DMA ISR.
+// The linker reports this as warning L15. This is safe because the DMA
+// interrupt is disabled while it is called here and the function has no
+// parameters or local variables.
+//
+//-----------------------------------------------------------------------------
+AES_ASYNC_STATUS AES_AsyncSubmit (
+   VARIABLE_SEGMENT_POINTER(request, AES_REQUEST, SEG_XDATA))
+{
+   U8 tail;
+
+   // check first for valid mode, operation and block count
+   if((request->mode >= AES_ASYNC_UNDEFINED)||
+      (request->operation == DECRYPTION_UNDEFINED)||
+      (request->operation >= ENCRYPTION_UNDEFINED)||
+      (request->blocks == 0))
+   {
+      return ERROR_INVALID_PARAMETER;
+   }
+
+   // Keep AES_AsyncService() out while the queue is changed.
+   EIE2 &= ~0x20;
+
+   if(AES_QueueCount == AES_ASYNC_QUEUE_SIZE)
+   {
+      EIE2 |= 0x20;                    // request still active
+      return AES_ASYNC_ERROR_QUEUE_FULL;
+   }
+
+   request->state = AES_REQUEST_QUEUED;
+
+   tail = (AES_QueueHead + AES_QueueCount) & (AES_ASYNC_QUEUE_SIZE - 1);
+   AES_Queue[tail] = request;
+   AES_QueueCount++;
+
+   if(AES_QueueCount == 1)
+      AES_AsyncStart();                // enables DMA interrupt
+   else
+      EIE2 |= 0x20;
+
+   return SUCCESS;
+}
+//-----------------------------------------------------------------------------
+// AES_AsyncBusy()
+//
+// returns:
+//    number of queued requests, including the active request
+//
+//-----------------------------------------------------------------------------
+U8 AES_AsyncBusy (void)
+{
+   return AES_QueueCount;
+}
+//-----------------------------------------------------------------------------
+// AES_AsyncService()
+//
+// description:
+//
+// This function must be called from the DMA ISR. When the AES0YOUT channel
+// has finished it either starts the next pass of the active request or
+// completes the request and starts the next queued request.
+//
+// When the queue is empty this function disables EIE2 bit 5, which is what
+// the DMA ISR does for the blocking functions.
+//
+//-----------------------------------------------------------------------------
+void AES_AsyncService (void)
+{
+   U8 restoreSFRPAGE;
+
+   restoreSFRPAGE = SFRPAGE;
+   SFRPAGE = DPPE_PAGE;
+
+   if(AES_QueueCount == 0)
+   {
+      EIE2 &= ~0x20;                   // disable further interrupts
+   }
+   else if(DMA0INT & AES0YOUT_MASK)
+   {
+      if(AES_ActiveBlocks)
+      {
+         AES_AsyncNext();
+      }
+      else
+      {
+         //Clear AES Block
+         AES0BCFG = 0x00;
+         AES0DCFG = 0x00;
+
+         // Clear KXBY (Key, Block, XOR, and Y out) bits in DMA0EN and DMA0INT.
+         DMA0EN &= ~AES0_KBXY_MASK;
+         DMA0INT &= ~AES0_KBXY_MASK;
+
+         AES_Active->state = AES_REQUEST_DONE;
+         AES_AsyncCompleted++;
+
+         AES_QueueHead = (AES_QueueHead + 1) & (AES_ASYNC_QUEUE_SIZE - 1);
+         AES_QueueCount--;
+
+         if(AES_QueueCount)
+            AES_AsyncStart();
+         else
+            EIE2 &= ~0x20;             // disable further interrupts
+      }
+   }
+
+   SFRPAGE = restoreSFRPAGE;
+}
+//=============================================================================
+// Internal Functions
+//=============================================================================
+//-----------------------------------------------------------------------------
+// AES_AsyncStart()
+//
+// description:
+//
+// Configures the DMA channels and the AES block for the first pass of the
+// request at the head of the queue. ECB requests are done in one pass.
+// CBC and CTR requests start with one block, as in CBC_EncryptDecrypt() and
+// CTR_EncryptDecrypt(). Called with the DMA interrupt disabled or from the
+// DMA ISR.
+//
+//-----------------------------------------------------------------------------
+void AES_AsyncStart (void)
+{
+   AES_Active = AES_Queue[AES_QueueHead];
+   AES_Active->state = AES_REQUEST_ACTIVE;
+
+   // Length of the first pass. ECB encrypts all blocks at once.
+   if(AES_Active->mode == AES_ASYNC_ECB)
+   {
+      AES_Length.U16 = (AES_Active->blocks << 4);
+      AES_ActiveBlocks = 0;
+   }
+   else
+   {
+      AES_Length.U16 = 16;
+      AES_ActiveBlocks = AES_Active->blocks - 1;
+   }
+
+   SFRPAGE = DPPE_PAGE;
+
+   AES0BCFG = 0x00;                    // disable for now
+   AES0DCFG = 0x00;                    // disable for now
+
+   // Disable AES0KIN, AES0BIN, AES0XIN, & AES0YOUT channels.
+   DMA0EN &= ~AES0_KBXY_MASK;
+
+   // Configure AES key input channel using key pointer. Wrap the key for
+   // ECB mode. CBC mode enables wrapping for the second pass. CTR mode
+   // resets the offset for each block.
+   DMA0SEL = AES0KIN_CHANNEL;
+   DMA0NCF = AES0KIN_PERIPHERAL_REQUEST;
+   if(AES_Active->mode == AES_ASYNC_ECB)
+      DMA0NMD = WRAPPING;
+   else
+      DMA0NMD = NO_WRAPPING;
+   AES_Addr.U16 = (U16)(AES_Active->key);
+   DMA0NBAL = AES_Addr.U8[LSB];
+   DMA0NBAH = AES_Addr.U8[MSB];
+   DMA0NSZH = 0;
+   DMA0NSZL = (((AES_Active->operation & 0x03) + 2) << 3);
+   DMA0NAOL = 0;
+   DMA0NAOH = 0;
+
+   // AES block input is the counter for CTR mode. Otherwise it is plaintext
+   // for encryption operation or ciphertext for decryption operation.
+   if(AES_Active->mode == AES_ASYNC_CTR)
+      AES_Addr.U16 = (U16)(AES_Active->iv);
+   else if(AES_Active->operation & ENCRYPTION_MODE)
+      AES_Addr.U16 = (U16)(AES_Active->plainText);
+   else
+      AES_Addr.U16 = (U16)(AES_Active->cipherText);
+
+   DMA0SEL = AES0BIN_CHANNEL;
+   DMA0NCF = AES0BIN_PERIPHERAL_REQUEST;
+   DMA0NMD = NO_WRAPPING;
+   DMA0NBAL = AES_Addr.U8[LSB];
+   DMA0NBAH = AES_Addr.U8[MSB];
+   DMA0NSZL = AES_Length.U8[LSB];
+   DMA0NSZH = AES_Length.U8[MSB];
+   DMA0NAOL = 0;
+   DMA0NAOH = 0;
+
+   // AES X input is the initial vector for CBC mode and the plaintext or
+   // ciphertext for CTR mode. It is not used for ECB mode.
+   if(AES_Active->mode != AES_ASYNC_ECB)
+   {
+      if(AES_Active->mode == AES_ASYNC_CBC)
+         AES_Addr.U16 = (U16)(AES_Active->iv);
+      else if(AES_Active->operation & ENCRYPTION_MODE)
+         AES_Addr.U16 = (U16)(AES_Active->plainText);
+      else
+         AES_Addr.U16 = (U16)(AES_Active->cipherText);
+
+      DMA0SEL = AES0XIN_CHANNEL;
+      DMA0NCF = AES0XIN_PERIPHERAL_REQUEST;
+      DMA0NMD = NO_WRAPPING;
+      DMA0NBAL = AES_Addr.U8[LSB];
+      DMA0NBAH = AES_Addr.U8[MSB];
+      DMA0NSZL = 16;                   // one block
+      DMA0NSZH = 0;
+      DMA0NAOL = 0;
+      DMA0NAOH = 0;
+   }
+
+   // AES Y output is ciphertext for encryption operation or
+   // plaintext for decryption operation.
+   if(AES_Active->operation & ENCRYPTION_MODE)
+      AES_Addr.U16 = (U16)(AES_Active->cipherText);
+   else
+      AES_Addr.U16 = (U16)(AES_Active->plainText);
+
+   DMA0SEL = AES0YOUT_CHANNEL;
+   DMA0NCF = AES0YOUT_PERIPHERAL_REQUEST|DMA_INT_EN;
+   DMA0NMD = NO_WRAPPING;
+   DMA0NBAL = AES_Addr.U8[LSB];
+   DMA0NBAH = AES_Addr.U8[MSB];
+   DMA0NSZL = AES_Length.U8[LSB];
+   DMA0NSZH = AES_Length.U8[MSB];
+   DMA0NAOH = 0;
+   DMA0NAOL = 0;
+
+   // Clear KBXY (Key, Block, X in, and Y out) bits in DMA0INT sfr using mask.
+   DMA0INT &= ~AES0_KBXY_MASK;
+
+   // Enable the DMA channels and select the XOR operation. For CBC Mode,
+   // the XOR operation is on the input for encryption or on the output for
+   // decryption. CTR Mode always uses the encryption core.
+   if(AES_Active->mode == AES_ASYNC_ECB)
+   {
+      DMA0EN |= AES0_KBY_MASK;
+      AES0DCFG = AES_OUTPUT;
+      AES0BCFG = AES_Active->operation;
+   }
+   else if(AES_Active->mode == AES_ASYNC_CBC)
+   {
+      DMA0EN |= AES0_KBXY_MASK;
+      if(AES_Active->operation & ENCRYPTION_MODE)
+         AES0DCFG = XOR_ON_INPUT;      // XOR on input - CBC Encryption
+      else
+         AES0DCFG = XOR_ON_OUTPUT;     // XOR on output - CBC Decryption
+      AES0BCFG = AES_Active->operation;
+   }
+   else
+   {
+      DMA0EN |= AES0_KBXY_MASK;
+      AES0DCFG = XOR_ON_OUTPUT;
+      AES0BCFG = AES_Active->operation | ENCRYPTION_MODE;
+   }
+
+   // Enabled AES module to start encryption/decryption operation.
+   AES0BCFG |= AES_ENABLE;
+
+   EIE2 |= 0x20;                       // enable DMA interrupt
+}
+//-----------------------------------------------------------------------------
+// AES_AsyncNext()
+//
+// description:
+//
+// Starts the next pass of the active CBC or CTR request. A CBC request
+// finishes all remaining blocks in the second pass. A CTR request uses one
+// pass per block with the counter incremented between blocks. Called only
+// from the DMA ISR with SFRPAGE set to DPPE_PAGE.
+//
+//-----------------------------------------------------------------------------
+void AES_AsyncNext (void)
+{
+   // Disable AES block and pause DMA channels used by AES block.
+   AES0BCFG &= ~AES_ENABLE;
+   DMA0EN &= ~AES0_KBXY_MASK;
+
+   if(AES_Active->mode == AES_ASYNC_CBC)
+   {
+      AES_Length.U16 = (AES_Active->blocks << 4);
+      AES_ActiveBlocks = 0;
+
+      // AESKIN DMA reset address offset and enable wrapping.
+      DMA0SEL = AES0KIN_CHANNEL;
+      DMA0NMD = WRAPPING;
+      DMA0NAOL = 0;
+      DMA0NAOH = 0;
+
+      // AESBIN DMA channel change length only.
+      DMA0SEL = AES0BIN_CHANNEL;
+      DMA0NSZL = AES_Length.U8[LSB];
+      DMA0NSZH = AES_Length.U8[MSB];
+
+      // AESXIN DMA channel point to ciphertext for
+      // both encryption and decryption.
+      DMA0SEL = AES0XIN_CHANNEL;
+      AES_Addr.U16 = (U16)(AES_Active->cipherText);
+      DMA0NBAL = AES_Addr.U8[LSB];
+      DMA0NBAH = AES_Addr.U8[MSB];
+      DMA0NSZL = AES_Length.U8[LSB];
+      DMA0NSZH = AES_Length.U8[MSB];
+      DMA0NAOL = 0;
+      DMA0NAOH = 0;
+
+      // AESYOUT DMA channel change length only.
+      DMA0SEL = AES0YOUT_CHANNEL;
+      DMA0NSZL = AES_Length.U8[LSB];
+      DMA0NSZH = AES_Length.U8[MSB];
+   }
+   else
+   {
+      AES_ActiveBlocks--;
+
+      AES_AsyncIncrementCounter(AES_Active->iv);
+
+      // AESKIN and AESBIN DMA reset address offsets.
+      DMA0SEL = AES0KIN_CHANNEL;
+      DMA0NAOL = 0;
+      DMA0NAOH = 0;
+
+      DMA0SEL = AES0BIN_CHANNEL;
+      DMA0NAOL = 0;
+      DMA0NAOH = 0;
+
+      // AESXIN and AESYOUT DMA channels increase length by 16.
+      DMA0SEL = AES0XIN_CHANNEL;
+      AES_Length.U8[LSB] = DMA0NSZL;
+      AES_Length.U8[MSB] = DMA0NSZH;
+      AES_Length.U16 += 16;
+      DMA0NSZL = AES_Length.U8[LSB];
+      DMA0NSZH = AES_Length.U8[MSB];
+
+      DMA0SEL = AES0YOUT_CHANNEL;
+      DMA0NSZL = AES_Length.U8[LSB];
+      DMA0NSZH = AES_Length.U8[MSB];
+   }
+
+   // Clear KBXY bits in DMA0INT and restart the DMA channels and AES block.
+   DMA0INT &= ~AES0_KBXY_MASK;
+   DMA0EN  |=  AES0_KBXY_MASK;
+   AES0BCFG |= AES_ENABLE;
+}
+//-----------------------------------------------------------------------------
+// AES_AsyncIncrementCounter()
+//
+// Same as IncrementCounter() in CTR_EncryptDecrypt.c. A separate copy is
+// used because this one is called from the DMA ISR.
+//
+//-----------------------------------------------------------------------------
+void AES_AsyncIncrementCounter (VARIABLE_SEGMENT_POINTER(counter, U8, SEG_XDATA))
+{
+   U8 i;
+   U8 x;
+
+   i = 16;
+   counter += 16;                      // point to end of data
+
+   do
+   {
+      counter--;                       // decrement data pointer
+      x = *counter;                    // read xdata using data pointer
+      x++;                             // increment value
+      *counter = x;                    // move to xram
+      if(x) break;                     // break if not zero
+   }  while(--i);                      // DJNZ
+}
+//=============================================================================
+// End of file
+//=============================================================================
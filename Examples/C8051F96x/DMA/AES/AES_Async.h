@@ -0,0 +1,106 @@
+#ifndef AES_ASYNC_H
+#define AES_ASYNC_H
+//=============================================================================
+// AES_Async.h
+//-----------------------------------------------------------------------------
+// Copyright 2010 Silicon Laboratories, Inc.
+// http://www.silabs.com
+//
+// C File Description:
+//
+//    Non-blocking front end for the AES0 ECB, CBC and CTR operations.
+//
+// Target:
+//    C8051F960
+//
+// IDE:
+//    Silicon Laboratories IDE
+//
+// Tool Chains:
+//    Keil
+//    SDCC
+//    Raisonance
+//
+// Project Name:
+//    C8051F960 AES Library
+//
+// This software must be used in accordance with the End User License Agreement.
+//
+//=============================================================================
+#ifndef COMPILER_DEFS_H
+#include <compiler_defs.h>
+#endif
+#ifndef AES_DEFS_H
+#include <AES_defs.h>
+#endif
+//=============================================================================
+//-----------------------------------------------------------------------------
+// Number of requests that may be queued, must be a power of two.
+//-----------------------------------------------------------------------------
+#define AES_ASYNC_QUEUE_SIZE     4
+//-----------------------------------------------------------------------------
+// typedefs for operation and status
+//-----------------------------------------------------------------------------
+typedef U8 AES_ASYNC_OPERATION;
+typedef U8 AES_ASYNC_STATUS;
+//-----------------------------------------------------------------------------
+// enum used for AES_REQUEST mode
+//-----------------------------------------------------------------------------
+enum AES_ASYNC_MODE_Enum
+{
+   AES_ASYNC_ECB = 0,                  // 0x00
+   AES_ASYNC_CBC,                      // 0x01
+   AES_ASYNC_CTR,                      // 0x02
+   AES_ASYNC_UNDEFINED                 // 0x03
+};
+//-----------------------------------------------------------------------------
+// enum used for AES_REQUEST state
+//-----------------------------------------------------------------------------
+enum AES_ASYNC_STATE_Enum
+{
+   AES_REQUEST_IDLE = 0,               // 0x00
+   AES_REQUEST_QUEUED,                 // 0x01
+   AES_REQUEST_ACTIVE,                 // 0x02
+   AES_REQUEST_DONE                    // 0x03
+};
+//-----------------------------------------------------------------------------
+// Error codes in addition to those defined in AES_defs.h
+//-----------------------------------------------------------------------------
+#define AES_ASYNC_ERROR_QUEUE_FULL     2
+//-----------------------------------------------------------------------------
+// Request structure
+//
+// The request must be located in xdata and must not be modified until the
+// state is AES_REQUEST_DONE. The iv pointer is the initial vector for CBC
+// mode and the counter for CTR mode. It is not used for ECB mode.
+//-----------------------------------------------------------------------------
+typedef struct AES_REQUEST_Struct
+{
+   U8 mode;
+   AES_ASYNC_OPERATION operation;
+   VARIABLE_SEGMENT_POINTER(plainText, U8, SEG_XDATA);
+   VARIABLE_SEGMENT_POINTER(cipherText, U8, SEG_XDATA);
+   VARIABLE_SEGMENT_POINTER(iv, U8, SEG_XDATA);
+   VARIABLE_SEGMENT_POINTER(key, U8, SEG_XDATA);
+   U16 blocks;
+   volatile U8 state;
+} AES_REQUEST;
+//-----------------------------------------------------------------------------
+// ENCRYPT_DECRYPT_AND_SIZE_Enum defined in AES_defs.h
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+// Public variables
+//-----------------------------------------------------------------------------
+extern volatile U8 AES_AsyncCompleted;
+//=============================================================================
+// Function Prototypes (API)
+//=============================================================================
+AES_ASYNC_STATUS AES_AsyncSubmit (
+   VARIABLE_SEGMENT_POINTER(request, AES_REQUEST, SEG_XDATA));
+U8   AES_AsyncBusy (void);
+void AES_AsyncService (void);
+//=============================================================================
+// End of file
+//=============================================================================
+#endif  // #ifdef AES_ASYNC_H
+//=============================================================================
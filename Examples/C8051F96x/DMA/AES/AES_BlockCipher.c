@@ -36,6 +36,9 @@
 #include "AES_BlockCipher.h"
 #include "DMA_defs.h"
 #include "AES_defs.h"
+#ifdef DECRYPTION_KEY_CACHE
+#include "DecryptionKeyCache.h"
+#endif
 //=============================================================================
 // API Functions
 //=============================================================================
@@ -110,6 +113,15 @@ AES_BLOCK_CIPHER_STATUS AES_BlockCipher (AES_BLOCK_CIPHER_OPERATION operation,
       keyLength = (((operation & 0x03) + 2) << 3);
    }
 
+   #ifdef DECRYPTION_KEY_CACHE
+   // The key parameter is the encryption key. Use the cached decryption key
+   // for a decryption operation.
+   if((operation & ENCRYPTION_MODE) == 0)
+   {
+      key = GetDecryptionKey(key, (operation & 0x03));
+   }
+   #endif
+
    // Calculate plaintext and ciphertext total length.
    length.U16 = (blocks << 4);
 
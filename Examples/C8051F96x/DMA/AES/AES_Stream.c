@@ -0,0 +1,346 @@
+//=============================================================================
+// AES_Stream.c
+//=============================================================================
+// Copyright 2010 Silicon Laboratories, Inc.
+// http://www.silabs.com
+//
+// C File Description:
+//
+//    CBC and CTR encryption and decryption of a message that arrives in
+//    pieces, such as USB packets or radio fragments. The running initial
+//    vector or counter is kept in a context between calls, so the message
+//    does not have to be collected in one buffer first.
+//
+// Target:
+//    C8051F960
+//
+// IDE:
+//    Silicon Laboratories IDE
+//
+// Tool Chains:
+//    Keil
+//    SDCC
+//    Raisonance
+//
+// Project Name:
+//    C8051F960 AES Code Examples
+//
+// This software must be used in accordance with the End User License Agreement.
+//
+//=============================================================================
+//-----------------------------------------------------------------------------
+// uncomment pragma SRC to generate assembly code
+//-----------------------------------------------------------------------------
+//#pragma SRC
+//=============================================================================
+// Includes
+//=============================================================================
+#include <compiler_defs.h>
+#include <C8051F960_defs.h>
+#include "AES_Stream.h"
+#include "CBC_EncryptDecrypt.h"
+#include "CTR_EncryptDecrypt.h"
+#include "AES_defs.h"
+//=============================================================================
+// local function prototypes
+//=============================================================================
+AES_STREAM_STATUS AES_StreamCBC (
+   VARIABLE_SEGMENT_POINTER(context, AES_STREAM, SEG_XDATA),
+   VARIABLE_SEGMENT_POINTER(input, U8, SEG_XDATA),
+   VARIABLE_SEGMENT_POINTER(output, U8, SEG_XDATA),
+   U16 blocks);
+
+void AES_StreamCopyBlock (
+   VARIABLE_SEGMENT_POINTER(destination, U8, SEG_XDATA),
+   VARIABLE_SEGMENT_POINTER(source, U8, SEG_XDATA));
+//=============================================================================
+// API Functions
+//=============================================================================
+//-----------------------------------------------------------------------------
+// AES_StreamInit()
+//
+// parameters:
+//    context         - xdata pointer to the stream context
+//    mode            - AES_STREAM_CBC or AES_STREAM_CTR
+//    operation       - decryption/encrypt & 128/192/256 options
+//    iv              - xdata pointer to initial vector or counter
+//    key             - xdata pointer to key
+//
+// returns:
+//    status         - 0 for success
+//                   - 1 for ERROR - Invalid mode or operation parameter.
+//
+// description:
+//
+// This function starts a new message. The initial vector for CBC mode or
+// the counter for CTR mode is copied into the context, so the iv buffer
+// may be reused as soon as this function returns.
+//
+// The key is used in place and must not be changed until AES_StreamFinal()
+// is called. The key is the same as for CBC_EncryptDecrypt() and
+// CTR_EncryptDecrypt(): the encryption key for CTR mode and for CBC
+// encryption, and the decryption key for CBC decryption unless
+// DECRYPTION_KEY_CACHE is defined in AES_defs.h.
+//
+//-----------------------------------------------------------------------------
+AES_STREAM_STATUS AES_StreamInit (
+   VARIABLE_SEGMENT_POINTER(context, AES_STREAM, SEG_XDATA),
+   U8 mode, AES_STREAM_OPERATION operation,
+   VARIABLE_SEGMENT_POINTER(iv, U8, SEG_XDATA),
+   VARIABLE_SEGMENT_POINTER(key, U8, SEG_XDATA))
+{
+   // check first for valid mode and operation
+   if((mode == 0)||(mode >= AES_STREAM_UNDEFINED)||
+      (operation == DECRYPTION_UNDEFINED)||(operation >= ENCRYPTION_UNDEFINED))
+   {
+      return ERROR_INVALID_PARAMETER;
+   }
+
+   context->mode = mode;
+   context->operation = operation;
+   context->count = 0;
+   context->key = key;
+
+   AES_StreamCopyBlock(context->chain, iv);
+
+   return SUCCESS;
+}
+//-----------------------------------------------------------------------------
+// AES_StreamUpdate()
+//
+// parameters:
+//    context         - xdata pointer to the stream context
+//    input           - xdata pointer to the next piece of the message
+//    output          - xdata pointer to the output buffer
+//    size            - number of input bytes, need not be a block multiple
+//    outputSize      - pointer to the number of bytes written to output
+//
+// returns:
+//    status         - 0 for success
+//                   - 1 for ERROR - Invalid context.
+//
+// description:
+//
+// This function encrypts or decrypts the next piece of the message.
+//
+// In CTR mode every input byte gives one output byte, so outputSize is
+// equal to size. The key stream left over from a partial block is used
+// for the first bytes of the next call.
+//
+// In CBC mode only whole blocks are output. The input bytes of an
+// incomplete block are kept in the context and are output when the next
+// call completes the block. The output buffer must have room for size
+// bytes plus 15.
+//
+// The whole blocks of each piece are processed with a single call to
+// CBC_EncryptDecrypt() or CTR_EncryptDecrypt() directly from the input
+// buffer. Only the bytes of a block split between two pieces are copied.
+//
+// The same restrictions on overlapping input and output apply as for
+// CBC_EncryptDecrypt() and CTR_EncryptDecrypt(). For CBC decryption the
+// output must not overlap the input.
+//
+//-----------------------------------------------------------------------------
+AES_STREAM_STATUS AES_StreamUpdate (
+   VARIABLE_SEGMENT_POINTER(context, AES_STREAM, SEG_XDATA),
+   VARIABLE_SEGMENT_POINTER(input, U8, SEG_XDATA),
+   VARIABLE_SEGMENT_POINTER(output, U8, SEG_XDATA),
+   U16 size, U16 *outputSize)
+{
+   U16 blocks;
+   U16 produced;
+   U8 status;
+
+   produced = 0;
+   status = SUCCESS;
+
+   if(context->mode == AES_STREAM_CBC)
+   {
+      // Complete a block held from the previous call.
+      if(context->count)
+      {
+         while(size && (context->count < 16))
+         {
+            context->buffer[context->count++] = *input++;
+            size--;
+         }
+
+         if(context->count == 16)
+         {
+            status = AES_StreamCBC(context, context->buffer, output, 1);
+            output += 16;
+            produced = 16;
+            context->count = 0;
+         }
+      }
+
+      // Whole blocks directly from the input buffer.
+      // Using >>4 in lieu of / 16 for code efficiency.
+      blocks = (size >> 4);
+
+      if(blocks)
+      {
+         status |= AES_StreamCBC(context, input, output, blocks);
+         input += (blocks << 4);
+         produced += (blocks << 4);
+      }
+
+      // Keep the remaining bytes for the next call.
+      size &= 0x0F;
+      while(size--)
+      {
+         context->buffer[context->count++] = *input++;
+      }
+   }
+   else if(context->mode == AES_STREAM_CTR)
+   {
+      produced = size;
+
+      while(size)
+      {
+         if(context->count == 0)
+         {
+            blocks = (size >> 4);
+
+            if(blocks)
+            {
+               // CTR mode decryption uses the AES core in encryption mode.
+               // CTR_EncryptDecrypt() increments the counter between blocks
+               // only, so it is incremented here for the next block.
+               status |= CTR_EncryptDecrypt(
+                  (context->operation | ENCRYPTION_MODE), input, output,
+                  context->chain, context->key, blocks);
+               IncrementCounter(context->chain);
+
+               input += (blocks << 4);
+               output += (blocks << 4);
+               size &= 0x0F;
+               continue;
+            }
+
+            // Encrypt a block of zeros to get the key stream for the
+            // last partial block.
+            for(blocks = 0; blocks < 16; blocks++)
+            {
+               context->buffer[blocks] = 0;
+            }
+
+            status |= CTR_EncryptDecrypt(
+               (context->operation | ENCRYPTION_MODE), context->buffer,
+               context->buffer, context->chain, context->key, 1);
+            IncrementCounter(context->chain);
+
+            context->count = 16;
+         }
+
+         *output++ = *input++ ^ context->buffer[16 - context->count];
+         context->count--;
+         size--;
+      }
+   }
+   else
+   {
+      status = ERROR_INVALID_PARAMETER;
+   }
+
+   *outputSize = produced;
+
+   return status;
+}
+//-----------------------------------------------------------------------------
+// AES_StreamFinal()
+//
+// parameters:
+//    context         - xdata pointer to the stream context
+//
+// returns:
+//    status         - 0 for success
+//                   - 2 for AES_STREAM_ERROR_PARTIAL_BLOCK
+//
+// description:
+//
+// This function ends the message and clears the buffered data in the
+// context. CBC mode does not pad the message, so an error is returned if
+// the message length was not a multiple of 16 bytes.
+//
+//-----------------------------------------------------------------------------
+AES_STREAM_STATUS AES_StreamFinal (
+   VARIABLE_SEGMENT_POINTER(context, AES_STREAM, SEG_XDATA))
+{
+   U8 status;
+   U8 i;
+
+   status = SUCCESS;
+
+   if((context->mode == AES_STREAM_CBC) && context->count)
+   {
+      status = AES_STREAM_ERROR_PARTIAL_BLOCK;
+   }
+
+   for(i = 0; i < 16; i++)
+   {
+      context->buffer[i] = 0;
+   }
+
+   context->count = 0;
+   context->mode = 0;
+
+   return status;
+}
+//=============================================================================
+// Local Functions
+//=============================================================================
+//-----------------------------------------------------------------------------
+// AES_StreamCBC()
+//
+// Processes whole blocks with CBC_EncryptDecrypt() and moves the last
+// ciphertext block into the chain field for the next call. For decryption
+// the last ciphertext block is the input, which CBC_EncryptDecrypt() does
+// not overwrite.
+//
+//-----------------------------------------------------------------------------
+AES_STREAM_STATUS AES_StreamCBC (
+   VARIABLE_SEGMENT_POINTER(context, AES_STREAM, SEG_XDATA),
+   VARIABLE_SEGMENT_POINTER(input, U8, SEG_XDATA),
+   VARIABLE_SEGMENT_POINTER(output, U8, SEG_XDATA),
+   U16 blocks)
+{
+   U8 status;
+
+   if(context->operation & ENCRYPTION_MODE)
+   {
+      status = CBC_EncryptDecrypt(context->operation, input, output,
+         context->chain, context->key, blocks);
+      AES_StreamCopyBlock(context->chain, output + ((blocks - 1) << 4));
+   }
+   else
+   {
+      status = CBC_EncryptDecrypt(context->operation, output, input,
+         context->chain, context->key, blocks);
+      AES_StreamCopyBlock(context->chain, input + ((blocks - 1) << 4));
+   }
+
+   return status;
+}
+//-----------------------------------------------------------------------------
+// AES_StreamCopyBlock()
+//
+// Copies one 16-byte block in xdata.
+//
+//-----------------------------------------------------------------------------
+void AES_StreamCopyBlock (
+   VARIABLE_SEGMENT_POINTER(destination, U8, SEG_XDATA),
+   VARIABLE_SEGMENT_POINTER(source, U8, SEG_XDATA))
+{
+   U8 i;
+
+   i = 16;
+
+   do
+   {
+      *destination++ = *source++;
+   }  while(--i);                      // DJNZ
+}
+//=============================================================================
+// End of file
+//=============================================================================
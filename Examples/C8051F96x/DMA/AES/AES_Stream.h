@@ -0,0 +1,97 @@
+#ifndef AES_STREAM_H
+#define AES_STREAM_H
+//=============================================================================
+// AES_Stream.h
+//-----------------------------------------------------------------------------
+// Copyright 2010 Silicon Laboratories, Inc.
+// http://www.silabs.com
+//
+// C File Description:
+//
+//    CBC and CTR encryption and decryption of data that arrives in pieces.
+//
+// Target:
+//    C8051F960
+//
+// IDE:
+//    Silicon Laboratories IDE
+//
+// Tool Chains:
+//    Keil
+//    SDCC
+//    Raisonance
+//
+// Project Name:
+//    C8051F960 AES Library
+//
+// This software must be used in accordance with the End User License Agreement.
+//
+//=============================================================================
+#ifndef COMPILER_DEFS_H
+#include <compiler_defs.h>
+#endif
+#ifndef AES_DEFS_H
+#include <AES_defs.h>
+#endif
+//=============================================================================
+//-----------------------------------------------------------------------------
+// typedefs for operation and status
+//-----------------------------------------------------------------------------
+typedef U8 AES_STREAM_OPERATION;
+typedef U8 AES_STREAM_STATUS;
+//-----------------------------------------------------------------------------
+// enum used for AES_STREAM mode, same values as AES_Async.h
+//-----------------------------------------------------------------------------
+enum AES_STREAM_MODE_Enum
+{
+   AES_STREAM_CBC = 1,                 // 0x01
+   AES_STREAM_CTR,                     // 0x02
+   AES_STREAM_UNDEFINED                // 0x03
+};
+//-----------------------------------------------------------------------------
+// Error codes in addition to those defined in AES_defs.h
+//-----------------------------------------------------------------------------
+#define AES_STREAM_ERROR_PARTIAL_BLOCK 2
+//-----------------------------------------------------------------------------
+// Stream context
+//
+// The context must be located in xdata, since the chain and buffer fields
+// are read by the DMA. The chain field holds the running initial vector
+// for CBC mode or the counter for CTR mode. The buffer holds the input
+// bytes of an incomplete CBC block or the unused key stream of the last
+// CTR block. The count field is the number of bytes held in the buffer.
+//-----------------------------------------------------------------------------
+typedef struct AES_STREAM_Struct
+{
+   U8 mode;
+   AES_STREAM_OPERATION operation;
+   U8 count;
+   VARIABLE_SEGMENT_POINTER(key, U8, SEG_XDATA);
+   U8 chain[16];
+   U8 buffer[16];
+} AES_STREAM;
+//-----------------------------------------------------------------------------
+// ENCRYPT_DECRYPT_AND_SIZE_Enum defined in AES_defs.h
+//-----------------------------------------------------------------------------
+//=============================================================================
+// Function Prototypes (API)
+//=============================================================================
+AES_STREAM_STATUS AES_StreamInit (
+   VARIABLE_SEGMENT_POINTER(context, AES_STREAM, SEG_XDATA),
+   U8 mode, AES_STREAM_OPERATION operation,
+   VARIABLE_SEGMENT_POINTER(iv, U8, SEG_XDATA),
+   VARIABLE_SEGMENT_POINTER(key, U8, SEG_XDATA));
+
+AES_STREAM_STATUS AES_StreamUpdate (
+   VARIABLE_SEGMENT_POINTER(context, AES_STREAM, SEG_XDATA),
+   VARIABLE_SEGMENT_POINTER(input, U8, SEG_XDATA),
+   VARIABLE_SEGMENT_POINTER(output, U8, SEG_XDATA),
+   U16 size, U16 *outputSize);
+
+AES_STREAM_STATUS AES_StreamFinal (
+   VARIABLE_SEGMENT_POINTER(context, AES_STREAM, SEG_XDATA));
+//=============================================================================
+// End of file
+//=============================================================================
+#endif  // #ifdef AES_STREAM_H
+//=============================================================================
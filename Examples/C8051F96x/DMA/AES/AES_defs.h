@@ -24,6 +24,10 @@
 #ifndef AES_DEFS_H
 #define AES_DEFS_H
 //-----------------------------------------------------------------------------
+// Decryption operations take the encryption key and use DecryptionKeyCache.c
+//-----------------------------------------------------------------------------
+//#define DECRYPTION_KEY_CACHE
+//-----------------------------------------------------------------------------
 // enum used for KEY_SIZE
 //-----------------------------------------------------------------------------
 enum KEY_SIZE_Enum
@@ -36,6 +36,9 @@
 #include "CBC_EncryptDecrypt.h"
 #include "DMA_defs.h"
 #include "AES_defs.h"
+#ifdef DECRYPTION_KEY_CACHE
+#include "DecryptionKeyCache.h"
+#endif
 //=============================================================================
 // API Functions
 //=============================================================================
@@ -136,6 +139,15 @@ CBC_ENCRYPT_DECRYPT_STATUS
       keyLength = (((operation & 0x03) + 2) << 3);
    }
 
+   #ifdef DECRYPTION_KEY_CACHE
+   // The key parameter is the encryption key. Use the cached decryption key
+   // for a decryption operation.
+   if((operation & ENCRYPTION_MODE) == 0)
+   {
+      key = GetDecryptionKey(key, (operation & 0x03));
+   }
+   #endif
+
    // Calculate plaintext and ciphertext total length.
    // Using <<4 in lieu of * 16 for code efficiency.
    length.U16 = (blocks << 4);
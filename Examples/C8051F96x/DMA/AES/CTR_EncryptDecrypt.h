@@ -54,6 +54,8 @@ CTR_ENCRYPT_DECRYPT_STATUS
    VARIABLE_SEGMENT_POINTER(counter, U8, SEG_XDATA),
    VARIABLE_SEGMENT_POINTER(key, U8, SEG_XDATA),
    U16 blocks);
+
+void IncrementCounter (VARIABLE_SEGMENT_POINTER(counter, U8, SEG_XDATA));
 //=============================================================================
 // End of file
 //=============================================================================
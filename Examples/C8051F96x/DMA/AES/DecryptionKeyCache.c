@@ -0,0 +1,166 @@
+//=============================================================================
+// DecryptionKeyCache.c
+//=============================================================================
+// Copyright 2010 Silicon Laboratories, Inc.
+// http://www.silabs.com
+//
+// C File Description:
+//
+//    Cache of decryption keys derived by GenerateDecryptionKey(). When
+//    DECRYPTION_KEY_CACHE is defined in AES_defs.h, AES_BlockCipher() and
+//    CBC_EncryptDecrypt() take the encryption key for decryption operations
+//    and look up the decryption key here.
+//
+// Target:
+//    C8051F960
+//
+// IDE:
+//    Silicon Laboratories IDE
+//
+// Tool Chains:
+//    Keil
+//    SDCC
+//    Raisonance
+//
+// Project Name:
+//    C8051F960 AES Code Examples
+//
+// This software must be used in accordance with the End User License Agreement.
+//
+//=============================================================================
+//-----------------------------------------------------------------------------
+// uncomment pragma SRC to generate assembly code
+//-----------------------------------------------------------------------------
+//#pragma SRC
+//=============================================================================
+// Includes
+//=============================================================================
+#include <compiler_defs.h>
+#include "C8051F960_defs.h"
+#include "DecryptionKeyCache.h"
+#include "GenerateDecryptionKey.h"
+#include "AES_defs.h"
+//=============================================================================
+// Global Variables
+//=============================================================================
+U16 DecryptionKeyCacheHits;
+U16 DecryptionKeyCacheMisses;
+//=============================================================================
+// File Global Variables
+//
+// Each entry is tagged with the xdata address and size of the encryption key
+// it was derived from. The size is stored as keySize + 1, so that zero marks
+// an empty entry.
+//
+//=============================================================================
+SEGMENT_VARIABLE (DecryptionKeyCacheData[DECRYPTION_KEY_CACHE_ENTRIES][32], U8, SEG_XDATA);
+U16 DecryptionKeyCacheTag[DECRYPTION_KEY_CACHE_ENTRIES];
+U8  DecryptionKeyCacheSize[DECRYPTION_KEY_CACHE_ENTRIES] = {0};
+U8  DecryptionKeyCacheNext;
+//=============================================================================
+// API Functions
+//=============================================================================
+//-----------------------------------------------------------------------------
+// GetDecryptionKey()
+//
+// parameters:
+//    encryptionKey     - xdata pointer to encryption key
+//    keySize           - enumerated type for key size 0/1/2 = 128/192/256
+//
+// returns:
+//    xdata pointer to the decryption key, or 0 for an invalid key size.
+//
+// description:
+//
+// This function returns the cached decryption key for the encryption key
+// at the given address. On a miss GenerateDecryptionKey() is called to
+// derive the key into the least recently filled entry.
+//
+// The cache does not read the encryption key on a hit. If the contents of
+// the encryption key are changed the application must call
+// InvalidateDecryptionKey() for that key before the next decryption.
+//
+// The returned pointer remains valid until DECRYPTION_KEY_CACHE_ENTRIES
+// other keys have been looked up, or the entry is invalidated.
+//
+// This function is blocking on a miss, the same as GenerateDecryptionKey().
+//
+//-----------------------------------------------------------------------------
+VARIABLE_SEGMENT_POINTER(GetDecryptionKey (
+   VARIABLE_SEGMENT_POINTER(encryptionKey, U8, SEG_XDATA), U8 keySize),
+   U8, SEG_XDATA)
+{
+   U8 i;
+
+   if(keySize >= KEY_SIZE_UNDEFINED)
+   {
+      return 0;
+   }
+
+   for(i = 0; i < DECRYPTION_KEY_CACHE_ENTRIES; i++)
+   {
+      if((DecryptionKeyCacheTag[i] == (U16)(encryptionKey)) &&
+         (DecryptionKeyCacheSize[i] == (keySize + 1)))
+      {
+         DecryptionKeyCacheHits++;
+         return DecryptionKeyCacheData[i];
+      }
+   }
+
+   DecryptionKeyCacheMisses++;
+
+   i = DecryptionKeyCacheNext;
+   DecryptionKeyCacheNext = (i + 1) % DECRYPTION_KEY_CACHE_ENTRIES;
+
+   GenerateDecryptionKey(encryptionKey, DecryptionKeyCacheData[i], keySize);
+
+   DecryptionKeyCacheTag[i] = (U16)(encryptionKey);
+   DecryptionKeyCacheSize[i] = keySize + 1;
+
+   return DecryptionKeyCacheData[i];
+}
+//-----------------------------------------------------------------------------
+// InvalidateDecryptionKey()
+//
+// parameters:
+//    encryptionKey     - xdata pointer to encryption key
+//
+// description:
+//
+// Removes all cached decryption keys derived from the encryption key at the
+// given address. Must be called after the encryption key is changed.
+//
+//-----------------------------------------------------------------------------
+void InvalidateDecryptionKey (
+   VARIABLE_SEGMENT_POINTER(encryptionKey, U8, SEG_XDATA))
+{
+   U8 i;
+
+   for(i = 0; i < DECRYPTION_KEY_CACHE_ENTRIES; i++)
+   {
+      if(DecryptionKeyCacheTag[i] == (U16)(encryptionKey))
+      {
+         DecryptionKeyCacheSize[i] = 0;
+      }
+   }
+}
+//-----------------------------------------------------------------------------
+// InvalidateDecryptionKeyCache()
+//
+// description:
+//
+// Removes all cached decryption keys.
+//
+//-----------------------------------------------------------------------------
+void InvalidateDecryptionKeyCache (void)
+{
+   U8 i;
+
+   for(i = 0; i < DECRYPTION_KEY_CACHE_ENTRIES; i++)
+   {
+      DecryptionKeyCacheSize[i] = 0;
+   }
+}
+//=============================================================================
+// End of file
+//=============================================================================
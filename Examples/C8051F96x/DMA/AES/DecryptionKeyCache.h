@@ -0,0 +1,62 @@
+#ifndef DECRYPTION_KEY_CACHE_H
+#define DECRYPTION_KEY_CACHE_H
+//=============================================================================
+// DecryptionKeyCache.h
+//=============================================================================
+// Copyright 2010 Silicon Laboratories, Inc.
+// http://www.silabs.com
+//
+// C File Description:
+//
+//    Cache of decryption keys derived by GenerateDecryptionKey().
+//
+// Target:
+//    C8051F960
+//
+// IDE:
+//    Silicon Laboratories IDE
+//
+// Tool Chains:
+//    Keil
+//    SDCC
+//    Raisonance
+//
+// Project Name:
+//    C8051F960 AES Library
+//
+// This software must be used in accordance with the End User License Agreement.
+//
+//=============================================================================
+#ifndef COMPILER_DEFS_H
+#include <compiler_defs.h>
+#endif
+#ifndef AES_DEFS_H
+#include <AES_defs.h>
+#endif
+//=============================================================================
+//-----------------------------------------------------------------------------
+// Number of cached decryption keys. Each entry uses 32 bytes of xdata.
+//-----------------------------------------------------------------------------
+#define DECRYPTION_KEY_CACHE_ENTRIES   4
+//-----------------------------------------------------------------------------
+// KEY_SIZE_Enum defined in AES_defs.h
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+// Public variables
+//-----------------------------------------------------------------------------
+extern U16 DecryptionKeyCacheHits;
+extern U16 DecryptionKeyCacheMisses;
+//=============================================================================
+// Function Prototypes (API)
+//=============================================================================
+VARIABLE_SEGMENT_POINTER(GetDecryptionKey (
+   VARIABLE_SEGMENT_POINTER(encryptionKey, U8, SEG_XDATA), U8 keySize),
+   U8, SEG_XDATA);
+void InvalidateDecryptionKey (
+   VARIABLE_SEGMENT_POINTER(encryptionKey, U8, SEG_XDATA));
+void InvalidateDecryptionKeyCache (void);
+//=============================================================================
+// End of file
+//=============================================================================
+#endif  // #ifdef DECRYPTION_KEY_CACHE_H
+//=============================================================================
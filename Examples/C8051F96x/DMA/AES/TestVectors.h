@@ -1,5 +1,5 @@
-#ifndef TEST_VECTORS_H
-#define TEST_VECTORS_H
+#ifndef AES_TEST_VECTORS_H
+#define AES_TEST_VECTORS_H
 //=============================================================================
 // TestVectors.h
 //-----------------------------------------------------------------------------
@@ -53,6 +53,6 @@ extern SEGMENT_VARIABLE (ReferenceCipherText_CTR_256[64], U8, SEG_CODE);
 //=============================================================================
 // End of file
 //=============================================================================
-#endif  // #ifdef TEST_VECTORS_H
+#endif  // #ifdef AES_TEST_VECTORS_H
 //=============================================================================
 
@@ -0,0 +1,306 @@
+//=============================================================================
+// CRC.c
+//=============================================================================
+// Copyright 2011 Silicon Laboratories, Inc.
+// http://www.silabs.com
+//
+// C File Description:
+//
+//    One CRC-16 API for all targets. The CRC engine used for xdata and for
+//    code memory is selected at compile time in CRC_defs.h:
+//
+//    - CRC1 with the DMA for xdata on the F96x. The core is in Idle mode
+//      while the DMA feeds the data.
+//    - CRC0 in automatic mode for whole Flash pages on parts that have it,
+//      CRC0 in manual mode for other data.
+//    - A table driven software CRC with a 16-entry nibble table for parts
+//      without a CRC engine.
+//
+//    All backends give the same result, so a CRC computed on one part can
+//    be checked on another.
+//
+// Target:
+//    C8051F960, any C8051 with or without CRC0
+//
+// IDE:
+//    Silicon Laboratories IDE
+//
+// Tool Chains:
+//    Keil
+//    SDCC
+//    Raisonance
+//
+// Project Name:
+//    C8051F960 Code Examples
+//
+// This software must be used in accordance with the End User License Agreement.
+//
+//=============================================================================
+//-----------------------------------------------------------------------------
+// uncomment pragma SRC to generate assembly code
+//-----------------------------------------------------------------------------
+//#pragma SRC
+//=============================================================================
+// Includes
+//=============================================================================
+#include <compiler_defs.h>
+#include "CRC_defs.h"
+#include "CRC.h"
+#if (CRC_XDATA_BACKEND == CRC_BACKEND_CRC1)
+#include "CRC1.h"
+#endif
+//=============================================================================
+// File Global Constants
+//=============================================================================
+//-----------------------------------------------------------------------------
+// CRC of each 4-bit value shifted into the top of the CRC register.
+//-----------------------------------------------------------------------------
+SEGMENT_VARIABLE (CRC_NibbleTable[16], U16, SEG_CODE) =
+{
+   0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+   0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF
+};
+//=============================================================================
+// API Functions
+//=============================================================================
+//-----------------------------------------------------------------------------
+// CRC_Xdata()
+//
+// parameters:
+//    input           - xdata pointer to the data
+//    size            - number of bytes, may be zero
+//    result          - generic pointer for the 16-bit result
+//
+// returns:
+//    status         - 0 for SUCCESS
+//
+// Description:
+//
+// Computes the CRC of data in xdata. With the CRC1 backend this uses
+// ComputeCRC1(), which requires the DMA ISR in the main module as for
+// the other DMA examples. The CRC of zero bytes is 0.
+//
+//-----------------------------------------------------------------------------
+CRC_STATUS CRC_Xdata (VARIABLE_SEGMENT_POINTER(input, U8, SEG_XDATA),
+   U16 size, U16 *result)
+{
+   if(size == 0)
+   {
+      *result = 0;
+      return SUCCESS;
+   }
+
+#if (CRC_XDATA_BACKEND == CRC_BACKEND_CRC1)
+   return ComputeCRC1(size, CRC_POLYNOMIAL, input, result);
+#elif (CRC_XDATA_BACKEND == CRC_BACKEND_CRC0)
+   *result = CRC_Crc0Manual(input, size);
+   return SUCCESS;
+#else
+   *result = CRC_Software(input, size);
+   return SUCCESS;
+#endif
+}
+//-----------------------------------------------------------------------------
+// CRC_Code()
+//
+// parameters:
+//    input           - code pointer to the data
+//    size            - number of bytes, may be zero
+//    result          - generic pointer for the 16-bit result
+//
+// returns:
+//    status         - 0 for SUCCESS
+//
+// Description:
+//
+// Computes the CRC of code memory. With the CRC0 backend whole Flash pages
+// use the automatic mode if the part has it, which is about ten times
+// faster than feeding each byte. Any other range uses the manual mode.
+//
+// The automatic mode reads the bank selected by PSBANK on 128 kB parts.
+// Data above 0x8000 in another bank must be checked with the bank
+// selected, from code in the common area.
+//
+//-----------------------------------------------------------------------------
+CRC_STATUS CRC_Code (VARIABLE_SEGMENT_POINTER(input, U8, SEG_CODE),
+   U16 size, U16 *result)
+{
+#if (CRC_CODE_BACKEND == CRC_BACKEND_CRC0)
+#ifdef CRC_CRC0_AUTO
+   U16 address;
+
+   address = (U16)input;
+
+   if((size != 0) &&
+      ((address % CRC_FLASH_PAGE_SIZE) == 0) &&
+      ((size % CRC_FLASH_PAGE_SIZE) == 0))
+   {
+      *result = CRC_Crc0Auto((U8)(address / CRC_FLASH_PAGE_SIZE),
+         (U8)(size / CRC_FLASH_PAGE_SIZE));
+   }
+   else
+#endif
+   {
+      *result = CRC_Crc0Manual(input, size);
+   }
+#else
+   *result = CRC_Software(input, size);
+#endif
+
+   return SUCCESS;
+}
+//=============================================================================
+// Backend Functions
+//=============================================================================
+//-----------------------------------------------------------------------------
+// CRC_Software()
+//
+// parameters:
+//    input           - generic pointer to the data
+//    size            - number of bytes
+//
+// returns:
+//    CRC of the data
+//
+// Description:
+//
+// Table driven CRC, one nibble at a time. The 16-entry table takes 32
+// bytes of code instead of 512 bytes for a byte table.
+//
+//-----------------------------------------------------------------------------
+U16 CRC_Software (U8 *input, U16 size)
+{
+   UU16 crc;
+   U8 index;
+
+   crc.U16 = 0;
+
+   while(size--)
+   {
+      crc.U8[MSB] ^= *input++;
+
+      index = crc.U8[MSB] >> 4;
+      crc.U16 = (crc.U16 << 4) ^ CRC_NibbleTable[index];
+
+      index = crc.U8[MSB] >> 4;
+      crc.U16 = (crc.U16 << 4) ^ CRC_NibbleTable[index];
+   }
+
+   return crc.U16;
+}
+#ifndef CRC_TARGET_SOFTWARE
+//-----------------------------------------------------------------------------
+// CRC_Crc0Manual()
+//
+// parameters:
+//    input           - generic pointer to the data
+//    size            - number of bytes
+//
+// returns:
+//    CRC of the data
+//
+// Description:
+//
+// Writes each byte to CRC0IN, as Byte_CRC16() in the CRC0 examples.
+//
+//-----------------------------------------------------------------------------
+U16 CRC_Crc0Manual (U8 *input, U16 size)
+{
+   UU16 crc;
+#ifdef CRC_SFR_PAGE
+   U8 restore;
+
+   restore = SFRPAGE;
+   SFRPAGE = CRC_SFR_PAGE;
+#endif
+
+   // set CRC0SEL to 1 (16-bit calc)
+   CRC0CN |= 0x10;
+   // initialize CRC result to 0x00 and clear the current result.
+   CRC0CN |= 0x08;
+
+   while(size--)
+   {
+      CRC0IN = *input++;
+   }
+
+   // Initialize CRC0PNT to access bits 7-0 of the CRC result
+   CRC0CN &= ~0x03;
+
+   // With each read of CRC0DAT, the value in CRC0PNT will auto-increment
+   crc.U8[LSB] = CRC0DAT;
+   crc.U8[MSB] = CRC0DAT;
+
+#ifdef CRC_SFR_PAGE
+   SFRPAGE = restore;
+#endif
+
+   return crc.U16;
+}
+#ifdef CRC_CRC0_AUTO
+//-----------------------------------------------------------------------------
+// CRC_Crc0Auto()
+//
+// parameters:
+//    startPage       - first Flash page, address / CRC_FLASH_PAGE_SIZE
+//    pages           - number of Flash pages
+//
+// returns:
+//    CRC of the pages
+//
+// Description:
+//
+// Uses the CRC0 automatic mode, as Auto_CRC16() in the CRC0 examples. The
+// core is stalled while the pages are read, so interrupts are disabled.
+//
+//-----------------------------------------------------------------------------
+U16 CRC_Crc0Auto (U8 startPage, U8 pages)
+{
+   UU16 crc;
+   bit restoreEA;
+#ifdef CRC_SFR_PAGE
+   U8 restore;
+
+   restore = SFRPAGE;
+   SFRPAGE = CRC_SFR_PAGE;
+#endif
+
+   restoreEA = EA;
+   EA = 0;
+
+   // set CRC0SEL to 1 (16-bit calc)
+   CRC0CN |= 0x10;
+   // initialize CRC result to 0x00 and clear the current result.
+   CRC0CN |= 0x08;
+
+   // set starting page and number of pages
+   CRC0AUTO = startPage;
+   CRC0CNT = pages;
+
+   // set AUTOEN to enable automatic computation
+   CRC0AUTO |= 0x80;
+
+   // write to CRC0CN to start computation
+   CRC0CN &= ~0x03;
+
+   // follow AUTO CRC with benign 3-byte opcode
+   CRC0FLIP = 0xFF;                    // benign 3-byte opcode
+   CRC0AUTO &= ~0x80;                  // clear AUTOEN
+
+   EA = restoreEA;
+
+   // CRC0PNT was cleared above to start the computation.
+   crc.U8[LSB] = CRC0DAT;
+   crc.U8[MSB] = CRC0DAT;
+
+#ifdef CRC_SFR_PAGE
+   SFRPAGE = restore;
+#endif
+
+   return crc.U16;
+}
+#endif // #ifdef CRC_CRC0_AUTO
+#endif // #ifndef CRC_TARGET_SOFTWARE
+//=============================================================================
+// End of file
+//=============================================================================
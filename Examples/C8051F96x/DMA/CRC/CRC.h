@@ -0,0 +1,78 @@
+#ifndef CRC_H
+#define CRC_H
+//=============================================================================
+// CRC.h
+//=============================================================================
+// Copyright 2011 Silicon Laboratories, Inc.
+// http://www.silabs.com
+//
+// C File Description:
+//
+//    CRC-16 of xdata or code memory using the fastest CRC engine of the
+//    target. See CRC_defs.h.
+//
+// Target:
+//    C8051F960, any C8051 with or without CRC0
+//
+// IDE:
+//    Silicon Laboratories IDE
+//
+// Tool Chains:
+//    Keil
+//    SDCC
+//    Raisonance
+//
+// Project Name:
+//    C8051F960 Code Examples
+//
+// This software must be used in accordance with the End User License Agreement.
+//
+//=============================================================================
+#ifndef COMPILER_DEFS_H
+#include <compiler_defs.h>
+#endif
+#ifndef CRC_DEFS_H
+#include "CRC_defs.h"
+#endif
+//-----------------------------------------------------------------------------
+// The CRC is the 16-bit CRC used by CRC0: polynomial 0x1021, msb first,
+// initial value 0, no final inversion. The CRC of "123456789" is 0x31C3.
+//-----------------------------------------------------------------------------
+#define CRC_POLYNOMIAL  0x1021
+//-----------------------------------------------------------------------------
+// Define SUCCESS if not already defined
+//-----------------------------------------------------------------------------
+#ifndef SUCCESS
+#define SUCCESS 0
+#elif(SUCCESS!=0)
+#error  "SUCCESS definition conflict!"
+#endif
+//-----------------------------------------------------------------------------
+// typedef for status
+//-----------------------------------------------------------------------------
+typedef U8 CRC_STATUS;
+//=============================================================================
+// Function Prototypes (API)
+//=============================================================================
+CRC_STATUS CRC_Xdata (VARIABLE_SEGMENT_POINTER(input, U8, SEG_XDATA),
+   U16 size, U16 *result);
+CRC_STATUS CRC_Code (VARIABLE_SEGMENT_POINTER(input, U8, SEG_CODE),
+   U16 size, U16 *result);
+//=============================================================================
+// Function Prototypes (backends)
+//
+// The backends available on the target may also be called directly, for
+// example to compare their speed.
+//=============================================================================
+U16 CRC_Software (U8 *input, U16 size);
+#ifndef CRC_TARGET_SOFTWARE
+U16 CRC_Crc0Manual (U8 *input, U16 size);
+#ifdef CRC_CRC0_AUTO
+U16 CRC_Crc0Auto (U8 startPage, U8 pages);
+#endif
+#endif
+//=============================================================================
+// End of file
+//=============================================================================
+#endif  // #ifdef CRC_H
+//=============================================================================
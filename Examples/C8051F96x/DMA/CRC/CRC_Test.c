@@ -0,0 +1,242 @@
+//=============================================================================
+// CRC_Test.c
+//=============================================================================
+// Copyright 2011 Silicon Laboratories, Inc.
+// http://www.silabs.com
+//
+// C File Description:
+//
+//    This file is the main module for CRC.c. It checks that all backends
+//    give the same CRC and measures the SYSCLK cycles taken by each one.
+//
+// Target:
+//    C8051F960
+//
+// IDE:
+//    Silicon Laboratories IDE
+//
+// Tool Chains:
+//    Keil
+//    SDCC
+//    Raisonance
+//
+// Project Name:
+//    C8051F960 Code Examples
+//
+// This software must be used in accordance with the End User License Agreement.
+//
+//=============================================================================
+//-----------------------------------------------------------------------------
+// uncomment pragma SRC to generate assemble code
+//-----------------------------------------------------------------------------
+//#pragma SRC
+//-----------------------------------------------------------------------------
+// Includes
+//-----------------------------------------------------------------------------
+#include <compiler_defs.h>
+#include "C8051F960_defs.h"
+#include "CRC.h"
+//-----------------------------------------------------------------------------
+// Benchmark sizes
+//-----------------------------------------------------------------------------
+#define DATA_SIZE       256            // bytes per backend
+#define CODE_PAGE       2              // Flash page used for the code tests
+//-----------------------------------------------------------------------------
+// Indexes into Cycles[]
+//-----------------------------------------------------------------------------
+enum BENCHMARK_Enum
+{
+   SOFTWARE_XDATA = 0,                 // 256 bytes xdata, nibble table
+   CRC0_MANUAL_XDATA,                  // 256 bytes xdata, CRC0IN writes
+   CRC1_DMA_XDATA,                     // 256 bytes xdata, CRC_Xdata()
+   SOFTWARE_CODE,                      // 256 bytes code, nibble table
+   CRC0_MANUAL_CODE,                   // 256 bytes code, CRC0IN writes
+   CRC0_AUTO_PAGE,                     // 1024 bytes code, CRC_Code()
+   BENCHMARKS
+};
+//=============================================================================
+// File global variables
+//=============================================================================
+SEGMENT_VARIABLE (myData[DATA_SIZE], U8, SEG_XDATA);
+
+SEGMENT_VARIABLE (CheckString[9], U8, SEG_CODE) =
+{
+   '1', '2', '3', '4', '5', '6', '7', '8', '9'
+};
+
+//-----------------------------------------------------------------------------
+// SYSCLK cycles for each benchmark, including the function call. View
+// with the debugger after the code reaches the end of main.
+//-----------------------------------------------------------------------------
+U16 Cycles[BENCHMARKS];
+U16 Results[BENCHMARKS];
+//=============================================================================
+// Function Prototypes
+//=============================================================================
+//-----------------------------------------------------------------------------
+// Interrupt proto (for SDCC compatibility)
+//-----------------------------------------------------------------------------
+INTERRUPT_PROTO(DMA_ISR, INTERRUPT_DMA0);
+//-----------------------------------------------------------------------------
+// Timer functions
+//-----------------------------------------------------------------------------
+void Timer2_Init (void);
+void startTimer (void);
+U16  stopTimer (void);
+//=============================================================================
+// main
+//=============================================================================
+//-----------------------------------------------------------------------------
+// main()
+//
+// Parameters: none
+// Returns: none
+//
+// Description:
+//
+// This main module program serves as a code example for CRC.c and as a
+// benchmark of the CRC backends.
+//
+// First the CRC of "123456789" is checked against 0x31C3 for the software
+// and CRC0 backends. Then each backend is timed with Timer2 counting
+// SYSCLK cycles, over 256 bytes of xdata, 256 bytes of code and one Flash
+// page. The results of all backends over the same data must be equal.
+//
+// The project also requires:
+// CRC.c
+// CRC1.c
+//
+// Steps to use:
+// Compile and download the code. Run code. If the code does not reach the
+// while(1) at the end of main, halt debugger and check code location.
+// The cycle counts are then in the Cycles array.
+//
+// This simple test code will hang just after the respective test
+// if any test fails.
+//-----------------------------------------------------------------------------
+void main (void)
+{
+   VARIABLE_SEGMENT_POINTER (codePtr, U8, SEG_CODE);
+   U16 crc;
+   U16 i;
+
+   PCA0MD  &= ~0x40;                   // disable watchdog timer
+
+   Timer2_Init();
+
+   EA = 1;                             // enable global interrupts
+
+   // check value
+   crc = CRC_Software(CheckString, 9);
+   while(crc != 0x31C3);               // code will hang here on error.
+
+   crc = CRC_Crc0Manual(CheckString, 9);
+   while(crc != 0x31C3);               // code will hang here on error.
+
+   for(i = 0; i < DATA_SIZE; i++)
+   {
+      myData[i] = (U8)(i * 7 + 3);
+   }
+
+   // xdata
+   startTimer();
+   Results[SOFTWARE_XDATA] = CRC_Software(myData, DATA_SIZE);
+   Cycles[SOFTWARE_XDATA] = stopTimer();
+
+   startTimer();
+   Results[CRC0_MANUAL_XDATA] = CRC_Crc0Manual(myData, DATA_SIZE);
+   Cycles[CRC0_MANUAL_XDATA] = stopTimer();
+
+   startTimer();
+   CRC_Xdata(myData, DATA_SIZE, &Results[CRC1_DMA_XDATA]);
+   Cycles[CRC1_DMA_XDATA] = stopTimer();
+
+   // code
+   codePtr = (CRC_FLASH_PAGE_SIZE * CODE_PAGE);
+
+   startTimer();
+   Results[SOFTWARE_CODE] = CRC_Software(codePtr, DATA_SIZE);
+   Cycles[SOFTWARE_CODE] = stopTimer();
+
+   startTimer();
+   Results[CRC0_MANUAL_CODE] = CRC_Crc0Manual(codePtr, DATA_SIZE);
+   Cycles[CRC0_MANUAL_CODE] = stopTimer();
+
+   startTimer();
+   CRC_Code(codePtr, CRC_FLASH_PAGE_SIZE, &Results[CRC0_AUTO_PAGE]);
+   Cycles[CRC0_AUTO_PAGE] = stopTimer();
+
+   // All backends must agree on the same data.
+   while(Results[CRC0_MANUAL_XDATA] != Results[SOFTWARE_XDATA]);
+   while(Results[CRC1_DMA_XDATA] != Results[SOFTWARE_XDATA]);
+   while(Results[CRC0_MANUAL_CODE] != Results[SOFTWARE_CODE]);
+
+   crc = CRC_Software(codePtr, CRC_FLASH_PAGE_SIZE);
+   while(Results[CRC0_AUTO_PAGE] != crc);
+
+   while(1);
+}
+//-----------------------------------------------------------------------------
+// DMA_ISR
+// description:
+//
+// This ISR is needed to support the DMA Idle mode wake up, which is used
+// in the CRC1 backend. This ISR will disable further interrupts. EA must
+// also be enabled.
+//
+//-----------------------------------------------------------------------------
+INTERRUPT(DMA_ISR, INTERRUPT_DMA0)
+{
+   EIE2 &= ~0x20;                      // disable further interrupts
+}
+//-----------------------------------------------------------------------------
+// Timer2_Init()
+//
+// description:
+//
+// Configures Timer2 as a 16-bit timer clocked by SYSCLK. The timer is
+// stopped.
+//
+//-----------------------------------------------------------------------------
+void Timer2_Init (void)
+{
+   SFRPAGE = LEGACY_PAGE;
+   CKCON |= 0x10;                      // Timer2 uses SYSCLK
+   TMR2CN = 0x00;                      // 16-bit mode, stopped
+   TMR2RL = 0;
+}
+//-----------------------------------------------------------------------------
+// startTimer()
+//
+// description:
+//
+// Clears and starts Timer2.
+//
+//-----------------------------------------------------------------------------
+void startTimer (void)
+{
+   SFRPAGE = LEGACY_PAGE;
+   TMR2 = 0;
+   TR2 = 1;
+}
+//-----------------------------------------------------------------------------
+// stopTimer()
+//
+// returns:
+//    SYSCLK cycles since startTimer()
+//
+// description:
+//
+// Stops Timer2 and returns the count. The counts are less than 65536 for
+// the sizes used here at any SYSCLK.
+//
+//-----------------------------------------------------------------------------
+U16 stopTimer (void)
+{
+   SFRPAGE = LEGACY_PAGE;
+   TR2 = 0;
+   return TMR2;
+}
+//=============================================================================
+// End of file
+//=============================================================================
@@ -0,0 +1,143 @@
+//-----------------------------------------------------------------------------
+//CRC_defs.h
+//-----------------------------------------------------------------------------
+// Copyright 2011 Silicon Laboratories, Inc.
+// http://www.silabs.com
+//
+// Program Description:
+//
+// Target and backend selection for CRC.c.
+//
+// Target:         C8051F96x, any C8051 with or without CRC0
+// Tool chain:     Keil, SDCC
+// Command Line:   None
+//
+//-----------------------------------------------------------------------------
+// Include compiler_defs.h if not already defined.
+//-----------------------------------------------------------------------------
+#ifndef COMPILER_DEFS_H
+#include <compiler_defs.h>
+#endif
+//-----------------------------------------------------------------------------
+// Header file applied only if not already defined.
+//-----------------------------------------------------------------------------
+#ifndef CRC_DEFS_H
+#define CRC_DEFS_H
+//-----------------------------------------------------------------------------
+// Target selection, define exactly one.
+//
+// CRC_TARGET_F96X     - xdata through CRC1 and the DMA, code through CRC0
+// CRC_TARGET_CRC0     - all data through CRC0, select the part below
+// CRC_TARGET_SOFTWARE - parts without a CRC engine, such as F32x and F50x
+//-----------------------------------------------------------------------------
+#define CRC_TARGET_F96X
+//#define CRC_TARGET_CRC0
+//#define CRC_TARGET_SOFTWARE
+//-----------------------------------------------------------------------------
+// Part selection for CRC_TARGET_CRC0, define exactly one.
+//-----------------------------------------------------------------------------
+//#define CRC_PART_F41X
+//#define CRC_PART_F70X
+//#define CRC_PART_F80X
+//#define CRC_PART_F91X
+//#define CRC_PART_F99X
+//#define CRC_PART_SI100X
+//#define CRC_PART_SI101X
+//-----------------------------------------------------------------------------
+// SFR definitions and CRC0 details for the part
+//
+// CRC_FLASH_PAGE_SIZE - Flash page size used by the CRC0 automatic mode
+// CRC_SFR_PAGE        - SFR page of CRC0, not defined for unpaged parts
+// CRC_CRC0_AUTO       - defined if CRC0 has the automatic mode
+//-----------------------------------------------------------------------------
+#ifdef CRC_TARGET_F96X
+#include <C8051F960_defs.h>
+#define CRC_FLASH_PAGE_SIZE   1024
+#define CRC_SFR_PAGE          CRC0_PAGE
+#define CRC_CRC0_AUTO
+#endif
+
+#ifdef CRC_TARGET_CRC0
+
+#ifdef CRC_PART_F41X
+#include <C8051F410_defs.h>
+#define CRC_FLASH_PAGE_SIZE   512
+#endif
+
+#ifdef CRC_PART_F70X
+#include <C8051F700_defs.h>
+#define CRC_FLASH_PAGE_SIZE   512
+#define CRC_SFR_PAGE          CONFIG_PAGE
+#define CRC_CRC0_AUTO
+#define CRC0DAT               CRC0DATA
+#endif
+
+#ifdef CRC_PART_F80X
+#include <C8051F800_defs.h>
+#define CRC_FLASH_PAGE_SIZE   512
+#define CRC_CRC0_AUTO
+#define CRC0DAT               CRC0DATA
+#endif
+
+#ifdef CRC_PART_F91X
+#include <C8051F912_defs.h>
+#define CRC_FLASH_PAGE_SIZE   512
+#define CRC_SFR_PAGE          CRC0_PAGE
+#define CRC_CRC0_AUTO
+#endif
+
+#ifdef CRC_PART_F99X
+#include <C8051F990_defs.h>
+#define CRC_FLASH_PAGE_SIZE   512
+#define CRC_SFR_PAGE          CRC0_PAGE
+#define CRC_CRC0_AUTO
+#endif
+
+#ifdef CRC_PART_SI100X
+#include <Si1000_defs.h>
+#define CRC_FLASH_PAGE_SIZE   1024
+#define CRC_SFR_PAGE          CRC0_PAGE
+#define CRC_CRC0_AUTO
+#endif
+
+#ifdef CRC_PART_SI101X
+#include <Si1010_defs.h>
+#define CRC_FLASH_PAGE_SIZE   512
+#define CRC_SFR_PAGE          CRC0_PAGE
+#define CRC_CRC0_AUTO
+#endif
+
+#ifndef CRC_FLASH_PAGE_SIZE
+#error  "CRC_defs.h: no part selected for CRC_TARGET_CRC0!"
+#endif
+
+#endif // #ifdef CRC_TARGET_CRC0
+//-----------------------------------------------------------------------------
+// Backends selected for the target
+//-----------------------------------------------------------------------------
+#define CRC_BACKEND_SOFTWARE  0
+#define CRC_BACKEND_CRC0      1
+#define CRC_BACKEND_CRC1      2
+
+#ifdef CRC_TARGET_F96X
+#define CRC_XDATA_BACKEND     CRC_BACKEND_CRC1
+#define CRC_CODE_BACKEND      CRC_BACKEND_CRC0
+#endif
+
+#ifdef CRC_TARGET_CRC0
+#define CRC_XDATA_BACKEND     CRC_BACKEND_CRC0
+#define CRC_CODE_BACKEND      CRC_BACKEND_CRC0
+#endif
+
+#ifdef CRC_TARGET_SOFTWARE
+#define CRC_XDATA_BACKEND     CRC_BACKEND_SOFTWARE
+#define CRC_CODE_BACKEND      CRC_BACKEND_SOFTWARE
+#endif
+
+#ifndef CRC_XDATA_BACKEND
+#error  "CRC_defs.h: no target selected!"
+#endif
+//-----------------------------------------------------------------------------
+// End CRC_defs.h
+//-----------------------------------------------------------------------------
+#endif                                 // CRC_DEFS_H
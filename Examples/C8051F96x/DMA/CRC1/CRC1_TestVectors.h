@@ -1,5 +1,5 @@
-#ifndef TEST_VECTORS_H
-#define TEST_VECTORS_H
+#ifndef CRC1_TEST_VECTORS_H
+#define CRC1_TEST_VECTORS_H
 //=============================================================================
 // TestVectors.h
 //-----------------------------------------------------------------------------
@@ -40,5 +40,5 @@ extern SEGMENT_VARIABLE (BlockTwo[6], U8, SEG_CODE);
 //=============================================================================
 // End of file
 //=============================================================================
-#endif  // #ifdef TEST_VECTORS_H
+#endif  // #ifdef CRC1_TEST_VECTORS_H
 //=============================================================================
@@ -0,0 +1,309 @@
+//=============================================================================
+// CRC1_Verify.c
+//=============================================================================
+// Copyright 2011 Silicon Laboratories, Inc.
+// http://www.silabs.com
+//
+// C File Description:
+//
+//    This C file is a reusable code module to verify a Flash or xdata
+//    region, such as a firmware image after a field update, against an
+//    expected CRC using ComputeCRC1().
+//
+//    Flash regions checked with the CRC0 polynomial use CRC_Code() from
+//    ../CRC/CRC.c, which must be added to the project.
+//
+// Target:
+//    C8051F960
+//
+// IDE:
+//    Silicon Laboratories IDE
+//
+// Tool Chains:
+//    Keil
+//    SDCC
+//    Raisonance
+//
+// Project Name:
+//    C8051F960 Code Examples
+//
+// This software must be used in accordance with the End User License Agreement.
+//
+//=============================================================================
+//-----------------------------------------------------------------------------
+// uncomment pragma SRC to generate assembly code
+//-----------------------------------------------------------------------------
+//#pragma SRC
+//=============================================================================
+// Includes
+//=============================================================================
+#include <compiler_defs.h>
+#include <C8051F960_defs.h>
+#include "CRC1.h"
+#include "CRC1_Verify.h"
+#include "CRC.h"
+//=============================================================================
+// File Global Variables
+//=============================================================================
+SEGMENT_VARIABLE (CRC1_Chunk[CRC1_VERIFY_CHUNK_SIZE], U8, SEG_XDATA);
+//=============================================================================
+// Internal Function Prototypes
+//=============================================================================
+static CRC1_STATUS CRC1_Software (U16 size, U16 polynomial, U8 *input,
+   U16 *results);
+//=============================================================================
+// API Functions
+//=============================================================================
+//-----------------------------------------------------------------------------
+// ComputeCRC1Code()
+//
+// parameters:
+//    size            - size of the Flash region
+//    polynomial      - 16-bit polynomial in normal msb first notation
+//    input           - code pointer to the Flash region
+//    results*        - generic pointer for 16-bit results
+//
+// returns:
+//    status         - 0 for SUCCESS
+//                   - 1 for CRC1_ERROR_INVALID_POLYNOMIAL
+//                   - 2 for CRC_ERROR_ZERO_LENGTH
+//
+// Description:
+//
+// Computes the same CRC as ComputeCRC1() for a region of Flash.
+//
+// With the CRC0 polynomial, CRC_POLYNOMIAL in CRC.h, the region is passed
+// to CRC_Code(). CRC0 reads Flash directly, in automatic mode for whole
+// pages, so no copy is needed. Regions shorter than CRC1_VERIFY_MIN_CHUNK
+// are computed in software.
+//
+// Otherwise the region is copied to an xdata buffer, because the DMA reads
+// xdata only. The copy is CRC1_VERIFY_CHUNK_SIZE bytes at a time and each
+// chunk is passed to ComputeCRC1(). The core is in Idle mode while the DMA
+// feeds each chunk, but the copy loop runs on the CPU for every byte.
+//
+// ComputeCRC1() always starts from a zero CRC. For a msb first CRC with
+// no final inversion, starting from a CRC value is the same as starting
+// from zero with the value XORed into the first two data bytes. So the
+// CRC of the previous chunks is XORed into the first two bytes of each
+// chunk after it is copied. All chunks are at least CRC1_VERIFY_MIN_CHUNK
+// bytes long.
+//
+// On 128 kB devices the region must be in the common area or in the bank
+// selected by PSBANK.
+//
+//-----------------------------------------------------------------------------
+CRC1_STATUS ComputeCRC1Code (U16 size, U16 polynomial,
+   VARIABLE_SEGMENT_POINTER(input, U8, SEG_CODE), U16 *results)
+{
+   UU16 crc;
+   U16 chunk;
+   U16 i;
+   U8 status;
+
+   if (size == 0)
+   {
+      return CRC1_ERROR_ZERO_LENGTH;
+   }
+
+   if (polynomial == CRC_POLYNOMIAL)
+   {
+      return CRC_Code(input, size, results);
+   }
+
+   if (size < CRC1_VERIFY_MIN_CHUNK)
+   {
+      return CRC1_Software(size, polynomial, input, results);
+   }
+
+   crc.U16 = 0;
+
+   while (size)
+   {
+      chunk = size;
+      if (chunk > CRC1_VERIFY_CHUNK_SIZE)
+      {
+         chunk = CRC1_VERIFY_CHUNK_SIZE;
+
+         // Leave at least CRC1_VERIFY_MIN_CHUNK bytes for the last chunk.
+         if ((size - chunk) < CRC1_VERIFY_MIN_CHUNK)
+         {
+            chunk -= CRC1_VERIFY_MIN_CHUNK;
+         }
+      }
+
+      for (i = 0; i < chunk; i++)
+      {
+         CRC1_Chunk[i] = *input++;
+      }
+
+      // Carry the CRC of the previous chunks into this chunk. The CRC is
+      // zero for the first chunk.
+      CRC1_Chunk[0] ^= crc.U8[MSB];
+      CRC1_Chunk[1] ^= crc.U8[LSB];
+
+      status = ComputeCRC1(chunk, polynomial, CRC1_Chunk, &crc.U16);
+
+      if (status != SUCCESS)
+      {
+         return status;
+      }
+
+      size -= chunk;
+   }
+
+   *results = crc.U16;
+
+   return SUCCESS;
+}
+//-----------------------------------------------------------------------------
+// VerifyCRC1Code()
+//
+// parameters:
+//    size            - size of the Flash region
+//    polynomial      - 16-bit polynomial in normal msb first notation
+//    input           - code pointer to the Flash region
+//    expected        - expected CRC of the region
+//
+// returns:
+//    status         - 0 for SUCCESS
+//                   - 1 for CRC1_ERROR_INVALID_POLYNOMIAL
+//                   - 2 for CRC_ERROR_ZERO_LENGTH
+//                   - 3 for CRC1_ERROR_MISMATCH
+//
+// Description:
+//
+// Computes the CRC of a Flash region with ComputeCRC1Code() and compares it
+// with the expected value.
+//
+//-----------------------------------------------------------------------------
+CRC1_STATUS VerifyCRC1Code (U16 size, U16 polynomial,
+   VARIABLE_SEGMENT_POINTER(input, U8, SEG_CODE), U16 expected)
+{
+   U16 crc;
+   U8 status;
+
+   status = ComputeCRC1Code(size, polynomial, input, &crc);
+
+   if (status != SUCCESS)
+   {
+      return status;
+   }
+
+   if (crc != expected)
+   {
+      return CRC1_ERROR_MISMATCH;
+   }
+
+   return SUCCESS;
+}
+//-----------------------------------------------------------------------------
+// VerifyCRC1Xdata()
+//
+// parameters:
+//    size            - size of the xdata region
+//    polynomial      - 16-bit polynomial in normal msb first notation
+//    input           - xdata pointer to the region
+//    expected        - expected CRC of the region
+//
+// returns:
+//    status         - 0 for SUCCESS
+//                   - 1 for CRC1_ERROR_INVALID_POLYNOMIAL
+//                   - 2 for CRC_ERROR_ZERO_LENGTH
+//                   - 3 for CRC1_ERROR_MISMATCH
+//
+// Description:
+//
+// Computes the CRC of an xdata region with a single ComputeCRC1() call and
+// compares it with the expected value. The DMA reads the region in place,
+// so no copy is needed. Regions shorter than CRC1_VERIFY_MIN_CHUNK are
+// computed in software.
+//
+//-----------------------------------------------------------------------------
+CRC1_STATUS VerifyCRC1Xdata (U16 size, U16 polynomial,
+   VARIABLE_SEGMENT_POINTER(input, U8, SEG_XDATA), U16 expected)
+{
+   U16 crc;
+   U8 status;
+
+   if ((size != 0) && (size < CRC1_VERIFY_MIN_CHUNK))
+   {
+      status = CRC1_Software(size, polynomial, input, &crc);
+   }
+   else
+   {
+      status = ComputeCRC1(size, polynomial, input, &crc);
+   }
+
+   if (status != SUCCESS)
+   {
+      return status;
+   }
+
+   if (crc != expected)
+   {
+      return CRC1_ERROR_MISMATCH;
+   }
+
+   return SUCCESS;
+}
+//=============================================================================
+// Internal Functions
+//=============================================================================
+//-----------------------------------------------------------------------------
+// CRC1_Software()
+//
+// parameters:
+//    size            - number of bytes, not zero
+//    polynomial      - 16-bit polynomial in normal msb first notation
+//    input           - generic pointer to the data
+//    results*        - generic pointer for 16-bit results
+//
+// returns:
+//    status         - 0 for SUCCESS
+//                   - 1 for CRC1_ERROR_INVALID_POLYNOMIAL
+//
+// Description:
+//
+// Bitwise CRC with the same result as ComputeCRC1(), for regions too short
+// for the DMA.
+//
+//-----------------------------------------------------------------------------
+static CRC1_STATUS CRC1_Software (U16 size, U16 polynomial, U8 *input,
+   U16 *results)
+{
+   U16 crc;
+   U8 i;
+
+   // polynomial must have a x^0 term
+   if ((polynomial & 0x0001) == 0)
+   {
+      return CRC1_ERROR_INVALID_POLYNOMIAL;
+   }
+
+   crc = 0;
+
+   while (size--)
+   {
+      crc ^= (U16)(*input++) << 8;
+
+      for (i = 0; i < 8; i++)
+      {
+         if (crc & 0x8000)
+         {
+            crc = (crc << 1) ^ polynomial;
+         }
+         else
+         {
+            crc = crc << 1;
+         }
+      }
+   }
+
+   *results = crc;
+
+   return SUCCESS;
+}
+//=============================================================================
+// End of file
+//=============================================================================
@@ -0,0 +1,67 @@
+#ifndef CRC1_VERIFY_H
+#define CRC1_VERIFY_H
+//=============================================================================
+// CRC1_Verify.h
+//-----------------------------------------------------------------------------
+// Copyright 2011 Silicon Laboratories, Inc.
+// http://www.silabs.com
+//
+// C File Description:
+//
+//    CRC1 verification of Flash and xdata regions.
+//
+// Target:
+//    C8051F960
+//
+// IDE:
+//    Silicon Laboratories IDE
+//
+// Tool Chains:
+//    Keil
+//    SDCC
+//    Raisonance
+//
+// Project Name:
+//    C8051F960 Code Examples
+//
+// This software must be used in accordance with the End User License Agreement.
+//
+//=============================================================================
+#ifndef COMPILER_DEFS_H
+#include <compiler_defs.h>
+#endif
+#ifndef CRC1_H
+#include "CRC1.h"
+#endif
+//-----------------------------------------------------------------------------
+// Size of the xdata buffer used to pass Flash data to the DMA. Larger
+// chunks take fewer DMA transfers.
+//-----------------------------------------------------------------------------
+#define CRC1_VERIFY_CHUNK_SIZE   256
+//-----------------------------------------------------------------------------
+// Smallest transfer passed to ComputeCRC1(). ComputeCRC1() enables the DMA
+// interrupt after starting the transfer, so a very short transfer could
+// complete before the core enters Idle mode. Shorter regions are computed
+// in software.
+//-----------------------------------------------------------------------------
+#define CRC1_VERIFY_MIN_CHUNK    16
+//-----------------------------------------------------------------------------
+// Error code in addition to CRC1_ERROR_CODES_Enum in CRC1.h
+//-----------------------------------------------------------------------------
+#define CRC1_ERROR_MISMATCH      3
+//=============================================================================
+// Function Prototypes (API)
+//=============================================================================
+CRC1_STATUS ComputeCRC1Code (U16 size, U16 polynomial,
+   VARIABLE_SEGMENT_POINTER(input, U8, SEG_CODE), U16 *results);
+
+CRC1_STATUS VerifyCRC1Code (U16 size, U16 polynomial,
+   VARIABLE_SEGMENT_POINTER(input, U8, SEG_CODE), U16 expected);
+
+CRC1_STATUS VerifyCRC1Xdata (U16 size, U16 polynomial,
+   VARIABLE_SEGMENT_POINTER(input, U8, SEG_XDATA), U16 expected);
+//=============================================================================
+// End of file
+//=============================================================================
+#endif  // #ifdef CRC1_VERIFY_H
+//=============================================================================
@@ -0,0 +1,464 @@
+//=============================================================================
+// EncoderStream.c
+//=============================================================================
+// Copyright 2011 Silicon Laboratories, Inc.
+// http://www.silabs.com
+//
+// C File Description:
+//
+// This C file is a reusable code module for streaming encode and decode
+// operations with the encoder/decoder module. The encoded data passes
+// through two chunk buffers, so only the unencoded data must be resident
+// in XRAM.
+//
+// Please see the API function description below for a detailed explaination
+// of the reusable functions.
+//
+// Target:
+//    C8051F960
+//
+// IDE:
+//    Silicon Laboratories IDE
+//
+// Tool Chains:
+//    Keil
+//    SDCC
+//    Raisonance
+//
+// Project Name:
+//    C8051F960 Code Examples
+//
+// This software must be used in accordance with the End User License Agreement.
+//
+//=============================================================================
+//-----------------------------------------------------------------------------
+// uncomment pragma SRC to generate assembly code
+//-----------------------------------------------------------------------------
+//#pragma SRC
+//=============================================================================
+// Includes
+//=============================================================================
+#include <compiler_defs.h>
+#include <C8051F960_defs.h>
+#include "DMA_defs.h"
+#include "EncoderDecoder.h"
+#include "EncoderStream.h"
+//=============================================================================
+// File Global Variables
+//
+// Chunks are numbered from zero. Chunk n uses buffer n&1. EncStream_Done
+// counts the chunks finished by ENC0 and EncStream_Released counts the
+// chunks released by the application.
+//
+//=============================================================================
+U8  EncStream_Operation;
+U16 EncStream_Size;
+U16 EncStream_ChunkSize;
+U16 EncStream_Chunks;
+VARIABLE_SEGMENT_POINTER(EncStream_Unencoded, U8, SEG_XDATA);
+VARIABLE_SEGMENT_POINTER(EncStream_Buffer[2], U8, SEG_XDATA);
+volatile U16 EncStream_Done;
+volatile U16 EncStream_Released;
+volatile U8 EncStream_Active;
+volatile U8 EncStream_Status;
+//-----------------------------------------------------------------------------
+// Unions used by EncStream_StartChunk(). These are globals rather than
+// locals so that EncStream_StartChunk() has no overlayable data.
+//-----------------------------------------------------------------------------
+UU16 EncStream_Length;
+UU16 EncStream_Addr;
+//=============================================================================
+// Function Prototypes (Internal)
+//=============================================================================
+void EncStream_Next (void);
+void EncStream_StartChunk (void);
+U16  EncStream_EncodedSize (U16 unencodedSize);
+//=============================================================================
+// API Functions
+//=============================================================================
+//-----------------------------------------------------------------------------
+// EncoderStreamStart()
+//
+// parameters:
+//    operation       - MANCHESTER_DECODE, THREEOUTOFSIX_DECODE,
+//                      MANCHESTER_ENCODE, or THREEOUTOFSIX_ENCODE
+//    size            - total size of unencoded data
+//    unencodedData   - xdata pointer to unencoded data
+//    chunkSize       - unencoded bytes per chunk
+//    buffer0         - xdata pointer to first chunk buffer
+//    buffer1         - xdata pointer to second chunk buffer
+//
+// returns:
+//    status         - 0 for SUCCESS
+//                   - 1 for ENC0_ERROR_INVALID_OPERATION
+//                   - 2 for ENC0_ERROR_ZERO_LENGTH
+//                   - 3 for ENC0_ERROR_INVALID_INSIZE
+//                   - 5 for ENC0_ERROR_STREAM_BUSY
+//
+// Description:
+//
+// This function starts a streaming encode or decode operation and returns
+// at once. The unencoded data is processed chunkSize bytes at a time. The
+// encoded data of each chunk is in one of the two chunk buffers, which
+// are used in turn. Each buffer must hold the encoded size of one chunk,
+// two times chunkSize for Manchester and three halves of chunkSize for
+// Three out of Six. The last chunk may be shorter.
+//
+// The application takes the chunks in order with EncoderStreamGetBuffer()
+// and returns each one with EncoderStreamReleaseBuffer().
+//
+// For an encode operation, ENC0 fills the chunk buffers with encoded data.
+// EncoderStreamGetBuffer() returns a filled buffer. The application sends
+// the data, for example to the radio TX FIFO, and releases the buffer.
+// ENC0 then encodes the next chunk into it.
+//
+// For a decode operation the application fills the chunk buffers with
+// encoded data. EncoderStreamGetBuffer() returns an empty buffer and the
+// number of encoded bytes to put in it. Releasing the buffer passes it to
+// ENC0, which decodes it into the unencoded data.
+//
+// While the application works on one buffer, ENC0 works on the other one
+// at full DMA rate. ENC0 is restarted for each chunk from the DMA ISR. If
+// the application is not ready, ENC0 waits until the next buffer is
+// released.
+//
+// The same size rules as EncodeDecode() apply. For Three out of Six, size
+// and chunkSize must be a multiple of 2 bytes.
+//
+// The DMA ISR in the main module must call EncoderStreamService() in place
+// of disabling EIE2 bit 5. The ENC0 channels are shared with the AES key
+// and block input channels, so the AES functions and EncodeDecode() must
+// not be used while EncoderStreamBusy() is non-zero.
+//
+// With Keil, EncStream_Next() and EncStream_StartChunk() are called from
+// the API functions and from the DMA ISR. The linker reports this as
+// warning L15. This is safe because the DMA interrupt is disabled while
+// they are called by the API functions and the functions have no
+// parameters or local variables.
+//
+//-----------------------------------------------------------------------------
+U8 EncoderStreamStart (U8 operation, U16 size,
+   VARIABLE_SEGMENT_POINTER(unencodedData, U8, SEG_XDATA), U16 chunkSize,
+   VARIABLE_SEGMENT_POINTER(buffer0, U8, SEG_XDATA),
+   VARIABLE_SEGMENT_POINTER(buffer1, U8, SEG_XDATA))
+{
+   if((size == 0) || (chunkSize == 0))
+   {
+      return ENC0_ERROR_ZERO_LENGTH;
+   }
+
+   if((operation == THREEOUTOFSIX_ENCODE)||(operation == THREEOUTOFSIX_DECODE))
+   {
+      // Check sizes for Three out of Six
+      if((size % THREEOUTOFSIX_UNENCODED_SIZE != 0)||
+         (chunkSize % THREEOUTOFSIX_UNENCODED_SIZE != 0))
+         return ENC0_ERROR_INVALID_INSIZE;
+   }
+   else if((operation != MANCHESTER_ENCODE)&&(operation != MANCHESTER_DECODE))
+   {
+      return ENC0_ERROR_INVALID_OPERATION;
+   }
+
+   if(EncoderStreamBusy())
+   {
+      return ENC0_ERROR_STREAM_BUSY;
+   }
+
+   // Keep EncoderStreamService() out while the stream is set up.
+   EIE2 &= ~0x20;
+
+   EncStream_Operation = operation;
+   EncStream_Size = size;
+   EncStream_ChunkSize = chunkSize;
+   EncStream_Chunks = ((size - 1) / chunkSize) + 1;
+   EncStream_Unencoded = unencodedData;
+   EncStream_Buffer[0] = buffer0;
+   EncStream_Buffer[1] = buffer1;
+   EncStream_Done = 0;
+   EncStream_Released = 0;
+   EncStream_Status = SUCCESS;
+
+   EncStream_Next();                   // encode starts the first chunk
+
+   if(EncStream_Active)
+      EIE2 |= 0x20;
+
+   return SUCCESS;
+}
+//-----------------------------------------------------------------------------
+// EncoderStreamGetBuffer()
+//
+// parameters:
+//    bytes           - pointer for the number of encoded bytes
+//
+// returns:
+//    xdata pointer to the next chunk buffer, or 0 if it is not available
+//
+// Description:
+//
+// For an encode operation this returns the next chunk buffer once ENC0 has
+// filled it. For a decode operation this returns the next chunk buffer
+// once ENC0 has emptied it. In both cases *bytes is set to the number of
+// encoded bytes of the chunk.
+//
+// The same buffer is returned until EncoderStreamReleaseBuffer() is
+// called. The application may wait for a buffer in Idle mode, since the
+// DMA interrupt wakes the core when a chunk is finished.
+//
+//-----------------------------------------------------------------------------
+VARIABLE_SEGMENT_POINTER(EncoderStreamGetBuffer (U16 *bytes), U8, SEG_XDATA)
+{
+   U16 chunk;
+   U16 offset;
+   U8 available;
+
+   EIE2 &= ~0x20;                      // read consistent counters
+
+   chunk = EncStream_Released;
+
+   if(EncStream_Operation & ENCODE_OPERATION)
+      available = (chunk < EncStream_Done);
+   else
+      available = ((chunk < EncStream_Chunks) && ((chunk - EncStream_Done) < 2));
+
+   if(EncStream_Active)
+      EIE2 |= 0x20;
+
+   if(!available)
+   {
+      return 0;
+   }
+
+   // The last chunk may be shorter.
+   offset = chunk * EncStream_ChunkSize;
+   if((EncStream_Size - offset) < EncStream_ChunkSize)
+      *bytes = EncStream_EncodedSize(EncStream_Size - offset);
+   else
+      *bytes = EncStream_EncodedSize(EncStream_ChunkSize);
+
+   return EncStream_Buffer[chunk & 1];
+}
+//-----------------------------------------------------------------------------
+// EncoderStreamReleaseBuffer()
+//
+// Description:
+//
+// Returns the buffer from EncoderStreamGetBuffer() to the stream. ENC0 is
+// started on it if ENC0 is waiting for it.
+//
+//-----------------------------------------------------------------------------
+void EncoderStreamReleaseBuffer (void)
+{
+   EIE2 &= ~0x20;
+
+   if(EncStream_Released < EncStream_Chunks)
+   {
+      EncStream_Released++;
+      EncStream_Next();
+   }
+
+   if(EncStream_Active)
+      EIE2 |= 0x20;
+}
+//-----------------------------------------------------------------------------
+// EncoderStreamBusy()
+//
+// returns:
+//    non-zero until ENC0 has finished and the application has released
+//    every chunk
+//
+//-----------------------------------------------------------------------------
+U8 EncoderStreamBusy (void)
+{
+   U8 busy;
+
+   EIE2 &= ~0x20;                      // read consistent counters
+
+   busy = ((EncStream_Done < EncStream_Chunks) ||
+           (EncStream_Released < EncStream_Chunks));
+
+   if(EncStream_Active)
+      EIE2 |= 0x20;
+
+   return busy;
+}
+//-----------------------------------------------------------------------------
+// EncoderStreamStatus()
+//
+// returns:
+//    status         - 0 for SUCCESS
+//                   - 4 for ENC0_ERROR_DECODER if any chunk had an error
+//
+//-----------------------------------------------------------------------------
+U8 EncoderStreamStatus (void)
+{
+   return EncStream_Status;
+}
+//-----------------------------------------------------------------------------
+// EncoderStreamService()
+//
+// Description:
+//
+// This function must be called from the DMA ISR. When ENC0 has finished a
+// chunk it starts the next chunk if its buffer is available.
+//
+// When ENC0 is not active this function disables EIE2 bit 5, which is what
+// the DMA ISR does for the blocking functions.
+//
+//-----------------------------------------------------------------------------
+void EncoderStreamService (void)
+{
+   U8 restoreSFRPAGE;
+
+   restoreSFRPAGE = SFRPAGE;
+   SFRPAGE = DPPE_PAGE;
+
+   if(EncStream_Active && (DMA0INT & ENC0_OUT_MASK))
+   {
+      // Clear ENC0 bits (ENC0_IN & ENC0_OUT) bits in DMA0EN and DMA0INT.
+      DMA0EN &= ~ENC0_MASK;
+      DMA0INT &= ~ENC0_MASK;
+
+      if((ENC0CN & DECODER_ERROR) == DECODER_ERROR)
+         EncStream_Status = ENC0_ERROR_DECODER;
+
+      ENC0CN = 0x00;                   // clear ENC0
+
+      EncStream_Active = 0;
+      EncStream_Done++;
+
+      EncStream_Next();
+   }
+
+   if(!EncStream_Active)
+      EIE2 &= ~0x20;                   // disable further interrupts
+
+   SFRPAGE = restoreSFRPAGE;
+}
+//=============================================================================
+// Internal Functions
+//=============================================================================
+//-----------------------------------------------------------------------------
+// EncStream_Next()
+//
+// Description:
+//
+// Starts ENC0 on chunk EncStream_Done if it is idle and the chunk buffer
+// is available. An encode operation needs a buffer released by the
+// application. A decode operation needs a buffer filled by the
+// application. Called with the DMA interrupt disabled or from the DMA ISR.
+//
+//-----------------------------------------------------------------------------
+void EncStream_Next (void)
+{
+   if(EncStream_Active || (EncStream_Done >= EncStream_Chunks))
+      return;
+
+   if(EncStream_Operation & ENCODE_OPERATION)
+   {
+      if((EncStream_Done - EncStream_Released) < 2)
+         EncStream_StartChunk();
+   }
+   else
+   {
+      if(EncStream_Done < EncStream_Released)
+         EncStream_StartChunk();
+   }
+}
+//-----------------------------------------------------------------------------
+// EncStream_StartChunk()
+//
+// Description:
+//
+// Configures the ENC0 DMA channels and ENC0 for chunk EncStream_Done,
+// the same way as EncodeDecode().
+//
+//-----------------------------------------------------------------------------
+void EncStream_StartChunk (void)
+{
+   SFRPAGE = DPPE_PAGE;
+
+   ENC0CN = 0;                         // disable ENC for now
+
+   // Clear ENC0 bits (ENC0_IN & ENC0_OUT) bits in DMA0EN sfr using mask.
+   DMA0EN &= ~ENC0_MASK;
+
+   // Unencoded data address and size of this chunk.
+   EncStream_Length.U16 = EncStream_Done * EncStream_ChunkSize;
+   EncStream_Addr.U16 = (U16)EncStream_Unencoded + EncStream_Length.U16;
+   EncStream_Length.U16 = EncStream_Size - EncStream_Length.U16;
+   if(EncStream_Length.U16 > EncStream_ChunkSize)
+      EncStream_Length.U16 = EncStream_ChunkSize;
+
+   // The unencoded data is the input for an encode operation
+   // and the output for a decode operation.
+   if(EncStream_Operation & ENCODE_OPERATION)
+   {
+      DMA0SEL = ENC0_IN_CHANNEL;
+      DMA0NCF = ENC0_IN_PERIPHERAL_REQUEST|DMA_BIG_ENDIAN;
+   }
+   else
+   {
+      DMA0SEL = ENC0_OUT_CHANNEL;
+      DMA0NCF = ENC0_OUT_PERIPHERAL_REQUEST|DMA_BIG_ENDIAN|DMA_INT_EN;
+   }
+   DMA0NMD = NO_WRAPPING;
+   DMA0NBAL = EncStream_Addr.U8[LSB];
+   DMA0NBAH = EncStream_Addr.U8[MSB];
+   DMA0NSZL = EncStream_Length.U8[LSB];
+   DMA0NSZH = EncStream_Length.U8[MSB];
+   DMA0NAOL = 0;
+   DMA0NAOH = 0;
+
+   // The chunk buffer is the other end. EncStream_EncodedSize() is not
+   // used here since this function is also called from the DMA ISR.
+   if(EncStream_Operation & THREEOUTOFSIX_ENCODING)
+      EncStream_Length.U16 += (EncStream_Length.U16 >> 1);
+   else
+      EncStream_Length.U16 <<= 1;
+   EncStream_Addr.U16 = (U16)EncStream_Buffer[EncStream_Done & 1];
+
+   if(EncStream_Operation & ENCODE_OPERATION)
+   {
+      DMA0SEL = ENC0_OUT_CHANNEL;
+      DMA0NCF = ENC0_OUT_PERIPHERAL_REQUEST|DMA_BIG_ENDIAN|DMA_INT_EN;
+   }
+   else
+   {
+      DMA0SEL = ENC0_IN_CHANNEL;
+      DMA0NCF = ENC0_IN_PERIPHERAL_REQUEST|DMA_BIG_ENDIAN;
+   }
+   DMA0NMD = NO_WRAPPING;
+   DMA0NBAL = EncStream_Addr.U8[LSB];
+   DMA0NBAH = EncStream_Addr.U8[MSB];
+   DMA0NSZL = EncStream_Length.U8[LSB];
+   DMA0NSZH = EncStream_Length.U8[MSB];
+   DMA0NAOL = 0;
+   DMA0NAOH = 0;
+
+   // Clear ENCO DMA channel bits in DMA0INT and enable the channels.
+   DMA0INT &= ~ENC0_MASK;
+   DMA0EN  |=  ENC0_MASK;
+
+   EncStream_Active = 1;
+
+   // Enable ENC0CN block using big endian mode.
+   ENC0CN = EncStream_Operation | BIG_ENDIAN_DMA_MODE;
+}
+//-----------------------------------------------------------------------------
+// EncStream_EncodedSize()
+//
+// Returns the encoded size of unencodedSize bytes. Not called from the
+// DMA ISR.
+//
+//-----------------------------------------------------------------------------
+U16 EncStream_EncodedSize (U16 unencodedSize)
+{
+   if(EncStream_Operation & THREEOUTOFSIX_ENCODING)
+      return unencodedSize + (unencodedSize >> 1);
+   else
+      return unencodedSize << 1;
+}
+//=============================================================================
+// End of file
+//=============================================================================
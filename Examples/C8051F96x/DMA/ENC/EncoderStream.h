@@ -0,0 +1,57 @@
+#ifndef ENCODER_STREAM_H
+#define ENCODER_STREAM_H
+//=============================================================================
+// EncoderStream.h
+//-----------------------------------------------------------------------------
+// Copyright 2011 Silicon Laboratories, Inc.
+// http://www.silabs.com
+//
+// C File Description:
+//
+// This file is the API header file for the EncoderStream.c reusable C
+// code module.
+//
+// Target:
+//    C8051F960
+//
+// IDE:
+//    Silicon Laboratories IDE
+//
+// Tool Chains:
+//    Keil
+//    SDCC
+//    Raisonance
+//
+// Project Name:
+//    C8051F960 Code Examples
+//
+// This software must be used in accordance with the End User License Agreement.
+//
+//=============================================================================
+#ifndef COMPILER_DEFS_H
+#include <compiler_defs.h>
+#endif
+#ifndef ENCODER_DECODER_H
+#include "EncoderDecoder.h"
+#endif
+//-----------------------------------------------------------------------------
+// Additional return error code, see ENC0_ERROR_CODES_Enum
+//-----------------------------------------------------------------------------
+#define ENC0_ERROR_STREAM_BUSY         5
+//=============================================================================
+// Function Prototypes (API)
+//=============================================================================
+U8 EncoderStreamStart (U8 operation, U16 size,
+   VARIABLE_SEGMENT_POINTER(unencodedData, U8, SEG_XDATA), U16 chunkSize,
+   VARIABLE_SEGMENT_POINTER(buffer0, U8, SEG_XDATA),
+   VARIABLE_SEGMENT_POINTER(buffer1, U8, SEG_XDATA));
+VARIABLE_SEGMENT_POINTER(EncoderStreamGetBuffer (U16 *bytes), U8, SEG_XDATA);
+void EncoderStreamReleaseBuffer (void);
+U8   EncoderStreamBusy (void);
+U8   EncoderStreamStatus (void);
+void EncoderStreamService (void);
+//=============================================================================
+// End of file
+//=============================================================================
+#endif  // #ifdef ENCODER_STREAM_H
+//=============================================================================
@@ -1,5 +1,5 @@
-#ifndef TEST_VECTORS_H
-#define TEST_VECTORS_H
+#ifndef ENC_TEST_VECTORS_H
+#define ENC_TEST_VECTORS_H
 //=============================================================================
 // TestVectors.h
 //-----------------------------------------------------------------------------
@@ -48,5 +48,5 @@ extern SEGMENT_VARIABLE (ThreeOutOfSixEncodedData[NUM_THREEOUTOFSIX_ENCODED_BYTE
 //=============================================================================
 // End of file
 //=============================================================================
-#endif  // #ifdef TEST_VECTORS_H
+#endif  // #ifdef ENC_TEST_VECTORS_H
 //=============================================================================
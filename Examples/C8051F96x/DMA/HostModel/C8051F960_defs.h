@@ -0,0 +1,127 @@
+//-----------------------------------------------------------------------------
+// C8051F960_defs.h
+//-----------------------------------------------------------------------------
+//
+// Host (Linux/GCC) replacement for the C8051F960 register definitions.
+//
+// Only the SFRs used by the DMA examples are defined. Each SFR is an lvalue
+// returned by ModelSfr() in DPPE_Model.c, which counts the access and runs
+// any DMA0, AES0, CRC0, CRC1, ENC0 or SPI1 work made possible by the previous
+// accesses before returning.
+//
+// Target:         Linux host
+// Tool chain:     GCC
+// Command Line:   See DPPE_Bench.c
+//
+//-----------------------------------------------------------------------------
+#ifndef C8051F960_DEFS_H
+#define C8051F960_DEFS_H
+
+#ifndef COMPILER_DEFS_H
+#include <compiler_defs.h>
+#endif
+
+//-----------------------------------------------------------------------------
+// Modeled SFRs
+//-----------------------------------------------------------------------------
+enum MODEL_SFR_Enum
+{
+   MODEL_SFRPAGE = 0,
+   MODEL_PCON,
+   MODEL_EA,
+   MODEL_EIE2,
+   MODEL_PCA0MD,
+   MODEL_DMA0SEL,
+   MODEL_DMA0NCF,
+   MODEL_DMA0NMD,
+   MODEL_DMA0NBAL,
+   MODEL_DMA0NBAH,
+   MODEL_DMA0NAOL,
+   MODEL_DMA0NAOH,
+   MODEL_DMA0NSZL,
+   MODEL_DMA0NSZH,
+   MODEL_DMA0EN,
+   MODEL_DMA0INT,
+   MODEL_DMA0MINT,
+   MODEL_DMA0BUSY,
+   MODEL_AES0BCFG,
+   MODEL_AES0DCFG,
+   MODEL_CRC1CN,
+   MODEL_CRC1POLL,
+   MODEL_CRC1POLH,
+   MODEL_CRC1OUTL,
+   MODEL_CRC1OUTH,
+   MODEL_ENC0CN,
+   MODEL_SPI1CN,
+   MODEL_SPI1CFG,
+   MODEL_SPI1CKR,
+   MODEL_SPI1DAT,
+   MODEL_P1,
+   MODEL_CRC0CN,
+   MODEL_CRC0IN,
+   MODEL_CRC0DAT,
+   MODEL_CRC0AUTO,
+   MODEL_CRC0CNT,
+   MODEL_CRC0FLIP,
+   MODEL_SFR_COUNT
+};
+
+volatile U8 *ModelSfr (U8 sfr);
+
+#define SFRPAGE   (*ModelSfr(MODEL_SFRPAGE))
+#define PCON      (*ModelSfr(MODEL_PCON))
+#define EA        (*ModelSfr(MODEL_EA))
+#define EIE2      (*ModelSfr(MODEL_EIE2))
+#define PCA0MD    (*ModelSfr(MODEL_PCA0MD))
+#define DMA0SEL   (*ModelSfr(MODEL_DMA0SEL))
+#define DMA0NCF   (*ModelSfr(MODEL_DMA0NCF))
+#define DMA0NMD   (*ModelSfr(MODEL_DMA0NMD))
+#define DMA0NBAL  (*ModelSfr(MODEL_DMA0NBAL))
+#define DMA0NBAH  (*ModelSfr(MODEL_DMA0NBAH))
+#define DMA0NAOL  (*ModelSfr(MODEL_DMA0NAOL))
+#define DMA0NAOH  (*ModelSfr(MODEL_DMA0NAOH))
+#define DMA0NSZL  (*ModelSfr(MODEL_DMA0NSZL))
+#define DMA0NSZH  (*ModelSfr(MODEL_DMA0NSZH))
+#define DMA0EN    (*ModelSfr(MODEL_DMA0EN))
+#define DMA0INT   (*ModelSfr(MODEL_DMA0INT))
+#define DMA0MINT  (*ModelSfr(MODEL_DMA0MINT))
+#define DMA0BUSY  (*ModelSfr(MODEL_DMA0BUSY))
+#define AES0BCFG  (*ModelSfr(MODEL_AES0BCFG))
+#define AES0DCFG  (*ModelSfr(MODEL_AES0DCFG))
+#define CRC1CN    (*ModelSfr(MODEL_CRC1CN))
+#define CRC1POLL  (*ModelSfr(MODEL_CRC1POLL))
+#define CRC1POLH  (*ModelSfr(MODEL_CRC1POLH))
+#define CRC1OUTL  (*ModelSfr(MODEL_CRC1OUTL))
+#define CRC1OUTH  (*ModelSfr(MODEL_CRC1OUTH))
+#define ENC0CN    (*ModelSfr(MODEL_ENC0CN))
+#define SPI1CN    (*ModelSfr(MODEL_SPI1CN))
+#define SPI1CFG   (*ModelSfr(MODEL_SPI1CFG))
+#define SPI1CKR   (*ModelSfr(MODEL_SPI1CKR))
+#define SPI1DAT   (*ModelSfr(MODEL_SPI1DAT))
+#define P1        (*ModelSfr(MODEL_P1))
+#define CRC0CN    (*ModelSfr(MODEL_CRC0CN))
+#define CRC0IN    (*ModelSfr(MODEL_CRC0IN))
+#define CRC0DAT   (*ModelSfr(MODEL_CRC0DAT))
+#define CRC0AUTO  (*ModelSfr(MODEL_CRC0AUTO))
+#define CRC0CNT   (*ModelSfr(MODEL_CRC0CNT))
+#define CRC0FLIP  (*ModelSfr(MODEL_CRC0FLIP))
+
+// SPI1CN bit used by the examples, read only in the model
+#define TXBMT1    ((SPI1CN >> 1) & 0x01)
+
+//-----------------------------------------------------------------------------
+// Interrupt vectors and SFR pages
+//-----------------------------------------------------------------------------
+#define INTERRUPT_DMA0             20  // Direct Memory Access 0
+
+#define LEGACY_PAGE       0x00         // LEGACY SFR PAGE
+#define DPPE_PAGE         0x02         // DPPE SFR PAGE
+#define DMA0_PAGE         0x02         // DMA0 SFR PAGE
+#define AES0_PAGE         0x02         // AES0 SFR PAGE
+#define ENC0_PAGE         0x02         // ENC0 SFR PAGE
+#define CRC1_PAGE         0x02         // CRC1 SFR PAGE
+#define SPI1_PAGE         0x02         // SPI1 SFR PAGE
+#define CONFIG_PAGE       0x0F         // SYSTEM AND PORT CONFIGURATION PAGE
+#define CRC0_PAGE         0x0F         // CRC0
+
+#endif                                 // #define C8051F960_DEFS_H
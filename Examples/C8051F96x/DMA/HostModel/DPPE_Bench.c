@@ -0,0 +1,871 @@
+//=============================================================================
+// DPPE_Bench.c
+//=============================================================================
+//
+// C File Description:
+//
+//    Runs the F96x DMA examples against the host DPPE model. Each API call
+//    is checked against the same test vectors as AES_Test.c, CRC1_Test.c
+//    and ENC_Test.c, and the SFR accesses and modeled cycles of the call
+//    are reported. The AES_Async.c queue is checked with the same vectors.
+//    AES_Stream.c is checked with the message split into uneven pieces.
+//    A 64-byte frame built by PacketPipeline.c is compared with the same
+//    frame built by the three blocking calls. EncoderStream.c is checked
+//    against EncodeDecode() for both encodings. A series of SPI1 slave
+//    transactions is run with the single-shot SPI1_Master.c calls and
+//    with the SPI1_Queue.c transfer queue. CRC1_Verify.c is checked
+//    against a bitwise CRC over a Flash image and an xdata region, with
+//    the CRC0 paths of CRC.c for the CRC0 polynomial.
+//
+//    Built with -DDECRYPTION_KEY_CACHE, the ECB and CBC decryptions take the
+//    encryption key as AES_defs.h requires, and DecryptionKeyCache.c is
+//    checked for the hit and miss counts of a cold and a warm lookup for
+//    each key size and after InvalidateDecryptionKey().
+//
+//    Exits with a non-zero status if any check fails.
+//
+// Build (from this directory):
+//
+//    gcc -O2 -Wno-pointer-to-int-cast -I. -I../AES -I../CRC -I../CRC1 -I../ENC
+//        -I../Pipeline -I../SPI1/Master -o DPPE_Bench DPPE_Bench.c DPPE_Model.c
+//        ../AES/AES_BlockCipher.c ../AES/CBC_EncryptDecrypt.c
+//        ../AES/CTR_EncryptDecrypt.c ../AES/GenerateDecryptionKey.c
+//        ../AES/AES_Async.c ../AES/AES_Stream.c ../AES/TestVectors.c
+//        ../CRC/CRC.c ../CRC1/CRC1.c ../CRC1/CRC1_TestVectors.c
+//        ../CRC1/CRC1_Verify.c
+//        ../ENC/EncoderDecoder.c ../ENC/EncoderStream.c ../ENC/TestVectors.c
+//        ../Pipeline/PacketPipeline.c
+//        ../SPI1/Master/SPI1_Master.c ../SPI1/Master/SPI1_Queue.c
+//
+//    For the decryption key cache add:
+//
+//        -DDECRYPTION_KEY_CACHE ../AES/DecryptionKeyCache.c
+//
+// Usage:
+//
+//    DPPE_Bench [-v]         -v lists the accesses per SFR for each call
+//
+// Target:
+//    Linux host
+//
+// Tool Chains:
+//    GCC
+//
+// Project Name:
+//    C8051F960 DMA host model
+//
+//=============================================================================
+//-----------------------------------------------------------------------------
+// Includes
+//-----------------------------------------------------------------------------
+#include <compiler_defs.h>
+#include <C8051F960_defs.h>
+#include "DPPE_Model.h"
+#include "AES_BlockCipher.h"
+#include "CBC_EncryptDecrypt.h"
+#include "CTR_EncryptDecrypt.h"
+#include "GenerateDecryptionKey.h"
+#ifdef DECRYPTION_KEY_CACHE
+#include "DecryptionKeyCache.h"
+#endif
+#include "AES_Async.h"
+#include "AES_Stream.h"
+#include "CRC1.h"
+#include "CRC1_Verify.h"
+#include "EncoderDecoder.h"
+#include "EncoderStream.h"
+#include "PacketPipeline.h"
+#include "SPI1_Master.h"
+#include "SPI1_Queue.h"
+#include "../AES/TestVectors.h"
+#include "../ENC/TestVectors.h"
+#include "CRC1_TestVectors.h"
+#include <stdio.h>
+#include <string.h>
+//-----------------------------------------------------------------------------
+// XRAM buffers
+//-----------------------------------------------------------------------------
+SEGMENT_VARIABLE (EncryptionKey[32], U8, SEG_XDATA);
+SEGMENT_VARIABLE (DecryptionKey[32], U8, SEG_XDATA);
+SEGMENT_VARIABLE (PlainText[64], U8, SEG_XDATA);
+SEGMENT_VARIABLE (CipherText[64], U8, SEG_XDATA);
+SEGMENT_VARIABLE (InitialVector[16], U8, SEG_XDATA);
+SEGMENT_VARIABLE (Counter[16], U8, SEG_XDATA);
+SEGMENT_VARIABLE (CrcData[16], U8, SEG_XDATA);
+SEGMENT_VARIABLE (UnencodedData[32], U8, SEG_XDATA);
+SEGMENT_VARIABLE (EncodedData[16*3], U8, SEG_XDATA);
+SEGMENT_VARIABLE (Requests[3], AES_REQUEST, SEG_XDATA);
+SEGMENT_VARIABLE (VerifyData[1024], U8, SEG_XDATA);
+//-----------------------------------------------------------------------------
+// Flash image for CRC1_Verify.c, filled at run time. It starts on a page
+// boundary of the modeled code memory for the CRC0 automatic mode.
+//-----------------------------------------------------------------------------
+#define FLASH_IMAGE_ADDRESS   0x0800
+#define FLASH_IMAGE_SIZE      4098
+#define FlashImage            (ModelCode + FLASH_IMAGE_ADDRESS)
+//-----------------------------------------------------------------------------
+// Reference data indexed by key size
+//-----------------------------------------------------------------------------
+static const U8 *EncryptionKeys[3] =
+   {ReferenceEncryptionKey128, ReferenceEncryptionKey192, ReferenceEncryptionKey256};
+static const U8 *DecryptionKeys[3] =
+   {ReferenceDecryptionKey128, ReferenceDecryptionKey192, ReferenceDecryptionKey256};
+static const U8 *CipherECB[3] =
+   {ReferenceCipherText_ECB_128, ReferenceCipherText_ECB_192, ReferenceCipherText_ECB_256};
+static const U8 *CipherCBC[3] =
+   {ReferenceCipherText_CBC_128, ReferenceCipherText_CBC_192, ReferenceCipherText_CBC_256};
+static const U8 *CipherCTR[3] =
+   {ReferenceCipherText_CTR_128, ReferenceCipherText_CTR_192, ReferenceCipherText_CTR_256};
+//-----------------------------------------------------------------------------
+// Key for the ECB and CBC decryptions. With the cache these take the
+// encryption key, which must be invalidated when its contents change.
+//-----------------------------------------------------------------------------
+#ifdef DECRYPTION_KEY_CACHE
+#define CIPHER_DECRYPTION_KEY EncryptionKey
+#define KEY_CHANGED(key) InvalidateDecryptionKey(key)
+#else
+#define CIPHER_DECRYPTION_KEY DecryptionKey
+#define KEY_CHANGED(key)
+#endif
+//-----------------------------------------------------------------------------
+// Measurement state
+//-----------------------------------------------------------------------------
+static ModelStatsStruct Before;
+static int Verbose;
+static int Failures;
+static int Streaming;
+//-----------------------------------------------------------------------------
+// Internal Function Prototypes
+//-----------------------------------------------------------------------------
+static void Begin (void);
+static void End (const char *, U8, const U8 *, const U8 *, U16);
+static void AesPass (void);
+static void AsyncPass (void);
+static void SegmentPass (void);
+#ifdef DECRYPTION_KEY_CACHE
+static void KeyCachePass (void);
+#endif
+static void Crc1Pass (void);
+static void VerifyPass (void);
+static U16 ReferenceCRC (const U8 *, U16, U16);
+static void EncPass (void);
+static void PipelinePass (void);
+static void StreamPass (void);
+static void SpiPass (void);
+//=============================================================================
+// Functions
+//=============================================================================
+//-----------------------------------------------------------------------------
+// main ()
+//-----------------------------------------------------------------------------
+int main (int argc, char *argv[])
+{
+   if((argc > 1) && (strcmp(argv[1], "-v") == 0))
+      Verbose = 1;
+
+   ModelInit();
+
+   PCA0MD &= ~0x40;                    // disable watchdog timer
+   EA = 1;                             // enable global interrupts
+
+   printf("%-28s %6s %8s %8s %6s\n", "call", "result", "SFR acc", "cycles", "us");
+
+   AesPass();
+   AsyncPass();
+   SegmentPass();
+#ifdef DECRYPTION_KEY_CACHE
+   KeyCachePass();
+#endif
+   Crc1Pass();
+   VerifyPass();
+   EncPass();
+   PipelinePass();
+   StreamPass();
+   SpiPass();
+
+   printf("\n%s: %d failure(s)\n", Failures ? "FAIL" : "PASS", Failures);
+   return Failures ? 1 : 0;
+}
+//-----------------------------------------------------------------------------
+// AesPass ()
+//
+// Same sequence as AES_Test.c.
+//-----------------------------------------------------------------------------
+static void AesPass (void)
+{
+   U8 size, status;
+   U8 keyLength;
+   char name[40];
+
+   for(size = KEY_SIZE_128_BITS; size <= KEY_SIZE_256_BITS; size++)
+   {
+      keyLength = (size + 2) << 3;
+
+      memcpy(EncryptionKey, EncryptionKeys[size], keyLength);
+      Begin();
+      status = GenerateDecryptionKey(EncryptionKey, DecryptionKey, size);
+      sprintf(name, "GenerateDecryptionKey %d", 128 + 64 * size);
+      End(name, status, DecryptionKey, DecryptionKeys[size], keyLength);
+   }
+
+   for(size = KEY_SIZE_128_BITS; size <= KEY_SIZE_256_BITS; size++)
+   {
+      keyLength = (size + 2) << 3;
+
+      memcpy(PlainText, ReferencePlainText, 64);
+      memcpy(EncryptionKey, EncryptionKeys[size], keyLength);
+      KEY_CHANGED(EncryptionKey);
+      Begin();
+      status = AES_BlockCipher(ENCRYPTION_MODE | size, PlainText, CipherText,
+         EncryptionKey, 4);
+      sprintf(name, "ECB encrypt %d x4", 128 + 64 * size);
+      End(name, status, CipherText, CipherECB[size], 64);
+
+      memcpy(CipherText, CipherECB[size], 64);
+      memcpy(DecryptionKey, DecryptionKeys[size], keyLength);
+      Begin();
+      status = AES_BlockCipher(DECRYPTION_MODE | size, PlainText, CipherText,
+         CIPHER_DECRYPTION_KEY, 4);
+      sprintf(name, "ECB decrypt %d x4", 128 + 64 * size);
+      End(name, status, PlainText, ReferencePlainText, 64);
+
+      memcpy(PlainText, ReferencePlainText, 64);
+      memcpy(InitialVector, ReferenceInitialVector, 16);
+      Begin();
+      status = CBC_EncryptDecrypt(ENCRYPTION_MODE | size, PlainText, CipherText,
+         InitialVector, EncryptionKey, 4);
+      sprintf(name, "CBC encrypt %d x4", 128 + 64 * size);
+      End(name, status, CipherText, CipherCBC[size], 64);
+
+      memcpy(CipherText, CipherCBC[size], 64);
+      Begin();
+      status = CBC_EncryptDecrypt(DECRYPTION_MODE | size, PlainText, CipherText,
+         InitialVector, CIPHER_DECRYPTION_KEY, 4);
+      sprintf(name, "CBC decrypt %d x4", 128 + 64 * size);
+      End(name, status, PlainText, ReferencePlainText, 64);
+
+      memcpy(PlainText, ReferencePlainText, 64);
+      memcpy(Counter, Nonce, 16);
+      Begin();
+      status = CTR_EncryptDecrypt(ENCRYPTION_MODE | size, PlainText, CipherText,
+         Counter, EncryptionKey, 4);
+      sprintf(name, "CTR encrypt %d x4", 128 + 64 * size);
+      End(name, status, CipherText, CipherCTR[size], 64);
+
+      memcpy(CipherText, CipherCTR[size], 64);
+      memcpy(Counter, Nonce, 16);
+      Begin();
+      status = CTR_EncryptDecrypt(DECRYPTION_MODE | size, PlainText, CipherText,
+         Counter, EncryptionKey, 4);
+      sprintf(name, "CTR decrypt %d x4", 128 + 64 * size);
+      End(name, status, PlainText, ReferencePlainText, 64);
+   }
+}
+//-----------------------------------------------------------------------------
+// AsyncPass ()
+//
+// Queues one ECB, CBC and CTR 128-bit encryption with AES_AsyncSubmit()
+// and waits in Idle mode until all three are done.
+//-----------------------------------------------------------------------------
+static void AsyncPass (void)
+{
+   static SEGMENT_VARIABLE (AsyncOut[3][64], U8, SEG_XDATA);
+   static SEGMENT_VARIABLE (AsyncIV[16], U8, SEG_XDATA);
+   U8 status = SUCCESS;
+   U8 i;
+
+   memcpy(PlainText, ReferencePlainText, 64);
+   memcpy(EncryptionKey, ReferenceEncryptionKey128, 16);
+   memcpy(AsyncIV, ReferenceInitialVector, 16);
+   memcpy(Counter, Nonce, 16);
+
+   for(i = 0; i < 3; i++)
+   {
+      Requests[i].mode = AES_ASYNC_ECB + i;
+      Requests[i].operation = ENCRYPTION_128_BITS;
+      Requests[i].plainText = PlainText;
+      Requests[i].cipherText = AsyncOut[i];
+      Requests[i].iv = (i == AES_ASYNC_CBC) ? AsyncIV : Counter;
+      Requests[i].key = EncryptionKey;
+      Requests[i].blocks = 4;
+   }
+
+   Begin();
+   for(i = 0; i < 3; i++)
+      status |= AES_AsyncSubmit(&Requests[i]);
+   while(Requests[2].state != AES_REQUEST_DONE)
+      PCON |= 0x01;                    // go to Idle mode
+
+   End("AES_Async ECB+CBC+CTR x4", status, NULL, NULL, 0);
+   End("  async ECB", status, AsyncOut[0], ReferenceCipherText_ECB_128, 64);
+   End("  async CBC", status, AsyncOut[1], ReferenceCipherText_CBC_128, 64);
+   End("  async CTR", status, AsyncOut[2], ReferenceCipherText_CTR_128, 64);
+}
+//-----------------------------------------------------------------------------
+// SegmentPass ()
+//
+// Encrypts and decrypts the 64-byte reference message with AES_Stream.c in
+// pieces of 5, 27, 1 and 31 bytes, for CBC and CTR with a 128-bit key.
+//-----------------------------------------------------------------------------
+static void SegmentPass (void)
+{
+   static SEGMENT_VARIABLE (Context, AES_STREAM, SEG_XDATA);
+   static const U8 pieces[4] = {5, 27, 1, 31};
+   U8 mode, encrypt, status, i;
+   U16 in, out, produced;
+   const U8 *cipher;
+   char name[40];
+
+   memcpy(EncryptionKey, ReferenceEncryptionKey128, 16);
+   KEY_CHANGED(EncryptionKey);
+   memcpy(DecryptionKey, ReferenceDecryptionKey128, 16);
+   memcpy(InitialVector, ReferenceInitialVector, 16);
+   memcpy(Counter, Nonce, 16);
+
+   for(mode = AES_STREAM_CBC; mode <= AES_STREAM_CTR; mode++)
+   {
+      cipher = (mode == AES_STREAM_CBC) ? ReferenceCipherText_CBC_128 :
+         ReferenceCipherText_CTR_128;
+
+      for(encrypt = 1; encrypt <= 1; encrypt--)
+      {
+         memcpy(PlainText, ReferencePlainText, 64);
+         memcpy(CipherText, cipher, 64);
+
+         Begin();
+         status = AES_StreamInit(&Context, mode,
+            encrypt ? ENCRYPTION_128_BITS : DECRYPTION_128_BITS,
+            (mode == AES_STREAM_CBC) ? InitialVector : Counter,
+            (encrypt || (mode == AES_STREAM_CTR)) ? EncryptionKey : CIPHER_DECRYPTION_KEY);
+         in = 0;
+         out = 0;
+         for(i = 0; i < 4; i++)
+         {
+            if(encrypt)
+               status |= AES_StreamUpdate(&Context, PlainText + in,
+                  CipherText + out, pieces[i], &produced);
+            else
+               status |= AES_StreamUpdate(&Context, CipherText + in,
+                  PlainText + out, pieces[i], &produced);
+            in += pieces[i];
+            out += produced;
+         }
+         status |= AES_StreamFinal(&Context);
+         if(out != 64)
+            status = 1;
+         sprintf(name, "%s %s 128 5+27+1+31",
+            (mode == AES_STREAM_CBC) ? "CBC stream" : "CTR stream",
+            encrypt ? "enc" : "dec");
+         if(encrypt)
+            End(name, status, CipherText, cipher, 64);
+         else
+            End(name, status, PlainText, ReferencePlainText, 64);
+      }
+   }
+}
+#ifdef DECRYPTION_KEY_CACHE
+//-----------------------------------------------------------------------------
+// KeyCachePass ()
+//
+// Decrypts one ECB block with each key size from a cold cache, then again
+// with the keys cached, then once more after InvalidateDecryptionKey(). Each
+// call must give the reference plaintext and add one miss or one hit.
+//-----------------------------------------------------------------------------
+static void KeyCachePass (void)
+{
+   static SEGMENT_VARIABLE (Keys[3][32], U8, SEG_XDATA);
+   static const char *pass[3] = {"miss", "hit", "inval"};
+   U16 hits, misses;
+   U8 size, status, n;
+   char name[40];
+
+   InvalidateDecryptionKeyCache();
+
+   for(size = KEY_SIZE_128_BITS; size <= KEY_SIZE_256_BITS; size++)
+      memcpy(Keys[size], EncryptionKeys[size], (size + 2) << 3);
+
+   for(n = 0; n < 3; n++)
+   {
+      for(size = KEY_SIZE_128_BITS; size <= KEY_SIZE_256_BITS; size++)
+      {
+         if(n == 2)
+            InvalidateDecryptionKey(Keys[size]);
+
+         memcpy(CipherText, CipherECB[size], 16);
+         hits = DecryptionKeyCacheHits;
+         misses = DecryptionKeyCacheMisses;
+         Begin();
+         status = AES_BlockCipher(DECRYPTION_MODE | size, PlainText, CipherText,
+            Keys[size], 1);
+         if(n == 1)
+            status |= (DecryptionKeyCacheHits != hits + 1) ||
+               (DecryptionKeyCacheMisses != misses);
+         else
+            status |= (DecryptionKeyCacheHits != hits) ||
+               (DecryptionKeyCacheMisses != misses + 1);
+         sprintf(name, "cached ECB dec %d %s", 128 + 64 * size, pass[n]);
+         End(name, status, PlainText, ReferencePlainText, 16);
+      }
+   }
+}
+#endif
+//-----------------------------------------------------------------------------
+// Crc1Pass ()
+//
+// Same sequence as CRC1_Test.c.
+//-----------------------------------------------------------------------------
+static void Crc1Pass (void)
+{
+   U16 results;
+   U8 status;
+   U8 result[2];
+   U8 expected[2];
+
+   memcpy(CrcData, BlockOne, 10);
+   Begin();
+   status = ComputeCRC1(10, 0x3d65, CrcData, &results);
+   results = ~results;
+   result[0] = (U8)(results >> 8);
+   result[1] = (U8)results;
+   expected[0] = 0x44;
+   expected[1] = 0x47;
+   End("ComputeCRC1 10 bytes", status, result, expected, 2);
+
+   memcpy(CrcData, BlockTwo, 6);
+   Begin();
+   status = ComputeCRC1(6, 0x3d65, CrcData, &results);
+   results = ~results;
+   result[0] = (U8)(results >> 8);
+   result[1] = (U8)results;
+   expected[0] = 0x1E;
+   expected[1] = 0x6D;
+   End("ComputeCRC1 6 bytes", status, result, expected, 2);
+}
+//-----------------------------------------------------------------------------
+// VerifyPass ()
+//
+// Checks ComputeCRC1Code() against a bitwise CRC for a size that is a
+// multiple of the chunk size, for sizes that leave a one and a two byte
+// last chunk and for a region too short for the DMA. Then checks the CRC0
+// paths taken with the CRC0 polynomial: the automatic mode for whole pages
+// and the manual mode for other regions, and that a changed byte is
+// reported as a mismatch. Last, VerifyCRC1Xdata() with a long and a short
+// region.
+//
+// The model does not run CPU instructions, so the per byte loops of each
+// path are charged with ModelAdvance(): the copy to xdata, the CRC0IN
+// writes and the bitwise CRC of short regions.
+//-----------------------------------------------------------------------------
+static void VerifyPass (void)
+{
+   static const U16 sizes[4] = {4096, 4097, 4098, 5};
+   char name[32];
+   U16 results;
+   U16 expected;
+   U16 i;
+   U8 status;
+   U8 n;
+
+   for(i = 0; i < FLASH_IMAGE_SIZE; i++)
+      FlashImage[i] = (U8)(i * 7 + (i >> 8));
+
+   for(n = 0; n < 4; n++)
+   {
+      expected = ReferenceCRC(FlashImage, sizes[n], 0x3d65);
+      sprintf(name, "ComputeCRC1Code %u", sizes[n]);
+      Begin();
+      status = ComputeCRC1Code(sizes[n], 0x3d65, FlashImage, &results);
+      ModelAdvance((U32)sizes[n] * ((sizes[n] < CRC1_VERIFY_MIN_CHUNK) ?
+         MODEL_BITWISE_CRC_BYTE_CYCLES : MODEL_CODE_COPY_BYTE_CYCLES));
+      End(name, status, (U8 *)&results, (U8 *)&expected, 2);
+   }
+
+   expected = ReferenceCRC(FlashImage, 4096, 0x1021);
+   Begin();
+   status = ComputeCRC1Code(4096, 0x1021, FlashImage, &results);
+   End("ComputeCRC1Code 4096 CRC0", status, (U8 *)&results, (U8 *)&expected, 2);
+
+   expected = ReferenceCRC(FlashImage, 4097, 0x1021);
+   Begin();
+   status = VerifyCRC1Code(4097, 0x1021, FlashImage, expected);
+   ModelAdvance(4097L * MODEL_CODE_READ_BYTE_CYCLES);
+   End("VerifyCRC1Code 4097 CRC0", status, NULL, NULL, 0);
+
+   FlashImage[1000] ^= 0x01;
+   Begin();
+   status = VerifyCRC1Code(4097, 0x1021, FlashImage, expected);
+   ModelAdvance(4097L * MODEL_CODE_READ_BYTE_CYCLES);
+   FlashImage[1000] ^= 0x01;
+   End("VerifyCRC1Code mismatch", (status == CRC1_ERROR_MISMATCH) ?
+      SUCCESS : status + 1, NULL, NULL, 0);
+
+   memcpy(VerifyData, FlashImage, sizeof(VerifyData));
+   expected = ReferenceCRC(VerifyData, sizeof(VerifyData), 0x3d65);
+   Begin();
+   status = VerifyCRC1Xdata(sizeof(VerifyData), 0x3d65, VerifyData, expected);
+   End("VerifyCRC1Xdata 1024", status, NULL, NULL, 0);
+
+   expected = ReferenceCRC(VerifyData, 5, 0x3d65);
+   Begin();
+   status = VerifyCRC1Xdata(5, 0x3d65, VerifyData, expected);
+   ModelAdvance(5L * MODEL_BITWISE_CRC_BYTE_CYCLES);
+   End("VerifyCRC1Xdata 5", status, NULL, NULL, 0);
+}
+//-----------------------------------------------------------------------------
+// ReferenceCRC ()
+//
+// Bitwise msb first CRC with a zero initial value, as computed by CRC1.
+//-----------------------------------------------------------------------------
+static U16 ReferenceCRC (const U8 *input, U16 size, U16 polynomial)
+{
+   U16 crc = 0;
+   U8 bit;
+
+   while(size--)
+   {
+      crc ^= (U16)(*input++) << 8;
+
+      for(bit = 0; bit < 8; bit++)
+         crc = (crc & 0x8000) ? (U16)((crc << 1) ^ polynomial) : (U16)(crc << 1);
+   }
+
+   return crc;
+}
+//-----------------------------------------------------------------------------
+// EncPass ()
+//
+// Same sequence as ENC_Test.c.
+//-----------------------------------------------------------------------------
+static void EncPass (void)
+{
+   U8 status;
+
+   memcpy(UnencodedData, ManchesterUnencodedData, 16);
+   Begin();
+   status = EncodeDecode(MANCHESTER_ENCODE, 16, UnencodedData, EncodedData);
+   End("Manchester encode 16", status, EncodedData, ManchesterEncodedData, 32);
+
+   memcpy(UnencodedData, ThreeOutOfSixUnencodedData, 32);
+   Begin();
+   status = EncodeDecode(THREEOUTOFSIX_ENCODE, 32, UnencodedData, EncodedData);
+   End("3-out-of-6 encode 32", status, EncodedData, ThreeOutOfSixEncodedData, 48);
+
+   memcpy(EncodedData, ManchesterEncodedData, 32);
+   Begin();
+   status = EncodeDecode(MANCHESTER_DECODE, 32, UnencodedData, EncodedData);
+   End("Manchester decode 32", status, UnencodedData, ManchesterUnencodedData, 16);
+
+   memcpy(EncodedData, ThreeOutOfSixEncodedData, 48);
+   Begin();
+   status = EncodeDecode(THREEOUTOFSIX_DECODE, 48, UnencodedData, EncodedData);
+   End("3-out-of-6 decode 48", status, UnencodedData, ThreeOutOfSixUnencodedData, 32);
+}
+//-----------------------------------------------------------------------------
+// PipelinePass ()
+//
+// Builds a 64-byte CTR encrypted frame with an appended CRC1 and encodes it
+// into a TX buffer, first with the three blocking calls and then with one
+// PacketPipelineRun() call, for both encodings. The pipeline must give the
+// same TX buffer as the blocking calls.
+//
+// SFR accesses / modeled cycles per 64-byte payload frame:
+//
+//    encoding     blocking calls    PacketPipelineRun
+//    Manchester   215 / 1778        194 / 1740
+//    3-out-of-6   215 / 1712        194 / 1674
+//
+// The blocking sequence wakes the core six times, the pipeline once.
+//-----------------------------------------------------------------------------
+static void PipelinePass (void)
+{
+   static SEGMENT_VARIABLE (Frame[66], U8, SEG_XDATA);
+   static SEGMENT_VARIABLE (TxBuffer[132], U8, SEG_XDATA);
+   static SEGMENT_VARIABLE (Stages[4], PIPELINE_STAGE, SEG_XDATA);
+   U8 expected[132];
+   U8 encoding, status;
+   U16 crc, txSize;
+   char name[40];
+
+   for(encoding = MANCHESTER_ENCODE; encoding <= THREEOUTOFSIX_ENCODE; encoding++)
+   {
+      txSize = (encoding == MANCHESTER_ENCODE) ? 132 : 99;
+
+      memcpy(PlainText, ReferencePlainText, 64);
+      memcpy(EncryptionKey, ReferenceEncryptionKey128, 16);
+      memcpy(Counter, Nonce, 16);
+      Begin();
+      status = CTR_EncryptDecrypt(ENCRYPTION_128_BITS, PlainText, Frame,
+         Counter, EncryptionKey, 4);
+      status |= ComputeCRC1(64, 0x3d65, Frame, &crc);
+      crc = ~crc;
+      Frame[64] = (U8)(crc >> 8);
+      Frame[65] = (U8)crc;
+      status |= EncodeDecode(encoding, 66, Frame, TxBuffer);
+      sprintf(name, "CTR+CRC1+%s 64", (encoding == MANCHESTER_ENCODE) ? "Manch" : "3of6");
+      End(name, status, Frame, ReferenceCipherText_CTR_128, 64);
+      memcpy(expected, TxBuffer, txSize);
+
+      memset(Frame, 0, sizeof(Frame));
+      memset(TxBuffer, 0, sizeof(TxBuffer));
+      memcpy(Counter, Nonce, 16);
+
+      Stages[0].type = PIPELINE_CTR;
+      Stages[0].option = ENCRYPTION_128_BITS;
+      Stages[0].size = 64;
+      Stages[0].input = PlainText;
+      Stages[0].output = Frame;
+      Stages[0].counter = Counter;
+      Stages[0].key = EncryptionKey;
+      Stages[1].type = PIPELINE_CRC1;
+      Stages[1].option = PIPELINE_CRC1_INVERT;
+      Stages[1].size = 64;
+      Stages[1].input = Frame;
+      Stages[1].output = Frame + 64;
+      Stages[1].polynomial = 0x3d65;
+      Stages[2].type = PIPELINE_ENCODE;
+      Stages[2].option = encoding;
+      Stages[2].size = 66;
+      Stages[2].input = Frame;
+      Stages[2].output = TxBuffer;
+      Stages[3].type = PIPELINE_END;
+
+      Begin();
+      status = PacketPipelineRun(Stages);
+      sprintf(name, "PacketPipelineRun %s 64", (encoding == MANCHESTER_ENCODE) ? "Manch" : "3of6");
+      End(name, status, TxBuffer, expected, txSize);
+   }
+}
+//-----------------------------------------------------------------------------
+// StreamPass ()
+//
+// Encodes a 64-byte frame with EncoderStream.c in 16-byte chunks, copying
+// each chunk buffer out as a TX FIFO writer would, and compares the result
+// with EncodeDecode(). The encoded frame is then decoded the same way.
+//-----------------------------------------------------------------------------
+static void StreamPass (void)
+{
+   static SEGMENT_VARIABLE (Frame[64], U8, SEG_XDATA);
+   static SEGMENT_VARIABLE (Whole[96], U8, SEG_XDATA);
+   static SEGMENT_VARIABLE (Chunk[2][32], U8, SEG_XDATA);
+   U8 streamed[128];
+   U8 encoding, status;
+   U16 encodedSize, bytes, n;
+   U8 *buffer;
+   char name[40];
+
+   Streaming = 1;
+
+   for(encoding = MANCHESTER_ENCODE; encoding <= THREEOUTOFSIX_ENCODE; encoding++)
+   {
+      encodedSize = (encoding == MANCHESTER_ENCODE) ? 128 : 96;
+
+      // Reference from the blocking call, in two halves for Manchester.
+      memcpy(Frame, ReferencePlainText, 64);
+      status = EncodeDecode(encoding, 32, Frame, Whole);
+      memcpy(streamed, Whole, encodedSize / 2);
+      status |= EncodeDecode(encoding, 32, Frame + 32, Whole);
+      memcpy(streamed + encodedSize / 2, Whole, encodedSize / 2);
+
+      Begin();
+      status |= EncoderStreamStart(encoding, 64, Frame, 16, Chunk[0], Chunk[1]);
+      n = 0;
+      while(EncoderStreamBusy())
+      {
+         buffer = EncoderStreamGetBuffer(&bytes);
+         if(buffer == 0)
+         {
+            PCON |= 0x01;              // go to Idle mode
+            continue;
+         }
+         if(memcmp(buffer, streamed + n, bytes))
+            status = 1;
+         n += bytes;
+         EncoderStreamReleaseBuffer();
+      }
+      if(n != encodedSize)
+         status = 1;
+      sprintf(name, "EncStream %s enc 64/16",
+         (encoding == MANCHESTER_ENCODE) ? "Manch" : "3of6");
+      End(name, status, NULL, NULL, 0);
+
+      memset(Frame, 0, 64);
+      Begin();
+      status = EncoderStreamStart(encoding - ENCODE_OPERATION + DECODE_OPERATION,
+         64, Frame, 16, Chunk[0], Chunk[1]);
+      n = 0;
+      while(EncoderStreamBusy())
+      {
+         buffer = EncoderStreamGetBuffer(&bytes);
+         if(buffer == 0)
+         {
+            PCON |= 0x01;              // go to Idle mode
+            continue;
+         }
+         memcpy(buffer, streamed + n, bytes);
+         n += bytes;
+         EncoderStreamReleaseBuffer();
+      }
+      status |= EncoderStreamStatus();
+      sprintf(name, "EncStream %s dec 64/16",
+         (encoding == MANCHESTER_ENCODE) ? "Manch" : "3of6");
+      End(name, status, Frame, ReferencePlainText, 64);
+   }
+
+   Streaming = 0;
+}
+//-----------------------------------------------------------------------------
+// SpiPass ()
+//
+// Runs 16 slave transactions of 3 command bytes and 8 data bytes, as used
+// to read a radio FIFO or a serial flash, alternating between two slaves.
+// MISO is looped back to MOSI in the model, so each read returns the data
+// sent. The single-shot calls select the slave, send the command, transfer
+// the data and release the slave. The queue submits all 16 transfers and
+// waits once. A second pair of rows does the same with write transfers.
+//-----------------------------------------------------------------------------
+#define SPI_TRANSACTIONS   16
+#define SPI_COMMAND_SIZE   3
+#define SPI_DATA_SIZE      8
+
+static void SpiPass (void)
+{
+   static SEGMENT_VARIABLE (Command[SPI_TRANSACTIONS][SPI_COMMAND_SIZE], U8, SEG_XDATA);
+   static SEGMENT_VARIABLE (Discard[SPI_COMMAND_SIZE], U8, SEG_XDATA);
+   static SEGMENT_VARIABLE (Out[SPI_TRANSACTIONS][SPI_DATA_SIZE], U8, SEG_XDATA);
+   static SEGMENT_VARIABLE (In[SPI_TRANSACTIONS][SPI_DATA_SIZE], U8, SEG_XDATA);
+   static SEGMENT_VARIABLE (Transfers[SPI_TRANSACTIONS], SPI1_TRANSFER, SEG_XDATA);
+   U8 select, reading, status;
+   U8 i, j;
+   char name[40];
+
+   SFRPAGE = SPI1_PAGE;
+   SPI1CFG = 0x40;                     // master mode
+   SPI1CN = 0x01;                      // 3-wire mode, SPI1 enabled
+   SPI1CKR = 0x00;                     // SYSCLK/2
+   P1 = 0xFF;                          // both slaves released
+
+   for(i = 0; i < SPI_TRANSACTIONS; i++)
+   {
+      Command[i][0] = 0x03;            // read or write command
+      Command[i][1] = 0x00;
+      Command[i][2] = i * SPI_DATA_SIZE;
+      for(j = 0; j < SPI_DATA_SIZE; j++)
+         Out[i][j] = ReferencePlainText[(i * SPI_DATA_SIZE + j) & 63];
+   }
+
+   for(reading = 1; reading <= 1; reading--)
+   {
+      memset(In, 0, sizeof(In));
+      Begin();
+      for(i = 0; i < SPI_TRANSACTIONS; i++)
+      {
+         select = (i & 1) ? 0x02 : 0x01;
+         SFRPAGE = LEGACY_PAGE;
+         P1 &= ~select;
+         SPI1_MasterOutIn(SPI_COMMAND_SIZE, Command[i], Discard);
+         if(reading)
+            SPI1_MasterOutIn(SPI_DATA_SIZE, Out[i], In[i]);
+         else
+            SPI1_MasterOutOnly(SPI_DATA_SIZE, Out[i]);
+         SFRPAGE = LEGACY_PAGE;
+         P1 |= select;
+      }
+      status = (P1 != 0xFF);
+      sprintf(name, "SPI1 single %s 16x(3+8)", reading ? "rd" : "wr");
+      if(reading)
+         End(name, status, In[0], Out[0], sizeof(In));
+      else
+         End(name, status, NULL, NULL, 0);
+
+      memset(In, 0, sizeof(In));
+      for(i = 0; i < SPI_TRANSACTIONS; i++)
+      {
+         Transfers[i].select = (i & 1) ? 0x02 : 0x01;
+         Transfers[i].flags = 0;
+         Transfers[i].commandSize = SPI_COMMAND_SIZE;
+         memcpy(Transfers[i].command, Command[i], SPI_COMMAND_SIZE);
+         Transfers[i].size = SPI_DATA_SIZE;
+         Transfers[i].outPointer = Out[i];
+         Transfers[i].inPointer = reading ? In[i] : 0;
+      }
+
+      Begin();
+      status = 0;
+      for(i = 0; i < SPI_TRANSACTIONS; )
+      {
+         if(SPI1_QueueSubmit(&Transfers[i]) == SPI1_QUEUE_ERROR_FULL)
+            PCON |= 0x01;              // go to Idle mode
+         else
+            i++;
+      }
+      SPI1_QueueWait();
+      for(i = 0; i < SPI_TRANSACTIONS; i++)
+         if(Transfers[i].state != SPI1_TRANSFER_DONE)
+            status = 1;
+      SFRPAGE = LEGACY_PAGE;
+      if(P1 != 0xFF)
+         status = 1;
+      sprintf(name, "SPI1_Queue %s 16x(3+8)", reading ? "rd" : "wr");
+      if(reading)
+         End(name, status, In[0], Out[0], sizeof(In));
+      else
+         End(name, status, NULL, NULL, 0);
+   }
+}
+//-----------------------------------------------------------------------------
+// Begin ()
+//-----------------------------------------------------------------------------
+static void Begin (void)
+{
+   Before = ModelStats;
+}
+//-----------------------------------------------------------------------------
+// End ()
+//
+// Compares the result with the reference and prints the cost of the call.
+//-----------------------------------------------------------------------------
+static void End (const char *name, U8 status, const U8 *result,
+   const U8 *reference, U16 length)
+{
+   U32 accesses = ModelStats.SfrAccesses - Before.SfrAccesses;
+   uint64_t cycles = ModelStats.Cycles - Before.Cycles;
+   const char *verdict = "ok";
+   U8 sfr;
+
+   if((status != SUCCESS) || (length && memcmp(result, reference, length)))
+   {
+      verdict = "FAIL";
+      Failures++;
+   }
+
+   printf("%-28s %6s %8u %8llu %6.1f\n", name, verdict, accesses,
+      (unsigned long long)cycles, cycles * 1e6 / MODEL_SYSCLK_HZ);
+
+   if(Verbose && accesses)
+   {
+      for(sfr = 0; sfr < MODEL_SFR_COUNT; sfr++)
+      {
+         if(ModelStats.SfrBySfr[sfr] != Before.SfrBySfr[sfr])
+            printf("    %-10s %u\n", ModelSfrName(sfr),
+               ModelStats.SfrBySfr[sfr] - Before.SfrBySfr[sfr]);
+      }
+   }
+}
+//-----------------------------------------------------------------------------
+// DMA_ISR
+//
+// Wakes the core from Idle mode and services the AES_Async.c queue, the
+// packet pipeline, the encoder stream or the SPI1 queue, whichever is in
+// use.
+//-----------------------------------------------------------------------------
+INTERRUPT(DMA_ISR, INTERRUPT_DMA0)
+{
+   if(Streaming)
+      EncoderStreamService();
+   else if(SPI1_QueueBusy())
+      SPI1_QueueService();
+   else if(PacketPipelineBusy())
+      PacketPipelineService();
+   else
+      AES_AsyncService();
+}
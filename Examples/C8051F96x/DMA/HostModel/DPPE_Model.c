@@ -0,0 +1,881 @@
+//=============================================================================
+// DPPE_Model.c
+//=============================================================================
+//
+// C File Description:
+//
+//    Host model of the C8051F96x DMA0, AES0, CRC1, ENC0 and SPI1 peripherals
+//    to run the DMA examples on Linux. See DPPE_Model.h.
+//
+//    Modeled behavior:
+//
+//    - DMA0 channel registers selected by DMA0SEL, DMA0EN, DMA0INT, address
+//      offset and wrapping. The peripheral is taken from DMA0NCF, so any
+//      channel allocation works.
+//    - AES0 encryption and decryption with 128/192/256-bit keys, XOR on
+//      input or output and the inverse key output used to generate the
+//      decryption key. The output of a block is held until AES0YOUT takes
+//      it, so the AES0YOUT channel may be paused and restarted.
+//    - CRC1 with a 16-bit polynomial, msb first, cleared by CRC1CN bit 7.
+//      The FLIP, INV and SEED_POL bits are not modeled.
+//    - CRC0 16-bit manual and automatic mode with CRC0PNT auto-increment.
+//      The automatic mode reads ModelCode with 1024-byte pages and stalls
+//      the core. The 32-bit CRC and CRC0FLIP are not modeled.
+//    - ENC0 Manchester and 3-out-of-6 encode and decode in big endian DMA
+//      mode, including the decoder error flag.
+//    - SPI1 master mode with MISO wired to MOSI. Each byte takes
+//      16 * (SPI1CKR + 1) cycles. Bytes received without an SPI1_OUT
+//      channel are left in SPI1DAT. The NSS and clock phase settings are
+//      not modeled. SPI1 shares the engine timeline with the DPPE blocks.
+//
+// Target:
+//    Linux host
+//
+// Tool Chains:
+//    GCC
+//
+// Project Name:
+//    C8051F960 DMA host model
+//
+//=============================================================================
+//-----------------------------------------------------------------------------
+// Includes
+//-----------------------------------------------------------------------------
+#include <compiler_defs.h>
+#include <C8051F960_defs.h>
+#include "DPPE_Model.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+//-----------------------------------------------------------------------------
+// DMA0 peripheral requests and register bits (see DMA_defs.h)
+//-----------------------------------------------------------------------------
+#define REQ_ENC0_IN                 0x0
+#define REQ_ENC0_OUT                0x1
+#define REQ_CRC1                    0x2
+#define REQ_SPI1_IN                 0x3
+#define REQ_SPI1_OUT                0x4
+#define REQ_AES0KIN                 0x5
+#define REQ_AES0BIN                 0x6
+#define REQ_AES0XIN                 0x7
+#define REQ_AES0YOUT                0x8
+#define NCF_REQUEST                 0x0F
+#define NCF_INT_EN                  0x80
+#define NMD_WRAPPING                0x01
+//-----------------------------------------------------------------------------
+// AES0, CRC1 and ENC0 register bits
+//-----------------------------------------------------------------------------
+#define AES_BCFG_SIZE               0x03
+#define AES_BCFG_ENCRYPT            0x04
+#define AES_BCFG_ENABLE             0x08
+#define AES_DCFG_XOR_INPUT          0x01
+#define AES_DCFG_XOR_OUTPUT         0x02
+#define AES_DCFG_INVERSE_KEY        0x04
+#define CRC1_CN_CLEAR               0x80
+#define CRC1_CN_DMA                 0x08
+#define CRC0_CN_SEL                 0x10
+#define CRC0_CN_INIT                0x08
+#define CRC0_CN_VAL                 0x04
+#define CRC0_CN_PNT                 0x03
+#define CRC0_AUTO_EN                0x80
+#define CRC0_AUTO_PAGE              0x3F
+#define CRC0_PAGE_SIZE              1024
+#define ENC_CN_THREEOUTOFSIX        0x01
+#define ENC_CN_DECODE               0x10
+#define ENC_CN_ENCODE               0x20
+#define ENC_CN_ERROR                0x40
+#define SPI1_CN_ENABLE              0x01
+#define SPI1_CN_TXBMT               0x02
+#define SPI1_CN_SPIF                0x80
+#define MODEL_SPI1_BIT_CYCLES       2      // SYSCLK / (2 * (SPI1CKR + 1))
+//-----------------------------------------------------------------------------
+// DMA ISR in the main module
+//-----------------------------------------------------------------------------
+INTERRUPT_PROTO(DMA_ISR, INTERRUPT_DMA0);
+//-----------------------------------------------------------------------------
+// Model state
+//-----------------------------------------------------------------------------
+typedef struct ChannelStruct
+{
+   U8 Ncf;
+   U8 Nmd;
+   U8 Nbal;
+   U8 Nbah;
+   U8 Naol;
+   U8 Naoh;
+   U8 Nszl;
+   U8 Nszh;
+} ChannelStruct;
+
+ModelStatsStruct ModelStats;
+
+static U8 Sfr[MODEL_SFR_COUNT];
+static ChannelStruct Channel[8];
+static uint64_t FlagAt[8];
+static U8 FlagPending;
+static U8 Completed;
+static uint64_t EngineFree;
+static U8 InIsr;
+
+static U8 AesOut[32];
+static U8 AesOutIndex;
+static U8 AesOutCount;
+static U16 Crc1;
+static U16 Crc0;
+static U8 LastSfr;
+
+U8 ModelCode[0x10000] __attribute__((aligned(0x10000)));
+
+static const char *SfrNames[MODEL_SFR_COUNT] =
+{
+   "SFRPAGE", "PCON", "EA", "EIE2", "PCA0MD",
+   "DMA0SEL", "DMA0NCF", "DMA0NMD", "DMA0NBAL", "DMA0NBAH",
+   "DMA0NAOL", "DMA0NAOH", "DMA0NSZL", "DMA0NSZH", "DMA0EN",
+   "DMA0INT", "DMA0MINT", "DMA0BUSY", "AES0BCFG", "AES0DCFG",
+   "CRC1CN", "CRC1POLL", "CRC1POLH", "CRC1OUTL", "CRC1OUTH",
+   "ENC0CN", "SPI1CN", "SPI1CFG", "SPI1CKR", "SPI1DAT",
+   "P1", "CRC0CN", "CRC0IN", "CRC0DAT", "CRC0AUTO", "CRC0CNT",
+   "CRC0FLIP"
+};
+//-----------------------------------------------------------------------------
+// XRAM
+//
+// All SEG_XDATA variables are in the "xdata" section. The low 16 bits of a
+// pointer are the XRAM address used by the DMA. The section is smaller than
+// 64 kB, so each address maps back to one byte of the section. Addresses
+// outside the section, such as the don't care block read from address 0 by
+// GenerateDecryptionKey(), use the Xram array.
+//-----------------------------------------------------------------------------
+extern U8 __start_xdata[];
+extern U8 __stop_xdata[];
+static U8 Xram[0x10000];
+//-----------------------------------------------------------------------------
+// AES tables
+//-----------------------------------------------------------------------------
+static U8 Sbox[256];
+static U8 InvSbox[256];
+static U8 Rcon[16];
+//-----------------------------------------------------------------------------
+// Internal Function Prototypes
+//-----------------------------------------------------------------------------
+static void ModelRun (void);
+static void ModelIdle (void);
+//=============================================================================
+// AES reference implementation
+//=============================================================================
+static U8 Xtime (U8 x)
+{
+   return (U8)((x << 1) ^ ((x & 0x80) ? 0x1B : 0x00));
+}
+
+static U8 Mul (U8 a, U8 b)
+{
+   U8 r = 0;
+
+   while(b)
+   {
+      if(b & 1)
+         r ^= a;
+      a = Xtime(a);
+      b >>= 1;
+   }
+   return r;
+}
+
+static void AesInitTables (void)
+{
+   U8 p = 1;
+   U8 q = 1;
+   U8 x;
+   U8 i;
+
+   // Walk the multiplicative group with generator 3 and its inverse.
+   do
+   {
+      p = p ^ Xtime(p);
+      q ^= q << 1;
+      q ^= q << 2;
+      q ^= q << 4;
+      if(q & 0x80)
+         q ^= 0x09;
+      x = q ^ (U8)((q << 1) | (q >> 7)) ^ (U8)((q << 2) | (q >> 6)) ^
+          (U8)((q << 3) | (q >> 5)) ^ (U8)((q << 4) | (q >> 4));
+      Sbox[p] = x ^ 0x63;
+   }  while(p != 1);
+   Sbox[0] = 0x63;
+
+   for(i = 0; ; i++)
+   {
+      InvSbox[Sbox[i]] = i;
+      if(i == 255)
+         break;
+   }
+
+   Rcon[1] = 1;
+   for(i = 2; i < 16; i++)
+      Rcon[i] = Xtime(Rcon[i - 1]);
+}
+
+// Key schedule word function applied to w[i-1] for word i.
+static void AesScheduleWord (U8 *t, const U8 *prev, int i, int nk)
+{
+   U8 s;
+
+   memcpy(t, prev, 4);
+   if((i % nk) == 0)
+   {
+      s = t[0];
+      t[0] = Sbox[t[1]] ^ Rcon[i / nk];
+      t[1] = Sbox[t[2]];
+      t[2] = Sbox[t[3]];
+      t[3] = Sbox[s];
+   }
+   else if((nk > 6) && ((i % nk) == 4))
+   {
+      t[0] = Sbox[t[0]];
+      t[1] = Sbox[t[1]];
+      t[2] = Sbox[t[2]];
+      t[3] = Sbox[t[3]];
+   }
+}
+
+static void AesExpandKey (U8 *w, const U8 *key, int nk)
+{
+   int i, j;
+   int words = 4 * (nk + 7);
+   U8 t[4];
+
+   memcpy(w, key, 4 * nk);
+   for(i = nk; i < words; i++)
+   {
+      AesScheduleWord(t, &w[4 * (i - 1)], i, nk);
+      for(j = 0; j < 4; j++)
+         w[4 * i + j] = w[4 * (i - nk) + j] ^ t[j];
+   }
+}
+
+// The decryption key is the last nk words of the key schedule. The last
+// round key is in the first 16 bytes, followed by the words before it.
+static void AesDecryptionKey (U8 *dkey, const U8 *w, int nk)
+{
+   int words = 4 * (nk + 7);
+
+   memcpy(dkey, &w[4 * (words - 4)], 16);
+   memcpy(dkey + 16, &w[4 * (words - nk)], 4 * (nk - 4));
+}
+
+// Runs the key schedule backwards from a decryption key.
+static void AesExpandDecryptionKey (U8 *w, const U8 *dkey, int nk)
+{
+   int i, j;
+   int words = 4 * (nk + 7);
+   U8 t[4];
+
+   memcpy(&w[4 * (words - 4)], dkey, 16);
+   memcpy(&w[4 * (words - nk)], dkey + 16, 4 * (nk - 4));
+   for(i = words - 1; i >= nk; i--)
+   {
+      AesScheduleWord(t, &w[4 * (i - 1)], i, nk);
+      for(j = 0; j < 4; j++)
+         w[4 * (i - nk) + j] = w[4 * i + j] ^ t[j];
+   }
+}
+
+static void AesAddRoundKey (U8 *s, const U8 *k)
+{
+   int i;
+
+   for(i = 0; i < 16; i++)
+      s[i] ^= k[i];
+}
+
+static void AesEncrypt (U8 *s, const U8 *w, int nr)
+{
+   int r, c, i;
+   U8 t[16];
+
+   AesAddRoundKey(s, w);
+   for(r = 1; r <= nr; r++)
+   {
+      // SubBytes and ShiftRows
+      for(c = 0; c < 4; c++)
+         for(i = 0; i < 4; i++)
+            t[4 * c + i] = Sbox[s[4 * ((c + i) & 3) + i]];
+      // MixColumns
+      if(r != nr)
+      {
+         for(c = 0; c < 4; c++)
+         {
+            U8 *a = &t[4 * c];
+            U8 a0 = a[0], a1 = a[1], a2 = a[2], a3 = a[3];
+            a[0] = Xtime(a0) ^ Xtime(a1) ^ a1 ^ a2 ^ a3;
+            a[1] = a0 ^ Xtime(a1) ^ Xtime(a2) ^ a2 ^ a3;
+            a[2] = a0 ^ a1 ^ Xtime(a2) ^ Xtime(a3) ^ a3;
+            a[3] = Xtime(a0) ^ a0 ^ a1 ^ a2 ^ Xtime(a3);
+         }
+      }
+      memcpy(s, t, 16);
+      AesAddRoundKey(s, &w[16 * r]);
+   }
+}
+
+static void AesDecrypt (U8 *s, const U8 *w, int nr)
+{
+   int r, c, i;
+   U8 t[16];
+
+   AesAddRoundKey(s, &w[16 * nr]);
+   for(r = nr - 1; r >= 0; r--)
+   {
+      // InvShiftRows and InvSubBytes
+      for(c = 0; c < 4; c++)
+         for(i = 0; i < 4; i++)
+            t[4 * ((c + i) & 3) + i] = InvSbox[s[4 * c + i]];
+      memcpy(s, t, 16);
+      AesAddRoundKey(s, &w[16 * r]);
+      // InvMixColumns
+      if(r != 0)
+      {
+         for(c = 0; c < 4; c++)
+         {
+            U8 *a = &s[4 * c];
+            U8 a0 = a[0], a1 = a[1], a2 = a[2], a3 = a[3];
+            a[0] = Mul(a0, 14) ^ Mul(a1, 11) ^ Mul(a2, 13) ^ Mul(a3, 9);
+            a[1] = Mul(a0, 9) ^ Mul(a1, 14) ^ Mul(a2, 11) ^ Mul(a3, 13);
+            a[2] = Mul(a0, 13) ^ Mul(a1, 9) ^ Mul(a2, 14) ^ Mul(a3, 11);
+            a[3] = Mul(a0, 11) ^ Mul(a1, 13) ^ Mul(a2, 9) ^ Mul(a3, 14);
+         }
+      }
+   }
+}
+//=============================================================================
+// DMA0 channels
+//=============================================================================
+static U16 ChannelSize (U8 ch)
+{
+   return (U16)(Channel[ch].Nszl | (Channel[ch].Nszh << 8));
+}
+
+static U16 ChannelOffset (U8 ch)
+{
+   return (U16)(Channel[ch].Naol | (Channel[ch].Naoh << 8));
+}
+
+// Returns the enabled channel for a peripheral request, or -1.
+static int ChannelFind (U8 request)
+{
+   U8 ch;
+
+   for(ch = 0; ch < 8; ch++)
+   {
+      if((Sfr[MODEL_DMA0EN] & (1 << ch)) &&
+         ((Channel[ch].Ncf & NCF_REQUEST) == request))
+         return ch;
+   }
+   return -1;
+}
+
+// Bytes left before the channel stops. A wrapping channel never stops.
+static U16 ChannelRemaining (int ch)
+{
+   if(ch < 0)
+      return 0;
+   if(Channel[ch].Nmd & NMD_WRAPPING)
+      return 0xFFFF;
+   return ChannelSize(ch) - ChannelOffset(ch);
+}
+
+// Moves one byte to or from XRAM and updates the address offset.
+static U8 *ChannelNext (int ch)
+{
+   U16 base = (U16)(Channel[ch].Nbal | (Channel[ch].Nbah << 8));
+   U16 offset = ChannelOffset(ch);
+   U16 addr = base + offset;
+   U16 index = addr - (U16)(uintptr_t)__start_xdata;
+   U8 *p;
+
+   if(index < (U16)(__stop_xdata - __start_xdata))
+      p = __start_xdata + index;
+   else
+      p = &Xram[addr];
+
+   offset++;
+   if(offset >= ChannelSize(ch))
+   {
+      Completed |= (1 << ch);
+      if(Channel[ch].Nmd & NMD_WRAPPING)
+         offset = 0;
+   }
+   Channel[ch].Naol = (U8)offset;
+   Channel[ch].Naoh = (U8)(offset >> 8);
+   ModelStats.DmaBytes++;
+   return p;
+}
+
+// Charges engine time and schedules the flags of completed channels.
+static void EngineCharge (U32 cycles)
+{
+   U8 ch;
+
+   if(EngineFree < ModelStats.Cycles)
+      EngineFree = ModelStats.Cycles;
+   EngineFree += cycles;
+
+   for(ch = 0; ch < 8; ch++)
+   {
+      if(Completed & (1 << ch))
+      {
+         FlagAt[ch] = EngineFree;
+         FlagPending |= (1 << ch);
+      }
+   }
+   Completed = 0;
+}
+//=============================================================================
+// Peripherals
+//=============================================================================
+static void RunAes (void)
+{
+   int kin, bin, xin, yout;
+   U8 keyLength, nk, nr, i;
+   U8 key[32], block[16], x[16], w[240];
+   U8 dcfg;
+   U32 bytes;
+
+   if((Sfr[MODEL_AES0BCFG] & AES_BCFG_ENABLE) == 0)
+   {
+      AesOutCount = 0;                 // disabling resets the core
+      return;
+   }
+
+   keyLength = ((Sfr[MODEL_AES0BCFG] & AES_BCFG_SIZE) + 2) << 3;
+   nk = keyLength / 4;
+   nr = nk + 6;
+   dcfg = Sfr[MODEL_AES0DCFG];
+
+   for(;;)
+   {
+      // Output waiting for AES0YOUT
+      if(AesOutCount)
+      {
+         yout = ChannelFind(REQ_AES0YOUT);
+         bytes = 0;
+         while(AesOutCount && ChannelRemaining(yout))
+         {
+            *ChannelNext(yout) = AesOut[AesOutIndex++];
+            AesOutCount--;
+            bytes++;
+         }
+         if(bytes)
+            EngineCharge(bytes * MODEL_DMA_BYTE_CYCLES);
+         if(AesOutCount)
+            return;
+      }
+
+      // Next block needs the key, block input and X input if used.
+      kin = ChannelFind(REQ_AES0KIN);
+      bin = ChannelFind(REQ_AES0BIN);
+      xin = ChannelFind(REQ_AES0XIN);
+      if((ChannelRemaining(kin) < keyLength) || (ChannelRemaining(bin) < 16))
+         return;
+      if((dcfg & (AES_DCFG_XOR_INPUT|AES_DCFG_XOR_OUTPUT)) &&
+         (ChannelRemaining(xin) < 16))
+         return;
+      if(ChannelFind(REQ_AES0YOUT) < 0)
+         return;
+
+      bytes = keyLength + 16;
+      for(i = 0; i < keyLength; i++)
+         key[i] = *ChannelNext(kin);
+      for(i = 0; i < 16; i++)
+         block[i] = *ChannelNext(bin);
+      if(dcfg & (AES_DCFG_XOR_INPUT|AES_DCFG_XOR_OUTPUT))
+      {
+         for(i = 0; i < 16; i++)
+            x[i] = *ChannelNext(xin);
+         bytes += 16;
+      }
+
+      AesOutIndex = 0;
+      if(dcfg & AES_DCFG_INVERSE_KEY)
+      {
+         // The extended part of the key comes out first.
+         AesExpandKey(w, key, nk);
+         AesDecryptionKey(key, w, nk);
+         memcpy(AesOut, key + 16, keyLength - 16);
+         memcpy(AesOut + keyLength - 16, key, 16);
+         AesOutCount = keyLength;
+      }
+      else
+      {
+         if(dcfg & AES_DCFG_XOR_INPUT)
+            for(i = 0; i < 16; i++)
+               block[i] ^= x[i];
+         if(Sfr[MODEL_AES0BCFG] & AES_BCFG_ENCRYPT)
+         {
+            AesExpandKey(w, key, nk);
+            AesEncrypt(block, w, nr);
+         }
+         else
+         {
+            AesExpandDecryptionKey(w, key, nk);
+            AesDecrypt(block, w, nr);
+         }
+         if(dcfg & AES_DCFG_XOR_OUTPUT)
+            for(i = 0; i < 16; i++)
+               block[i] ^= x[i];
+         memcpy(AesOut, block, 16);
+         AesOutCount = 16;
+      }
+      ModelStats.AesBlocks++;
+      EngineCharge(bytes * MODEL_DMA_BYTE_CYCLES + nr * MODEL_AES_ROUND_CYCLES);
+   }
+}
+
+static void RunCrc1 (void)
+{
+   int ch;
+   U16 poly;
+   U32 bytes = 0;
+   U8 i;
+
+   if(Sfr[MODEL_CRC1CN] & CRC1_CN_CLEAR)
+   {
+      Crc1 = 0;
+      Sfr[MODEL_CRC1CN] &= ~CRC1_CN_CLEAR;
+   }
+
+   if(Sfr[MODEL_CRC1CN] & CRC1_CN_DMA)
+   {
+      ch = ChannelFind(REQ_CRC1);
+      poly = (U16)(Sfr[MODEL_CRC1POLL] | (Sfr[MODEL_CRC1POLH] << 8));
+      while(ChannelRemaining(ch))
+      {
+         Crc1 ^= (U16)(*ChannelNext(ch) << 8);
+         for(i = 0; i < 8; i++)
+            Crc1 = (Crc1 & 0x8000) ? (U16)((Crc1 << 1) ^ poly) : (U16)(Crc1 << 1);
+         bytes++;
+      }
+      if(bytes)
+         EngineCharge(bytes * MODEL_DMA_BYTE_CYCLES);
+   }
+
+   Sfr[MODEL_CRC1OUTL] = (U8)Crc1;
+   Sfr[MODEL_CRC1OUTH] = (U8)(Crc1 >> 8);
+}
+
+static U16 Crc0Byte (U16 crc, U8 value)
+{
+   U8 i;
+
+   crc ^= (U16)(value << 8);
+   for(i = 0; i < 8; i++)
+      crc = (crc & 0x8000) ? (U16)((crc << 1) ^ 0x1021) : (U16)(crc << 1);
+   return crc;
+}
+
+// Applies a write to CRC0CN or CRC0IN. Called at the access after the
+// write, when the value written is known.
+static void RunCrc0 (U8 sfr)
+{
+   U32 address, bytes;
+
+   if(sfr == MODEL_CRC0IN)
+   {
+      Crc0 = Crc0Byte(Crc0, Sfr[MODEL_CRC0IN]);
+   }
+   else if(sfr == MODEL_CRC0CN)
+   {
+      if(Sfr[MODEL_CRC0CN] & CRC0_CN_INIT)
+      {
+         Crc0 = (Sfr[MODEL_CRC0CN] & CRC0_CN_VAL) ? 0xFFFF : 0x0000;
+         Sfr[MODEL_CRC0CN] &= ~CRC0_CN_INIT;
+      }
+
+      // A write to CRC0CN with AUTOEN set runs the automatic mode.
+      if(Sfr[MODEL_CRC0AUTO] & CRC0_AUTO_EN)
+      {
+         address = (U32)(Sfr[MODEL_CRC0AUTO] & CRC0_AUTO_PAGE) * CRC0_PAGE_SIZE;
+         bytes = (U32)Sfr[MODEL_CRC0CNT] * CRC0_PAGE_SIZE;
+         if(address + bytes > sizeof(ModelCode))
+         {
+            fprintf(stderr, "DPPE model: CRC0 automatic mode past 64 kB\n");
+            exit(2);
+         }
+         while(bytes--)
+            Crc0 = Crc0Byte(Crc0, ModelCode[address++]);
+         ModelStats.Cycles += (uint64_t)Sfr[MODEL_CRC0CNT] * CRC0_PAGE_SIZE *
+            MODEL_CRC0_AUTO_BYTE_CYCLES;
+      }
+   }
+
+   if(((sfr == MODEL_CRC0IN) || (sfr == MODEL_CRC0CN)) &&
+      !(Sfr[MODEL_CRC0CN] & CRC0_CN_SEL))
+   {
+      fprintf(stderr, "DPPE model: 32-bit CRC0 is not modeled\n");
+      exit(2);
+   }
+}
+
+static const U8 ThreeOutOfSix[16] =
+{
+   0x16, 0x0D, 0x0E, 0x0B, 0x1C, 0x19, 0x1A, 0x13,
+   0x2C, 0x25, 0x26, 0x23, 0x34, 0x31, 0x32, 0x29
+};
+
+static void RunEnc0 (void)
+{
+   int in, out;
+   U8 cn = Sfr[MODEL_ENC0CN];
+   U8 inSize, outSize, i, j;
+   U8 src[3], dst[3];
+   U32 input, result;
+   U32 bytes = 0;
+
+   if((cn & (ENC_CN_ENCODE|ENC_CN_DECODE)) == 0)
+      return;
+
+   if(cn & ENC_CN_THREEOUTOFSIX)
+   {
+      inSize = (cn & ENC_CN_ENCODE) ? 2 : 3;
+      outSize = (cn & ENC_CN_ENCODE) ? 3 : 2;
+   }
+   else
+   {
+      inSize = (cn & ENC_CN_ENCODE) ? 1 : 2;
+      outSize = (cn & ENC_CN_ENCODE) ? 2 : 1;
+   }
+
+   in = ChannelFind(REQ_ENC0_IN);
+   out = ChannelFind(REQ_ENC0_OUT);
+
+   while((ChannelRemaining(in) >= inSize) && (ChannelRemaining(out) >= outSize))
+   {
+      input = 0;
+      for(i = 0; i < inSize; i++)
+         src[i] = *ChannelNext(in);
+      for(i = 0; i < inSize; i++)
+         input = (input << 8) | src[i];
+      result = 0;
+
+      if(cn & ENC_CN_THREEOUTOFSIX)
+      {
+         if(cn & ENC_CN_ENCODE)
+         {
+            for(i = 0; i < 4; i++)
+               result = (result << 6) | ThreeOutOfSix[(input >> (12 - 4 * i)) & 0x0F];
+         }
+         else
+         {
+            for(i = 0; i < 4; i++)
+            {
+               U8 symbol = (input >> (18 - 6 * i)) & 0x3F;
+               for(j = 0; j < 16; j++)
+                  if(ThreeOutOfSix[j] == symbol)
+                     break;
+               if(j == 16)
+               {
+                  Sfr[MODEL_ENC0CN] |= ENC_CN_ERROR;
+                  j = 0;
+               }
+               result = (result << 4) | j;
+            }
+         }
+      }
+      else
+      {
+         if(cn & ENC_CN_ENCODE)
+         {
+            for(i = 0; i < 8; i++)
+               result = (result << 2) | (((input >> (7 - i)) & 1) ? 0x1 : 0x2);
+         }
+         else
+         {
+            for(i = 0; i < 8; i++)
+            {
+               U8 pair = (input >> (14 - 2 * i)) & 0x3;
+               if((pair == 0) || (pair == 3))
+                  Sfr[MODEL_ENC0CN] |= ENC_CN_ERROR;
+               result = (result << 1) | (pair == 0x1);
+            }
+         }
+      }
+
+      for(i = 0; i < outSize; i++)
+         dst[i] = (U8)(result >> (8 * (outSize - 1 - i)));
+      for(i = 0; i < outSize; i++)
+         *ChannelNext(out) = dst[i];
+      bytes += inSize + outSize;
+   }
+
+   if(bytes)
+      EngineCharge(bytes * MODEL_DMA_BYTE_CYCLES);
+}
+
+static void RunSpi1 (void)
+{
+   int in, out;
+   U8 data;
+   U32 bytes = 0;
+
+   if((Sfr[MODEL_SPI1CN] & SPI1_CN_ENABLE) == 0)
+      return;
+
+   Sfr[MODEL_SPI1CN] |= SPI1_CN_TXBMT;
+
+   in = ChannelFind(REQ_SPI1_IN);
+   out = ChannelFind(REQ_SPI1_OUT);
+
+   // With an SPI1_OUT channel each byte must have room to be received.
+   while(ChannelRemaining(in) && ((out < 0) || ChannelRemaining(out)))
+   {
+      data = *ChannelNext(in);
+      if(out >= 0)
+         *ChannelNext(out) = data;
+      else
+         Sfr[MODEL_SPI1DAT] = data;
+      bytes++;
+   }
+
+   if(bytes)
+   {
+      Sfr[MODEL_SPI1CN] |= SPI1_CN_SPIF;
+      EngineCharge(bytes * 8 * MODEL_SPI1_BIT_CYCLES *
+         (Sfr[MODEL_SPI1CKR] + 1));
+   }
+}
+//=============================================================================
+// Scheduler
+//=============================================================================
+static void ModelRun (void)
+{
+   U8 ch;
+   U8 intEnabled = 0;
+
+   RunCrc1();
+   RunEnc0();
+   RunAes();
+   RunSpi1();
+
+   // Set the DMA0INT flags that are due.
+   for(ch = 0; ch < 8; ch++)
+   {
+      if((FlagPending & (1 << ch)) && (FlagAt[ch] <= ModelStats.Cycles))
+      {
+         Sfr[MODEL_DMA0INT] |= (1 << ch);
+         FlagPending &= ~(1 << ch);
+      }
+      if(Channel[ch].Ncf & NCF_INT_EN)
+         intEnabled |= (1 << ch);
+   }
+
+   if(!InIsr && Sfr[MODEL_EA] && (Sfr[MODEL_EIE2] & 0x20) &&
+      (Sfr[MODEL_DMA0INT] & intEnabled))
+   {
+      InIsr = 1;
+      ModelStats.IsrCalls++;
+      ModelStats.Cycles += MODEL_ISR_CYCLES;
+      DMA_ISR();
+      InIsr = 0;
+   }
+}
+
+// Idle mode: the clock runs to the next DMA0INT flag.
+static void ModelIdle (void)
+{
+   uint64_t next = 0;
+   U8 ch;
+
+   ModelStats.IdleEntries++;
+
+   for(ch = 0; ch < 8; ch++)
+   {
+      if((FlagPending & (1 << ch)) && ((next == 0) || (FlagAt[ch] < next)))
+         next = FlagAt[ch];
+   }
+
+   if(next == 0)
+   {
+      fprintf(stderr, "DPPE model: Idle mode with no DMA transfer pending\n");
+      exit(2);
+   }
+
+   if(next > ModelStats.Cycles)
+      ModelStats.Cycles = next;
+   ModelStats.Cycles += MODEL_IDLE_WAKE_CYCLES;
+}
+//=============================================================================
+// Public functions
+//=============================================================================
+volatile U8 *ModelSfr (U8 sfr)
+{
+   ChannelStruct *c;
+
+   ModelStats.SfrAccesses++;
+   ModelStats.SfrBySfr[sfr]++;
+   ModelStats.Cycles += MODEL_SFR_CYCLES;
+
+   RunCrc0(LastSfr);
+   LastSfr = sfr;
+
+   ModelRun();
+   if(sfr == MODEL_PCON)
+   {
+      ModelIdle();
+      ModelRun();
+   }
+
+   c = &Channel[Sfr[MODEL_DMA0SEL] & 0x07];
+
+   switch(sfr)
+   {
+      case MODEL_DMA0NCF:  return &c->Ncf;
+      case MODEL_DMA0NMD:  return &c->Nmd;
+      case MODEL_DMA0NBAL: return &c->Nbal;
+      case MODEL_DMA0NBAH: return &c->Nbah;
+      case MODEL_DMA0NAOL: return &c->Naol;
+      case MODEL_DMA0NAOH: return &c->Naoh;
+      case MODEL_DMA0NSZL: return &c->Nszl;
+      case MODEL_DMA0NSZH: return &c->Nszh;
+      case MODEL_CRC0DAT:
+         // Each read returns the byte at CRC0PNT and increments it.
+         Sfr[MODEL_CRC0DAT] = (U8)(Crc0 >> (8 * (Sfr[MODEL_CRC0CN] & 0x01)));
+         Sfr[MODEL_CRC0CN] = (Sfr[MODEL_CRC0CN] & ~CRC0_CN_PNT) |
+            ((Sfr[MODEL_CRC0CN] + 1) & CRC0_CN_PNT);
+         return &Sfr[sfr];
+      default:             return &Sfr[sfr];
+   }
+}
+
+void ModelInit (void)
+{
+   if((__stop_xdata - __start_xdata) >= 0x10000)
+   {
+      fprintf(stderr, "DPPE model: xdata section is larger than 64 kB\n");
+      exit(2);
+   }
+
+   AesInitTables();
+   memset(Sfr, 0, sizeof(Sfr));
+   memset(Channel, 0, sizeof(Channel));
+   memset(&ModelStats, 0, sizeof(ModelStats));
+   FlagPending = 0;
+   Completed = 0;
+   EngineFree = 0;
+   AesOutCount = 0;
+   Crc1 = 0;
+   Crc0 = 0;
+   LastSfr = MODEL_SFRPAGE;
+}
+
+// Simulates CPU work between SFR accesses.
+void ModelAdvance (U32 cycles)
+{
+   ModelStats.Cycles += cycles;
+   ModelRun();
+}
+
+const char *ModelSfrName (U8 sfr)
+{
+   return (sfr < MODEL_SFR_COUNT) ? SfrNames[sfr] : "?";
+}
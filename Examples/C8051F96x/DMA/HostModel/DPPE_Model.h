@@ -0,0 +1,86 @@
+#ifndef  DPPE_MODEL_H
+#define  DPPE_MODEL_H
+//=============================================================================
+// DPPE_Model.h
+//-----------------------------------------------------------------------------
+//
+// Header File Description:
+//
+//    Host model of the C8051F96x DPPE page: the DMA0 channels, AES0, CRC1
+//    and ENC0, and of CRC0. The model lets the DMA example sources compile
+//    unchanged with GCC and counts every SFR access they make.
+//
+//    SFRs are accessed through ModelSfr(). Before returning, ModelSfr()
+//    runs every transfer that the current register state allows, so a
+//    transfer starts at the first access after the peripheral is enabled.
+//    Data is moved at once, but the DMA0INT flags are set only when the
+//    simulated clock reaches the time the engine would have finished.
+//    Writing PCON (Idle mode) advances the clock to the next flag. The DMA
+//    ISR is called when a flag of a channel with DMA_INT_EN is set, EIE2
+//    bit 5 is set and EA is set.
+//
+//    Code memory is the ModelCode array, aligned so that the low 16 bits of
+//    a pointer into it are the code address. Data that the CRC0 automatic
+//    mode must read is placed there.
+//
+//    Cycle counts are estimates from the model timing constants below, not
+//    measurements. SFR access counts are exact. CPU instructions are not
+//    modeled. A bench may charge the loops it knows about with
+//    ModelAdvance().
+//
+// Target:
+//    Linux host
+//
+// Tool Chains:
+//    GCC
+//
+// Project Name:
+//    C8051F960 DMA host model
+//
+//=============================================================================
+#ifndef COMPILER_DEFS_H
+#include <compiler_defs.h>
+#endif
+#ifndef C8051F960_DEFS_H
+#include <C8051F960_defs.h>
+#endif
+//-----------------------------------------------------------------------------
+// Model timing in SYSCLK cycles
+//-----------------------------------------------------------------------------
+#define MODEL_SYSCLK_HZ             24500000L
+#define MODEL_SFR_CYCLES            2      // direct SFR read or write
+#define MODEL_DMA_BYTE_CYCLES       2      // one XRAM access by DMA0
+#define MODEL_AES_ROUND_CYCLES      4      // AES0 core, per round
+#define MODEL_ISR_CYCLES            24     // vector, push/pop and RETI
+#define MODEL_IDLE_WAKE_CYCLES      6      // Idle mode exit
+#define MODEL_CRC0_AUTO_BYTE_CYCLES 1      // CRC0 automatic mode, per byte
+#define MODEL_CODE_READ_BYTE_CYCLES 8      // C loop reading code, per byte
+#define MODEL_CODE_COPY_BYTE_CYCLES 16     // C loop copying code to xdata
+#define MODEL_BITWISE_CRC_BYTE_CYCLES 96   // C loop of a bitwise CRC-16
+//-----------------------------------------------------------------------------
+// Model statistics
+//-----------------------------------------------------------------------------
+typedef struct ModelStatsStruct
+{
+   uint64_t Cycles;                    // simulated time
+   U32 SfrAccesses;                    // all modeled SFRs
+   U32 SfrBySfr[MODEL_SFR_COUNT];
+   U32 DmaBytes;
+   U32 AesBlocks;
+   U32 IsrCalls;
+   U32 IdleEntries;
+} ModelStatsStruct;
+//-----------------------------------------------------------------------------
+// Public variables
+//-----------------------------------------------------------------------------
+extern ModelStatsStruct ModelStats;
+extern U8 ModelCode[0x10000];
+//-----------------------------------------------------------------------------
+// Public function prototypes
+//-----------------------------------------------------------------------------
+void  ModelInit (void);
+void  ModelAdvance (U32);
+const char *ModelSfrName (U8);
+//=============================================================================
+//=============================================================================
+#endif // DPPE_MODEL_H
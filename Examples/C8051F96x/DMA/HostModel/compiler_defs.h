@@ -0,0 +1,93 @@
+//-----------------------------------------------------------------------------
+// compiler_defs.h
+//-----------------------------------------------------------------------------
+//
+// Host (Linux/GCC) replacement for the C8051 compiler_defs.h.
+//
+// Used only by the DPPE host model build. Variables located in xdata are
+// placed in the "xdata" section, which must be smaller than 64 kB, so that
+// the 16-bit address taken by (U16)pointer casts identifies one byte of
+// that section. Pointer
+// target segments are removed. SFRs are declared in the host
+// C8051F960_defs.h and interrupt service routines become plain functions
+// that the model calls.
+//
+// Target:         Linux host
+// Tool chain:     GCC
+// Command Line:   See DPPE_Bench.c
+//
+//-----------------------------------------------------------------------------
+#ifndef COMPILER_DEFS_H
+#define COMPILER_DEFS_H
+
+#include <stdint.h>
+
+# define SEG_GENERIC
+# define SEG_FAR
+# define SEG_DATA
+# define SEG_NEAR
+# define SEG_IDATA
+# define SEG_XDATA __attribute__((section("xdata")))
+# define SEG_PDATA
+# define SEG_CODE  const
+# define SEG_BDATA
+
+// Keil memory space keywords used directly in the example sources
+# define code      const
+
+# define INTERRUPT(name, vector) void name (void)
+# define INTERRUPT_USING(name, vector, regnum) void name (void)
+# define INTERRUPT_PROTO(name, vector) void name (void)
+# define INTERRUPT_PROTO_USING(name, vector, regnum) void name (void)
+
+# define FUNCTION_USING(name, return_value, parameter, regnum) return_value name (parameter)
+# define FUNCTION_PROTO_USING(name, return_value, parameter, regnum) return_value name (parameter)
+
+# define SEGMENT_VARIABLE(name, vartype, locsegment) vartype locsegment name
+# define VARIABLE_SEGMENT_POINTER(name, vartype, targsegment) vartype * name
+# define SEGMENT_VARIABLE_SEGMENT_POINTER(name, vartype, targsegment, locsegment) vartype * locsegment name
+# define SEGMENT_POINTER(name, vartype, locsegment) vartype * locsegment name
+# define LOCATED_VARIABLE_NO_INIT(name, vartype, locsegment, addr) vartype locsegment name
+
+// used with UU16 (host is little endian)
+# define LSB 0
+# define MSB 1
+
+// used with UU32 (b0 is least-significant byte)
+# define b0 0
+# define b1 1
+# define b2 2
+# define b3 3
+
+typedef uint8_t  U8;
+typedef uint16_t U16;
+typedef uint32_t U32;
+
+typedef int8_t  S8;
+typedef int16_t S16;
+typedef int32_t S32;
+
+typedef U8 bit;
+
+typedef union UU16
+{
+   U16 U16;
+   S16 S16;
+   U8 U8[2];
+   S8 S8[2];
+} UU16;
+
+typedef union UU32
+{
+   U32 U32;
+   S32 S32;
+   UU16 UU16[2];
+   U16 U16[2];
+   S16 S16[2];
+   U8 U8[4];
+   S8 S8[4];
+} UU32;
+
+#define NOP()
+
+#endif                                 // #define COMPILER_DEFS_H
@@ -0,0 +1,592 @@
+//=============================================================================
+// PacketPipeline.c
+//=============================================================================
+// Copyright 2010 Silicon Laboratories, Inc.
+// http://www.silabs.com
+//
+// C File Description:
+//
+//    Runs a list of CTR encryption, CRC1 and ENC0 encoding stages back to
+//    back. Each stage is started from the DMA ISR as soon as the previous
+//    stage has finished, so a radio frame can be encrypted, protected with
+//    a CRC and encoded into the TX buffer with a single call and a single
+//    wake up of the core.
+//
+// Target:
+//    C8051F960
+//
+// IDE:
+//    Silicon Laboratories IDE
+//
+// Tool Chains:
+//    Keil
+//    SDCC
+//    Raisonance
+//
+// Project Name:
+//    C8051F960 Code Examples
+//
+// This software must be used in accordance with the End User License Agreement.
+//
+//=============================================================================
+//-----------------------------------------------------------------------------
+// uncomment pragma SRC to generate assembly code
+//-----------------------------------------------------------------------------
+//#pragma SRC
+//=============================================================================
+// Includes
+//=============================================================================
+#include <compiler_defs.h>
+#include <C8051F960_defs.h>
+#include "PacketPipeline.h"
+#include "DMA_defs.h"
+#include "AES_defs.h"
+#include "CRC1.h"
+#include "EncoderDecoder.h"
+//=============================================================================
+// File Global Variables
+//=============================================================================
+VARIABLE_SEGMENT_POINTER(Pipeline_Stage, PIPELINE_STAGE, SEG_XDATA);
+volatile U8 Pipeline_Busy;
+U16 Pipeline_Blocks;                   // CTR blocks left after current block
+U8 Pipeline_DoneMask;                  // DMA0INT bit ending the current stage
+//-----------------------------------------------------------------------------
+// Unions used by Pipeline_StartStage(). These are globals rather than
+// locals so that Pipeline_StartStage() has no overlayable data.
+//-----------------------------------------------------------------------------
+UU16 Pipeline_Length;
+UU16 Pipeline_Addr;
+//=============================================================================
+// Function Prototypes (Internal)
+//=============================================================================
+void Pipeline_StartStage (void);
+void Pipeline_StartCTR (void);
+void Pipeline_StartCRC1 (void);
+void Pipeline_StartEncode (void);
+void Pipeline_NextBlock (void);
+void Pipeline_EndStage (void);
+void Pipeline_IncrementCounter (VARIABLE_SEGMENT_POINTER(counter, U8, SEG_XDATA));
+//=============================================================================
+// API Functions
+//=============================================================================
+//-----------------------------------------------------------------------------
+// PacketPipelineStart()
+//
+// parameters:
+//    stages          - xdata pointer to the first stage of the list
+//
+// returns:
+//    status         - 0 for SUCCESS
+//                   - 1 for PIPELINE_ERROR_INVALID_STAGE
+//                   - 2 for PIPELINE_ERROR_BUSY
+//
+// description:
+//
+// This function checks every stage of the list and starts the first stage.
+// It returns at once. The remaining stages are started by
+// PacketPipelineService() from the DMA ISR. PacketPipelineBusy() returns
+// zero when the last stage has finished.
+//
+// The stage list and all buffers must not be changed while the pipeline
+// is busy. The output of one stage is normally the input of a following
+// stage. For example, a secure radio frame is built with:
+//
+//    CTR      payload     -> frame
+//    CRC1     frame       -> frame + payload size
+//    ENCODE   frame       -> TX buffer
+//    END
+//
+// where the CRC1 size is the payload size and the ENCODE size is the
+// payload size plus two. The TX buffer then holds the encoded frame in
+// transmit order, ready to be written to the EZRadioPRO TX FIFO.
+//
+// The stages use the static channel allocation in DMA_defs.h. The ENC0
+// channels are shared with the AES key and block input channels. This is
+// not a problem since the stages run one at a time. The blocking AES, CRC1
+// and ENC0 functions must not be used while the pipeline is busy.
+//
+// The DMA ISR in the main module must call PacketPipelineService() in
+// place of disabling EIE2 bit 5. PacketPipelineService() disables EIE2
+// bit 5 when the pipeline is not busy, so the blocking functions can still
+// be used at other times. Global interrupts must be enabled.
+//
+// With Keil, Pipeline_StartStage() and the functions it calls are called
+// from here and from the DMA ISR. The linker reports this as warning L15.
+// This is safe because the DMA interrupt is disabled while they are called
+// here and the functions have no parameters or local variables.
+//
+//-----------------------------------------------------------------------------
+PIPELINE_STATUS PacketPipelineStart (
+   VARIABLE_SEGMENT_POINTER(stages, PIPELINE_STAGE, SEG_XDATA))
+{
+   VARIABLE_SEGMENT_POINTER(stage, PIPELINE_STAGE, SEG_XDATA);
+
+   if(Pipeline_Busy)
+   {
+      return PIPELINE_ERROR_BUSY;
+   }
+
+   // Check every stage before starting the first one.
+   for(stage = stages; stage->type != PIPELINE_END; stage++)
+   {
+      if(stage->size == 0)
+      {
+         return PIPELINE_ERROR_INVALID_STAGE;
+      }
+      else if(stage->type == PIPELINE_CTR)
+      {
+         if((stage->option == DECRYPTION_UNDEFINED)||
+            (stage->option >= ENCRYPTION_UNDEFINED)||
+            ((stage->size & 0x0F) != 0))
+            return PIPELINE_ERROR_INVALID_STAGE;
+      }
+      else if(stage->type == PIPELINE_CRC1)
+      {
+         // polynomial must have a x^0 term
+         if((stage->polynomial & 0x0001) == 0)
+            return PIPELINE_ERROR_INVALID_STAGE;
+      }
+      else if(stage->type == PIPELINE_ENCODE)
+      {
+         if(stage->option == THREEOUTOFSIX_ENCODE)
+         {
+            if(stage->size % THREEOUTOFSIX_UNENCODED_SIZE != 0)
+               return PIPELINE_ERROR_INVALID_STAGE;
+         }
+         else if(stage->option != MANCHESTER_ENCODE)
+         {
+            return PIPELINE_ERROR_INVALID_STAGE;
+         }
+      }
+      else
+      {
+         return PIPELINE_ERROR_INVALID_STAGE;
+      }
+   }
+
+   if(stages->type == PIPELINE_END)
+   {
+      return SUCCESS;                  // nothing to do
+   }
+
+   // Keep PacketPipelineService() out while the first stage is started.
+   EIE2 &= ~0x20;
+
+   Pipeline_Stage = stages;
+   Pipeline_Busy = 1;
+   Pipeline_StartStage();              // enables DMA interrupt
+
+   return SUCCESS;
+}
+//-----------------------------------------------------------------------------
+// PacketPipelineRun()
+//
+// parameters:
+//    stages          - xdata pointer to the first stage of the list
+//
+// returns:
+//    status         - same as PacketPipelineStart()
+//
+// description:
+//
+// Blocking version of PacketPipelineStart(). This function puts the MCU
+// core into idle mode until the last stage has finished.
+//
+//-----------------------------------------------------------------------------
+PIPELINE_STATUS PacketPipelineRun (
+   VARIABLE_SEGMENT_POINTER(stages, PIPELINE_STAGE, SEG_XDATA))
+{
+   PIPELINE_STATUS status;
+
+   status = PacketPipelineStart(stages);
+
+   if(status == SUCCESS)
+   {
+      // This loop ensures that the CPU will remain in Idle mode
+      // until the last stage is complete.
+      while(Pipeline_Busy)
+      {
+         #ifdef DMA_TRANSFERS_USE_IDLE
+         PCON |= 0x01;                 // go to Idle mode
+         #endif
+      }
+   }
+
+   return status;
+}
+//-----------------------------------------------------------------------------
+// PacketPipelineBusy()
+//
+// returns:
+//    non-zero while a stage of the list is running
+//
+//-----------------------------------------------------------------------------
+U8 PacketPipelineBusy (void)
+{
+   return Pipeline_Busy;
+}
+//-----------------------------------------------------------------------------
+// PacketPipelineService()
+//
+// description:
+//
+// This function must be called from the DMA ISR. When the current stage
+// has finished it starts the next CTR block or the next stage of the list.
+//
+// When the pipeline is not busy this function disables EIE2 bit 5, which
+// is what the DMA ISR does for the blocking functions.
+//
+//-----------------------------------------------------------------------------
+void PacketPipelineService (void)
+{
+   U8 restoreSFRPAGE;
+
+   restoreSFRPAGE = SFRPAGE;
+   SFRPAGE = DPPE_PAGE;
+
+   if(Pipeline_Busy == 0)
+   {
+      EIE2 &= ~0x20;                   // disable further interrupts
+   }
+   else if(DMA0INT & Pipeline_DoneMask)
+   {
+      if(Pipeline_Blocks)
+      {
+         Pipeline_NextBlock();
+      }
+      else
+      {
+         Pipeline_EndStage();
+
+         Pipeline_Stage++;
+
+         if(Pipeline_Stage->type != PIPELINE_END)
+         {
+            Pipeline_StartStage();
+         }
+         else
+         {
+            Pipeline_Busy = 0;
+            EIE2 &= ~0x20;             // disable further interrupts
+         }
+      }
+   }
+
+   SFRPAGE = restoreSFRPAGE;
+}
+//=============================================================================
+// Internal Functions
+//=============================================================================
+//-----------------------------------------------------------------------------
+// Pipeline_StartStage()
+//
+// description:
+//
+// Starts the current stage and enables the DMA interrupt. Called with the
+// DMA interrupt disabled or from the DMA ISR.
+//
+//-----------------------------------------------------------------------------
+void Pipeline_StartStage (void)
+{
+   SFRPAGE = DPPE_PAGE;
+
+   Pipeline_Blocks = 0;
+
+   if(Pipeline_Stage->type == PIPELINE_CTR)
+      Pipeline_StartCTR();
+   else if(Pipeline_Stage->type == PIPELINE_CRC1)
+      Pipeline_StartCRC1();
+   else
+      Pipeline_StartEncode();
+
+   EIE2 |= 0x20;                       // enable DMA interrupt
+}
+//-----------------------------------------------------------------------------
+// Pipeline_StartCTR()
+//
+// description:
+//
+// Configures the AES channels for the first block of a CTR stage, the same
+// way as CTR_EncryptDecrypt().
+//
+//-----------------------------------------------------------------------------
+void Pipeline_StartCTR (void)
+{
+   Pipeline_Blocks = (Pipeline_Stage->size >> 4) - 1;
+   Pipeline_DoneMask = AES0YOUT_MASK;
+
+   AES0BCFG = 0x00;                    // disable for now
+   AES0DCFG = 0x00;                    // disable for now
+
+   // Disable AES0KIN, AES0BIN, AES0XIN, & AES0YOUT channels.
+   DMA0EN &= ~AES0_KBXY_MASK;
+
+   // Configure AES key input channel using key pointer.
+   Pipeline_Addr.U16 = (U16)(Pipeline_Stage->key);
+   DMA0SEL = AES0KIN_CHANNEL;
+   DMA0NCF = AES0KIN_PERIPHERAL_REQUEST;
+   DMA0NMD = NO_WRAPPING;
+   DMA0NBAL = Pipeline_Addr.U8[LSB];
+   DMA0NBAH = Pipeline_Addr.U8[MSB];
+   DMA0NSZH = 0;
+   DMA0NSZL = (((Pipeline_Stage->option & 0x03) + 2) << 3);
+   DMA0NAOL = 0;
+   DMA0NAOH = 0;
+
+   // AES block input is the counter, one block.
+   Pipeline_Addr.U16 = (U16)(Pipeline_Stage->counter);
+   DMA0SEL = AES0BIN_CHANNEL;
+   DMA0NCF = AES0BIN_PERIPHERAL_REQUEST;
+   DMA0NMD = NO_WRAPPING;
+   DMA0NBAL = Pipeline_Addr.U8[LSB];
+   DMA0NBAH = Pipeline_Addr.U8[MSB];
+   DMA0NSZL = 16;                      // one block
+   DMA0NSZH = 0;
+   DMA0NAOL = 0;
+   DMA0NAOH = 0;
+
+   // AES XOR input is the stage input, the first block.
+   Pipeline_Addr.U16 = (U16)(Pipeline_Stage->input);
+   DMA0SEL = AES0XIN_CHANNEL;
+   DMA0NCF = AES0XIN_PERIPHERAL_REQUEST;
+   DMA0NMD = NO_WRAPPING;
+   DMA0NBAL = Pipeline_Addr.U8[LSB];
+   DMA0NBAH = Pipeline_Addr.U8[MSB];
+   DMA0NSZL = 16;                      // one block
+   DMA0NSZH = 0;
+   DMA0NAOL = 0;
+   DMA0NAOH = 0;
+
+   // AES Y output is the stage output, the first block.
+   Pipeline_Addr.U16 = (U16)(Pipeline_Stage->output);
+   DMA0SEL = AES0YOUT_CHANNEL;
+   DMA0NCF = AES0YOUT_PERIPHERAL_REQUEST|DMA_INT_EN;
+   DMA0NMD = NO_WRAPPING;
+   DMA0NBAL = Pipeline_Addr.U8[LSB];
+   DMA0NBAH = Pipeline_Addr.U8[MSB];
+   DMA0NSZL = 16;                      // one block
+   DMA0NSZH = 0;
+   DMA0NAOH = 0;
+   DMA0NAOL = 0;
+
+   // Clear KBXY (Key, Block, X in, and Y out) bits in DMA0INT and enable.
+   DMA0INT &= ~AES0_KBXY_MASK;
+   DMA0EN  |=  AES0_KBXY_MASK;
+
+   // CTR mode always uses the encryption core with XOR on the output.
+   AES0DCFG = XOR_ON_OUTPUT;
+   AES0BCFG = Pipeline_Stage->option | ENCRYPTION_MODE;
+   AES0BCFG |= AES_ENABLE;
+}
+//-----------------------------------------------------------------------------
+// Pipeline_StartCRC1()
+//
+// description:
+//
+// Configures CRC1 and the CRC1 channel, the same way as ComputeCRC1().
+//
+//-----------------------------------------------------------------------------
+void Pipeline_StartCRC1 (void)
+{
+   Pipeline_DoneMask = CRC1_IN_MASK;
+
+   CRC1CN = CRC1_CLEAR;                // clear CRC results to zero
+
+   // Set CRC1 polynomial
+   Pipeline_Addr.U16 = Pipeline_Stage->polynomial;
+   CRC1POLL = Pipeline_Addr.U8[LSB];
+   CRC1POLH = Pipeline_Addr.U8[MSB];
+
+   DMA0EN &= ~CRC1_IN_MASK;            // disable CRC1 DMA
+
+   Pipeline_Addr.U16 = (U16)(Pipeline_Stage->input);
+   DMA0SEL = CRC1_IN_CHANNEL;
+   DMA0NCF = CRC1_PERIPHERAL_REQUEST|DMA_INT_EN;
+   DMA0NMD = NO_WRAPPING;
+   DMA0NBAL = Pipeline_Addr.U8[LSB];
+   DMA0NBAH = Pipeline_Addr.U8[MSB];
+   Pipeline_Length.U16 = Pipeline_Stage->size;
+   DMA0NSZL = Pipeline_Length.U8[LSB];
+   DMA0NSZH = Pipeline_Length.U8[MSB];
+   DMA0NAOL = 0;
+   DMA0NAOH = 0;
+
+   DMA0INT &= ~CRC1_IN_MASK;
+   DMA0EN  |=  CRC1_IN_MASK;
+
+   // Set CRC1 DMA mode enable bit to start operation
+   CRC1CN |=  CRC1_DMA_ENABLE;
+}
+//-----------------------------------------------------------------------------
+// Pipeline_StartEncode()
+//
+// description:
+//
+// Configures ENC0 and the ENC0 channels for an encode operation in big
+// endian mode, the same way as EncodeDecode().
+//
+//-----------------------------------------------------------------------------
+void Pipeline_StartEncode (void)
+{
+   Pipeline_DoneMask = ENC0_OUT_MASK;
+
+   ENC0CN = 0;                         // disable ENC for now
+
+   // Clear ENC0 bits (ENC0_IN & ENC0_OUT) bits in DMA0EN sfr using mask.
+   DMA0EN &= ~ENC0_MASK;
+
+   Pipeline_Addr.U16 = (U16)(Pipeline_Stage->input);
+   DMA0SEL = ENC0_IN_CHANNEL;
+   DMA0NCF = ENC0_IN_PERIPHERAL_REQUEST|DMA_BIG_ENDIAN;
+   DMA0NMD = NO_WRAPPING;
+   DMA0NBAL = Pipeline_Addr.U8[LSB];
+   DMA0NBAH = Pipeline_Addr.U8[MSB];
+   Pipeline_Length.U16 = Pipeline_Stage->size;
+   DMA0NSZL = Pipeline_Length.U8[LSB];
+   DMA0NSZH = Pipeline_Length.U8[MSB];
+   DMA0NAOL = 0;
+   DMA0NAOH = 0;
+
+   // Output size is twice the input for Manchester encoding and
+   // three halves of the input for Three out of Six encoding.
+   if(Pipeline_Stage->option == MANCHESTER_ENCODE)
+      Pipeline_Length.U16 <<= 1;
+   else
+      Pipeline_Length.U16 += (Pipeline_Length.U16 >> 1);
+
+   Pipeline_Addr.U16 = (U16)(Pipeline_Stage->output);
+   DMA0SEL = ENC0_OUT_CHANNEL;
+   DMA0NCF = ENC0_OUT_PERIPHERAL_REQUEST|DMA_BIG_ENDIAN|DMA_INT_EN;
+   DMA0NMD = NO_WRAPPING;
+   DMA0NBAL = Pipeline_Addr.U8[LSB];
+   DMA0NBAH = Pipeline_Addr.U8[MSB];
+   DMA0NSZL = Pipeline_Length.U8[LSB];
+   DMA0NSZH = Pipeline_Length.U8[MSB];
+   DMA0NAOL = 0;
+   DMA0NAOH = 0;
+
+   DMA0INT &= ~ENC0_MASK;
+   DMA0EN  |=  ENC0_MASK;
+
+   // Enable ENC0CN block using big endian mode.
+   ENC0CN = Pipeline_Stage->option | BIG_ENDIAN_DMA_MODE;
+}
+//-----------------------------------------------------------------------------
+// Pipeline_NextBlock()
+//
+// description:
+//
+// Starts the next block of a CTR stage with the counter incremented, the
+// same way as CTR_EncryptDecrypt(). Called only from the DMA ISR with
+// SFRPAGE set to DPPE_PAGE.
+//
+//-----------------------------------------------------------------------------
+void Pipeline_NextBlock (void)
+{
+   Pipeline_Blocks--;
+
+   // Disable AES block and pause DMA channels used by AES block.
+   AES0BCFG &= ~AES_ENABLE;
+   DMA0EN &= ~AES0_KBXY_MASK;
+
+   Pipeline_IncrementCounter(Pipeline_Stage->counter);
+
+   // AESKIN and AESBIN DMA reset address offsets.
+   DMA0SEL = AES0KIN_CHANNEL;
+   DMA0NAOL = 0;
+   DMA0NAOH = 0;
+
+   DMA0SEL = AES0BIN_CHANNEL;
+   DMA0NAOL = 0;
+   DMA0NAOH = 0;
+
+   // AESXIN and AESYOUT DMA channels increase length by 16.
+   DMA0SEL = AES0XIN_CHANNEL;
+   Pipeline_Length.U8[LSB] = DMA0NSZL;
+   Pipeline_Length.U8[MSB] = DMA0NSZH;
+   Pipeline_Length.U16 += 16;
+   DMA0NSZL = Pipeline_Length.U8[LSB];
+   DMA0NSZH = Pipeline_Length.U8[MSB];
+
+   DMA0SEL = AES0YOUT_CHANNEL;
+   DMA0NSZL = Pipeline_Length.U8[LSB];
+   DMA0NSZH = Pipeline_Length.U8[MSB];
+
+   // Clear KBXY bits in DMA0INT and restart the DMA channels and AES block.
+   DMA0INT &= ~AES0_KBXY_MASK;
+   DMA0EN  |=  AES0_KBXY_MASK;
+   AES0BCFG |= AES_ENABLE;
+}
+//-----------------------------------------------------------------------------
+// Pipeline_EndStage()
+//
+// description:
+//
+// Disables the peripheral and channels of the current stage. A CRC1 stage
+// stores the result here. A CTR stage leaves the counter at the value used
+// for the last block, the same as CTR_EncryptDecrypt(). Called only from
+// the DMA ISR with SFRPAGE set to DPPE_PAGE.
+//
+//-----------------------------------------------------------------------------
+void Pipeline_EndStage (void)
+{
+   if(Pipeline_Stage->type == PIPELINE_CTR)
+   {
+      //Clear AES Block
+      AES0BCFG = 0x00;
+      AES0DCFG = 0x00;
+
+      DMA0EN &= ~AES0_KBXY_MASK;
+      DMA0INT &= ~AES0_KBXY_MASK;
+   }
+   else if(Pipeline_Stage->type == PIPELINE_CRC1)
+   {
+      CRC1CN &= ~CRC1_DMA_ENABLE;      // disable CRC1
+
+      DMA0EN &= ~CRC1_IN_MASK;
+      DMA0INT &= ~CRC1_IN_MASK;
+
+      Pipeline_Length.U8[LSB] = CRC1OUTL;
+      Pipeline_Length.U8[MSB] = CRC1OUTH;
+
+      if(Pipeline_Stage->option & PIPELINE_CRC1_INVERT)
+         Pipeline_Length.U16 = ~Pipeline_Length.U16;
+
+      // Store the result msb first, in transmit order.
+      Pipeline_Stage->output[0] = Pipeline_Length.U8[MSB];
+      Pipeline_Stage->output[1] = Pipeline_Length.U8[LSB];
+   }
+   else
+   {
+      DMA0EN &= ~ENC0_MASK;
+      DMA0INT &= ~ENC0_MASK;
+      ENC0CN = 0x00;                   // clear ENC0
+   }
+}
+//-----------------------------------------------------------------------------
+// Pipeline_IncrementCounter()
+//
+// Same as IncrementCounter() in CTR_EncryptDecrypt.c. A separate copy is
+// used because this one is called from the DMA ISR.
+//
+//-----------------------------------------------------------------------------
+void Pipeline_IncrementCounter (VARIABLE_SEGMENT_POINTER(counter, U8, SEG_XDATA))
+{
+   U8 i;
+   U8 x;
+
+   i = 16;
+   counter += 16;                      // point to end of data
+
+   do
+   {
+      counter--;                       // decrement data pointer
+      x = *counter;                    // read xdata using data pointer
+      x++;                             // increment value
+      *counter = x;                    // move to xram
+      if(x) break;                     // break if not zero
+   }  while(--i);                      // DJNZ
+}
+//=============================================================================
+// End of file
+//=============================================================================
@@ -0,0 +1,101 @@
+#ifndef PACKET_PIPELINE_H
+#define PACKET_PIPELINE_H
+//=============================================================================
+// PacketPipeline.h
+//-----------------------------------------------------------------------------
+// Copyright 2010 Silicon Laboratories, Inc.
+// http://www.silabs.com
+//
+// C File Description:
+//
+//    Chains CTR encryption, CRC1 and ENC0 encoding DMA operations from a
+//    single descriptor list.
+//
+// Target:
+//    C8051F960
+//
+// IDE:
+//    Silicon Laboratories IDE
+//
+// Tool Chains:
+//    Keil
+//    SDCC
+//    Raisonance
+//
+// Project Name:
+//    C8051F960 Code Examples
+//
+// This software must be used in accordance with the End User License Agreement.
+//
+//=============================================================================
+#ifndef COMPILER_DEFS_H
+#include <compiler_defs.h>
+#endif
+//=============================================================================
+//-----------------------------------------------------------------------------
+// enum used for PIPELINE_STAGE type
+//-----------------------------------------------------------------------------
+enum PIPELINE_STAGE_Enum
+{
+   PIPELINE_END = 0,                   // 0x00
+   PIPELINE_CTR,                       // 0x01
+   PIPELINE_CRC1,                      // 0x02
+   PIPELINE_ENCODE,                    // 0x03
+   PIPELINE_UNDEFINED                  // 0x04
+};
+//-----------------------------------------------------------------------------
+// Option used with a PIPELINE_CRC1 stage
+//-----------------------------------------------------------------------------
+#define PIPELINE_CRC1_INVERT           0x01
+//-----------------------------------------------------------------------------
+// typedef for status
+//-----------------------------------------------------------------------------
+typedef U8 PIPELINE_STATUS;
+//-----------------------------------------------------------------------------
+// Error codes
+//-----------------------------------------------------------------------------
+#ifndef SUCCESS
+#define SUCCESS 0
+#endif
+#define PIPELINE_ERROR_INVALID_STAGE   1
+#define PIPELINE_ERROR_BUSY            2
+//-----------------------------------------------------------------------------
+// Stage descriptor
+//
+// type     option                          size           input/output
+// CTR      operation as for                bytes, a       plaintext and
+//          CTR_EncryptDecrypt()            multiple of 16 ciphertext
+// CRC1     PIPELINE_CRC1_INVERT or 0       bytes          data and 2-byte
+//                                                         result, msb first
+// ENCODE   MANCHESTER_ENCODE or            unencoded      unencoded and
+//          THREEOUTOFSIX_ENCODE            bytes          encoded data
+//
+// The counter and key are used only by CTR stages and the polynomial only
+// by CRC1 stages. A CTR stage updates the counter the same way as
+// CTR_EncryptDecrypt(). The list ends with a PIPELINE_END stage.
+//-----------------------------------------------------------------------------
+typedef struct PIPELINE_STAGE_Struct
+{
+   U8 type;
+   U8 option;
+   U16 size;
+   VARIABLE_SEGMENT_POINTER(input, U8, SEG_XDATA);
+   VARIABLE_SEGMENT_POINTER(output, U8, SEG_XDATA);
+   VARIABLE_SEGMENT_POINTER(counter, U8, SEG_XDATA);
+   VARIABLE_SEGMENT_POINTER(key, U8, SEG_XDATA);
+   U16 polynomial;
+} PIPELINE_STAGE;
+//=============================================================================
+// Function Prototypes (API)
+//=============================================================================
+PIPELINE_STATUS PacketPipelineStart (
+   VARIABLE_SEGMENT_POINTER(stages, PIPELINE_STAGE, SEG_XDATA));
+PIPELINE_STATUS PacketPipelineRun (
+   VARIABLE_SEGMENT_POINTER(stages, PIPELINE_STAGE, SEG_XDATA));
+U8   PacketPipelineBusy (void);
+void PacketPipelineService (void);
+//=============================================================================
+// End of file
+//=============================================================================
+#endif  // #ifdef PACKET_PIPELINE_H
+//=============================================================================
@@ -0,0 +1,303 @@
+//=============================================================================
+// Pipeline_Test.c
+//=============================================================================
+// Copyright 2010 Silicon Laboratories, Inc.
+// http://www.silabs.com
+//
+// C File Description:
+//
+//    This file is the main module for the packet pipeline and validates a
+// secure radio frame built with a single PacketPipelineRun() call.
+//
+// Target:
+//    C8051F960
+//
+// IDE:
+//    Silicon Laboratories IDE
+//
+// Tool Chains:
+//    Keil
+//    SDCC
+//    Raisonance
+//
+// Project Name:
+//    C8051F960 Code Examples
+//
+// This software must be used in accordance with the End User License Agreement.
+//
+//=============================================================================
+//-----------------------------------------------------------------------------
+// uncomment pragma SRC to generate assemble code
+//-----------------------------------------------------------------------------
+//#pragma SRC
+//-----------------------------------------------------------------------------
+// Includes
+//-----------------------------------------------------------------------------
+#include <compiler_defs.h>
+#include "C8051F960_defs.h"
+#include "PacketPipeline.h"
+#include "AES_defs.h"
+#include "CRC1.h"
+#include "EncoderDecoder.h"
+#include "../AES/TestVectors.h"
+//-----------------------------------------------------------------------------
+// Frame sizes
+//-----------------------------------------------------------------------------
+#define PAYLOAD_SIZE    64
+#define FRAME_SIZE      (PAYLOAD_SIZE + 2)
+#define CRC_POLYNOMIAL  0x3d65
+//=============================================================================
+// File global variables
+//
+// The pipeline stages and all buffers must be located in XRAM.
+//
+//=============================================================================
+SEGMENT_VARIABLE (EncryptionKey[16], U8, SEG_XDATA);
+SEGMENT_VARIABLE (Counter[16], U8, SEG_XDATA);
+SEGMENT_VARIABLE (Payload[PAYLOAD_SIZE], U8, SEG_XDATA);
+SEGMENT_VARIABLE (Frame[FRAME_SIZE], U8, SEG_XDATA);
+SEGMENT_VARIABLE (TxBuffer[FRAME_SIZE * 2], U8, SEG_XDATA);
+SEGMENT_VARIABLE (Stages[4], PIPELINE_STAGE, SEG_XDATA);
+//=============================================================================
+// Function Prototypes
+//=============================================================================
+//-----------------------------------------------------------------------------
+// Interrupt proto (for SDCC compatibility)
+//-----------------------------------------------------------------------------
+INTERRUPT_PROTO(DMA_ISR, INTERRUPT_DMA0);
+//-----------------------------------------------------------------------------
+// Functions used to initialize and verify arrays.
+//-----------------------------------------------------------------------------
+void initData (VARIABLE_SEGMENT_POINTER(xdataPointer, U8, SEG_XDATA),
+   VARIABLE_SEGMENT_POINTER(codePointer, U8, SEG_CODE), U8 bytes);
+
+U8 verifyData (VARIABLE_SEGMENT_POINTER(xdataPointer, U8, SEG_XDATA),
+   VARIABLE_SEGMENT_POINTER(codePointer, U8, SEG_CODE), U8 bytes);
+
+U8 verifyFrame (U8 decoding);
+
+void initStages (U8 encoding);
+//=============================================================================
+// main
+//=============================================================================
+//-----------------------------------------------------------------------------
+// main()
+//
+// Parameters: none
+// Returns: none
+//
+// Description:
+//
+// This main module program serves as a code example for the packet
+// pipeline. A 64-byte payload is encrypted in CTR mode, the CRC of the
+// ciphertext is appended and the frame is encoded into the TX buffer.
+// This is done once with Manchester encoding and once with Three out of
+// Six encoding.
+//
+// The TX buffer is then decoded with EncodeDecode() and the ciphertext
+// and CRC are checked using the reference CTR ciphertext and
+// ComputeCRC1().
+//
+// The project also requires:
+// PacketPipeline.c
+// CRC1.c
+// EncoderDecoder.c
+// TestVectors.c (AES)
+//
+// Steps to use:
+// Compile and download the code. Run code. If the code does not reach the
+// while(1) at the end of main, halt debugger and check code location.
+//
+// This simple test code will hang just after the respective test
+// if any test fails.
+//-----------------------------------------------------------------------------
+void main (void)
+{
+   U8 status;
+
+   PCA0MD  &= ~0x40;                   // disable watchdog timer
+
+   EA = 1;                             // enable global interrupts
+
+   // Manchester encoded frame
+   initStages(MANCHESTER_ENCODE);
+
+   status = PacketPipelineRun(Stages);
+
+   while(status);                      // code will hang here on error.
+
+   status = verifyFrame(MANCHESTER_DECODE);
+
+   while(status);                      // code will hang here on error.
+
+   // Three out of Six encoded frame
+   initStages(THREEOUTOFSIX_ENCODE);
+
+   status = PacketPipelineRun(Stages);
+
+   while(status);                      // code will hang here on error.
+
+   status = verifyFrame(THREEOUTOFSIX_DECODE);
+
+   while(status);                      // code will hang here on error.
+
+   while(1);
+}
+//-----------------------------------------------------------------------------
+// DMA_ISR
+// description:
+//
+// The pipeline starts each stage from the DMA ISR. PacketPipelineService()
+// disables EIE2 bit 5 when the pipeline is not busy, so the blocking
+// functions used by verifyFrame() work with this ISR as well.
+//
+//-----------------------------------------------------------------------------
+INTERRUPT(DMA_ISR, INTERRUPT_DMA0)
+{
+   PacketPipelineService();
+}
+//-----------------------------------------------------------------------------
+// initStages()
+//
+// parameters:
+//   encoding           - MANCHESTER_ENCODE or THREEOUTOFSIX_ENCODE
+//
+// description:
+//
+// Copies the reference key, nonce and plaintext to XRAM and fills in the
+// stage list for one frame.
+//
+//-----------------------------------------------------------------------------
+void initStages (U8 encoding)
+{
+   initData(EncryptionKey, ReferenceEncryptionKey128, 16);
+   initData(Counter, Nonce, 16);
+   initData(Payload, ReferencePlainText, PAYLOAD_SIZE);
+
+   // Encrypt the payload into the frame.
+   Stages[0].type = PIPELINE_CTR;
+   Stages[0].option = ENCRYPTION_128_BITS;
+   Stages[0].size = PAYLOAD_SIZE;
+   Stages[0].input = Payload;
+   Stages[0].output = Frame;
+   Stages[0].counter = Counter;
+   Stages[0].key = EncryptionKey;
+
+   // Append the CRC of the ciphertext.
+   Stages[1].type = PIPELINE_CRC1;
+   Stages[1].option = PIPELINE_CRC1_INVERT;
+   Stages[1].size = PAYLOAD_SIZE;
+   Stages[1].input = Frame;
+   Stages[1].output = Frame + PAYLOAD_SIZE;
+   Stages[1].polynomial = CRC_POLYNOMIAL;
+
+   // Encode the frame into the TX buffer.
+   Stages[2].type = PIPELINE_ENCODE;
+   Stages[2].option = encoding;
+   Stages[2].size = FRAME_SIZE;
+   Stages[2].input = Frame;
+   Stages[2].output = TxBuffer;
+
+   Stages[3].type = PIPELINE_END;
+}
+//-----------------------------------------------------------------------------
+// verifyFrame()
+//
+// parameters:
+//   decoding           - MANCHESTER_DECODE or THREEOUTOFSIX_DECODE
+//
+// returns:
+//    number of errors, zero if the TX buffer holds the expected frame
+//
+// description:
+//
+// Decodes the TX buffer into the frame buffer and checks the ciphertext
+// and the CRC.
+//
+//-----------------------------------------------------------------------------
+U8 verifyFrame (U8 decoding)
+{
+   U16 encodedSize;
+   U16 crc;
+   U8 errors;
+
+   if(decoding == MANCHESTER_DECODE)
+      encodedSize = FRAME_SIZE * 2;
+   else
+      encodedSize = (FRAME_SIZE / 2) * 3;
+
+   initData(Frame, Nonce, 16);         // overwrite part of the old frame
+
+   errors = EncodeDecode(decoding, encodedSize, Frame, TxBuffer);
+
+   errors += verifyData(Frame, ReferenceCipherText_CTR_128, PAYLOAD_SIZE);
+
+   errors += ComputeCRC1(PAYLOAD_SIZE, CRC_POLYNOMIAL, Frame, &crc);
+
+   crc = ~crc;
+
+   if((Frame[PAYLOAD_SIZE] != (U8)(crc >> 8)) ||
+      (Frame[PAYLOAD_SIZE + 1] != (U8)crc))
+      errors++;
+
+   return errors;
+}
+//-----------------------------------------------------------------------------
+// initData()
+//
+// parameters:
+//   xdataPointer       - xdata pointer to destination
+//   codePointer        - code pointer to reference data
+//   bytes              - the number of bytes to copy
+//
+// description:
+//
+// Copies reference data in Flash to xdata RAM.
+// The data must be copied to xdata for use by the DMA.
+//
+//-----------------------------------------------------------------------------
+void initData (VARIABLE_SEGMENT_POINTER(xdataPointer, U8, SEG_XDATA),
+   VARIABLE_SEGMENT_POINTER(codePointer, U8, SEG_CODE),
+   U8 bytes)
+{
+   while(bytes--)
+   {
+      *xdataPointer++ = *codePointer++;
+   }
+}
+//-----------------------------------------------------------------------------
+// verifyData()
+//
+// parameters:
+//   xdataPointer       - xdata pointer to data
+//   codePointer        - code pointer to reference data
+//   bytes              - the number of bytes to compare
+//
+// returns:
+//    badBytes          - the number of incorrect bytes
+//
+// description:
+//
+// Compares data in RAM to reference data stored in Flash.
+// The return value should be zero if the data are identical.
+//
+//-----------------------------------------------------------------------------
+U8 verifyData (VARIABLE_SEGMENT_POINTER(xdataPointer, U8, SEG_XDATA),
+   VARIABLE_SEGMENT_POINTER(codePointer, U8, SEG_CODE),
+   U8 bytes)
+{
+   U8 badBytes;
+
+   badBytes=0;
+
+   while(bytes--)
+   {
+      if(*xdataPointer++ != *codePointer++)
+         badBytes++;
+   }
+
+   return badBytes;
+}
+//=============================================================================
+// End of file
+//=============================================================================
@@ -0,0 +1,356 @@
+//=============================================================================
+// SPI1_Queue.c
+//-----------------------------------------------------------------------------
+// Copyright 2011 Silicon Laboratories, Inc.
+// http://www.silabs.com
+//
+// C File Description:
+//
+// This reusable module queues SPI1 master mode DMA transfers. Each transfer
+// selects a slave, sends its command bytes and transfers its data. The DMA
+// ISR starts each phase and each queued transfer as soon as the previous
+// one has finished, so a series of short radio and flash commands runs
+// without the CPU waiting on each one.
+//
+// SPI1 must be initialized as in SPI1_Master_Test.c. The DMA ISR in the
+// main module must call SPI1_QueueService(). The DMA channels are
+// configured in the DMA-defs.h header file.
+//
+// Target:
+//    C8051F960
+//
+// IDE:
+//    Silicon Laboratories IDE
+//
+// Tool Chains:
+//    Keil
+//    SDCC
+//    Raisonance
+//
+// Project Name:
+//    C8051F960 Example Code
+//
+// This software must be used in accordance with the End User License Agreement.
+//
+//=============================================================================
+//-----------------------------------------------------------------------------
+// Includes
+//-----------------------------------------------------------------------------
+#include <compiler_defs.h>
+#include <C8051F960_defs.h>
+#include "SPI1_Queue.h"
+#include "DMA_defs.h"
+//=============================================================================
+// Global Variables
+//=============================================================================
+volatile U8 SPI1_QueueCompleted;       // incremented for each finished transfer
+//=============================================================================
+// File Global Variables
+//=============================================================================
+VARIABLE_SEGMENT_POINTER(SPI1_Queue[SPI1_QUEUE_SIZE], SPI1_TRANSFER, SEG_XDATA);
+VARIABLE_SEGMENT_POINTER(SPI1_Active, SPI1_TRANSFER, SEG_XDATA);
+U8 SPI1_QueueHead;
+volatile U8 SPI1_QueueCount;
+bit SPI1_DataPhase;                    // command phase done
+U8 SPI1_DoneMask;                      // DMA0INT bit ending the phase
+//-----------------------------------------------------------------------------
+// MISO data received during the command bytes
+//-----------------------------------------------------------------------------
+SEGMENT_VARIABLE (SPI1_Discard[SPI1_QUEUE_COMMAND_SIZE], U8, SEG_XDATA);
+//-----------------------------------------------------------------------------
+// Unions used by SPI1_StartPhase(). These are globals rather than locals so
+// that SPI1_StartPhase() has no overlayable data.
+//-----------------------------------------------------------------------------
+UU16 SPI1_Length;
+UU16 SPI1_OutAddr;
+UU16 SPI1_InAddr;
+//=============================================================================
+// Function Prototypes (Internal)
+//=============================================================================
+void SPI1_StartTransfer (void);
+void SPI1_StartPhase (void);
+void SPI1_EndPhase (void);
+//=============================================================================
+// API Functions
+//=============================================================================
+//-----------------------------------------------------------------------------
+// SPI1_QueueSubmit()
+//
+// parameters:
+//    transfer        - xdata pointer to a filled in SPI1_TRANSFER
+//
+// returns:
+//    status         - 0 for SUCCESS
+//                   - 1 for SPI1_QUEUE_ERROR_INVALID_TRANSFER
+//                   - 2 for SPI1_QUEUE_ERROR_FULL
+//
+// Description:
+//
+// This function adds a transfer to the queue and returns at once. If SPI1
+// is idle the transfer is started before returning.
+//
+// Transfers are done in the order they are submitted. A transfer clears
+// the select pins on SPI1_QUEUE_SELECT_PORT, sends the command bytes,
+// transfers the data and sets the select pins again, unless the
+// SPI1_KEEP_SELECT flag is set. With SPI1_KEEP_SELECT the next transfer
+// continues the same slave transaction, for example to read a flash page
+// into two buffers.
+//
+// The command and data phases each use one DMA transfer. The data phase
+// of a write only transfer (inPointer is zero) uses the SPI1_IN channel
+// only. At the end of it the DMA ISR waits for the last byte to be sent,
+// about one byte time, before the slave is released.
+//
+// The same restrictions as SPI1_MasterOutIn() apply to the buffers.
+// SPI1_MasterOutIn() and SPI1_MasterOutOnly() must not be used while
+// SPI1_QueueBusy() is non-zero.
+//
+// With Keil, SPI1_StartTransfer() and SPI1_StartPhase() are called from
+// here and from the DMA ISR. The linker reports this as warning L15. This
+// is safe because the DMA interrupt is disabled while they are called here
+// and the functions have no parameters or local variables.
+//
+//-----------------------------------------------------------------------------
+U8 SPI1_QueueSubmit (
+   VARIABLE_SEGMENT_POINTER(transfer, SPI1_TRANSFER, SEG_XDATA))
+{
+   U8 tail;
+
+   // check first for valid command size and data pointers
+   if((transfer->commandSize > SPI1_QUEUE_COMMAND_SIZE)||
+      ((transfer->commandSize == 0) && (transfer->size == 0))||
+      ((transfer->size != 0) && (transfer->outPointer == 0)))
+   {
+      return SPI1_QUEUE_ERROR_INVALID_TRANSFER;
+   }
+
+   // Keep SPI1_QueueService() out while the queue is changed.
+   EIE2 &= ~0x20;
+
+   if(SPI1_QueueCount == SPI1_QUEUE_SIZE)
+   {
+      EIE2 |= 0x20;                    // transfer still active
+      return SPI1_QUEUE_ERROR_FULL;
+   }
+
+   transfer->state = SPI1_TRANSFER_QUEUED;
+
+   tail = (SPI1_QueueHead + SPI1_QueueCount) & (SPI1_QUEUE_SIZE - 1);
+   SPI1_Queue[tail] = transfer;
+   SPI1_QueueCount++;
+
+   if(SPI1_QueueCount == 1)
+      SPI1_StartTransfer();            // enables DMA interrupt
+   else
+      EIE2 |= 0x20;
+
+   return SUCCESS;
+}
+//-----------------------------------------------------------------------------
+// SPI1_QueueBusy()
+//
+// returns:
+//    number of queued transfers, including the active transfer
+//
+//-----------------------------------------------------------------------------
+U8 SPI1_QueueBusy (void)
+{
+   return SPI1_QueueCount;
+}
+//-----------------------------------------------------------------------------
+// SPI1_QueueWait()
+//
+// Description:
+//
+// Waits in Idle mode until all queued transfers are done.
+//
+//-----------------------------------------------------------------------------
+void SPI1_QueueWait (void)
+{
+   while(SPI1_QueueCount)
+   {
+      #ifdef DMA_TRANSFERS_USE_IDLE
+      PCON |= 0x01;                    // go to Idle mode
+      #endif
+   }
+}
+//-----------------------------------------------------------------------------
+// SPI1_QueueService()
+//
+// Description:
+//
+// This function must be called from the DMA ISR. When the current phase
+// has finished it starts the data phase of the active transfer or
+// completes the transfer and starts the next queued transfer.
+//
+// When the queue is empty this function disables EIE2 bit 5, which is what
+// the DMA ISR does for the blocking functions.
+//
+//-----------------------------------------------------------------------------
+void SPI1_QueueService (void)
+{
+   U8 restoreSFRPAGE;
+
+   restoreSFRPAGE = SFRPAGE;
+   SFRPAGE = DPPE_PAGE;
+
+   if(SPI1_QueueCount == 0)
+   {
+      EIE2 &= ~0x20;                   // disable further interrupts
+   }
+   else if(DMA0INT & SPI1_DoneMask)
+   {
+      SPI1_EndPhase();
+
+      if((SPI1_DataPhase == 0) && (SPI1_Active->size != 0))
+      {
+         SPI1_DataPhase = 1;
+         SPI1_StartPhase();
+      }
+      else
+      {
+         // Release the slave unless the next transfer continues.
+         if((SPI1_Active->flags & SPI1_KEEP_SELECT) == 0)
+         {
+            SFRPAGE = LEGACY_PAGE;
+            SPI1_QUEUE_SELECT_PORT |= SPI1_Active->select;
+            SFRPAGE = DPPE_PAGE;
+         }
+
+         SPI1_Active->state = SPI1_TRANSFER_DONE;
+         SPI1_QueueCompleted++;
+
+         SPI1_QueueHead = (SPI1_QueueHead + 1) & (SPI1_QUEUE_SIZE - 1);
+         SPI1_QueueCount--;
+
+         if(SPI1_QueueCount)
+            SPI1_StartTransfer();
+         else
+            EIE2 &= ~0x20;             // disable further interrupts
+      }
+   }
+
+   SFRPAGE = restoreSFRPAGE;
+}
+//=============================================================================
+// Internal Functions
+//=============================================================================
+//-----------------------------------------------------------------------------
+// SPI1_StartTransfer()
+//
+// Description:
+//
+// Selects the slave for the transfer at the head of the queue and starts
+// the first phase. Called with the DMA interrupt disabled or from the DMA
+// ISR.
+//
+//-----------------------------------------------------------------------------
+void SPI1_StartTransfer (void)
+{
+   SPI1_Active = SPI1_Queue[SPI1_QueueHead];
+   SPI1_Active->state = SPI1_TRANSFER_ACTIVE;
+
+   SPI1_DataPhase = (SPI1_Active->commandSize == 0);
+
+   SFRPAGE = LEGACY_PAGE;
+   SPI1_QUEUE_SELECT_PORT &= ~SPI1_Active->select;
+
+   SPI1_StartPhase();
+
+   EIE2 |= 0x20;                       // enable DMA interrupt
+}
+//-----------------------------------------------------------------------------
+// SPI1_StartPhase()
+//
+// Description:
+//
+// Configures the SPI1 DMA channels for the command or data phase of the
+// active transfer, the same way as SPI1_MasterOutIn() or
+// SPI1_MasterOutOnly().
+//
+//-----------------------------------------------------------------------------
+void SPI1_StartPhase (void)
+{
+   if(SPI1_DataPhase)
+   {
+      SPI1_Length.U16 = SPI1_Active->size;
+      SPI1_OutAddr.U16 = (U16)(SPI1_Active->outPointer);
+      SPI1_InAddr.U16 = (U16)(SPI1_Active->inPointer);
+   }
+   else
+   {
+      SPI1_Length.U16 = SPI1_Active->commandSize;
+      SPI1_OutAddr.U16 = (U16)(SPI1_Active->command);
+      SPI1_InAddr.U16 = (U16)(SPI1_Discard);
+   }
+
+   SFRPAGE = DPPE_PAGE;
+   DMA0EN &= ~(SPI1_MASK);             // Disable SPI DMA channels for now.
+
+   // SPI1_IN means XRAM to SPI1DAT, transmitted on MOSI.
+   DMA0SEL = SPI1_IN_CHANNEL;
+   if(SPI1_InAddr.U16)
+      DMA0NCF = SPI1_IN_PERIPHERAL_REQUEST;
+   else
+      DMA0NCF = SPI1_IN_PERIPHERAL_REQUEST|DMA_INT_EN;
+   DMA0NMD = NO_WRAPPING;
+   DMA0NBAL = SPI1_OutAddr.U8[LSB];
+   DMA0NBAH = SPI1_OutAddr.U8[MSB];
+   DMA0NSZL = SPI1_Length.U8[LSB];
+   DMA0NSZH = SPI1_Length.U8[MSB];
+   DMA0NAOL = 0;
+   DMA0NAOH = 0;
+
+   if(SPI1_InAddr.U16)
+   {
+      // SPI1_OUT means SPI1DAT to XRAM, received on MISO.
+      DMA0SEL = SPI1_OUT_CHANNEL;
+      DMA0NCF = SPI1_OUT_PERIPHERAL_REQUEST|DMA_INT_EN;
+      DMA0NMD = NO_WRAPPING;
+      DMA0NBAL = SPI1_InAddr.U8[LSB];
+      DMA0NBAH = SPI1_InAddr.U8[MSB];
+      DMA0NSZL = SPI1_Length.U8[LSB];
+      DMA0NSZH = SPI1_Length.U8[MSB];
+      DMA0NAOL = 0;
+      DMA0NAOH = 0;
+
+      SPI1_DoneMask = SPI1_OUT_MASK;
+      DMA0INT &= ~(SPI1_MASK);
+      DMA0EN |= (SPI1_MASK);           // start the transfer
+   }
+   else
+   {
+      SPI1_DoneMask = SPI1_IN_MASK;
+      DMA0INT &= ~SPI1_IN_MASK;
+      DMA0EN |= SPI1_IN_MASK;          // start the transfer
+   }
+}
+//-----------------------------------------------------------------------------
+// SPI1_EndPhase()
+//
+// Description:
+//
+// Disables the SPI1 DMA channels. After a write only phase this waits
+// until the last byte has been transmitted and clears the SPI1 receive
+// flags, so that no stale data is taken by the next phase. Called only
+// from the DMA ISR with SFRPAGE set to DPPE_PAGE.
+//
+//-----------------------------------------------------------------------------
+void SPI1_EndPhase (void)
+{
+   // Clear SPI1 bits (SPI1_IN & SPI1_OUT) bits in DMA0EN and DMA0INT.
+   DMA0EN &= ~(SPI1_MASK);
+   DMA0INT &= ~(SPI1_MASK);
+
+   if(SPI1_DoneMask == SPI1_IN_MASK)
+   {
+      SFRPAGE = SPI1_PAGE;
+      while(!TXBMT1);                  // wait on TXBMT1
+      while((SPI1CFG & 0x80) == 0x80); // wait on SPIBSY1
+      SPI1CN &= ~0xF0;                 // clear SPIF1, WCOL1, MODF1, RXOVRN1
+      SFRPAGE = DPPE_PAGE;
+   }
+}
+//=============================================================================
+// End of file
+//=============================================================================
@@ -0,0 +1,110 @@
+#ifndef SPI1_QUEUE_H
+#define SPI1_QUEUE_H
+//=============================================================================
+// SPI1_Queue.h
+//-----------------------------------------------------------------------------
+// Copyright 2011 Silicon Laboratories, Inc.
+// http://www.silabs.com
+//
+// C File Description:
+//
+//    Queue of SPI1 master mode DMA transfers with slave select and command
+//    bytes.
+//
+// Target:
+//    C8051F960
+//
+// IDE:
+//    Silicon Laboratories IDE
+//
+// Tool Chains:
+//    Keil
+//    SDCC
+//    Raisonance
+//
+// Project Name:
+//    C8051F960 Code Examples
+//
+// This software must be used in accordance with the End User License Agreement.
+//
+//=============================================================================
+#ifndef COMPILER_DEFS_H
+#include <compiler_defs.h>
+#endif
+//=============================================================================
+//-----------------------------------------------------------------------------
+// Number of transfers that may be queued, must be a power of two.
+//-----------------------------------------------------------------------------
+#define SPI1_QUEUE_SIZE          8
+//-----------------------------------------------------------------------------
+// Maximum number of command bytes in one transfer.
+//-----------------------------------------------------------------------------
+#define SPI1_QUEUE_COMMAND_SIZE  5
+//-----------------------------------------------------------------------------
+// Port with the active low slave select pins. The select field of a
+// transfer is a mask of pins on this port. The pins must be configured as
+// push-pull outputs and set high by the application.
+//-----------------------------------------------------------------------------
+#define SPI1_QUEUE_SELECT_PORT   P1
+//-----------------------------------------------------------------------------
+// defines used with SPI1_TRANSFER flags
+//-----------------------------------------------------------------------------
+#define SPI1_KEEP_SELECT         0x01  // leave slave selected at the end
+//-----------------------------------------------------------------------------
+// enum used for SPI1_TRANSFER state
+//-----------------------------------------------------------------------------
+enum SPI1_TRANSFER_STATE_Enum
+{
+   SPI1_TRANSFER_IDLE = 0,             // 0x00
+   SPI1_TRANSFER_QUEUED,               // 0x01
+   SPI1_TRANSFER_ACTIVE,               // 0x02
+   SPI1_TRANSFER_DONE                  // 0x03
+};
+//-----------------------------------------------------------------------------
+// Error codes
+//-----------------------------------------------------------------------------
+#ifndef SUCCESS
+#define SUCCESS 0
+#endif
+#define SPI1_QUEUE_ERROR_INVALID_TRANSFER 1
+#define SPI1_QUEUE_ERROR_FULL             2
+//-----------------------------------------------------------------------------
+// Transfer structure
+//
+// A transfer selects the slave, sends the command bytes and then transfers
+// size bytes of data. The data from outPointer is transmitted on MOSI. If
+// inPointer is not zero the data received on MISO is stored there. To read
+// from a slave, outPointer may be the same as inPointer. The data received
+// while the command bytes are sent is discarded.
+//
+// The transfer must be located in xdata and must not be modified until the
+// state is SPI1_TRANSFER_DONE.
+//-----------------------------------------------------------------------------
+typedef struct SPI1_TRANSFER_Struct
+{
+   U8 select;
+   U8 flags;
+   U8 commandSize;
+   U8 command[SPI1_QUEUE_COMMAND_SIZE];
+   U16 size;
+   VARIABLE_SEGMENT_POINTER(outPointer, U8, SEG_XDATA);
+   VARIABLE_SEGMENT_POINTER(inPointer, U8, SEG_XDATA);
+   volatile U8 state;
+} SPI1_TRANSFER;
+//-----------------------------------------------------------------------------
+// Public variables
+//-----------------------------------------------------------------------------
+extern volatile U8 SPI1_QueueCompleted;
+//=============================================================================
+// Function Prototypes (API)
+//=============================================================================
+U8   SPI1_QueueSubmit (
+   VARIABLE_SEGMENT_POINTER(transfer, SPI1_TRANSFER, SEG_XDATA));
+U8   SPI1_QueueBusy (void);
+void SPI1_QueueWait (void);
+void SPI1_QueueService (void);
+//=============================================================================
+#endif  // #ifdef SPI1_QUEUE_H
+//=============================================================================
+// End of file
+//=============================================================================
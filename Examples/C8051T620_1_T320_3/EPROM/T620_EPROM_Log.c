@@ -0,0 +1,402 @@
+//-----------------------------------------------------------------------------
+// T620_EPROM_Log.c
+//-----------------------------------------------------------------------------
+// Copyright 2009 Silicon Laboratories, Inc.
+// http://www.silabs.com
+//
+// Program Description:
+//
+// This program contains an append-only log of records, such as calibration
+// and production data, in the EPROM between EPROM_LOG_START and
+// EPROM_LOG_END. A byte of the log is never written twice, so a record is
+// changed by appending a new record of the same type. The last valid
+// record of a type supersedes the earlier ones.
+//
+// Each record is written in this order:
+//
+//    [header][type][length][data ...][CRC MSB][CRC LSB]
+//
+// The header is 0xA0 plus the format version. The CRC covers the header,
+// type, length and data bytes. It is the CRC-16 of CRC0 (polynomial
+// 0x1021, initial value 0), so it can also be checked with CRC0 on other
+// parts.
+//
+// EPROMLog_Init() reads the log once and keeps the address of the last
+// valid record of each type in xdata, so EPROMLog_Find() and
+// EPROMLog_Read() do not search the EPROM.
+//
+// If a reset occurs while a record is written, the record is left
+// incomplete. Its CRC does not match, so it is ignored, and the log
+// continues after it:
+//
+//    - a header that is not a record header is skipped alone
+//    - a record with a length over EPROM_LOG_MAX_DATA, including an
+//      unwritten length, is skipped after the length byte
+//    - any other record is skipped by its length
+//
+// Records with the record header of another format version are skipped by
+// their length.
+//
+// Target:         C8051T620/1 or C8051T320/1/2/3
+// Tool chain:     Keil / Raisonance
+// Command Line:   None
+//
+//
+// Release 1.0
+//    -Initial Revision
+//
+
+//-----------------------------------------------------------------------------
+// Includes
+//-----------------------------------------------------------------------------
+
+#include "compiler_defs.h"
+#include "T620_EPROM_Primitives.h"
+#include "T620_EPROM_Utils.h"
+#include "T620_EPROM_Log.h"
+
+//-----------------------------------------------------------------------------
+// Global Constants
+//-----------------------------------------------------------------------------
+
+#define LOG_MARKER         0xA0        // Upper nibble of a record header
+#define LOG_VERSION        0x01        // Format version of this file
+#define LOG_HEADER         (LOG_MARKER | LOG_VERSION)
+
+#define LOG_UNWRITTEN      0xFF
+
+//-----------------------------------------------------------------------------
+// Function Prototypes
+//-----------------------------------------------------------------------------
+
+void      EPROMLog_Init (void);
+U8        EPROMLog_Read (U8 type, U8 *dest, U8 size);
+U8        EPROMLog_Append (U8 type, U8 *src, U8 length);
+EPROMADDR EPROMLog_Find (U8 type);
+U16       EPROMLog_Free (void);
+
+U8  Log_Valid (EPROMADDR addr);
+U16 Log_Crc (U16 crc, U8 byte);
+
+//-----------------------------------------------------------------------------
+// Global Variables
+//-----------------------------------------------------------------------------
+
+// CRC of each 4-bit value shifted into the top of the CRC register
+SEGMENT_VARIABLE (Log_CrcTable[16], U16, SEG_CODE) =
+{
+   0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+   0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF
+};
+
+// Address of the last valid record of each type, 0 if none
+SEGMENT_VARIABLE (Log_Index[EPROM_LOG_TYPES], EPROMADDR, xdata);
+
+EPROMADDR Log_Next;                    // First unwritten byte of the log
+
+//-----------------------------------------------------------------------------
+// EPROMLog_Init
+//-----------------------------------------------------------------------------
+//
+// Return Value : None
+// Parameters   : None
+//
+// This routine reads the log from EPROM_LOG_START to the first unwritten
+// header, checks the CRC of each record and indexes the valid records.
+// It must be called before the other routines.
+//
+//-----------------------------------------------------------------------------
+void EPROMLog_Init (void)
+{
+   EPROMADDR addr;
+   U8 header;
+   U8 type;
+   U8 length;
+   U8 i;
+
+   for (i = 0; i < EPROM_LOG_TYPES; i++)
+   {
+      Log_Index[i] = 0;
+   }
+
+   addr = EPROM_LOG_START;
+
+   while (addr < EPROM_LOG_END)
+   {
+      header = EPROM_ByteRead (addr);
+
+      if (header == LOG_UNWRITTEN)
+      {
+         break;                        // End of the log
+      }
+
+      if ((header & 0xF0) != LOG_MARKER)
+      {
+         addr++;                       // Incomplete header
+         continue;
+      }
+
+      if ((EPROM_LOG_END - addr) < EPROM_LOG_OVERHEAD)
+      {
+         addr = EPROM_LOG_END;         // Incomplete record at the end
+         break;
+      }
+
+      type = EPROM_ByteRead (addr + 1);
+      length = EPROM_ByteRead (addr + 2);
+
+      if (length > EPROM_LOG_MAX_DATA)
+      {
+         addr += 3;                    // Incomplete length
+         continue;
+      }
+
+      if ((header == LOG_HEADER) && (type < EPROM_LOG_TYPES) &&
+          Log_Valid (addr))
+      {
+         Log_Index[type] = addr;
+      }
+
+      if ((EPROM_LOG_END - addr) < (length + EPROM_LOG_OVERHEAD))
+      {
+         addr = EPROM_LOG_END;
+         break;
+      }
+
+      addr += length + EPROM_LOG_OVERHEAD;
+   }
+
+   Log_Next = addr;
+}
+
+//-----------------------------------------------------------------------------
+// EPROMLog_Find
+//-----------------------------------------------------------------------------
+//
+// Return Value :
+//   1) EPROMADDR - address of the record data, 0 if no record of <type>
+// Parameters   :
+//   1) U8 type - record type, 0 to EPROM_LOG_TYPES - 1
+//
+// This routine returns the address of the data of the last valid record
+// of <type>. The length of the data is at the address minus 1.
+//
+//-----------------------------------------------------------------------------
+EPROMADDR EPROMLog_Find (U8 type)
+{
+   if ((type >= EPROM_LOG_TYPES) || (Log_Index[type] == 0))
+   {
+      return 0;
+   }
+
+   return Log_Index[type] + 3;
+}
+
+//-----------------------------------------------------------------------------
+// EPROMLog_Read
+//-----------------------------------------------------------------------------
+//
+// Return Value :
+//   1) U8 - length of the record, 0 if no record of <type>
+// Parameters   :
+//   1) U8 type - record type, 0 to EPROM_LOG_TYPES - 1
+//   2) U8 *dest - pointer to destination bytes
+//   3) U8 size - size of <dest>
+//
+// This routine copies the data of the last valid record of <type> to
+// <dest>, up to <size> bytes, and returns the length of the record.
+//
+//-----------------------------------------------------------------------------
+U8 EPROMLog_Read (U8 type, U8 *dest, U8 size)
+{
+   EPROMADDR addr;
+   U8 length;
+
+   addr = EPROMLog_Find (type);
+
+   if (addr == 0)
+   {
+      return 0;
+   }
+
+   length = EPROM_ByteRead (addr - 1);
+
+   EPROM_Read ((char *) dest, addr, (length < size) ? length : size);
+
+   return length;
+}
+
+//-----------------------------------------------------------------------------
+// EPROMLog_Append
+//-----------------------------------------------------------------------------
+//
+// Return Value :
+//   0 if the record could not be written, 1 if successful
+// Parameters   :
+//   1) U8 type - record type, 0 to EPROM_LOG_TYPES - 1
+//   2) U8 *src - pointer to the record data
+//   3) U8 length - length of the data, 1 to EPROM_LOG_MAX_DATA
+//
+// This routine appends a record of <type> that supersedes the previous
+// one. Nothing is written if the data is the same as the last record of
+// <type>.
+//
+// It fails if the log does not have EPROM_LOG_OVERHEAD + <length> bytes
+// left, or if the record does not read back with a valid CRC. The bytes of
+// a failed record stay used, so a failed append may be repeated.
+//
+// - NOTE: this routine requires that the capacitor on VPP be populated for
+// the internal EPROM charge pump.
+//-----------------------------------------------------------------------------
+U8 EPROMLog_Append (U8 type, U8 *src, U8 length)
+{
+   EPROMADDR addr;
+   EPROMADDR data_addr;
+   UU16 crc;
+   U8 i;
+
+   if ((type >= EPROM_LOG_TYPES) || (length == 0) ||
+       (length > EPROM_LOG_MAX_DATA))
+   {
+      return 0;
+   }
+
+   // Skip the write if the last record holds the same data
+   data_addr = EPROMLog_Find (type);
+
+   if (data_addr && (EPROM_ByteRead (data_addr - 1) == length))
+   {
+      for (i = 0; i < length; i++)
+      {
+         if (EPROM_ByteRead (data_addr + i) != src[i])
+         {
+            break;
+         }
+      }
+
+      if (i == length)
+      {
+         return 1;
+      }
+   }
+
+   if (EPROMLog_Free () < (length + EPROM_LOG_OVERHEAD))
+   {
+      return 0;
+   }
+
+   // The bytes must be unwritten. If another routine wrote one of them,
+   // the log continues after it.
+   for (i = 0; i < (length + EPROM_LOG_OVERHEAD); i++)
+   {
+      if (EPROM_ByteRead (Log_Next + i) != LOG_UNWRITTEN)
+      {
+         Log_Next += i + 1;
+         return 0;
+      }
+   }
+
+   addr = Log_Next;
+   Log_Next += length + EPROM_LOG_OVERHEAD;
+
+   crc.U16 = Log_Crc (0, LOG_HEADER);
+   crc.U16 = Log_Crc (crc.U16, type);
+   crc.U16 = Log_Crc (crc.U16, length);
+
+   for (i = 0; i < length; i++)
+   {
+      crc.U16 = Log_Crc (crc.U16, src[i]);
+   }
+
+   EPROM_ByteWrite (addr, LOG_HEADER);
+   EPROM_ByteWrite (addr + 1, type);
+   EPROM_ByteWrite (addr + 2, length);
+   EPROM_Write (addr + 3, (char *) src, length);
+   EPROM_ByteWrite (addr + 3 + length, crc.U8[MSB]);
+   EPROM_ByteWrite (addr + 4 + length, crc.U8[LSB]);
+
+   if (!Log_Valid (addr))
+   {
+      return 0;
+   }
+
+   Log_Index[type] = addr;
+
+   return 1;
+}
+
+//-----------------------------------------------------------------------------
+// EPROMLog_Free
+//-----------------------------------------------------------------------------
+//
+// Return Value :
+//   1) U16 - unwritten bytes left in the log
+// Parameters   : None
+//
+// A record of <length> data bytes needs EPROM_LOG_OVERHEAD + <length>
+// bytes.
+//
+//-----------------------------------------------------------------------------
+U16 EPROMLog_Free (void)
+{
+   return EPROM_LOG_END - Log_Next;
+}
+
+//-----------------------------------------------------------------------------
+// Local Routines
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// Log_Valid
+//-----------------------------------------------------------------------------
+//
+// Returns 1 if the CRC of the record at <addr> matches. The length must be
+// at most EPROM_LOG_MAX_DATA and the record must fit in the log.
+//
+//-----------------------------------------------------------------------------
+U8 Log_Valid (EPROMADDR addr)
+{
+   EPROMADDR end;
+   UU16 crc;
+
+   end = addr + 3 + EPROM_ByteRead (addr + 2);
+
+   if (end > (EPROM_LOG_END - 2))
+   {
+      return 0;
+   }
+
+   crc.U16 = 0;
+
+   while (addr < end)
+   {
+      crc.U16 = Log_Crc (crc.U16, EPROM_ByteRead (addr++));
+   }
+
+   return ((EPROM_ByteRead (end) == crc.U8[MSB]) &&
+           (EPROM_ByteRead (end + 1) == crc.U8[LSB]));
+}
+
+//-----------------------------------------------------------------------------
+// Log_Crc
+//-----------------------------------------------------------------------------
+//
+// Adds <byte> to <crc>, one nibble at a time.
+//
+//-----------------------------------------------------------------------------
+U16 Log_Crc (U16 crc, U8 byte)
+{
+   UU16 value;
+
+   value.U16 = crc;
+   value.U8[MSB] ^= byte;
+
+   value.U16 = (value.U16 << 4) ^ Log_CrcTable[value.U8[MSB] >> 4];
+   value.U16 = (value.U16 << 4) ^ Log_CrcTable[value.U8[MSB] >> 4];
+
+   return value.U16;
+}
+
+//-----------------------------------------------------------------------------
+// End Of File
+//-----------------------------------------------------------------------------
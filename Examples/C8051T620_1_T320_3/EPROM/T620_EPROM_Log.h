@@ -0,0 +1,73 @@
+//-----------------------------------------------------------------------------
+// T620_EPROM_Log.h
+//-----------------------------------------------------------------------------
+// Copyright 2009 Silicon Laboratories, Inc.
+// http://www.silabs.com
+//
+// Program Description:
+//
+// Header for the append-only EPROM record log in T620_EPROM_Log.c.
+//
+// Target:         C8051T620/1 or C8051T320/1/2/3
+// Tool chain:     Keil / Raisonance
+// Command Line:   None
+//
+//
+// Release 1.0
+//    -Initial Revision
+//
+
+//-----------------------------------------------------------------------------
+// Open Header #define
+//-----------------------------------------------------------------------------
+
+#ifndef _T620_EPROMLOG_H_
+#define _T620_EPROMLOG_H_
+
+//-----------------------------------------------------------------------------
+// Includes
+//-----------------------------------------------------------------------------
+
+#include "T620_EPROM_Primitives.h"
+
+//-----------------------------------------------------------------------------
+// Global Constants
+//-----------------------------------------------------------------------------
+
+#ifndef EPROM_LOG_START
+#define EPROM_LOG_START 0x3200         // First byte of the log
+#endif
+
+#ifndef EPROM_LOG_END
+#define EPROM_LOG_END 0x3E00           // First byte after the log
+#endif                                 // (0x3E00 for 16K EPROM devices)
+
+#ifndef EPROM_LOG_TYPES
+#define EPROM_LOG_TYPES 16             // Record types are 0 to
+#endif                                 // EPROM_LOG_TYPES - 1
+
+#ifndef EPROM_LOG_MAX_DATA
+#define EPROM_LOG_MAX_DATA 32          // Largest record in bytes
+#endif
+
+#define EPROM_LOG_OVERHEAD 5           // Header, type, length and CRC bytes
+
+//-----------------------------------------------------------------------------
+// Exported Function Prototypes
+//-----------------------------------------------------------------------------
+
+void      EPROMLog_Init (void);
+U8        EPROMLog_Read (U8 type, U8 *dest, U8 size);
+U8        EPROMLog_Append (U8 type, U8 *src, U8 length);
+EPROMADDR EPROMLog_Find (U8 type);
+U16       EPROMLog_Free (void);
+
+//-----------------------------------------------------------------------------
+// Close Header #define
+//-----------------------------------------------------------------------------
+
+#endif    // _T620_EPROMLOG_H_
+
+//-----------------------------------------------------------------------------
+// End Of File
+//-----------------------------------------------------------------------------
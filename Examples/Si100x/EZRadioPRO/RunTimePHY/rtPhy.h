@@ -71,11 +71,17 @@
 // Production version should be 0x06
 //-----------------------------------------------------------------------------
 #define MIN_RADIO_VERSION   0x05
+//-----------------------------------------------------------------------------
+// TX FIFO size and the almost empty threshold used by rtPhyTxStart()
+//-----------------------------------------------------------------------------
+#define TX_FIFO_SIZE          64
+#define TX_FIFO_ALMOST_EMPTY  16
 //------------------------------------------------------------------------------------------------
 //
 //------------------------------------------------------------------------------------------------
 #define SYSCLK_HZ                (24500000L)
 #define MILLISECONDS(t)          (((SYSCLK_HZ/1000)*(t))/48)
+#define HOP_MICROSECONDS(t)      (((SYSCLK_HZ/12000L)*(t))/1000)
 //-----------------------------------------------------------------------------
 // ET0 inverted and used as timeout flag
 //-----------------------------------------------------------------------------
@@ -128,6 +134,12 @@ enum
 extern bit RxPacketReceived;
 extern SEGMENT_VARIABLE (RxPacketLength, U8, BUFFER_MSPACE);
 extern SEGMENT_VARIABLE (RxErrors, U8, BUFFER_MSPACE);
+#ifdef FREQUENCY_HOPPING
+extern U16 HopCount;
+#endif
+#if defined(TX_INTERRUPT) && !defined(RECEIVER_ONLY)
+extern bit TxPacketSent;
+#endif
 //------------------------------------------------------------------------------------------------
 // Public Run Time PHY function prototypes (API)
 //------------------------------------------------------------------------------------------------
@@ -140,9 +152,20 @@ PHY_STATUS    rtPhyIdle (void);
 PHY_STATUS    rtPhyShutDown (void);
 PHY_STATUS    rtPhyReStart (void);
 PHY_STATUS    rtPhyTx (U8, VARIABLE_SEGMENT_POINTER(buffer, U8, BUFFER_MSPACE));
+#if defined(TX_INTERRUPT) && !defined(RECEIVER_ONLY)
+PHY_STATUS    rtPhyTxStart (U8, VARIABLE_SEGMENT_POINTER(buffer, U8, BUFFER_MSPACE));
+PHY_STATUS    rtPhyTxAbort (void);
+#endif
 PHY_STATUS    rtPhyRxOn (void);
 PHY_STATUS    rtPhyRxOff (void);
 PHY_STATUS    rtPhyGetRxPacket (U8*, VARIABLE_SEGMENT_POINTER(buffer, U8, BUFFER_MSPACE));
+#ifdef FREQUENCY_HOPPING
+PHY_STATUS    rtPhyHopInit (U8, VARIABLE_SEGMENT_POINTER(table, U8, SEG_CODE));
+PHY_STATUS    rtPhyHopChannel (U8);
+PHY_STATUS    rtPhyHopNext (void);
+PHY_STATUS    rtPhyHopStart (U16);      // dwell in Timer 2 ticks
+PHY_STATUS    rtPhyHopStop (void);
+#endif
 //------------------------------------------------------------------------------------------------
 // Public primitive phy function prototypes
 //------------------------------------------------------------------------------------------------
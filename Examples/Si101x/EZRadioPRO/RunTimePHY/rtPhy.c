@@ -78,11 +78,26 @@ SEGMENT_VARIABLE (RxErrors, U8, BUFFER_MSPACE);
 //-----------------------------------------------------------------------------
 SEGMENT_VARIABLE (RxIntBuffer[64], U8, BUFFER_MSPACE);
 //-----------------------------------------------------------------------------
+// Transmit interrupt state
+//-----------------------------------------------------------------------------
+#if defined(TX_INTERRUPT) && !defined(RECEIVER_ONLY)
+bit TxPacketSent;
+bit TxIntActive;
+VARIABLE_SEGMENT_POINTER(TxIntBuffer, U8, BUFFER_MSPACE);
+U8 TxIntRemaining;
+#endif
+//-----------------------------------------------------------------------------
 // Internal interrupt functions
 //-----------------------------------------------------------------------------
 U8    RxIntPhyRead (U8);
 void  RxIntPhyWrite (U8, U8);
 void  RxIntphyReadFIFO (U8, VARIABLE_SEGMENT_POINTER(buffer, U8, BUFFER_MSPACE));
+#ifdef FREQUENCY_HOPPING
+void  HopIntPhyWrite (U8, U8);
+#endif
+#if defined(TX_INTERRUPT) && !defined(RECEIVER_ONLY)
+void  TxIntPhyWriteFIFO (U8, VARIABLE_SEGMENT_POINTER(buffer, U8, BUFFER_MSPACE));
+#endif
 //=============================================================================
 //
 // API Functions
@@ -90,6 +105,13 @@ void  RxIntphyReadFIFO (U8, VARIABLE_SEGMENT_POINTER(buffer, U8, BUFFER_MSPACE))
 //=============================================================================
 rtPhySettingsStruct SEG_XDATA rtPhySettings;
 bit PhyInitialized = 0;
+#ifdef FREQUENCY_HOPPING
+VARIABLE_SEGMENT_POINTER(HopTable, U8, SEG_CODE);
+U8 HopTableLength;
+U8 HopIndex;
+U16 HopCount;                          // hops since rtPhyHopStart(), read
+                                       // with ET2 = 0, wraps at 65536
+#endif
 //=============================================================================
 // local functions
 //=============================================================================
@@ -107,6 +129,7 @@ void  SetTxDataRate (U32);
 void  AutoRxBandwith (void);
 void  UpdateRxModemSettings(void);
 U8    LookUpFilterSetting(U32, U32 , U32 );
+U8    FindFilterIndex (VARIABLE_SEGMENT_POINTER(table, rtPhyFilterEntry, SEG_CODE), U8, U16);
 U32   CalcAFC_PullInRange(U32);
 void  SetAFC_Limit (U32);
 U16   CalcRxOverSamplingRatio (U8, U32);
@@ -764,9 +787,14 @@ void UpdateRxModemSettings()
 }
 //-----------------------------------------------------------------------------
 // Function Name
+//    LookUpFilterSetting()
 //
-// Return Value : None
-// Parameters   :
+// Return Value : U8 IF filter setting
+// Parameters   : U32 bandwidth, U32 deviation, U32 dataRate
+//
+// Selects the table for the modulation index and finds the smallest table
+// bandwidth not less than the target. The matched table bandwidth is also
+// used to update rtPhySettings.RxBandWidth.
 //
 //-----------------------------------------------------------------------------
 #ifdef HIGH_MODULATION_INDEX_TABLES
@@ -774,82 +802,83 @@ U8 LookUpFilterSetting(U32 bandwidth, U32 deviation, U32 dataRate)
 {
    U8 i;
    U32 modIndex;
-   U8 filterSetting;
-
 
    bandwidth  = Divide (bandwidth, 100);
+   if(bandwidth > 0xFFFF)
+      bandwidth = 0xFFFF;              // FindFilterIndex() takes a U16
 
    modIndex = Divide ((deviation * 20), dataRate);
 
    if(modIndex < 20)
    {
-      // Find largest value in table smaller than target.
-      i=0;
-      while (rtPhyTableRxBandwidthLT2[i] <  bandwidth)
-      {
-         i++;
-      }
-
-      filterSetting = rtPhyTableIF_FilterSettingLT2[i];
+      i = FindFilterIndex(rtPhyTableFilterLT2, NUMBER_OF_RX_BANDWIDTH_VALUES_LT2, (U16)bandwidth);
       // also use index to update Rxbandwidth
-      rtPhySettings.RxBandWidth = (rtPhyTableRxBandwidthLT2[i]) * (100L);
-
+      rtPhySettings.RxBandWidth = (rtPhyTableFilterLT2[i].RxBandwidth) * (100L);
+      return rtPhyTableFilterLT2[i].IF_FilterSetting;
    }
    else if(modIndex < 100)
    {
-      // Find largest value in table smaller than target.
-      i=0;
-      while (rtPhyTableRxBandwidthLT10[i] <  bandwidth)
-      {
-         i++;
-      }
-
-      filterSetting = rtPhyTableIF_FilterSettingLT10[i];
+      i = FindFilterIndex(rtPhyTableFilterLT10, NUMBER_OF_RX_BANDWIDTH_VALUES_LT10, (U16)bandwidth);
       // also use index to update Rxbandwidth
-      rtPhySettings.RxBandWidth = (rtPhyTableRxBandwidthLT10[i]) * (100L);
-
+      rtPhySettings.RxBandWidth = (rtPhyTableFilterLT10[i].RxBandwidth) * (100L);
+      return rtPhyTableFilterLT10[i].IF_FilterSetting;
    }
    else
    {
-      // Find largest value in table smaller than target.
-      i=0;
-      while (rtPhyTableRxBandwidthGE10[i] <  bandwidth)
-      {
-         i++;
-      }
-
-      filterSetting = rtPhyTableIF_FilterSettingGE10[i];
+      i = FindFilterIndex(rtPhyTableFilterGE10, NUMBER_OF_RX_BANDWIDTH_VALUES_GE10, (U16)bandwidth);
       // also use index to update Rxbandwidth
-      rtPhySettings.RxBandWidth = (rtPhyTableRxBandwidthGE10[i]) * (100L);
+      rtPhySettings.RxBandWidth = (rtPhyTableFilterGE10[i].RxBandwidth) * (100L);
+      return rtPhyTableFilterGE10[i].IF_FilterSetting;
    }
-
-   return filterSetting;
 }
 #else
 U8 LookUpFilterSetting(U32 bandwidth, U32 deviation, U32 dataRate)
 {
    U8 i;
-   U8 filterSetting;
 
    bandwidth  = Divide (bandwidth, 100);
+   if(bandwidth > 0xFFFF)
+      bandwidth = 0xFFFF;              // FindFilterIndex() takes a U16
 
    deviation = deviation;
    dataRate = dataRate;
 
-   // Find largest value in table smaller than target.
-   i=0;
-   while (rtPhyTableRxBandwidthLT2[i] <  bandwidth)
+   i = FindFilterIndex(rtPhyTableFilterLT2, NUMBER_OF_RX_BANDWIDTH_VALUES_LT2, (U16)bandwidth);
+   // also use index to update Rxbandwidth
+   rtPhySettings.RxBandWidth = (rtPhyTableFilterLT2[i].RxBandwidth) * (100L);
+
+   return rtPhyTableFilterLT2[i].IF_FilterSetting;
+}
+#endif
+//-----------------------------------------------------------------------------
+// Function Name
+//    FindFilterIndex()
+//
+// Return Value : U8 index of the smallest entry not less than bandwidth
+// Parameters   : table, U8 n - number of entries, U16 bandwidth (100 Hz units)
+//
+// Fixed-step binary search. The step is halved on every pass, so a table of
+// up to 64 entries always takes 6 probes and the only data dependent branch
+// is the index update. Bandwidths above the last entry select the last entry.
+//
+//-----------------------------------------------------------------------------
+U8 FindFilterIndex (VARIABLE_SEGMENT_POINTER(table, rtPhyFilterEntry, SEG_CODE), U8 n, U16 bandwidth)
+{
+   U8 i;
+   U8 step;
+
+   i = 0;
+   for(step = 32; step; step >>= 1)
    {
-      i++;
+      if(((i + step) <= n) && (table[i + step - 1].RxBandwidth < bandwidth))
+         i += step;
    }
 
-   filterSetting = rtPhyTableIF_FilterSettingLT2[i];
-   // also use index to update Rxbandwidth
-   rtPhySettings.RxBandWidth = (rtPhyTableRxBandwidthLT2[i]) * (100L);
+   if(i >= n)
+      i = n - 1;
 
-   return filterSetting;
+   return i;
 }
-#endif
 //-----------------------------------------------------------------------------
 // Function Name
 //
@@ -1087,18 +1116,166 @@ S8 PhySetTxPower (S8 power)
    return power;
 }
 
+//=============================================================================
+//
+// Frequency Hopping Functions
+//
+//=============================================================================
+//
+// Notes:
+//
+// The hop functions use the radio frequency hopping registers. The channel
+// spacing is written once by rtPhyHopInit(), after that a hop is a single
+// write to the channel select register:
+//
+//    frequency = TRX_FREQUENCY + channel * TRX_CHANNEL_SPACING
+//
+// compared to the band select and two carrier registers, plus the 32-bit
+// math, used by rtPhySet(TRX_FREQUENCY,...).
+//
+// The hop table holds channel numbers. rtPhyHopNext() steps through it from
+// the main thread, rtPhyHopStart() steps through it from the Timer 2
+// interrupt with a fixed dwell time.
+//
+//-----------------------------------------------------------------------------
+#ifdef FREQUENCY_HOPPING
 //-----------------------------------------------------------------------------
 // Function Name
+//    rtPhyHopInit()
 //
-// Return Value : None
-// Parameters   :
+// Return Value : PHY_STATUS
+// Parameters   : U8 length, table - hop table in code space, or 0
+//                for the default rtPhyHopTable
+//
+// TRX_CHANNEL_SPACING must be set and the radio initialized first.
+//-----------------------------------------------------------------------------
+PHY_STATUS rtPhyHopInit (U8 length, VARIABLE_SEGMENT_POINTER(table, U8, SEG_CODE))
+{
+   if(table == 0)
+   {
+      table = rtPhyHopTable;
+      length = NUMBER_OF_HOP_CHANNELS;
+   }
+
+   if(length == 0)
+      return PHY_STATUS_ERROR_INVALID_VALUE;
+
+   if(rtPhySettings.TRxChannelSpacing == 0)
+      return PHY_STATUS_ERROR_INVALID_VALUE;
+
+   rtPhyHopStop();
+
+   HopTable = table;
+   HopTableLength = length;
+   HopIndex = 0;
+
+   // program the step size once, then only the channel select changes
+   SetTRxChannelSpacing(rtPhySettings.TRxChannelSpacing);
+   phyWrite(EZRADIOPRO_FREQUENCY_HOPPING_CHANNEL_SELECT, HopTable[0]);
+
+   return PHY_STATUS_SUCCESS;
+}
+//-----------------------------------------------------------------------------
+// Function Name
+//    rtPhyHopChannel()
 //
+// Return Value : PHY_STATUS
+// Parameters   : U8 channel
+//
+// Tunes to any channel with a single register write.
+//-----------------------------------------------------------------------------
+PHY_STATUS rtPhyHopChannel (U8 channel)
+{
+   phyWrite(EZRADIOPRO_FREQUENCY_HOPPING_CHANNEL_SELECT, channel);
+   return PHY_STATUS_SUCCESS;
+}
+//-----------------------------------------------------------------------------
+// Function Name
+//    rtPhyHopNext()
+//
+// Return Value : PHY_STATUS
+// Parameters   : none
+//
+// Tunes to the next channel in the hop table.
+//-----------------------------------------------------------------------------
+PHY_STATUS rtPhyHopNext (void)
+{
+   HopIndex++;
+   if(HopIndex >= HopTableLength)
+      HopIndex = 0;
+
+   phyWrite(EZRADIOPRO_FREQUENCY_HOPPING_CHANNEL_SELECT, HopTable[HopIndex]);
+
+   return PHY_STATUS_SUCCESS;
+}
+//-----------------------------------------------------------------------------
+// Function Name
+//    rtPhyHopStart()
+//
+// Return Value : PHY_STATUS
+// Parameters   : U16 dwell - Timer 2 ticks, use HOP_MICROSECONDS()
+//
+// Starts the Timer 2 hop schedule. Timer 2 runs from SYSCLK/12 in 16-bit
+// auto-reload mode and Hop_ISR() tunes to the next table entry on every
+// overflow.
+//-----------------------------------------------------------------------------
+PHY_STATUS rtPhyHopStart (U16 dwell)
+{
+   UU16 reload;
+
+   if((dwell == 0) || (HopTableLength == 0))
+      return PHY_STATUS_ERROR_INVALID_VALUE;
+
+   reload.U16 = -dwell;
+
+   ET2 = 0;
+   TMR2CN = 0x00;                      // 16-bit auto-reload, SYSCLK/12
+   CKCON &= ~0x30;                     // T2 clock selected by T2XCLK
+
+   TMR2RLL = reload.U8[LSB];
+   TMR2RLH = reload.U8[MSB];
+   TMR2L   = reload.U8[LSB];
+   TMR2H   = reload.U8[MSB];
+
+   HopCount = 0;
+
+   ET2 = 1;
+   TR2 = 1;
+
+   return PHY_STATUS_SUCCESS;
+}
 //-----------------------------------------------------------------------------
-// PHY_STATUS rtPhyHopChannel (U8 channel)
-// {
-//    phyWrite(EZRADIOPRO_FREQUENCY_HOPPING_CHANNEL_SELECT, channel);
-//    return PHY_STATUS_SUCCESS;
-// }
+// Function Name
+//    rtPhyHopStop()
+//
+// Return Value : PHY_STATUS
+// Parameters   : none
+//
+//-----------------------------------------------------------------------------
+PHY_STATUS rtPhyHopStop (void)
+{
+   ET2 = 0;
+   TR2 = 0;
+   TF2H = 0;
+
+   return PHY_STATUS_SUCCESS;
+}
+//-----------------------------------------------------------------------------
+// Hop_ISR() - Timer 2 hop schedule
+//-----------------------------------------------------------------------------
+INTERRUPT(Hop_ISR, INTERRUPT_TIMER2)
+{
+   TF2H = 0;
+
+   HopIndex++;
+   if(HopIndex >= HopTableLength)
+      HopIndex = 0;
+
+   HopIntPhyWrite(EZRADIOPRO_FREQUENCY_HOPPING_CHANNEL_SELECT, HopTable[HopIndex]);
+
+   HopCount++;
+}
+#endif
 //-----------------------------------------------------------------------------
 // Function Name
 //
@@ -1139,6 +1316,105 @@ U8 rtPhyTx (U8 length, VARIABLE_SEGMENT_POINTER(txBuffer, U8, BUFFER_MSPACE))
    return 0;
 }
 #endif
+//-----------------------------------------------------------------------------
+// Function Name
+//    rtPhyTxStart()
+//
+// Return Value : PHY_STATUS
+// Parameters   : U8 length - 1 to 255 bytes
+//                txBuffer - packet, must stay valid until TxPacketSent
+//
+// Non-blocking transmit. The first TX_FIFO_SIZE bytes are written here, the
+// rest is written by Receiver_ISR() each time the TX FIFO falls to the
+// TX_FIFO_ALMOST_EMPTY threshold. TxPacketSent is set when the packet sent
+// interrupt arrives. Packets may be longer than the radio FIFO.
+//
+// There is no time out. The caller may check TxPacketSent against its own
+// time base and use rtPhyTxAbort().
+//-----------------------------------------------------------------------------
+#if defined(TX_INTERRUPT) && !defined(RECEIVER_ONLY)
+PHY_STATUS rtPhyTxStart (U8 length, VARIABLE_SEGMENT_POINTER(txBuffer, U8, BUFFER_MSPACE))
+{
+   U8 status;
+   U8 n;
+
+   if(TxIntActive)
+      return PHY_STATUS_TRANSMIT_ERROR;
+
+   if(length == 0)
+      return PHY_STATUS_ERROR_INVALID_VALUE;
+
+   EX0 = 0;
+   TxPacketSent = 0;
+
+   n = length;
+   if(n > TX_FIFO_SIZE)
+      n = TX_FIFO_SIZE;
+
+   phyWrite(EZRADIOPRO_TX_FIFO_CONTROL_2, TX_FIFO_ALMOST_EMPTY);
+   phyWrite(EZRADIOPRO_TRANSMIT_PACKET_LENGTH, length);
+
+   phyWriteFIFO(n, txBuffer);
+
+   TxIntBuffer = txBuffer + n;
+   TxIntRemaining = length - n;
+
+   // packet sent IRQ, plus TX FIFO almost empty if there is more to write
+   if(TxIntRemaining)
+      phyWrite(EZRADIOPRO_INTERRUPT_ENABLE_1, EZRADIOPRO_ENPKSENT|EZRADIOPRO_ENTXFFAEM);
+   else
+      phyWrite(EZRADIOPRO_INTERRUPT_ENABLE_1, EZRADIOPRO_ENPKSENT);
+   phyWrite(EZRADIOPRO_INTERRUPT_ENABLE_2, 0x00);
+
+   // read Si4432 interrupts to clear
+   status = phyRead(EZRADIOPRO_INTERRUPT_STATUS_1);
+   status = phyRead(EZRADIOPRO_INTERRUPT_STATUS_2);
+
+   TxIntActive = 1;
+   EX0 = 1;
+
+   // start TX
+   phyWrite(EZRADIOPRO_OPERATING_AND_FUNCTION_CONTROL_1,(EZRADIOPRO_TXON|EZRADIOPRO_XTON));
+
+   return PHY_STATUS_SUCCESS;
+}
+//-----------------------------------------------------------------------------
+// Function Name
+//    rtPhyTxAbort()
+//
+// Return Value : PHY_STATUS
+// Parameters   : none
+//
+// Stops a transmission started by rtPhyTxStart() and clears the TX FIFO.
+//-----------------------------------------------------------------------------
+PHY_STATUS rtPhyTxAbort (void)
+{
+   U8 status;
+
+   EX0 = 0;
+   TxIntActive = 0;
+
+   // clear interrupt enables
+   phyWrite(EZRADIOPRO_INTERRUPT_ENABLE_1, 0x00);
+   phyWrite(EZRADIOPRO_INTERRUPT_ENABLE_2, 0x00);
+
+   // disable TX
+   phyWrite(EZRADIOPRO_OPERATING_AND_FUNCTION_CONTROL_1,(EZRADIOPRO_XTON));
+
+   // Clear TX FIFO
+   status = phyRead(EZRADIOPRO_OPERATING_AND_FUNCTION_CONTROL_2);
+   status |= EZRADIOPRO_FFCLRTX;
+   phyWrite(EZRADIOPRO_OPERATING_AND_FUNCTION_CONTROL_2, status);
+   status &= ~EZRADIOPRO_FFCLRTX;
+   phyWrite(EZRADIOPRO_OPERATING_AND_FUNCTION_CONTROL_2, status);
+
+   // read Si4432 interrupts to clear
+   status = phyRead(EZRADIOPRO_INTERRUPT_STATUS_1);
+   status = phyRead(EZRADIOPRO_INTERRUPT_STATUS_2);
+
+   return PHY_STATUS_SUCCESS;
+}
+#endif
 
 //-----------------------------------------------------------------------------
 // Function Name
@@ -1445,16 +1721,47 @@ PHY_STATUS  rtPhyGetRxPacket(U8 *pLength, VARIABLE_SEGMENT_POINTER(rxBuffer, U8,
 //-----------------------------------------------------------------------------
 //
 //-----------------------------------------------------------------------------
-#ifndef TRANSMITTER_ONLY
+#if !defined(TRANSMITTER_ONLY) || defined(TX_INTERRUPT)
 INTERRUPT(Receiver_ISR, INTERRUPT_INT0)
 {
    U8 status;
+#if defined(TX_INTERRUPT) && !defined(RECEIVER_ONLY)
+   U8 n;
+#endif
 
    IE0 = 0;
 
    status = RxIntPhyRead(EZRADIOPRO_INTERRUPT_STATUS_2);
    status = RxIntPhyRead(EZRADIOPRO_INTERRUPT_STATUS_1);
 
+#if defined(TX_INTERRUPT) && !defined(RECEIVER_ONLY)
+   if(TxIntActive)
+   {
+      if((status & EZRADIOPRO_IPKSENT)==EZRADIOPRO_IPKSENT)
+      {
+         RxIntPhyWrite(EZRADIOPRO_INTERRUPT_ENABLE_1, 0x00);
+         TxIntActive = 0;
+         TxPacketSent = 1;
+      }
+      else if(((status & EZRADIOPRO_ITXFFAEM)==EZRADIOPRO_ITXFFAEM) && TxIntRemaining)
+      {
+         // refill the TX FIFO from the packet buffer
+         n = TxIntRemaining;
+         if(n > (TX_FIFO_SIZE - TX_FIFO_ALMOST_EMPTY))
+            n = TX_FIFO_SIZE - TX_FIFO_ALMOST_EMPTY;
+
+         TxIntPhyWriteFIFO(n, TxIntBuffer);
+         TxIntBuffer += n;
+         TxIntRemaining -= n;
+
+         // all written, only wait for packet sent
+         if(TxIntRemaining == 0)
+            RxIntPhyWrite(EZRADIOPRO_INTERRUPT_ENABLE_1, EZRADIOPRO_ENPKSENT);
+      }
+      return;
+   }
+#endif
+#ifndef TRANSMITTER_ONLY
    if((status & EZRADIOPRO_IPKVALID)==EZRADIOPRO_IPKVALID)
    {
       if(RxPacketReceived==0)
@@ -1487,6 +1794,7 @@ INTERRUPT(Receiver_ISR, INTERRUPT_INT0)
 
    // enable RX again
    RxIntPhyWrite(EZRADIOPRO_OPERATING_AND_FUNCTION_CONTROL_1,(EZRADIOPRO_RXON|EZRADIOPRO_XTON));
+#endif
 }
 #endif
 //=============================================================================
@@ -1508,7 +1816,7 @@ INTERRUPT(Receiver_ISR, INTERRUPT_INT0)
 //    Write uses a Double buffered transfer.
 //
 //-----------------------------------------------------------------------------
-#ifndef TRANSMITTER_ONLY
+#if !defined(TRANSMITTER_ONLY) || defined(TX_INTERRUPT)
 void RxIntPhyWrite (U8 reg, U8 value)
 {
    bit restoreEA;
@@ -1541,7 +1849,7 @@ void RxIntPhyWrite (U8 reg, U8 value)
 // Return Value : U8 value - value returned from the si4432 register
 //
 //-----------------------------------------------------------------------------
-#ifndef TRANSMITTER_ONLY
+#if !defined(TRANSMITTER_ONLY) || defined(TX_INTERRUPT)
 U8 RxIntPhyRead (U8 reg)
 {
    U8 value;
@@ -1611,6 +1919,97 @@ void RxIntphyReadFIFO (U8 n, VARIABLE_SEGMENT_POINTER(buffer, U8, BUFFER_MSPACE)
    EA = restoreEA;
 }
 #endif
+//=============================================================================
+//
+// spi Functions for hop timer interrupt
+//
+//=============================================================================
+//-----------------------------------------------------------------------------
+// Function Name HopIntPhyWrite()
+//
+// Return Value   : None
+// Parameters :
+//    U8 reg - register address from the si4432.h file.
+//    U8 value - value to write to register
+//
+// Notes:
+//
+//    Same as phyWrite(), used only by Hop_ISR().
+//
+//-----------------------------------------------------------------------------
+#ifdef FREQUENCY_HOPPING
+void HopIntPhyWrite (U8 reg, U8 value)
+{
+   bit restoreEA;
+
+   // disable interrupts during SPI transfer
+   restoreEA = EA;
+   EA = 0;
+
+   // Send SPI data using double buffered write
+   NSS1 = 0;                           // drive NSS low
+   SPIF1 = 0;                          // clear SPIF
+   SPI1DAT = (reg | 0x80);             // write reg address
+   while(!TXBMT1);                     // wait on TXBMT
+   SPI1DAT = value;                    // write value
+   while(!TXBMT1);                     // wait on TXBMT
+   while((SPI1CFG & 0x80) == 0x80);    // wait on SPIBSY
+
+   SPIF1 = 0;                          // leave SPIF cleared
+   NSS1 = 1;                           // drive NSS high
+
+   // Restore interrupts after SPI transfer
+   EA = restoreEA;
+}
+#endif
+//=============================================================================
+//
+// spi Functions for Tx interrupt
+//
+//=============================================================================
+//-----------------------------------------------------------------------------
+// Function Name TxIntPhyWriteFIFO()
+//
+// Return Value   : None
+// Parameters :
+//    U8 n - number of bytes to write
+//    buffer - pointer to the data
+//
+// Notes:
+//
+//    Same as phyWriteFIFO(), used only by Receiver_ISR() to refill the
+//    TX FIFO.
+//
+//-----------------------------------------------------------------------------
+#if defined(TX_INTERRUPT) && !defined(RECEIVER_ONLY)
+void TxIntPhyWriteFIFO (U8 n, VARIABLE_SEGMENT_POINTER(buffer, U8, BUFFER_MSPACE))
+{
+   bit restoreEA;
+
+   // disable interrupts during SPI transfer
+   restoreEA = EA;
+   EA = 0;
+
+   NSS1 = 0;                            // drive NSS low
+   SPIF1 = 0;                           // clear SPIF
+   SPI1DAT = (0x80 | EZRADIOPRO_FIFO_ACCESS);
+
+   while(n--)
+   {
+      while(!TXBMT1);                   // wait on TXBMT
+      SPI1DAT = *buffer++;              // write buffer
+   }
+
+   while(!TXBMT1);                      // wait on TXBMT
+   while((SPI1CFG & 0x80) == 0x80);     // wait on SPIBSY
+
+   SPIF1 = 0;                           // leave SPI  cleared
+   NSS1 = 1;                            // drive NSS high
+
+   // Restore interrupts after SPI transfer
+   EA = restoreEA;
+}
+#endif
 //-----------------------------------------------------------------------------
 // Function Divide
 //
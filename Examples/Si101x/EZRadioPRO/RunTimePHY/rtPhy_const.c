@@ -71,120 +71,62 @@ const SEGMENT_VARIABLE (rtPhyInitSettings[NUMBER_OF_INIT_REGISTERS], U8, SEG_COD
 //-------------------------------------------------------------------------------------------------
 // Table for m < 2
 //-------------------------------------------------------------------------------------------------
-const SEGMENT_VARIABLE (rtPhyTableRxBandwidthLT2[NUMBER_OF_RX_BANDWIDTH_VALUES_LT2], U16, SEG_CODE) =
+const SEGMENT_VARIABLE (rtPhyTableFilterLT2[NUMBER_OF_RX_BANDWIDTH_VALUES_LT2], rtPhyFilterEntry, SEG_CODE) =
 {
-   26,   // 2.6 kHz
-   28,   // 2.8 kHz
-   31,   // 3.1 kHz
-   32,   // 3.2 kHz
-   37,   // 3.7 kHz
-   49,   // 4.9 kHz
-   54,   // 5.4 kHz
-   59,   // 5.9 kHz
-   61,   // 6.1 kHz
-   72,   // 7.2 kHz
-   95,   // 9.5 kHz
-   106,  // 10.6 kHz
-   115,  // 11.5 kHz
-   121,  // 12.1 kHz
-   142,  // 14.2 kHz
-   162,  // 16.2 kHz
-   175,  // 17.5 kHz
-   194,  // 19.4 kHz
-   214,  // 21.4 kHz
-   239,  // 23.9 kHz
-   257,  // 25.7 kHz
-   282,  // 28.2 kHz
-   322,  // 32.2 kHz
-   347,  // 34.7 kHz
-   386,  // 38.6 kHz
-   427,  // 42.7 kHz
-   477,  // 47.7 kHz
-   512,  // 51.2 kHz
-   562,  // 56.2 kHz
-   641,  // 64.1 kHz
-   692,  // 69.2 kHz
-   752,  // 75.2 kHz
-   832,  // 83.2 kHz
-   900,  // 90 kHz
-   953,  // 95.3 kHz
-   1121, // 112.1 kHz
-   1279, // 127.9 kHz
-   1379, // 137.9 kHz
-   1428, // 142.8 kHz
-   1678, // 167.8 kHz
-   1811, // 181.1 kHz
-   1915, // 191.5 kHz
-   2084, // 208.4 kHz
-   2251, // 225.1 kHz
-   2488, // 248.8 kHz
-   2693, // 269.3 kHz
-   2849, // 284.9 kHz
-   3355, // 335.5 kHz
-   3618, // 361.8 kHz
-   4202, // 420.2 kHz
-   4684, // 468.4 kHz
-   5188, // 518.8 kHz
-   5770, // 577 kHz
-   6207 // 620.7 kHz
-};
-
-const SEGMENT_VARIABLE (rtPhyTableIF_FilterSettingLT2[NUMBER_OF_RX_BANDWIDTH_VALUES_LT2], U8, code) =
-{
-   0x51, // 2.6 kHz, dwn3_byp = 0, ndec_exp = 5 , filset = 1
-   0x52, // 2.8 kHz, dwn3_byp = 0, ndec_exp = 5 , filset = 2
-   0x53, // 3.1 kHz, dwn3_byp = 0, ndec_exp = 5 , filset = 3
-   0x54, // 3.2 kHz, dwn3_byp = 0, ndec_exp = 5 , filset = 4
-   0x55, // 3.7 kHz, dwn3_byp = 0, ndec_exp = 5 , filset = 5
-   0x41, // 4.9 kHz, dwn3_byp = 0, ndec_exp = 4 , filset = 1
-   0x42, // 5.4 kHz, dwn3_byp = 0, ndec_exp = 4 , filset = 2
-   0x43, // 5.9 kHz, dwn3_byp = 0, ndec_exp = 4 , filset = 3
-   0x44, // 6.1 kHz, dwn3_byp = 0, ndec_exp = 4 , filset = 4
-   0x45, // 7.2 kHz, dwn3_byp = 0, ndec_exp = 4 , filset = 5
-   0x31, // 9.5 kHz, dwn3_byp = 0, ndec_exp = 3 , filset = 1
-   0x32, // 10.6 kHz, dwn3_byp = 0, ndec_exp = 3 , filset = 2
-   0x33, // 11.5 kHz, dwn3_byp = 0, ndec_exp = 3 , filset = 3
-   0x34, // 12.1 kHz, dwn3_byp = 0, ndec_exp = 3 , filset = 4
-   0x35, // 14.2 kHz, dwn3_byp = 0, ndec_exp = 3 , filset = 5
-   0x36, // 16.2 kHz, dwn3_byp = 0, ndec_exp = 3 , filset = 6
-   0x3A, // 17.5 kHz, dwn3_byp = 0, ndec_exp = 3 , filset = 10
-   0x3B, // 19.4 kHz, dwn3_byp = 0, ndec_exp = 3 , filset = 11
-   0x3C, // 21.4 kHz, dwn3_byp = 0, ndec_exp = 3 , filset = 12
-   0x3D, // 23.9 kHz, dwn3_byp = 0, ndec_exp = 3 , filset = 13
-   0x3E, // 25.7 kHz, dwn3_byp = 0, ndec_exp = 3 , filset = 14
-   0x25, // 28.2 kHz, dwn3_byp = 0, ndec_exp = 2 , filset = 5
-   0x26, // 32.2 kHz, dwn3_byp = 0, ndec_exp = 2 , filset = 6
-   0x27, // 34.7 kHz, dwn3_byp = 0, ndec_exp = 2 , filset = 7
-   0x2B, // 38.6 kHz, dwn3_byp = 0, ndec_exp = 2 , filset = 11
-   0x2C, // 42.7 kHz, dwn3_byp = 0, ndec_exp = 2 , filset = 12
-   0x2D, // 47.7 kHz, dwn3_byp = 0, ndec_exp = 2 , filset = 13
-   0x2E, // 51.2 kHz, dwn3_byp = 0, ndec_exp = 2 , filset = 14
-   0x15, // 56.2 kHz, dwn3_byp = 0, ndec_exp = 1 , filset = 5
-   0x16, // 64.1 kHz, dwn3_byp = 0, ndec_exp = 1 , filset = 6
-   0x17, // 69.2 kHz, dwn3_byp = 0, ndec_exp = 1 , filset = 7
-   0x01, // 75.2 kHz, dwn3_byp = 0, ndec_exp = 0 , filset = 1
-   0x02, // 83.2 kHz, dwn3_byp = 0, ndec_exp = 0 , filset = 2
-   0x03, // 90 kHz, dwn3_byp = 0, ndec_exp = 0 , filset = 3
-   0x04, // 95.3 kHz, dwn3_byp = 0, ndec_exp = 0 , filset = 4
-   0x05, // 112.1 kHz, dwn3_byp = 0, ndec_exp = 0 , filset = 5
-   0x06, // 127.9 kHz, dwn3_byp = 0, ndec_exp = 0 , filset = 6
-   0x07, // 137.9 kHz, dwn3_byp = 0, ndec_exp = 0 , filset = 7
-   0x94, // 142.8 kHz, dwn3_byp = 1, ndec_exp = 1 , filset = 4
-   0x95, // 167.8 kHz, dwn3_byp = 1, ndec_exp = 1 , filset = 5
-   0x99, // 181.1 kHz, dwn3_byp = 1, ndec_exp = 1 , filset = 9
-   0x96, // 191.5 kHz, dwn3_byp = 1, ndec_exp = 1 , filset = 6
-   0x9A, // 208.4 kHz, dwn3_byp = 1, ndec_exp = 1 , filset = 10
-   0x81, // 225.1 kHz, dwn3_byp = 1, ndec_exp = 0 , filset = 1
-   0x82, // 248.8 kHz, dwn3_byp = 1, ndec_exp = 0 , filset = 2
-   0x83, // 269.3 kHz, dwn3_byp = 1, ndec_exp = 0 , filset = 3
-   0x84, // 284.9 kHz, dwn3_byp = 1, ndec_exp = 0 , filset = 4
-   0x88, // 335.5 kHz, dwn3_byp = 1, ndec_exp = 0 , filset = 8
-   0x89, // 361.8 kHz, dwn3_byp = 1, ndec_exp = 0 , filset = 9
-   0x8A, // 420.2 kHz, dwn3_byp = 1, ndec_exp = 0 , filset = 10
-   0x8B, // 468.4 kHz, dwn3_byp = 1, ndec_exp = 0 , filset = 11
-   0x8C, // 518.8 kHz, dwn3_byp = 1, ndec_exp = 0 , filset = 12
-   0x8D, // 577 kHz, dwn3_byp = 1, ndec_exp = 0 , filset = 13
-   0x8E, // 620.7 kHz, dwn3_byp = 1, ndec_exp = 0 , filset = 14
+   {   26, 0x51}, // 2.6 kHz, dwn3_byp = 0, ndec_exp = 5 , filset = 1
+   {   28, 0x52}, // 2.8 kHz, dwn3_byp = 0, ndec_exp = 5 , filset = 2
+   {   31, 0x53}, // 3.1 kHz, dwn3_byp = 0, ndec_exp = 5 , filset = 3
+   {   32, 0x54}, // 3.2 kHz, dwn3_byp = 0, ndec_exp = 5 , filset = 4
+   {   37, 0x55}, // 3.7 kHz, dwn3_byp = 0, ndec_exp = 5 , filset = 5
+   {   49, 0x41}, // 4.9 kHz, dwn3_byp = 0, ndec_exp = 4 , filset = 1
+   {   54, 0x42}, // 5.4 kHz, dwn3_byp = 0, ndec_exp = 4 , filset = 2
+   {   59, 0x43}, // 5.9 kHz, dwn3_byp = 0, ndec_exp = 4 , filset = 3
+   {   61, 0x44}, // 6.1 kHz, dwn3_byp = 0, ndec_exp = 4 , filset = 4
+   {   72, 0x45}, // 7.2 kHz, dwn3_byp = 0, ndec_exp = 4 , filset = 5
+   {   95, 0x31}, // 9.5 kHz, dwn3_byp = 0, ndec_exp = 3 , filset = 1
+   {  106, 0x32}, // 10.6 kHz, dwn3_byp = 0, ndec_exp = 3 , filset = 2
+   {  115, 0x33}, // 11.5 kHz, dwn3_byp = 0, ndec_exp = 3 , filset = 3
+   {  121, 0x34}, // 12.1 kHz, dwn3_byp = 0, ndec_exp = 3 , filset = 4
+   {  142, 0x35}, // 14.2 kHz, dwn3_byp = 0, ndec_exp = 3 , filset = 5
+   {  162, 0x36}, // 16.2 kHz, dwn3_byp = 0, ndec_exp = 3 , filset = 6
+   {  175, 0x3A}, // 17.5 kHz, dwn3_byp = 0, ndec_exp = 3 , filset = 10
+   {  194, 0x3B}, // 19.4 kHz, dwn3_byp = 0, ndec_exp = 3 , filset = 11
+   {  214, 0x3C}, // 21.4 kHz, dwn3_byp = 0, ndec_exp = 3 , filset = 12
+   {  239, 0x3D}, // 23.9 kHz, dwn3_byp = 0, ndec_exp = 3 , filset = 13
+   {  257, 0x3E}, // 25.7 kHz, dwn3_byp = 0, ndec_exp = 3 , filset = 14
+   {  282, 0x25}, // 28.2 kHz, dwn3_byp = 0, ndec_exp = 2 , filset = 5
+   {  322, 0x26}, // 32.2 kHz, dwn3_byp = 0, ndec_exp = 2 , filset = 6
+   {  347, 0x27}, // 34.7 kHz, dwn3_byp = 0, ndec_exp = 2 , filset = 7
+   {  386, 0x2B}, // 38.6 kHz, dwn3_byp = 0, ndec_exp = 2 , filset = 11
+   {  427, 0x2C}, // 42.7 kHz, dwn3_byp = 0, ndec_exp = 2 , filset = 12
+   {  477, 0x2D}, // 47.7 kHz, dwn3_byp = 0, ndec_exp = 2 , filset = 13
+   {  512, 0x2E}, // 51.2 kHz, dwn3_byp = 0, ndec_exp = 2 , filset = 14
+   {  562, 0x15}, // 56.2 kHz, dwn3_byp = 0, ndec_exp = 1 , filset = 5
+   {  641, 0x16}, // 64.1 kHz, dwn3_byp = 0, ndec_exp = 1 , filset = 6
+   {  692, 0x17}, // 69.2 kHz, dwn3_byp = 0, ndec_exp = 1 , filset = 7
+   {  752, 0x01}, // 75.2 kHz, dwn3_byp = 0, ndec_exp = 0 , filset = 1
+   {  832, 0x02}, // 83.2 kHz, dwn3_byp = 0, ndec_exp = 0 , filset = 2
+   {  900, 0x03}, // 90 kHz, dwn3_byp = 0, ndec_exp = 0 , filset = 3
+   {  953, 0x04}, // 95.3 kHz, dwn3_byp = 0, ndec_exp = 0 , filset = 4
+   { 1121, 0x05}, // 112.1 kHz, dwn3_byp = 0, ndec_exp = 0 , filset = 5
+   { 1279, 0x06}, // 127.9 kHz, dwn3_byp = 0, ndec_exp = 0 , filset = 6
+   { 1379, 0x07}, // 137.9 kHz, dwn3_byp = 0, ndec_exp = 0 , filset = 7
+   { 1428, 0x94}, // 142.8 kHz, dwn3_byp = 1, ndec_exp = 1 , filset = 4
+   { 1678, 0x95}, // 167.8 kHz, dwn3_byp = 1, ndec_exp = 1 , filset = 5
+   { 1811, 0x99}, // 181.1 kHz, dwn3_byp = 1, ndec_exp = 1 , filset = 9
+   { 1915, 0x96}, // 191.5 kHz, dwn3_byp = 1, ndec_exp = 1 , filset = 6
+   { 2084, 0x9A}, // 208.4 kHz, dwn3_byp = 1, ndec_exp = 1 , filset = 10
+   { 2251, 0x81}, // 225.1 kHz, dwn3_byp = 1, ndec_exp = 0 , filset = 1
+   { 2488, 0x82}, // 248.8 kHz, dwn3_byp = 1, ndec_exp = 0 , filset = 2
+   { 2693, 0x83}, // 269.3 kHz, dwn3_byp = 1, ndec_exp = 0 , filset = 3
+   { 2849, 0x84}, // 284.9 kHz, dwn3_byp = 1, ndec_exp = 0 , filset = 4
+   { 3355, 0x88}, // 335.5 kHz, dwn3_byp = 1, ndec_exp = 0 , filset = 8
+   { 3618, 0x89}, // 361.8 kHz, dwn3_byp = 1, ndec_exp = 0 , filset = 9
+   { 4202, 0x8A}, // 420.2 kHz, dwn3_byp = 1, ndec_exp = 0 , filset = 10
+   { 4684, 0x8B}, // 468.4 kHz, dwn3_byp = 1, ndec_exp = 0 , filset = 11
+   { 5188, 0x8C}, // 518.8 kHz, dwn3_byp = 1, ndec_exp = 0 , filset = 12
+   { 5770, 0x8D}, // 577 kHz, dwn3_byp = 1, ndec_exp = 0 , filset = 13
+   { 6207, 0x8E}  // 620.7 kHz, dwn3_byp = 1, ndec_exp = 0 , filset = 14
 };
 //=============================================================================
 #ifdef HIGH_MODULATION_INDEX_TABLES
@@ -192,242 +134,141 @@ const SEGMENT_VARIABLE (rtPhyTableIF_FilterSettingLT2[NUMBER_OF_RX_BANDWIDTH_VAL
 //-----------------------------------------------------------------------------
 // Table for m < 10
 //-----------------------------------------------------------------------------
-const SEGMENT_VARIABLE (rtPhyTableRxBandwidthLT10[NUMBER_OF_RX_BANDWIDTH_VALUES_LT10], U16, SEG_CODE) =
-{
-   26,   // 2.6 kHz
-   28,   // 2.8 kHz
-   31,   // 3.1 kHz
-   32,   // 3.2 kHz
-   37,   // 3.7 kHz
-   49,   // 4.9 kHz
-   54,   // 5.4 kHz
-   59,   // 5.9 kHz
-   61,   // 6.1 kHz
-   72,   // 7.2 kHz
-   95,   // 9.5 kHz
-   106,  // 10.6 kHz
-   115,  // 11.5 kHz
-   121,  // 12.1 kHz
-   142,  // 14.2 kHz
-   162,  // 16.2 kHz
-   175,  // 17.5 kHz
-   189,  // 18.9 kHz
-   216,  // 21.6 kHz
-   227,  // 22.7 kHz
-   240,  // 24 kHz
-   282,  // 28.2 kHz
-   319,  // 31.9 kHz
-   347,  // 34.7 kHz
-   386,  // 38.6 kHz
-   427,  // 42.7 kHz
-   477,  // 47.7 kHz
-   512,  // 51.2 kHz
-   562,  // 56.2 kHz
-   641,  // 64.1 kHz
-   692,  // 69.2 kHz
-   752,  // 75.2 kHz
-   832,  // 83.2 kHz
-   900,  // 90 kHz
-   953,  // 95.3 kHz
-   1121, // 112.1 kHz
-   1279, // 127.9 kHz
-   1379, // 137.9 kHz
-   1387, // 138.7 kHz
-   1542, // 154.2 kHz
-   1680, // 168 kHz
-   1811, // 181.1 kHz
-   2084, // 208.4 kHz
-   2320, // 232 kHz
-   2560, // 256 kHz
-   2693, // 269.3 kHz
-   2849, // 284.9 kHz
-   3355, // 335.5 kHz
-   3618, // 361.8 kHz
-   4202, // 420.2 kHz
-   4684, // 468.4 kHz
-   5188, // 518.8 kHz
-   5770, // 577 kHz
-   6207  // 620.7 kHz
-};
-
-const SEGMENT_VARIABLE (rtPhyTableIF_FilterSettingLT10[NUMBER_OF_RX_BANDWIDTH_VALUES_LT10], U8, code) =
+const SEGMENT_VARIABLE (rtPhyTableFilterLT10[NUMBER_OF_RX_BANDWIDTH_VALUES_LT10], rtPhyFilterEntry, SEG_CODE) =
 {
-   0x51, // 2.6 kHz, dwn3_byp = 0, ndec_exp = 5 , filset = 1
-   0x52, // 2.8 kHz, dwn3_byp = 0, ndec_exp = 5 , filset = 2
-   0x53, // 3.1 kHz, dwn3_byp = 0, ndec_exp = 5 , filset = 3
-   0x54, // 3.2 kHz, dwn3_byp = 0, ndec_exp = 5 , filset = 4
-   0x55, // 3.7 kHz, dwn3_byp = 0, ndec_exp = 5 , filset = 5
-   0x41, // 4.9 kHz, dwn3_byp = 0, ndec_exp = 4 , filset = 1
-   0x42, // 5.4 kHz, dwn3_byp = 0, ndec_exp = 4 , filset = 2
-   0x43, // 5.9 kHz, dwn3_byp = 0, ndec_exp = 4 , filset = 3
-   0x44, // 6.1 kHz, dwn3_byp = 0, ndec_exp = 4 , filset = 4
-   0x45, // 7.2 kHz, dwn3_byp = 0, ndec_exp = 4 , filset = 5
-   0x31, // 9.5 kHz, dwn3_byp = 0, ndec_exp = 3 , filset = 1
-   0x32, // 10.6 kHz, dwn3_byp = 0, ndec_exp = 3 , filset = 2
-   0x33, // 11.5 kHz, dwn3_byp = 0, ndec_exp = 3 , filset = 3
-   0x34, // 12.1 kHz, dwn3_byp = 0, ndec_exp = 3 , filset = 4
-   0x35, // 14.2 kHz, dwn3_byp = 0, ndec_exp = 3 , filset = 5
-   0x36, // 16.2 kHz, dwn3_byp = 0, ndec_exp = 3 , filset = 6
-   0x37, // 17.5 kHz, dwn3_byp = 0, ndec_exp = 3 , filset = 7
-   0x21, // 18.9 kHz, dwn3_byp = 0, ndec_exp = 2 , filset = 1
-   0x22, // 21.6 kHz, dwn3_byp = 0, ndec_exp = 2 , filset = 2
-   0x23, // 22.7 kHz, dwn3_byp = 0, ndec_exp = 2 , filset = 3
-   0x24, // 24 kHz, dwn3_byp = 0, ndec_exp = 2 , filset = 4
-   0x2A, // 28.2 kHz, dwn3_byp = 0, ndec_exp = 2 , filset = 10
-   0x1F, // 31.9 kHz, dwn3_byp = 0, ndec_exp = 1 , filset = 15
-   0x27, // 34.7 kHz, dwn3_byp = 0, ndec_exp = 2 , filset = 7
-   0x2B, // 38.6 kHz, dwn3_byp = 0, ndec_exp = 2 , filset = 11
-   0x2C, // 42.7 kHz, dwn3_byp = 0, ndec_exp = 2 , filset = 12
-   0x2D, // 47.7 kHz, dwn3_byp = 0, ndec_exp = 2 , filset = 13
-   0x2E, // 51.2 kHz, dwn3_byp = 0, ndec_exp = 2 , filset = 14
-   0x15, // 56.2 kHz, dwn3_byp = 0, ndec_exp = 1 , filset = 5
-   0x16, // 64.1 kHz, dwn3_byp = 0, ndec_exp = 1 , filset = 6
-   0x17, // 69.2 kHz, dwn3_byp = 0, ndec_exp = 1 , filset = 7
-   0x01, // 75.2 kHz, dwn3_byp = 0, ndec_exp = 0 , filset = 1
-   0x02, // 83.2 kHz, dwn3_byp = 0, ndec_exp = 0 , filset = 2
-   0x03, // 90 kHz, dwn3_byp = 0, ndec_exp = 0 , filset = 3
-   0x04, // 95.3 kHz, dwn3_byp = 0, ndec_exp = 0 , filset = 4
-   0x05, // 112.1 kHz, dwn3_byp = 0, ndec_exp = 0 , filset = 5
-   0x06, // 127.9 kHz, dwn3_byp = 0, ndec_exp = 0 , filset = 6
-   0x07, // 137.9 kHz, dwn3_byp = 0, ndec_exp = 0 , filset = 7
-   0x0A, // 138.7 kHz, dwn3_byp = 0, ndec_exp = 0 , filset = 10
-   0x0B, // 154.2 kHz, dwn3_byp = 0, ndec_exp = 0 , filset = 11
-   0x98, // 168 kHz, dwn3_byp = 1, ndec_exp = 1 , filset = 8
-   0x99, // 181.1 kHz, dwn3_byp = 1, ndec_exp = 1 , filset = 9
-   0x9A, // 208.4 kHz, dwn3_byp = 1, ndec_exp = 1 , filset = 10
-   0x9B, // 232 kHz, dwn3_byp = 1, ndec_exp = 1 , filset = 11
-   0x9C, // 256 kHz, dwn3_byp = 1, ndec_exp = 1 , filset = 12
-   0x83, // 269.3 kHz, dwn3_byp = 1, ndec_exp = 0 , filset = 3
-   0x84, // 284.9 kHz, dwn3_byp = 1, ndec_exp = 0 , filset = 4
-   0x88, // 335.5 kHz, dwn3_byp = 1, ndec_exp = 0 , filset = 8
-   0x89, // 361.8 kHz, dwn3_byp = 1, ndec_exp = 0 , filset = 9
-   0x8A, // 420.2 kHz, dwn3_byp = 1, ndec_exp = 0 , filset = 10
-   0x8B, // 468.4 kHz, dwn3_byp = 1, ndec_exp = 0 , filset = 11
-   0x8C, // 518.8 kHz, dwn3_byp = 1, ndec_exp = 0 , filset = 12
-   0x8D, // 577 kHz, dwn3_byp = 1, ndec_exp = 0 , filset = 13
-   0x8E, // 620.7 kHz, dwn3_byp = 1, ndec_exp = 0 , filset = 14
-
+   {   26, 0x51}, // 2.6 kHz, dwn3_byp = 0, ndec_exp = 5 , filset = 1
+   {   28, 0x52}, // 2.8 kHz, dwn3_byp = 0, ndec_exp = 5 , filset = 2
+   {   31, 0x53}, // 3.1 kHz, dwn3_byp = 0, ndec_exp = 5 , filset = 3
+   {   32, 0x54}, // 3.2 kHz, dwn3_byp = 0, ndec_exp = 5 , filset = 4
+   {   37, 0x55}, // 3.7 kHz, dwn3_byp = 0, ndec_exp = 5 , filset = 5
+   {   49, 0x41}, // 4.9 kHz, dwn3_byp = 0, ndec_exp = 4 , filset = 1
+   {   54, 0x42}, // 5.4 kHz, dwn3_byp = 0, ndec_exp = 4 , filset = 2
+   {   59, 0x43}, // 5.9 kHz, dwn3_byp = 0, ndec_exp = 4 , filset = 3
+   {   61, 0x44}, // 6.1 kHz, dwn3_byp = 0, ndec_exp = 4 , filset = 4
+   {   72, 0x45}, // 7.2 kHz, dwn3_byp = 0, ndec_exp = 4 , filset = 5
+   {   95, 0x31}, // 9.5 kHz, dwn3_byp = 0, ndec_exp = 3 , filset = 1
+   {  106, 0x32}, // 10.6 kHz, dwn3_byp = 0, ndec_exp = 3 , filset = 2
+   {  115, 0x33}, // 11.5 kHz, dwn3_byp = 0, ndec_exp = 3 , filset = 3
+   {  121, 0x34}, // 12.1 kHz, dwn3_byp = 0, ndec_exp = 3 , filset = 4
+   {  142, 0x35}, // 14.2 kHz, dwn3_byp = 0, ndec_exp = 3 , filset = 5
+   {  162, 0x36}, // 16.2 kHz, dwn3_byp = 0, ndec_exp = 3 , filset = 6
+   {  175, 0x37}, // 17.5 kHz, dwn3_byp = 0, ndec_exp = 3 , filset = 7
+   {  189, 0x21}, // 18.9 kHz, dwn3_byp = 0, ndec_exp = 2 , filset = 1
+   {  216, 0x22}, // 21.6 kHz, dwn3_byp = 0, ndec_exp = 2 , filset = 2
+   {  227, 0x23}, // 22.7 kHz, dwn3_byp = 0, ndec_exp = 2 , filset = 3
+   {  240, 0x24}, // 24 kHz, dwn3_byp = 0, ndec_exp = 2 , filset = 4
+   {  282, 0x2A}, // 28.2 kHz, dwn3_byp = 0, ndec_exp = 2 , filset = 10
+   {  319, 0x1F}, // 31.9 kHz, dwn3_byp = 0, ndec_exp = 1 , filset = 15
+   {  347, 0x27}, // 34.7 kHz, dwn3_byp = 0, ndec_exp = 2 , filset = 7
+   {  386, 0x2B}, // 38.6 kHz, dwn3_byp = 0, ndec_exp = 2 , filset = 11
+   {  427, 0x2C}, // 42.7 kHz, dwn3_byp = 0, ndec_exp = 2 , filset = 12
+   {  477, 0x2D}, // 47.7 kHz, dwn3_byp = 0, ndec_exp = 2 , filset = 13
+   {  512, 0x2E}, // 51.2 kHz, dwn3_byp = 0, ndec_exp = 2 , filset = 14
+   {  562, 0x15}, // 56.2 kHz, dwn3_byp = 0, ndec_exp = 1 , filset = 5
+   {  641, 0x16}, // 64.1 kHz, dwn3_byp = 0, ndec_exp = 1 , filset = 6
+   {  692, 0x17}, // 69.2 kHz, dwn3_byp = 0, ndec_exp = 1 , filset = 7
+   {  752, 0x01}, // 75.2 kHz, dwn3_byp = 0, ndec_exp = 0 , filset = 1
+   {  832, 0x02}, // 83.2 kHz, dwn3_byp = 0, ndec_exp = 0 , filset = 2
+   {  900, 0x03}, // 90 kHz, dwn3_byp = 0, ndec_exp = 0 , filset = 3
+   {  953, 0x04}, // 95.3 kHz, dwn3_byp = 0, ndec_exp = 0 , filset = 4
+   { 1121, 0x05}, // 112.1 kHz, dwn3_byp = 0, ndec_exp = 0 , filset = 5
+   { 1279, 0x06}, // 127.9 kHz, dwn3_byp = 0, ndec_exp = 0 , filset = 6
+   { 1379, 0x07}, // 137.9 kHz, dwn3_byp = 0, ndec_exp = 0 , filset = 7
+   { 1387, 0x0A}, // 138.7 kHz, dwn3_byp = 0, ndec_exp = 0 , filset = 10
+   { 1542, 0x0B}, // 154.2 kHz, dwn3_byp = 0, ndec_exp = 0 , filset = 11
+   { 1680, 0x98}, // 168 kHz, dwn3_byp = 1, ndec_exp = 1 , filset = 8
+   { 1811, 0x99}, // 181.1 kHz, dwn3_byp = 1, ndec_exp = 1 , filset = 9
+   { 2084, 0x9A}, // 208.4 kHz, dwn3_byp = 1, ndec_exp = 1 , filset = 10
+   { 2320, 0x9B}, // 232 kHz, dwn3_byp = 1, ndec_exp = 1 , filset = 11
+   { 2560, 0x9C}, // 256 kHz, dwn3_byp = 1, ndec_exp = 1 , filset = 12
+   { 2693, 0x83}, // 269.3 kHz, dwn3_byp = 1, ndec_exp = 0 , filset = 3
+   { 2849, 0x84}, // 284.9 kHz, dwn3_byp = 1, ndec_exp = 0 , filset = 4
+   { 3355, 0x88}, // 335.5 kHz, dwn3_byp = 1, ndec_exp = 0 , filset = 8
+   { 3618, 0x89}, // 361.8 kHz, dwn3_byp = 1, ndec_exp = 0 , filset = 9
+   { 4202, 0x8A}, // 420.2 kHz, dwn3_byp = 1, ndec_exp = 0 , filset = 10
+   { 4684, 0x8B}, // 468.4 kHz, dwn3_byp = 1, ndec_exp = 0 , filset = 11
+   { 5188, 0x8C}, // 518.8 kHz, dwn3_byp = 1, ndec_exp = 0 , filset = 12
+   { 5770, 0x8D}, // 577 kHz, dwn3_byp = 1, ndec_exp = 0 , filset = 13
+   { 6207, 0x8E}  // 620.7 kHz, dwn3_byp = 1, ndec_exp = 0 , filset = 14
 };
 
 //-------------------------------------------------------------------------------------------------
 // Table for m >= 10
 //-------------------------------------------------------------------------------------------------
-const SEGMENT_VARIABLE (rtPhyTableRxBandwidthGE10[NUMBER_OF_RX_BANDWIDTH_VALUES_GE10], U16, SEG_CODE) =
+const SEGMENT_VARIABLE (rtPhyTableFilterGE10[NUMBER_OF_RX_BANDWIDTH_VALUES_GE10], rtPhyFilterEntry, SEG_CODE) =
 {
-   26,   // 2.6 kHz
-   28,   // 2.8 kHz
-   31,   // 3.1 kHz
-   32,   // 3.2 kHz
-   37,   // 3.7 kHz
-   49,   // 4.9 kHz
-   54,   // 5.4 kHz
-   59,   // 5.9 kHz
-   61,   // 6.1 kHz
-   72,   // 7.2 kHz
-   95,   // 9.5 kHz
-   106,  // 10.6 kHz
-   115,  // 11.5 kHz
-   121,  // 12.1 kHz
-   142,  // 14.2 kHz
-   162,  // 16.2 kHz
-   175,  // 17.5 kHz
-   194,  // 19.4 kHz
-   214,  // 21.4 kHz
-   239,  // 23.9 kHz
-   257,  // 25.7 kHz
-   282,  // 28.2 kHz
-   322,  // 32.2 kHz
-   347,  // 34.7 kHz
-   386,  // 38.6 kHz
-   427,  // 42.7 kHz
-   477,  // 47.7 kHz
-   512,  // 51.2 kHz
-   562,  // 56.2 kHz
-   641,  // 64.1 kHz
-   694,  // 69.4 kHz
-   771,  // 77.1 kHz
-   851,  // 85.1 kHz
-   953,  // 95.3 kHz
-   1022, // 102.2 kHz
-   1156, // 115.6 kHz
-   1277, // 127.7 kHz
-   1428, // 142.8 kHz
-   1533, // 153.3 kHz
-   1680, // 168 kHz
-   1811, // 181.1 kHz
-   2084, // 208.4 kHz
-   2320, // 232 kHz
-   2560, // 256 kHz
-   2693, // 269.3 kHz
-   2849, // 284.9 kHz
-   3355, // 335.5 kHz
-   3618, // 361.8 kHz
-   4202, // 420.2 kHz
-   4684, // 468.4 kHz
-   5188, // 518.8 kHz
-   5770, // 577 kHz
-   6207 // 620.7 kHz
+   {   26, 0x51}, // 2.6 kHz, dwn3_byp = 0, ndec_exp = 5 , filset = 1
+   {   28, 0x52}, // 2.8 kHz, dwn3_byp = 0, ndec_exp = 5 , filset = 2
+   {   31, 0x53}, // 3.1 kHz, dwn3_byp = 0, ndec_exp = 5 , filset = 3
+   {   32, 0x54}, // 3.2 kHz, dwn3_byp = 0, ndec_exp = 5 , filset = 4
+   {   37, 0x55}, // 3.7 kHz, dwn3_byp = 0, ndec_exp = 5 , filset = 5
+   {   49, 0x41}, // 4.9 kHz, dwn3_byp = 0, ndec_exp = 4 , filset = 1
+   {   54, 0x42}, // 5.4 kHz, dwn3_byp = 0, ndec_exp = 4 , filset = 2
+   {   59, 0x43}, // 5.9 kHz, dwn3_byp = 0, ndec_exp = 4 , filset = 3
+   {   61, 0x44}, // 6.1 kHz, dwn3_byp = 0, ndec_exp = 4 , filset = 4
+   {   72, 0x45}, // 7.2 kHz, dwn3_byp = 0, ndec_exp = 4 , filset = 5
+   {   95, 0x31}, // 9.5 kHz, dwn3_byp = 0, ndec_exp = 3 , filset = 1
+   {  106, 0x32}, // 10.6 kHz, dwn3_byp = 0, ndec_exp = 3 , filset = 2
+   {  115, 0x33}, // 11.5 kHz, dwn3_byp = 0, ndec_exp = 3 , filset = 3
+   {  121, 0x34}, // 12.1 kHz, dwn3_byp = 0, ndec_exp = 3 , filset = 4
+   {  142, 0x35}, // 14.2 kHz, dwn3_byp = 0, ndec_exp = 3 , filset = 5
+   {  162, 0x36}, // 16.2 kHz, dwn3_byp = 0, ndec_exp = 3 , filset = 6
+   {  175, 0x3A}, // 17.5 kHz, dwn3_byp = 0, ndec_exp = 3 , filset = 10
+   {  194, 0x3B}, // 19.4 kHz, dwn3_byp = 0, ndec_exp = 3 , filset = 11
+   {  214, 0x3C}, // 21.4 kHz, dwn3_byp = 0, ndec_exp = 3 , filset = 12
+   {  239, 0x3D}, // 23.9 kHz, dwn3_byp = 0, ndec_exp = 3 , filset = 13
+   {  257, 0x3E}, // 25.7 kHz, dwn3_byp = 0, ndec_exp = 3 , filset = 14
+   {  282, 0x25}, // 28.2 kHz, dwn3_byp = 0, ndec_exp = 2 , filset = 5
+   {  322, 0x26}, // 32.2 kHz, dwn3_byp = 0, ndec_exp = 2 , filset = 6
+   {  347, 0x27}, // 34.7 kHz, dwn3_byp = 0, ndec_exp = 2 , filset = 7
+   {  386, 0x2B}, // 38.6 kHz, dwn3_byp = 0, ndec_exp = 2 , filset = 11
+   {  427, 0x2C}, // 42.7 kHz, dwn3_byp = 0, ndec_exp = 2 , filset = 12
+   {  477, 0x2D}, // 47.7 kHz, dwn3_byp = 0, ndec_exp = 2 , filset = 13
+   {  512, 0x2E}, // 51.2 kHz, dwn3_byp = 0, ndec_exp = 2 , filset = 14
+   {  562, 0x15}, // 56.2 kHz, dwn3_byp = 0, ndec_exp = 1 , filset = 5
+   {  641, 0x16}, // 64.1 kHz, dwn3_byp = 0, ndec_exp = 1 , filset = 6
+   {  694, 0x1A}, // 69.4 kHz, dwn3_byp = 0, ndec_exp = 1 , filset = 10
+   {  771, 0x1B}, // 77.1 kHz, dwn3_byp = 0, ndec_exp = 1 , filset = 11
+   {  851, 0x1C}, // 85.1 kHz, dwn3_byp = 0, ndec_exp = 1 , filset = 12
+   {  953, 0x1D}, // 95.3 kHz, dwn3_byp = 0, ndec_exp = 1 , filset = 13
+   { 1022, 0x1E}, // 102.2 kHz, dwn3_byp = 0, ndec_exp = 1 , filset = 14
+   { 1156, 0xAB}, // 115.6 kHz, dwn3_byp = 1, ndec_exp = 2 , filset = 11
+   { 1277, 0xAC}, // 127.7 kHz, dwn3_byp = 1, ndec_exp = 2 , filset = 12
+   { 1428, 0xAD}, // 142.8 kHz, dwn3_byp = 1, ndec_exp = 2 , filset = 13
+   { 1533, 0xAE}, // 153.3 kHz, dwn3_byp = 1, ndec_exp = 2 , filset = 14
+   { 1680, 0x98}, // 168 kHz, dwn3_byp = 1, ndec_exp = 1 , filset = 8
+   { 1811, 0x99}, // 181.1 kHz, dwn3_byp = 1, ndec_exp = 1 , filset = 9
+   { 2084, 0x9A}, // 208.4 kHz, dwn3_byp = 1, ndec_exp = 1 , filset = 10
+   { 2320, 0x9B}, // 232 kHz, dwn3_byp = 1, ndec_exp = 1 , filset = 11
+   { 2560, 0x9C}, // 256 kHz, dwn3_byp = 1, ndec_exp = 1 , filset = 12
+   { 2693, 0x83}, // 269.3 kHz, dwn3_byp = 1, ndec_exp = 0 , filset = 3
+   { 2849, 0x84}, // 284.9 kHz, dwn3_byp = 1, ndec_exp = 0 , filset = 4
+   { 3355, 0x88}, // 335.5 kHz, dwn3_byp = 1, ndec_exp = 0 , filset = 8
+   { 3618, 0x89}, // 361.8 kHz, dwn3_byp = 1, ndec_exp = 0 , filset = 9
+   { 4202, 0x8A}, // 420.2 kHz, dwn3_byp = 1, ndec_exp = 0 , filset = 10
+   { 4684, 0x8B}, // 468.4 kHz, dwn3_byp = 1, ndec_exp = 0 , filset = 11
+   { 5188, 0x8C}, // 518.8 kHz, dwn3_byp = 1, ndec_exp = 0 , filset = 12
+   { 5770, 0x8D}, // 577 kHz, dwn3_byp = 1, ndec_exp = 0 , filset = 13
+   { 6207, 0x8E}  // 620.7 kHz, dwn3_byp = 1, ndec_exp = 0 , filset = 14
 };
-
-const SEGMENT_VARIABLE (rtPhyTableIF_FilterSettingGE10[NUMBER_OF_RX_BANDWIDTH_VALUES_GE10], U8, code) =
+//=============================================================================
+#endif // HIGH_MODULATION_INDEX_TABLES
+//=============================================================================
+#ifdef FREQUENCY_HOPPING
+//=============================================================================
+// Default hop sequence - each of the 50 channels used once, consecutive
+// channels at least 6 channel spacings apart.
+//=============================================================================
+const SEGMENT_VARIABLE (rtPhyHopTable[NUMBER_OF_HOP_CHANNELS], U8, SEG_CODE) =
 {
-   0x51, // 2.6 kHz, dwn3_byp = 0, ndec_exp = 5 , filset = 1
-   0x52, // 2.8 kHz, dwn3_byp = 0, ndec_exp = 5 , filset = 2
-   0x53, // 3.1 kHz, dwn3_byp = 0, ndec_exp = 5 , filset = 3
-   0x54, // 3.2 kHz, dwn3_byp = 0, ndec_exp = 5 , filset = 4
-   0x55, // 3.7 kHz, dwn3_byp = 0, ndec_exp = 5 , filset = 5
-   0x41, // 4.9 kHz, dwn3_byp = 0, ndec_exp = 4 , filset = 1
-   0x42, // 5.4 kHz, dwn3_byp = 0, ndec_exp = 4 , filset = 2
-   0x43, // 5.9 kHz, dwn3_byp = 0, ndec_exp = 4 , filset = 3
-   0x44, // 6.1 kHz, dwn3_byp = 0, ndec_exp = 4 , filset = 4
-   0x45, // 7.2 kHz, dwn3_byp = 0, ndec_exp = 4 , filset = 5
-   0x31, // 9.5 kHz, dwn3_byp = 0, ndec_exp = 3 , filset = 1
-   0x32, // 10.6 kHz, dwn3_byp = 0, ndec_exp = 3 , filset = 2
-   0x33, // 11.5 kHz, dwn3_byp = 0, ndec_exp = 3 , filset = 3
-   0x34, // 12.1 kHz, dwn3_byp = 0, ndec_exp = 3 , filset = 4
-   0x35, // 14.2 kHz, dwn3_byp = 0, ndec_exp = 3 , filset = 5
-   0x36, // 16.2 kHz, dwn3_byp = 0, ndec_exp = 3 , filset = 6
-   0x3A, // 17.5 kHz, dwn3_byp = 0, ndec_exp = 3 , filset = 10
-   0x3B, // 19.4 kHz, dwn3_byp = 0, ndec_exp = 3 , filset = 11
-   0x3C, // 21.4 kHz, dwn3_byp = 0, ndec_exp = 3 , filset = 12
-   0x3D, // 23.9 kHz, dwn3_byp = 0, ndec_exp = 3 , filset = 13
-   0x3E, // 25.7 kHz, dwn3_byp = 0, ndec_exp = 3 , filset = 14
-   0x25, // 28.2 kHz, dwn3_byp = 0, ndec_exp = 2 , filset = 5
-   0x26, // 32.2 kHz, dwn3_byp = 0, ndec_exp = 2 , filset = 6
-   0x27, // 34.7 kHz, dwn3_byp = 0, ndec_exp = 2 , filset = 7
-   0x2B, // 38.6 kHz, dwn3_byp = 0, ndec_exp = 2 , filset = 11
-   0x2C, // 42.7 kHz, dwn3_byp = 0, ndec_exp = 2 , filset = 12
-   0x2D, // 47.7 kHz, dwn3_byp = 0, ndec_exp = 2 , filset = 13
-   0x2E, // 51.2 kHz, dwn3_byp = 0, ndec_exp = 2 , filset = 14
-   0x15, // 56.2 kHz, dwn3_byp = 0, ndec_exp = 1 , filset = 5
-   0x16, // 64.1 kHz, dwn3_byp = 0, ndec_exp = 1 , filset = 6
-   0x1A, // 69.4 kHz, dwn3_byp = 0, ndec_exp = 1 , filset = 10
-   0x1B, // 77.1 kHz, dwn3_byp = 0, ndec_exp = 1 , filset = 11
-   0x1C, // 85.1 kHz, dwn3_byp = 0, ndec_exp = 1 , filset = 12
-   0x1D, // 95.3 kHz, dwn3_byp = 0, ndec_exp = 1 , filset = 13
-   0x1E, // 102.2 kHz, dwn3_byp = 0, ndec_exp = 1 , filset = 14
-   0xAB, // 115.6 kHz, dwn3_byp = 1, ndec_exp = 2 , filset = 11
-   0xAC, // 127.7 kHz, dwn3_byp = 1, ndec_exp = 2 , filset = 12
-   0xAD, // 142.8 kHz, dwn3_byp = 1, ndec_exp = 2 , filset = 13
-   0xAE, // 153.3 kHz, dwn3_byp = 1, ndec_exp = 2 , filset = 14
-   0x98, // 168 kHz, dwn3_byp = 1, ndec_exp = 1 , filset = 8
-   0x99, // 181.1 kHz, dwn3_byp = 1, ndec_exp = 1 , filset = 9
-   0x9A, // 208.4 kHz, dwn3_byp = 1, ndec_exp = 1 , filset = 10
-   0x9B, // 232 kHz, dwn3_byp = 1, ndec_exp = 1 , filset = 11
-   0x9C, // 256 kHz, dwn3_byp = 1, ndec_exp = 1 , filset = 12
-   0x83, // 269.3 kHz, dwn3_byp = 1, ndec_exp = 0 , filset = 3
-   0x84, // 284.9 kHz, dwn3_byp = 1, ndec_exp = 0 , filset = 4
-   0x88, // 335.5 kHz, dwn3_byp = 1, ndec_exp = 0 , filset = 8
-   0x89, // 361.8 kHz, dwn3_byp = 1, ndec_exp = 0 , filset = 9
-   0x8A, // 420.2 kHz, dwn3_byp = 1, ndec_exp = 0 , filset = 10
-   0x8B, // 468.4 kHz, dwn3_byp = 1, ndec_exp = 0 , filset = 11
-   0x8C, // 518.8 kHz, dwn3_byp = 1, ndec_exp = 0 , filset = 12
-   0x8D, // 577 kHz, dwn3_byp = 1, ndec_exp = 0 , filset = 13
-   0x8E, // 620.7 kHz, dwn3_byp = 1, ndec_exp = 0 , filset = 14
-
+   15, 48, 41, 19,  6, 46, 23, 44, 26, 13,
+   49, 33, 24, 18, 10, 22,  4, 14,  7, 40,
+   29,  8, 21,  1, 25, 11, 31,  2, 17, 37,
+   47,  3, 42, 16,  9, 38, 28, 12,  5, 30,
+   20, 36, 27, 45, 32, 39,  0, 35, 43, 34
 };
 //=============================================================================
-#endif // HIGH_MODULATION_INDEX_TABLES
+#endif // FREQUENCY_HOPPING
 //=============================================================================
 //=============================================================================
 // End
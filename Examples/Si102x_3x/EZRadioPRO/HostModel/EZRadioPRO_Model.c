@@ -0,0 +1,563 @@
+//=============================================================================
+// EZRadioPRO_Model.c
+//=============================================================================
+//
+// C File Description:
+//
+//    Host model of the EZRadioPRO radio used to run the Run Time PHY on
+//    Linux. See EZRadioPRO_Model.h.
+//
+//    Only the registers and events used by rtPhy.c are modeled:
+//
+//    - Device version, interrupt status (clear on read) and enables
+//    - Software reset, TXON and RXON in Operating & Function Control 1
+//    - FIFO clear bits in Operating & Function Control 2
+//    - TX and RX FIFO through the FIFO access register
+//    - Received packet length
+//
+//    All other registers are a plain register file.
+//
+// Target:
+//    Linux host
+//
+// Tool Chains:
+//    GCC
+//
+// Project Name:
+//    Run Time PHY host model
+//
+//=============================================================================
+//-----------------------------------------------------------------------------
+// Includes
+//-----------------------------------------------------------------------------
+#include <compiler_defs.h>
+#include "hardware_defs.h"
+#include "rtPhy.h"
+#include "EZRadioPRO_Model.h"
+#include <string.h>
+//-----------------------------------------------------------------------------
+// MCU SFRs and sbits used by rtPhy.c
+//-----------------------------------------------------------------------------
+volatile U8 SDN;
+volatile U8 IRQ = 1;
+volatile U8 NSS1 = 1;
+volatile U8 EA;
+volatile U8 EX0;
+volatile U8 IE0;
+volatile U8 ET0;
+volatile U8 P2MDOUT;
+#ifdef FREQUENCY_HOPPING
+volatile U8 CKCON;
+volatile U8 TMR2CN;
+volatile U8 TMR2RLL;
+volatile U8 TMR2RLH;
+volatile U8 TMR2L;
+volatile U8 TMR2H;
+volatile U8 ET2;
+volatile U8 TF2H;
+volatile U8 TR2;
+#endif
+//-----------------------------------------------------------------------------
+// Receive ISR in rtPhy.c
+//-----------------------------------------------------------------------------
+INTERRUPT_PROTO(Receiver_ISR, INTERRUPT_INT0);
+//-----------------------------------------------------------------------------
+// Model state
+//-----------------------------------------------------------------------------
+ModelStatsStruct ModelStats;
+U8 ModelPeerRxLength;
+U8 ModelPeerRxBuffer[MODEL_MAX_PACKET];
+
+static U8 Registers[128];
+static U8 TxFifo[MODEL_FIFO_SIZE];
+static U8 TxFifoLength;
+static U8 RxFifo[MODEL_FIFO_SIZE];
+static U8 RxFifoLength;
+static U8 RxFifoIndex;
+static ModelChannelStruct Channel;
+static U32 ChannelRandom;
+//-----------------------------------------------------------------------------
+// Channel outcomes
+//-----------------------------------------------------------------------------
+enum
+{
+   CHANNEL_VALID = 0,
+   CHANNEL_CRC_ERROR,
+   CHANNEL_LOST
+};
+//-----------------------------------------------------------------------------
+// local functions
+//-----------------------------------------------------------------------------
+static void  ResetRegisters (void);
+static void  UpdateIrq (void);
+static void  SpiTransaction (U8);
+static void  Transmit (void);
+static U8    ChannelOutcome (void);
+static void  ServiceInterrupts (void);
+//-----------------------------------------------------------------------------
+// ModelInit()
+//
+// Parameters   : channel configuration
+// Return Value : none
+//
+// Puts the radio in the power-on state and clears all statistics.
+//-----------------------------------------------------------------------------
+void ModelInit (ModelChannelStruct *channel)
+{
+   U32 i;
+
+   Channel = *channel;
+   ChannelRandom = Channel.Seed ? Channel.Seed : 1;
+
+   for(i = 0; i < sizeof(ModelStats); i++)
+      ((U8 *)&ModelStats)[i] = 0;
+
+   ModelPeerRxLength = 0;
+
+   ResetRegisters();
+}
+//-----------------------------------------------------------------------------
+// ModelPeerTransmit()
+//
+// Parameters   : U8 length, U8 *buffer
+// Return Value : none
+//
+// Sends a packet from the peer radio through the channel. If the modeled
+// radio is receiving, the packet ends up in the RX FIFO (or as a CRC error)
+// and Receiver_ISR() is called when INT0 is enabled.
+//-----------------------------------------------------------------------------
+void ModelPeerTransmit (U8 length, U8 *buffer)
+{
+   U8 outcome;
+   U8 i;
+
+   ModelStats.TimeNs += (uint64_t)ModelAirTimeUs(length) * 1000;
+   ModelStats.PeerTxPackets++;
+
+   if((Registers[EZRADIOPRO_OPERATING_AND_FUNCTION_CONTROL_1] & EZRADIOPRO_RXON) == 0)
+   {
+      ModelStats.RxMissed++;
+      return;
+   }
+
+   outcome = ChannelOutcome();
+
+   if(outcome == CHANNEL_LOST)
+   {
+      ModelStats.RxLost++;
+      return;
+   }
+
+   if(outcome == CHANNEL_CRC_ERROR)
+   {
+      ModelStats.RxCrcError++;
+      Registers[EZRADIOPRO_INTERRUPT_STATUS_1] |= EZRADIOPRO_ICRCERROR;
+   }
+   else
+   {
+      ModelStats.RxValid++;
+
+      if(length > MODEL_FIFO_SIZE)
+         length = MODEL_FIFO_SIZE;
+
+      for(i = 0; i < length; i++)
+         RxFifo[i] = buffer[i];
+
+      RxFifoLength = length;
+      RxFifoIndex = 0;
+      Registers[EZRADIOPRO_RECEIVED_PACKET_LENGTH] = length;
+      Registers[EZRADIOPRO_INTERRUPT_STATUS_1] |= EZRADIOPRO_IPKVALID;
+   }
+
+   // radio returns to READY after a packet
+   Registers[EZRADIOPRO_OPERATING_AND_FUNCTION_CONTROL_1] &= ~EZRADIOPRO_RXON;
+
+   UpdateIrq();
+   ServiceInterrupts();
+}
+//-----------------------------------------------------------------------------
+// ModelAirTimeUs()
+//
+// Parameters   : U8 length - payload length
+// Return Value : packet air time in microseconds
+//
+// Uses the packet handler and modem registers: preamble, sync word, header,
+// length byte, CRC, Manchester and the TX data rate.
+//-----------------------------------------------------------------------------
+U32 ModelAirTimeUs (U8 length)
+{
+   U8 headerControl2;
+   U32 bytes;
+   uint64_t bits;
+   UU16 txDataRate;
+
+   headerControl2 = Registers[EZRADIOPRO_HEADER_CONTROL_2];
+
+   bytes = length;
+   bytes += ((headerControl2 >> 1) & 0x03) + 1;      // sync word
+   bytes += (headerControl2 >> 4) & 0x07;            // header
+   if((headerControl2 & 0x08) == 0)
+      bytes += 1;                                    // length byte
+   if(Registers[EZRADIOPRO_DATA_ACCESS_CONTROL] & 0x04)
+      bytes += 2;                                    // CRC
+
+   bits = (Registers[EZRADIOPRO_PREAMBLE_LENGTH] + ((headerControl2 & 0x01) << 8)) * 4;
+   bits += bytes * 8;
+
+   if(Registers[EZRADIOPRO_MODULATION_MODE_CONTROL_1] & 0x02)
+      bits <<= 1;                                    // Manchester
+
+   txDataRate.U8[MSB] = Registers[EZRADIOPRO_TX_DATA_RATE_1];
+   txDataRate.U8[LSB] = Registers[EZRADIOPRO_TX_DATA_RATE_0];
+   if(txDataRate.U16 == 0)
+      return 0;
+
+   // rate = txdr * 10^6 / 2^16 (2^21 with txdtrtscale)
+   if(Registers[EZRADIOPRO_MODULATION_MODE_CONTROL_1] & 0x20)
+      return (U32)((bits << 21) / txDataRate.U16);
+   else
+      return (U32)((bits << 16) / txDataRate.U16);
+}
+//=============================================================================
+//
+// PHY primitives replaced by the model
+//
+//=============================================================================
+//-----------------------------------------------------------------------------
+// phyWrite()
+//-----------------------------------------------------------------------------
+void phyWrite (U8 reg, U8 value)
+{
+   SpiTransaction(2);
+
+   reg &= 0x7F;
+
+   switch (reg)
+   {
+      case EZRADIOPRO_DEVICE_TYPE:
+      case EZRADIOPRO_DEVICE_VERSION:
+      case EZRADIOPRO_DEVICE_STATUS:
+      case EZRADIOPRO_INTERRUPT_STATUS_1:
+      case EZRADIOPRO_INTERRUPT_STATUS_2:
+      case EZRADIOPRO_RECEIVED_PACKET_LENGTH:
+         break;                        // read only
+
+      case EZRADIOPRO_OPERATING_AND_FUNCTION_CONTROL_1:
+         if(value & EZRADIOPRO_SWRES)
+         {
+            ResetRegisters();
+            Registers[EZRADIOPRO_INTERRUPT_STATUS_2] = EZRADIOPRO_IPOR|EZRADIOPRO_ICHIPRDY;
+            break;
+         }
+         Registers[reg] = value;
+         if(value & EZRADIOPRO_TXON)
+            Transmit();
+         break;
+
+      case EZRADIOPRO_OPERATING_AND_FUNCTION_CONTROL_2:
+         if(value & EZRADIOPRO_FFCLRRX)
+         {
+            RxFifoLength = 0;
+            RxFifoIndex = 0;
+         }
+         if(value & EZRADIOPRO_FFCLRTX)
+            TxFifoLength = 0;
+         Registers[reg] = value & ~(EZRADIOPRO_FFCLRRX|EZRADIOPRO_FFCLRTX);
+         break;
+
+      case EZRADIOPRO_FIFO_ACCESS:
+         if(TxFifoLength < MODEL_FIFO_SIZE)
+            TxFifo[TxFifoLength++] = value;
+         break;
+
+      default:
+         Registers[reg] = value;
+         break;
+   }
+
+   UpdateIrq();
+}
+//-----------------------------------------------------------------------------
+// phyRead()
+//-----------------------------------------------------------------------------
+U8 phyRead (U8 reg)
+{
+   U8 value;
+
+   SpiTransaction(2);
+
+   reg &= 0x7F;
+
+   switch (reg)
+   {
+      case EZRADIOPRO_INTERRUPT_STATUS_1:
+      case EZRADIOPRO_INTERRUPT_STATUS_2:
+         value = Registers[reg];
+         Registers[reg] = 0;           // cleared on read
+         UpdateIrq();
+         break;
+
+      case EZRADIOPRO_FIFO_ACCESS:
+         value = (RxFifoIndex < RxFifoLength) ? RxFifo[RxFifoIndex++] : 0;
+         break;
+
+      default:
+         value = Registers[reg];
+         break;
+   }
+
+   return value;
+}
+//-----------------------------------------------------------------------------
+// phyWriteFIFO()
+//-----------------------------------------------------------------------------
+void phyWriteFIFO (U8 n, VARIABLE_SEGMENT_POINTER(buffer, U8, BUFFER_MSPACE))
+{
+   SpiTransaction(n + 1);
+
+   while(n--)
+   {
+      if(TxFifoLength < MODEL_FIFO_SIZE)
+         TxFifo[TxFifoLength++] = *buffer;
+      buffer++;
+   }
+}
+//-----------------------------------------------------------------------------
+// Receive interrupt SPI functions - same behavior as the main thread ones
+//-----------------------------------------------------------------------------
+void RxIntPhyWrite (U8 reg, U8 value)
+{
+   phyWrite(reg, value);
+}
+
+U8 RxIntPhyRead (U8 reg)
+{
+   return phyRead(reg);
+}
+
+void RxIntphyReadFIFO (U8 n, VARIABLE_SEGMENT_POINTER(buffer, U8, BUFFER_MSPACE))
+{
+   SpiTransaction(n + 1);
+
+   while(n--)
+      *buffer++ = (RxFifoIndex < RxFifoLength) ? RxFifo[RxFifoIndex++] : 0;
+}
+#ifdef TX_INTERRUPT
+//-----------------------------------------------------------------------------
+// Transmit interrupt SPI function
+//-----------------------------------------------------------------------------
+void TxIntPhyWriteFIFO (U8 n, VARIABLE_SEGMENT_POINTER(buffer, U8, BUFFER_MSPACE))
+{
+   phyWriteFIFO(n, buffer);
+}
+#endif
+#ifdef FREQUENCY_HOPPING
+//-----------------------------------------------------------------------------
+// Hop timer interrupt SPI function
+//-----------------------------------------------------------------------------
+void HopIntPhyWrite (U8 reg, U8 value)
+{
+   phyWrite(reg, value);
+}
+#endif
+//-----------------------------------------------------------------------------
+// delay() - T0 ticks are SYSCLK/48
+//-----------------------------------------------------------------------------
+void delay (U16 ticks)
+{
+   ModelStats.TimeNs += ((uint64_t)ticks * 48 * 1000000000) / SYSCLK_HZ;
+}
+//-----------------------------------------------------------------------------
+// SetTimeOut()
+//
+// Nothing in the model happens asynchronously, so if the IRQ is not already
+// asserted the wait loop that follows can only end by timing out. In that
+// case the full time-out is charged and the time-out flag is set at once.
+//-----------------------------------------------------------------------------
+void SetTimeOut (U16 ticks)
+{
+   if(IRQ)
+   {
+      delay(ticks);
+      ET0 = 0;
+   }
+   else
+   {
+      ET0 = 1;
+   }
+}
+//-----------------------------------------------------------------------------
+// ClearTimeOut()
+//-----------------------------------------------------------------------------
+void ClearTimeOut (void)
+{
+   ET0 = 0;
+}
+//=============================================================================
+//
+// Local functions
+//
+//=============================================================================
+//-----------------------------------------------------------------------------
+// ResetRegisters() - power-on state, radio ready with XTAL running
+//-----------------------------------------------------------------------------
+static void ResetRegisters (void)
+{
+   U8 i;
+
+   for(i = 0; i < sizeof(Registers); i++)
+      Registers[i] = 0;
+
+   Registers[EZRADIOPRO_DEVICE_TYPE] = 0x08;
+   Registers[EZRADIOPRO_DEVICE_VERSION] = 0x06;
+   Registers[EZRADIOPRO_INTERRUPT_STATUS_2] = EZRADIOPRO_IPOR|EZRADIOPRO_ICHIPRDY;
+   Registers[EZRADIOPRO_INTERRUPT_ENABLE_2] = EZRADIOPRO_ENPOR|EZRADIOPRO_ENCHIPRDY;
+   Registers[EZRADIOPRO_OPERATING_AND_FUNCTION_CONTROL_1] = EZRADIOPRO_XTON;
+
+   TxFifoLength = 0;
+   RxFifoLength = 0;
+   RxFifoIndex = 0;
+
+   UpdateIrq();
+}
+//-----------------------------------------------------------------------------
+// UpdateIrq() - nIRQ is low while any enabled status bit is set
+//-----------------------------------------------------------------------------
+static void UpdateIrq (void)
+{
+   U8 pending;
+
+   pending  = Registers[EZRADIOPRO_INTERRUPT_STATUS_1] & Registers[EZRADIOPRO_INTERRUPT_ENABLE_1];
+   pending |= Registers[EZRADIOPRO_INTERRUPT_STATUS_2] & Registers[EZRADIOPRO_INTERRUPT_ENABLE_2];
+
+   IRQ = pending ? 0 : 1;
+}
+//-----------------------------------------------------------------------------
+// SpiTransaction() - one NSS cycle of n bytes
+//-----------------------------------------------------------------------------
+static void SpiTransaction (U8 n)
+{
+   ModelStats.SpiTransactions++;
+   ModelStats.SpiBytes += n;
+   ModelStats.TimeNs += MODEL_SPI_OVERHEAD_NS;
+   ModelStats.TimeNs += ((uint64_t)n * 8 * 1000000000) / MODEL_SPI_CLOCK_HZ;
+}
+//-----------------------------------------------------------------------------
+// Transmit() - send the packet to the peer through the channel
+//
+// The TX FIFO is drained one byte per byte time. Each time the level falls
+// to the almost empty threshold ITXFFAEM is set and INT0 is serviced, so
+// the ISR refills the FIFO while the packet is on the air. The simulated
+// clock is never moved back, so SPI and ISR time overlap the air time.
+//-----------------------------------------------------------------------------
+static void Transmit (void)
+{
+   U8 packet[MODEL_MAX_PACKET];
+   U8 length;
+   U8 threshold;
+   U8 outcome;
+   U8 i;
+   uint64_t startNs;
+   uint64_t byteNs;
+   uint64_t endNs;
+
+   length = Registers[EZRADIOPRO_TRANSMIT_PACKET_LENGTH];
+   threshold = Registers[EZRADIOPRO_TX_FIFO_CONTROL_2] & 0x3F;
+
+   startNs = ModelStats.TimeNs + (uint64_t)(MODEL_TX_TURNAROUND_US + ModelAirTimeUs(0)) * 1000;
+   byteNs = length ? ((uint64_t)(ModelAirTimeUs(length) - ModelAirTimeUs(0)) * 1000) / length : 0;
+
+   ModelStats.TxPackets++;
+   outcome = CHANNEL_VALID;
+
+   for(i = 0; i < length; i++)
+   {
+      endNs = startNs + (i + 1) * byteNs;
+      if(ModelStats.TimeNs < endNs)
+         ModelStats.TimeNs = endNs;
+
+      if(TxFifoLength == 0)
+      {
+         ModelStats.TxUnderflow++;
+         Registers[EZRADIOPRO_INTERRUPT_STATUS_1] |= EZRADIOPRO_IFFERR;
+         outcome = CHANNEL_CRC_ERROR;
+         packet[i] = 0;
+         continue;
+      }
+
+      packet[i] = TxFifo[0];
+      memmove(TxFifo, TxFifo + 1, --TxFifoLength);
+
+      if((TxFifoLength == threshold) && ((i + 1) < length))
+      {
+         Registers[EZRADIOPRO_INTERRUPT_STATUS_1] |= EZRADIOPRO_ITXFFAEM;
+         UpdateIrq();
+         ServiceInterrupts();
+      }
+   }
+
+   endNs = startNs + length * byteNs;
+   if(ModelStats.TimeNs < endNs)
+      ModelStats.TimeNs = endNs;
+
+   if(outcome == CHANNEL_VALID)
+      outcome = ChannelOutcome();
+
+   if(outcome == CHANNEL_LOST)
+   {
+      ModelStats.PeerRxLost++;
+   }
+   else if(outcome == CHANNEL_CRC_ERROR)
+   {
+      ModelStats.PeerRxCrcError++;
+   }
+   else
+   {
+      ModelStats.PeerRxValid++;
+      for(i = 0; i < length; i++)
+         ModelPeerRxBuffer[i] = packet[i];
+      ModelPeerRxLength = length;
+   }
+
+   // radio returns to READY after the packet is sent
+   Registers[EZRADIOPRO_OPERATING_AND_FUNCTION_CONTROL_1] &= ~EZRADIOPRO_TXON;
+   Registers[EZRADIOPRO_INTERRUPT_STATUS_1] |= EZRADIOPRO_IPKSENT;
+
+   UpdateIrq();
+   ServiceInterrupts();
+}
+//-----------------------------------------------------------------------------
+// ChannelOutcome() - xorshift32 PRNG so runs repeat for a given seed
+//-----------------------------------------------------------------------------
+static U8 ChannelOutcome (void)
+{
+   U32 draw;
+
+   ChannelRandom ^= ChannelRandom << 13;
+   ChannelRandom ^= ChannelRandom >> 17;
+   ChannelRandom ^= ChannelRandom << 5;
+
+   draw = ChannelRandom % 1000;
+
+   if(draw < Channel.LossPerMille)
+      return CHANNEL_LOST;
+   else if(draw < (U32)Channel.LossPerMille + Channel.CorruptPerMille)
+      return CHANNEL_CRC_ERROR;
+   else
+      return CHANNEL_VALID;
+}
+//-----------------------------------------------------------------------------
+// ServiceInterrupts() - level triggered INT0 on nIRQ
+//-----------------------------------------------------------------------------
+static void ServiceInterrupts (void)
+{
+   if((IRQ == 0) && EX0 && EA)
+   {
+      IE0 = 1;
+      ModelStats.IsrCalls++;
+      Receiver_ISR();
+   }
+}
+//=============================================================================
+// end EZRadioPRO_Model.c
+//=============================================================================
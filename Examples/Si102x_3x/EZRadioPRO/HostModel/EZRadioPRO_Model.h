@@ -0,0 +1,91 @@
+#ifndef  EZRADIOPRO_MODEL_H
+#define  EZRADIOPRO_MODEL_H
+//=============================================================================
+// EZRadioPRO_Model.h
+//-----------------------------------------------------------------------------
+//
+// Header File Description:
+//
+//    Host model of the EZRadioPRO register file, FIFOs and a lossy RF
+//    channel to a peer radio. The model provides the phyWrite()/phyRead()/
+//    FIFO primitives, delay() and the T0 time-out functions that rtPhy.c
+//    removes when built with HOST_MODEL.
+//
+//    All events are resolved synchronously. Writing TXON sends the TX FIFO
+//    to the peer at once and ModelPeerTransmit() delivers a packet from the
+//    peer, calling Receiver_ISR() when the radio IRQ is asserted and INT0 is
+//    enabled. A simulated clock is advanced by SPI transfers, delays and
+//    packet air time so throughput can be reported in packets per second.
+//
+//    The TX FIFO drains one byte at a time during a packet. When the level
+//    reaches the almost empty threshold the ITXFFAEM interrupt is raised so
+//    the ISR can refill the FIFO, which allows packets up to 255 bytes. The
+//    air time runs in parallel with the SPI and ISR time.
+//
+// Target:
+//    Linux host
+//
+// Tool Chains:
+//    GCC
+//
+// Project Name:
+//    Run Time PHY host model
+//
+//=============================================================================
+#ifndef COMPILER_DEFS_H
+#include <compiler_defs.h>
+#endif
+//-----------------------------------------------------------------------------
+// Model timing
+//-----------------------------------------------------------------------------
+#define MODEL_SPI_CLOCK_HZ          (SYSCLK_HZ/2)   // SPI1CKR = 0
+#define MODEL_SPI_OVERHEAD_NS       2000            // NSS, call and EA save
+#define MODEL_TX_TURNAROUND_US      200             // PLL settle before TX
+#define MODEL_FIFO_SIZE             64
+#define MODEL_MAX_PACKET            255             // 8-bit packet length
+//-----------------------------------------------------------------------------
+// Channel configuration - probabilities in parts per thousand
+//-----------------------------------------------------------------------------
+typedef struct ModelChannelStruct
+{
+   U16 LossPerMille;                   // packet not detected at all
+   U16 CorruptPerMille;                // packet received with a CRC error
+   U32 Seed;                           // channel PRNG seed
+} ModelChannelStruct;
+//-----------------------------------------------------------------------------
+// Model statistics
+//-----------------------------------------------------------------------------
+typedef struct ModelStatsStruct
+{
+   uint64_t TimeNs;                    // simulated time
+   U32 SpiTransactions;                // NSS low to NSS high
+   U32 SpiBytes;                       // including address bytes
+   U32 IsrCalls;                       // Receiver_ISR() invocations
+
+   U32 TxPackets;                      // sent by the modeled radio
+   U32 TxUnderflow;                    // TX FIFO ran empty mid-packet
+   U32 PeerRxValid;
+   U32 PeerRxCrcError;
+   U32 PeerRxLost;
+
+   U32 PeerTxPackets;                  // sent by the peer
+   U32 RxValid;
+   U32 RxCrcError;
+   U32 RxLost;
+   U32 RxMissed;                       // receiver was not on
+} ModelStatsStruct;
+//-----------------------------------------------------------------------------
+// Public variables
+//-----------------------------------------------------------------------------
+extern ModelStatsStruct ModelStats;
+extern U8 ModelPeerRxLength;
+extern U8 ModelPeerRxBuffer[MODEL_MAX_PACKET];
+//-----------------------------------------------------------------------------
+// Public function prototypes
+//-----------------------------------------------------------------------------
+void  ModelInit (ModelChannelStruct *);
+void  ModelPeerTransmit (U8, U8 *);
+U32   ModelAirTimeUs (U8);
+//=============================================================================
+//=============================================================================
+#endif // EZRADIOPRO_MODEL_H
@@ -0,0 +1,10 @@
+//-----------------------------------------------------------------------------
+// SI1020_defs.h
+//-----------------------------------------------------------------------------
+//
+// hardware_defs.h includes <SI1020_defs.h>. The file in Header_Files is
+// named Si1020_defs.h, which only matches on a case-insensitive file system,
+// so the host build forwards the include here.
+//
+//-----------------------------------------------------------------------------
+#include "../../Header_Files/Si1020_defs.h"
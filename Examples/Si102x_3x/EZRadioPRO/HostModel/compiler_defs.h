@@ -0,0 +1,98 @@
+//-----------------------------------------------------------------------------
+// compiler_defs.h
+//-----------------------------------------------------------------------------
+//
+// Host (Linux/GCC) replacement for the C8051 compiler_defs.h.
+//
+// Used only by the EZRadioPRO host model build. Memory segment qualifiers
+// are removed, SFRs and sbits become ordinary variables owned by
+// EZRadioPRO_Model.c and interrupt service routines become plain functions
+// that the model calls when the radio IRQ is asserted.
+//
+// Target:         Linux host
+// Tool chain:     GCC
+// Command Line:   See rtPhyBench.c
+//
+//-----------------------------------------------------------------------------
+#ifndef COMPILER_DEFS_H
+#define COMPILER_DEFS_H
+
+#include <stdint.h>
+
+# define SEG_GENERIC
+# define SEG_FAR
+# define SEG_DATA
+# define SEG_NEAR
+# define SEG_IDATA
+# define SEG_XDATA
+# define SEG_PDATA
+# define SEG_CODE  const
+# define SEG_BDATA
+
+// Keil memory space keywords used directly in the example sources
+# define code      const
+
+# define SBIT(name, addr, bit)  extern volatile U8  name
+# define SFR(name, addr)        extern volatile U8  name
+# define SFRX(name, addr)       extern volatile U8  name
+# define SFR16(name, addr)      extern volatile U16 name
+# define SFR16E(name, fulladdr) extern volatile U16 name
+# define SFR32(name, fulladdr)  extern volatile U32 name
+# define SFR32E(name, fulladdr) extern volatile U32 name
+
+# define INTERRUPT(name, vector) void name (void)
+# define INTERRUPT_USING(name, vector, regnum) void name (void)
+# define INTERRUPT_PROTO(name, vector) void name (void)
+# define INTERRUPT_PROTO_USING(name, vector, regnum) void name (void)
+
+# define FUNCTION_USING(name, return_value, parameter, regnum) return_value name (parameter)
+# define FUNCTION_PROTO_USING(name, return_value, parameter, regnum) return_value name (parameter)
+
+# define SEGMENT_VARIABLE(name, vartype, locsegment) vartype locsegment name
+# define VARIABLE_SEGMENT_POINTER(name, vartype, targsegment) vartype targsegment * name
+# define SEGMENT_VARIABLE_SEGMENT_POINTER(name, vartype, targsegment, locsegment) vartype targsegment * locsegment name
+# define SEGMENT_POINTER(name, vartype, locsegment) vartype * locsegment name
+# define LOCATED_VARIABLE_NO_INIT(name, vartype, locsegment, addr) vartype locsegment name
+
+// used with UU16 (host is little endian)
+# define LSB 0
+# define MSB 1
+
+// used with UU32 (b0 is least-significant byte)
+# define b0 0
+# define b1 1
+# define b2 2
+# define b3 3
+
+typedef uint8_t  U8;
+typedef uint16_t U16;
+typedef uint32_t U32;
+
+typedef int8_t  S8;
+typedef int16_t S16;
+typedef int32_t S32;
+
+typedef U8 bit;
+
+typedef union UU16
+{
+   U16 U16;
+   S16 S16;
+   U8 U8[2];
+   S8 S8[2];
+} UU16;
+
+typedef union UU32
+{
+   U32 U32;
+   S32 S32;
+   UU16 UU16[2];
+   U16 U16[2];
+   S16 S16[2];
+   U8 U8[4];
+   S8 S8[4];
+} UU32;
+
+#define NOP()
+
+#endif                                 // #define COMPILER_DEFS_H
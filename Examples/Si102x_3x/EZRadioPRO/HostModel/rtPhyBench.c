@@ -0,0 +1,436 @@
+//=============================================================================
+// rtPhyBench.c
+//=============================================================================
+//
+// C File Description:
+//
+//    Runs the Run Time PHY against the host EZRadioPRO model and reports
+//    packets per second, drop rate and SPI transactions per call.
+//
+//    The node is configured exactly like mainTx.c and mainRx.c. The TX pass
+//    sends packets with rtPhyTx() to the peer radio in the model. The RX pass
+//    turns the receiver on with rtPhyRxOn() and lets the peer send packets,
+//    which arrive through Receiver_ISR() and are read with rtPhyGetRxPacket().
+//    Both directions go through the same lossy channel.
+//
+//    Before the passes, FindFilterIndex() is checked against the linear scan
+//    it replaced in LookUpFilterSetting(), for every bandwidth from 0 to the
+//    last entry of each IF filter table (LT10 and GE10 only when built with
+//    -DHIGH_MODULATION_INDEX_TABLES). The bench exits with status 1 if
+//    any result differs.
+//
+//    Built with TX_INTERRUPT a third pass sends long packets with
+//    rtPhyTxStart(), refilling the TX FIFO from the INT0 interrupt.
+//
+//    Built with FREQUENCY_HOPPING a hop pass compares retuning with
+//    rtPhySet(TRX_FREQUENCY,...) against rtPhyHopNext() and the Timer 2
+//    Hop_ISR().
+//
+// Build (from this directory):
+//
+//    gcc -O2 -DHOST_MODEL -I. -I../RunTimePHY -o rtPhyBench rtPhyBench.c
+//        EZRadioPRO_Model.c ../RunTimePHY/rtPhy.c ../RunTimePHY/rtPhy_const.c
+//
+//    Add -DTX_INTERRUPT and/or -DFREQUENCY_HOPPING for the extra passes,
+//    and -DHIGH_MODULATION_INDEX_TABLES to check all three filter tables.
+//
+// Usage:
+//
+//    rtPhyBench [-n packets] [-l length] [-r dataRate] [-d deviation]
+//               [-loss permille] [-crc permille] [-seed n]
+//               [-L long packet length, TX_INTERRUPT only]
+//
+// Target:
+//    Linux host
+//
+// Tool Chains:
+//    GCC
+//
+// Project Name:
+//    Run Time PHY host model
+//
+//=============================================================================
+//-----------------------------------------------------------------------------
+// Includes
+//-----------------------------------------------------------------------------
+#include <compiler_defs.h>
+#include "hardware_defs.h"
+#include "rtPhy.h"
+#include "rtPhy_const.h"
+#include "EZRadioPRO_Model.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+//-----------------------------------------------------------------------------
+SEGMENT_VARIABLE (TxBuffer[64], U8, BUFFER_MSPACE);
+SEGMENT_VARIABLE (RxBuffer[64], U8, BUFFER_MSPACE);
+#ifdef TX_INTERRUPT
+SEGMENT_VARIABLE (TxLongBuffer[MODEL_MAX_PACKET], U8, BUFFER_MSPACE);
+#endif
+//-----------------------------------------------------------------------------
+// Internal Function Prototypes
+//-----------------------------------------------------------------------------
+static void Report (const char *, U32, U32, U32, U32, U32, uint64_t);
+static U32  FilterIndexCheck (const char *,
+   VARIABLE_SEGMENT_POINTER(table, rtPhyFilterEntry, SEG_CODE), U8);
+U8 FindFilterIndex (VARIABLE_SEGMENT_POINTER(table, rtPhyFilterEntry, SEG_CODE), U8, U16);
+#ifdef TX_INTERRUPT
+static void TxInterruptPass (U32, U32);
+#endif
+#ifdef FREQUENCY_HOPPING
+static U32  HopPass (U32);
+INTERRUPT_PROTO(Hop_ISR, INTERRUPT_TIMER2);
+#endif
+//=============================================================================
+// Functions
+//=============================================================================
+//-----------------------------------------------------------------------------
+// main ()
+//-----------------------------------------------------------------------------
+int main (int argc, char *argv[])
+{
+   ModelChannelStruct channel;
+   U32 packets = 1000;
+   U32 length = 64;
+   U32 longLength = MODEL_MAX_PACKET;
+   U32 dataRate = 40000L;
+   U32 deviation = 20000L;
+   U32 i, n;
+   U32 spi, errors;
+   U32 spiInit;
+   uint64_t start;
+   U8 rxLength;
+   U8 status;
+   int arg;
+
+   channel.LossPerMille = 0;
+   channel.CorruptPerMille = 0;
+   channel.Seed = 1;
+
+   for(arg = 1; arg + 1 < argc; arg += 2)
+   {
+      if(strcmp(argv[arg], "-n") == 0)
+         packets = strtoul(argv[arg + 1], NULL, 0);
+      else if(strcmp(argv[arg], "-l") == 0)
+         length = strtoul(argv[arg + 1], NULL, 0);
+      else if(strcmp(argv[arg], "-r") == 0)
+         dataRate = strtoul(argv[arg + 1], NULL, 0);
+      else if(strcmp(argv[arg], "-d") == 0)
+         deviation = strtoul(argv[arg + 1], NULL, 0);
+      else if(strcmp(argv[arg], "-loss") == 0)
+         channel.LossPerMille = (U16)strtoul(argv[arg + 1], NULL, 0);
+      else if(strcmp(argv[arg], "-crc") == 0)
+         channel.CorruptPerMille = (U16)strtoul(argv[arg + 1], NULL, 0);
+      else if(strcmp(argv[arg], "-seed") == 0)
+         channel.Seed = strtoul(argv[arg + 1], NULL, 0);
+      else if(strcmp(argv[arg], "-L") == 0)
+         longLength = strtoul(argv[arg + 1], NULL, 0);
+   }
+
+   if(length == 0 || length > 64)
+   {
+      fprintf(stderr, "length must be 1 to 64\n");
+      return 1;
+   }
+
+   if(longLength == 0 || longLength > MODEL_MAX_PACKET)
+   {
+      fprintf(stderr, "long length must be 1 to %u\n", MODEL_MAX_PACKET);
+      return 1;
+   }
+
+   errors = FilterIndexCheck("LT2", rtPhyTableFilterLT2,
+      NUMBER_OF_RX_BANDWIDTH_VALUES_LT2);
+#ifdef HIGH_MODULATION_INDEX_TABLES
+   errors += FilterIndexCheck("LT10", rtPhyTableFilterLT10,
+      NUMBER_OF_RX_BANDWIDTH_VALUES_LT10);
+   errors += FilterIndexCheck("GE10", rtPhyTableFilterGE10,
+      NUMBER_OF_RX_BANDWIDTH_VALUES_GE10);
+#endif
+   printf("\n");
+   if(errors)
+      return 1;
+
+   ModelInit(&channel);
+
+   EA = 1;
+
+   status = rtPhyInit();
+   if(status != PHY_STATUS_SUCCESS)
+   {
+      fprintf(stderr, "rtPhyInit failed (%u)\n", status);
+      return 1;
+   }
+
+   rtPhySet (TRX_FREQUENCY, 915000000);
+   rtPhySet (TRX_DATA_RATE, dataRate);
+   rtPhySet (TRX_DEVIATION, deviation);
+
+   spi = ModelStats.SpiTransactions;
+   status = rtPhyInitRadio();
+   spiInit = ModelStats.SpiTransactions - spi;
+
+   printf("rtPhy host model: %lu packets, %lu bytes, %lu bps, air time %lu us\n",
+      (unsigned long)packets, (unsigned long)length, (unsigned long)dataRate,
+      (unsigned long)ModelAirTimeUs((U8)length));
+   printf("channel: loss %u/1000, crc error %u/1000, seed %lu\n",
+      channel.LossPerMille, channel.CorruptPerMille, (unsigned long)channel.Seed);
+   printf("rtPhyInitRadio: %lu SPI transactions\n\n", (unsigned long)spiInit);
+
+   //--------------------------------------------------------------------------
+   // TX pass - rtPhyTx() to the peer
+   //--------------------------------------------------------------------------
+   for (i = 0; i < length; i++)
+      TxBuffer[i] = (U8)i;
+
+   errors = 0;
+   start = ModelStats.TimeNs;
+   spi = ModelStats.SpiTransactions;
+
+   for (n = 0; n < packets; n++)
+   {
+      TxBuffer[0] = (U8)n;
+      ModelPeerRxLength = 0;
+
+      status = rtPhyTx((U8)length, TxBuffer);
+      if(status != PHY_STATUS_SUCCESS)
+         errors++;
+
+      if(ModelPeerRxLength &&
+         memcmp(ModelPeerRxBuffer, TxBuffer, length) != 0)
+         errors++;
+   }
+
+   Report("TX", packets, ModelStats.PeerRxValid,
+      ModelStats.PeerRxCrcError, errors,
+      ModelStats.SpiTransactions - spi, ModelStats.TimeNs - start);
+
+   //--------------------------------------------------------------------------
+   // RX pass - peer to rtPhy Receiver_ISR()
+   //--------------------------------------------------------------------------
+   rtPhyRxOn();
+
+   errors = 0;
+   start = ModelStats.TimeNs;
+   spi = ModelStats.SpiTransactions;
+
+   for (n = 0; n < packets; n++)
+   {
+      TxBuffer[0] = (U8)n;
+
+      ModelPeerTransmit((U8)length, TxBuffer);
+
+      if(RxPacketReceived)
+      {
+         rtPhyGetRxPacket(&rxLength, RxBuffer);
+         if(rxLength != length || memcmp(RxBuffer, TxBuffer, length) != 0)
+            errors++;
+      }
+   }
+
+   Report("RX", packets, ModelStats.RxValid, RxErrors, errors,
+      ModelStats.SpiTransactions - spi, ModelStats.TimeNs - start);
+
+   rtPhyRxOff();
+
+#ifdef TX_INTERRUPT
+   TxInterruptPass(packets, longLength);
+#else
+   (void)longLength;
+#endif
+
+#ifdef FREQUENCY_HOPPING
+   if(HopPass(packets))
+      return 1;
+#endif
+
+   return 0;
+}
+#ifdef TX_INTERRUPT
+//-----------------------------------------------------------------------------
+// TxInterruptPass ()
+//
+// Sends n packets of the given length with rtPhyTxStart(). The main thread
+// only starts the packet and checks TxPacketSent; the FIFO refills happen in
+// Receiver_ISR(). The busy share is the SPI time over the elapsed time.
+//-----------------------------------------------------------------------------
+static void TxInterruptPass (U32 n, U32 length)
+{
+   U32 i;
+   U32 errors;
+   U32 valid, crcErrors;
+   U32 spi, spiBytes, isr;
+   uint64_t start;
+   uint64_t spiNs;
+   uint64_t timeNs;
+   U8 status;
+
+   for (i = 0; i < length; i++)
+      TxLongBuffer[i] = (U8)(i * 7);
+
+   errors = 0;
+   valid = ModelStats.PeerRxValid;
+   crcErrors = ModelStats.PeerRxCrcError;
+   spi = ModelStats.SpiTransactions;
+   spiBytes = ModelStats.SpiBytes;
+   isr = ModelStats.IsrCalls;
+   start = ModelStats.TimeNs;
+
+   for (i = 0; i < n; i++)
+   {
+      TxLongBuffer[0] = (U8)i;
+      ModelPeerRxLength = 0;
+
+      status = rtPhyTxStart((U8)length, TxLongBuffer);
+      if(status != PHY_STATUS_SUCCESS || !TxPacketSent)
+      {
+         errors++;
+         rtPhyTxAbort();
+      }
+
+      if(ModelPeerRxLength &&
+         (ModelPeerRxLength != length ||
+          memcmp(ModelPeerRxBuffer, TxLongBuffer, length) != 0))
+         errors++;
+   }
+
+   valid = ModelStats.PeerRxValid - valid;
+   crcErrors = ModelStats.PeerRxCrcError - crcErrors;
+   spi = ModelStats.SpiTransactions - spi;
+   spiBytes = ModelStats.SpiBytes - spiBytes;
+   timeNs = ModelStats.TimeNs - start;
+   spiNs = (uint64_t)spi * MODEL_SPI_OVERHEAD_NS +
+      ((uint64_t)spiBytes * 8 * 1000000000) / MODEL_SPI_CLOCK_HZ;
+
+   printf("TX interrupt: %lu byte packets, air time %lu us, %lu FIFO underflows\n",
+      (unsigned long)length, (unsigned long)ModelAirTimeUs((U8)length),
+      (unsigned long)ModelStats.TxUnderflow);
+   printf("TX interrupt: %.2f ISR calls/packet, MCU busy with SPI %.2f%% of the time\n",
+      n ? (double)(ModelStats.IsrCalls - isr) / n : 0.0,
+      timeNs ? 100.0 * spiNs / timeNs : 0.0);
+   Report("TX interrupt", n, valid, crcErrors, errors, spi, timeNs);
+}
+#endif
+#ifdef FREQUENCY_HOPPING
+//-----------------------------------------------------------------------------
+// HopPass ()
+//
+// Each method retunes n times. rtPhySet() goes through the full frequency
+// calculation, rtPhyHopNext() and Hop_ISR() write the channel select only.
+// Returns 1 if HopCount does not match the number of Hop_ISR() calls.
+//-----------------------------------------------------------------------------
+static U32 HopPass (U32 n)
+{
+   U32 i;
+   U32 spi;
+   uint64_t start;
+
+   rtPhySet (TRX_CHANNEL_SPACING, 200000L);
+   rtPhyHopInit(0, 0);
+
+   spi = ModelStats.SpiTransactions;
+   start = ModelStats.TimeNs;
+   for (i = 0; i < n; i++)
+      rtPhySet (TRX_FREQUENCY, 902200000L + 200000L * rtPhyHopTable[i % NUMBER_OF_HOP_CHANNELS]);
+   printf("hop rtPhySet:     %.2f SPI transactions/hop, %.1f us/hop\n",
+      (double)(ModelStats.SpiTransactions - spi) / n,
+      (double)(ModelStats.TimeNs - start) / n / 1000.0);
+
+   rtPhySet (TRX_FREQUENCY, 902200000L);
+
+   spi = ModelStats.SpiTransactions;
+   start = ModelStats.TimeNs;
+   for (i = 0; i < n; i++)
+      rtPhyHopNext();
+   printf("hop rtPhyHopNext: %.2f SPI transactions/hop, %.1f us/hop\n",
+      (double)(ModelStats.SpiTransactions - spi) / n,
+      (double)(ModelStats.TimeNs - start) / n / 1000.0);
+
+   rtPhyHopStart(HOP_MICROSECONDS(400));
+
+   spi = ModelStats.SpiTransactions;
+   start = ModelStats.TimeNs;
+   for (i = 0; i < n; i++)
+      Hop_ISR();                       // one call per Timer 2 overflow
+   printf("hop Hop_ISR:      %.2f SPI transactions/hop, %.1f us/hop, "
+      "%u ticks for 400 us dwell, %u hops counted\n",
+      (double)(ModelStats.SpiTransactions - spi) / n,
+      (double)(ModelStats.TimeNs - start) / n / 1000.0,
+      (unsigned)HOP_MICROSECONDS(400), (unsigned)HopCount);
+
+   rtPhyHopStop();
+
+   if(HopCount != (U16)n)
+   {
+      printf("hop Hop_ISR: HopCount %u, expected %u\n",
+         (unsigned)HopCount, (unsigned)(U16)n);
+      return 1;
+   }
+
+   return 0;
+}
+#endif
+//-----------------------------------------------------------------------------
+// FilterIndexCheck ()
+//
+// Compares FindFilterIndex() with the linear scan of the original
+// LookUpFilterSetting() for every bandwidth from 0 to the last table entry,
+// in 100 Hz units. Returns the number of bandwidths that differ.
+//-----------------------------------------------------------------------------
+static U32 FilterIndexCheck (const char *name,
+   VARIABLE_SEGMENT_POINTER(table, rtPhyFilterEntry, SEG_CODE), U8 n)
+{
+   U32 bandwidth;
+   U32 errors;
+   U8 linear;
+   U8 search;
+
+   errors = 0;
+
+   for (bandwidth = 0; bandwidth <= table[n - 1].RxBandwidth; bandwidth++)
+   {
+      // Find largest value in table smaller than target.
+      linear = 0;
+      while (table[linear].RxBandwidth < bandwidth)
+      {
+         linear++;
+      }
+
+      search = FindFilterIndex(table, n, (U16)bandwidth);
+
+      if(search != linear)
+      {
+         if(errors < 10)
+            printf("filter %s: bandwidth %lu00 Hz, index %u, linear scan %u\n",
+               name, (unsigned long)bandwidth, search, linear);
+         errors++;
+      }
+   }
+
+   printf("filter %s: %lu bandwidths checked against the linear scan, %lu differ\n",
+      name, (unsigned long)bandwidth, (unsigned long)errors);
+
+   return errors;
+}
+//-----------------------------------------------------------------------------
+// Report ()
+//-----------------------------------------------------------------------------
+static void Report (const char *pass, U32 sent, U32 valid, U32 crcErrors,
+   U32 errors, U32 spi, uint64_t timeNs)
+{
+   double seconds;
+
+   seconds = (double)timeNs / 1e9;
+
+   printf("%s: %lu sent, %lu valid, %lu CRC errors, %lu lost, %lu data errors\n",
+      pass, (unsigned long)sent, (unsigned long)valid,
+      (unsigned long)crcErrors, (unsigned long)(sent - valid - crcErrors),
+      (unsigned long)errors);
+   printf("%s: %.1f packets/s, drop rate %.2f%%, %.2f SPI transactions/packet, %.3f s\n\n",
+      pass, seconds > 0 ? valid / seconds : 0.0,
+      sent ? 100.0 * (sent - valid) / sent : 0.0,
+      sent ? (double)spi / sent : 0.0, seconds);
+}
+//=============================================================================
+// end rtPhyBench.c
+//=============================================================================
@@ -41,9 +41,18 @@
 #define NUMBER_OF_RX_BANDWIDTH_VALUES_LT2                54
 #define NUMBER_OF_RX_BANDWIDTH_VALUES_LT10               54
 #define NUMBER_OF_RX_BANDWIDTH_VALUES_GE10               53
+#define NUMBER_OF_HOP_CHANNELS                           50
 //------------------------------------------------------------------------------------------------
 // Structures
 //------------------------------------------------------------------------------------------------
+// IF filter look-up table entry - RX bandwidth in units of 100 Hz with the
+// matching IF_FILTER_BANDWIDTH register value. Keeping both in one entry means
+// each probe of the binary search needs only one table access.
+typedef struct rtPhyFilterEntry
+{
+ U16 RxBandwidth;
+ U8  IF_FilterSetting;
+} rtPhyFilterEntry;
 //------------------------------------------------------------------------------------------------
 // Public Variables (API)
 //------------------------------------------------------------------------------------------------
@@ -52,12 +61,10 @@
 //------------------------------------------------------------------------------------------------
 extern SEGMENT_VARIABLE (rtPhyInitRegisters[NUMBER_OF_INIT_REGISTERS], U8, code);
 extern SEGMENT_VARIABLE (rtPhyInitSettings[NUMBER_OF_INIT_REGISTERS], U8, code);
-extern SEGMENT_VARIABLE (rtPhyTableRxBandwidthLT2[NUMBER_OF_RX_BANDWIDTH_VALUES_LT2], U16, code);
-extern SEGMENT_VARIABLE (rtPhyTableIF_FilterSettingLT2[NUMBER_OF_RX_BANDWIDTH_VALUES_LT2], U8, code);
-extern SEGMENT_VARIABLE (rtPhyTableRxBandwidthLT10[NUMBER_OF_RX_BANDWIDTH_VALUES_LT10], U16, code);
-extern SEGMENT_VARIABLE (rtPhyTableIF_FilterSettingLT10[NUMBER_OF_RX_BANDWIDTH_VALUES_LT10], U8, code);
-extern SEGMENT_VARIABLE (rtPhyTableRxBandwidthGE10[NUMBER_OF_RX_BANDWIDTH_VALUES_GE10], U16, code);
-extern SEGMENT_VARIABLE (rtPhyTableIF_FilterSettingGE10[NUMBER_OF_RX_BANDWIDTH_VALUES_GE10], U8, code);
+extern SEGMENT_VARIABLE (rtPhyTableFilterLT2[NUMBER_OF_RX_BANDWIDTH_VALUES_LT2], rtPhyFilterEntry, code);
+extern SEGMENT_VARIABLE (rtPhyTableFilterLT10[NUMBER_OF_RX_BANDWIDTH_VALUES_LT10], rtPhyFilterEntry, code);
+extern SEGMENT_VARIABLE (rtPhyTableFilterGE10[NUMBER_OF_RX_BANDWIDTH_VALUES_GE10], rtPhyFilterEntry, code);
+extern SEGMENT_VARIABLE (rtPhyHopTable[NUMBER_OF_HOP_CHANNELS], U8, code);
 //------------------------------------------------------------------------------------------------
 // Public function prototypes (API)
 //------------------------------------------------------------------------------------------------
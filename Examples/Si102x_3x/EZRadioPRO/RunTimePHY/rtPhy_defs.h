@@ -53,6 +53,22 @@
 // build option to check 32 bit math for overflow
 //-----------------------------------------------------------------------------
 //#define CHECK_32_BIT_MATH
+//-----------------------------------------------------------------------------
+// FREQUENCY_HOPPING - adds the hop API, the default hop table and the Timer 2
+// hop schedule. Uses Timer 2 and the Timer 2 interrupt.
+//-----------------------------------------------------------------------------
+//#define FREQUENCY_HOPPING
+//-----------------------------------------------------------------------------
+// TX_INTERRUPT - adds rtPhyTxStart(), a non-blocking transmit that refills
+// the TX FIFO from INT0. Allows packets longer than the radio FIFO. Has no
+// effect with RECEIVER_ONLY.
+//-----------------------------------------------------------------------------
+//#define TX_INTERRUPT
+//-----------------------------------------------------------------------------
+// HOST_MODEL - removes the SPI and timer primitives so that the PHY links
+// against the host EZRadioPRO model in ../HostModel. Set on the command line.
+//-----------------------------------------------------------------------------
+//#define HOST_MODEL
 //=================================================================================================
 //=================================================================================================
 #endif // RT_PHY_DEFS_H
\ No newline at end of file
@@ -9,6 +9,31 @@
 // This is a simple single file example for measuring the RSSI of a received
 // FSK or GFSK signal.
 //
+// The RSSI is swept over a list of channels for site surveys. Timer 2 runs a
+// fixed tick. On each channel the first tick lets the synthesizer settle and
+// the next SWEEP_SAMPLES ticks read the RSSI register. The dwell value is the
+// average of the samples without the lowest and highest one. After the dwell
+// the Timer 2 ISR tunes to the next channel with a single write to the
+// frequency hopping channel select register.
+//
+// For every channel the ISR keeps the running minimum, maximum and mean of
+// the dwell values. The mean is an exponential average in 8.8 fixed point.
+// The main loop sends one binary frame per dwell over UART0:
+//
+//    byte 0    SWEEP_FRAME_SYNC (0xA5)
+//    byte 1    index in the channel list, 0 starts a new sweep
+//    byte 2    dwell RSSI
+//    byte 3    minimum RSSI
+//    byte 4    maximum RSSI
+//    byte 5    mean RSSI, integer part
+//    byte 6    mean RSSI, fraction in 1/256
+//    byte 7    sum of bytes 1 to 6, modulo 256
+//
+// RSSI values are raw register values. The input power in dBm is about
+// RSSI * 10 / 19 - 127. With the default settings 128 channels are swept in
+// about 90 ms. If UART0 falls behind, frames are dropped and counted in
+// SweepOverruns, the statistics are not affected.
+//
 // This example provides run time support for setting the TRx frequency and
 // all the RX modem parameters. The measured RSSI will depend somewhat on the
 // modem settings.
@@ -65,7 +90,6 @@
 //-----------------------------------------------------------------------------
 #include <compiler_defs.h>
 #include <Si1020_defs.h>
-#include <stdio.h>
 
 //-----------------------------------------------------------------------------
 // Define SYSCLK using LP oscillator
@@ -133,9 +157,26 @@
 #endif
 
 //-----------------------------------------------------------------------------
-// RSSI Samples
+// Sweep settings
+//
+// Channel n is SWEEP_START_FREQUENCY + n * SWEEP_CHANNEL_SPACING. The step
+// size register has 10 kHz resolution and up to 256 channels are possible.
+// The dwell per channel is (1 + SWEEP_SAMPLES) ticks of SWEEP_TICK_US.
+//-----------------------------------------------------------------------------
+#define SWEEP_START_FREQUENCY    902200000L
+#define SWEEP_CHANNEL_SPACING    200000L
+#define SWEEP_CHANNELS           128
+#define SWEEP_SAMPLES            6     // at least 3
+#define SWEEP_TICK_US            100
+#define SWEEP_MEAN_SHIFT         3     // mean weight 1/8
+
+#define SWEEP_TICKS     ((SYSCLK_HZ/12/1000)*SWEEP_TICK_US/1000)
+
+//-----------------------------------------------------------------------------
+// Frame queue - must be a power of 2
 //-----------------------------------------------------------------------------
-#define RSSI_SAMPLES   10
+#define SWEEP_QUEUE_SIZE         16
+#define SWEEP_FRAME_SYNC         0xA5
 
 //-----------------------------------------------------------------------------
 // bit definitions
@@ -150,6 +191,33 @@ SBIT(LED1, SFR_P0, 0);
 //-----------------------------------------------------------------------------
 LOCATED_VARIABLE_NO_INIT(RadioStatus, U8, SEG_DATA, 0x43);
 
+//-----------------------------------------------------------------------------
+// Sweep channel list and per-channel statistics
+//-----------------------------------------------------------------------------
+SEGMENT_VARIABLE (SweepChannel[SWEEP_CHANNELS], U8, SEG_XDATA);
+SEGMENT_VARIABLE (SweepLast[SWEEP_CHANNELS], U8, SEG_XDATA);
+SEGMENT_VARIABLE (SweepMin[SWEEP_CHANNELS], U8, SEG_XDATA);
+SEGMENT_VARIABLE (SweepMax[SWEEP_CHANNELS], U8, SEG_XDATA);
+SEGMENT_VARIABLE (SweepMean[SWEEP_CHANNELS], U16, SEG_XDATA);
+
+//-----------------------------------------------------------------------------
+// Sweep state, written by the Timer 2 ISR
+//-----------------------------------------------------------------------------
+SEGMENT_VARIABLE (SweepIndex, U8, SEG_DATA);
+SEGMENT_VARIABLE (SweepTick, U8, SEG_DATA);
+SEGMENT_VARIABLE (SweepSum, U16, SEG_DATA);
+SEGMENT_VARIABLE (SweepLow, U8, SEG_DATA);
+SEGMENT_VARIABLE (SweepHigh, U8, SEG_DATA);
+SEGMENT_VARIABLE (SweepPasses, U16, SEG_DATA);
+SEGMENT_VARIABLE (SweepOverruns, U16, SEG_DATA);
+
+//-----------------------------------------------------------------------------
+// Frame queue, channel list indexes from the ISR to the main loop
+//-----------------------------------------------------------------------------
+SEGMENT_VARIABLE (SweepQueue[SWEEP_QUEUE_SIZE], U8, SEG_IDATA);
+SEGMENT_VARIABLE (SweepQueueIn, U8, SEG_DATA);
+SEGMENT_VARIABLE (SweepQueueOut, U8, SEG_DATA);
+
 //-----------------------------------------------------------------------------
 //
 // Look up table for IF Filter Settings assuming m < 2
@@ -294,9 +362,13 @@ U32   calcClockRecoveryOffset (U8, U32);
 void  setClockRecoveryOffset (U32);
 U16   calcClockRecoveryTimingLoopGain (U32, U16, U32);
 void  setClockRecoveryTimingLoopGain (U16);
-U8    sampleRSSI (void);
 U32   divideWithRounding (U32, U32);
-S16   calcInputPower (U8);
+void  SweepInit (void);
+void  SweepStart (void);
+void  SweepSendFrame (U8);
+U8    SweepPhyRead (U8);
+void  SweepPhyWrite (U8, U8);
+void  UART0_Write (U8);
 
 //=============================================================================
 // Functions
@@ -307,8 +379,7 @@ S16   calcInputPower (U8);
 void main (void)
 {
    U8 status;
-   U8 rssi;
-   S16 inputPower;
+   U8 index;
 
    // user variables
    U32 volatile trxFrequency;
@@ -394,21 +465,25 @@ void main (void)
 
    status = phyRead(EZRADIOPRO_DEVICE_STATUS);
 
-   // Check status for transmit mode.
+   // Check status for receive mode.
    if((status& 0x03)==0x01)
    {
-      // Blink forever.
+      SweepInit();
+      SweepStart();
+
+      // Send a frame for each dwell, blink once per sweep.
       while(1)
       {
-         rssi = sampleRSSI();
-
-         inputPower = calcInputPower (rssi);
-
-         printf("RSSI = %i    \r", inputPower);
+         if(SweepQueueOut != SweepQueueIn)
+         {
+            index = SweepQueue[SweepQueueOut];
+            SweepQueueOut = (SweepQueueOut + 1) & (SWEEP_QUEUE_SIZE - 1);
 
-         delay(TWO_HUNDRED_MS);
+            SweepSendFrame(index);
 
-         LED1 = !LED1;
+            if(index == 0)
+               LED1 = !LED1;
+         }
       }
    }
 
@@ -519,23 +594,21 @@ void   UART0_Init (void)
 }
 
 //-----------------------------------------------------------------------------
-// putchar
+// UART0_Write
 //-----------------------------------------------------------------------------
 //
 // Return Value : None
-// Parameters   : character to send to UART
+// Parameters   : byte to send to UART
 //
-// This function outputs a character to the UART.
-// Used for SDCC build only.
+// This function outputs a byte to the UART. Unlike putchar() there is no
+// newline translation, so it is used for the binary frames.
 //-----------------------------------------------------------------------------
-#ifdef SDCC
-void putchar (char c)
+void UART0_Write (U8 value)
 {
    while (!TI0);
    TI0 = 0;
-   SBUF0 = c;
+   SBUF0 = value;
 }
-#endif
 
 //=============================================================================
 //
@@ -1117,75 +1190,244 @@ void setClockRecoveryTimingLoopGain (U16 clockRecoveryTimingLoopGain)
 }
 
 //-----------------------------------------------------------------------------
-// sampleRSSI()
+// SweepInit()
 //
 // Parameters   : None
-// Return Value : U8 RSSI
+// Return Value : None
 //
-// This function will find the average of a number of samples discarding the
-// low and high values. This will discard the infrequent erroneous rssi
-// samples which are known to occur.
+// Fills the channel list with channels 0 to SWEEP_CHANNELS-1 and sets the
+// channel spacing. The list may be changed to skip or repeat channels.
+//-----------------------------------------------------------------------------
+void SweepInit (void)
+{
+   U8 i;
+
+   for(i = 0; i < SWEEP_CHANNELS; i++)
+   {
+      SweepChannel[i] = i;
+      SweepLast[i] = 0;
+      SweepMin[i] = 255;
+      SweepMax[i] = 0;
+      SweepMean[i] = 0;
+   }
+
+   SweepIndex = 0;
+   SweepPasses = 0;
+   SweepOverruns = 0;
+   SweepQueueIn = 0;
+   SweepQueueOut = 0;
+
+   // channel 0 frequency and the step size, the ISR only changes the channel
+   setTRxFrequency(SWEEP_START_FREQUENCY);
+   phyWrite(EZRADIOPRO_FREQUENCY_HOPPING_STEP_SIZE, SWEEP_CHANNEL_SPACING/10000);
+   phyWrite(EZRADIOPRO_FREQUENCY_HOPPING_CHANNEL_SELECT, SweepChannel[0]);
+}
+
+//-----------------------------------------------------------------------------
+// SweepStart()
+//
+// Parameters   : None
+// Return Value : None
 //
+// Starts Timer 2 in 16-bit auto-reload mode from SYSCLK/12. After this the
+// radio SPI is only used by Sweep_ISR().
 //-----------------------------------------------------------------------------
-U8  sampleRSSI (void)
+void SweepStart (void)
 {
+   UU16 reload;
+
+   reload.U16 = -SWEEP_TICKS;
+
+   SweepTick = 0;
+
+   // no radio interrupts are used
+   phyWrite(EZRADIOPRO_INTERRUPT_ENABLE_1, 0x00);
+   phyWrite(EZRADIOPRO_INTERRUPT_ENABLE_2, 0x00);
+   EX0 = 0;
+
+   TMR2CN  = 0x00;                     // 16-bit auto-reload, SYSCLK/12
+   CKCON  &= ~0x30;                    // T2 clock selected by T2XCLK
+   TMR2RLL = reload.U8[LSB];
+   TMR2RLH = reload.U8[MSB];
+   TMR2L   = reload.U8[LSB];
+   TMR2H   = reload.U8[MSB];
+
+   ET2 = 1;
+   TR2 = 1;
+   EA = 1;
+}
+
+//-----------------------------------------------------------------------------
+// SweepSendFrame()
+//
+// Parameters   : U8 index - channel list index
+// Return Value : None
+//
+// The statistics are copied with Timer 2 interrupts off so the 16-bit mean
+// is consistent.
+//-----------------------------------------------------------------------------
+void SweepSendFrame (U8 index)
+{
+   U8 frame[6];
+   U8 checksum;
    U8 i;
-   U8 sample;
+   UU16 mean;
 
-   U8    min = 255;
-   U8    max = 0;
-   U16   sum = 0;
+   ET2 = 0;
+   frame[1] = SweepLast[index];
+   frame[2] = SweepMin[index];
+   frame[3] = SweepMax[index];
+   mean.U16 = SweepMean[index];
+   ET2 = 1;
 
-   for(i=0;i<RSSI_SAMPLES;i++)
+   frame[0] = index;
+   frame[4] = mean.U8[MSB];
+   frame[5] = mean.U8[LSB];
+
+   UART0_Write(SWEEP_FRAME_SYNC);
+
+   checksum = 0;
+   for(i = 0; i < 6; i++)
    {
-      sample = phyRead(EZRADIOPRO_RECEIVED_SIGNAL_STRENGTH_INDICATOR);
+      UART0_Write(frame[i]);
+      checksum += frame[i];
+   }
 
-      sum += sample;
+   UART0_Write(checksum);
+}
 
-      if(sample > max)
-      {
-         max = sample;
-      }
+//-----------------------------------------------------------------------------
+// Sweep_ISR()
+//
+// Tick 0 of a dwell is the settling time after the channel change, ticks 1
+// to SWEEP_SAMPLES read the RSSI. The last tick updates the channel
+// statistics, queues a frame and tunes to the next channel.
+//-----------------------------------------------------------------------------
+INTERRUPT(Sweep_ISR, INTERRUPT_TIMER2)
+{
+   U8 rssi;
+   U16 value;
+   U16 mean;
 
-      if(sample < min)
-      {
-         min = sample;
-      }
+   TF2H = 0;
+
+   if(SweepTick == 0)
+   {
+      SweepSum = 0;
+      SweepLow = 255;
+      SweepHigh = 0;
+      SweepTick++;
+      return;
    }
 
-   sum -= min;
-   sum -= max;
+   rssi = SweepPhyRead(EZRADIOPRO_RECEIVED_SIGNAL_STRENGTH_INDICATOR);
+
+   SweepSum += rssi;
+   if(rssi < SweepLow)
+      SweepLow = rssi;
+   if(rssi > SweepHigh)
+      SweepHigh = rssi;
 
-   sum /= (RSSI_SAMPLES-2);
+   if(SweepTick < SWEEP_SAMPLES)
+   {
+      SweepTick++;
+      return;
+   }
 
-   return sum;
+   // dwell value without the lowest and highest sample
+   rssi = (SweepSum - SweepLow - SweepHigh) / (SWEEP_SAMPLES - 2);
+
+   SweepLast[SweepIndex] = rssi;
+   if(rssi < SweepMin[SweepIndex])
+      SweepMin[SweepIndex] = rssi;
+   if(rssi > SweepMax[SweepIndex])
+      SweepMax[SweepIndex] = rssi;
+
+   // exponential average in 8.8 fixed point, first sweep sets it
+   value = (U16)rssi << 8;
+   mean = SweepMean[SweepIndex];
+   if(SweepPasses == 0)
+      mean = value;
+   else if(value >= mean)
+      mean += (value - mean) >> SWEEP_MEAN_SHIFT;
+   else
+      mean -= (mean - value) >> SWEEP_MEAN_SHIFT;
+   SweepMean[SweepIndex] = mean;
+
+   // queue the frame, drop it if the UART is behind
+   if(((SweepQueueIn + 1) & (SWEEP_QUEUE_SIZE - 1)) != SweepQueueOut)
+   {
+      SweepQueue[SweepQueueIn] = SweepIndex;
+      SweepQueueIn = (SweepQueueIn + 1) & (SWEEP_QUEUE_SIZE - 1);
+   }
+   else
+   {
+      SweepOverruns++;
+   }
+
+   SweepIndex++;
+   if(SweepIndex >= SWEEP_CHANNELS)
+   {
+      SweepIndex = 0;
+      SweepPasses++;
+   }
+
+   SweepPhyWrite(EZRADIOPRO_FREQUENCY_HOPPING_CHANNEL_SELECT, SweepChannel[SweepIndex]);
+
+   SweepTick = 0;
 }
 
 //-----------------------------------------------------------------------------
-// calcInputPower()
+// Function Name SweepPhyWrite()
 //
-// Parameters   : U8    RSSI
-// Return Value : S16   inputPower
+// Same as phyWrite(), used only by Sweep_ISR().
+//-----------------------------------------------------------------------------
+void SweepPhyWrite (U8 reg, U8 value)
+{
+   U8 restoreSFRPAGE;
+   restoreSFRPAGE = SFRPAGE;
+
+   SFRPAGE = SPI1_PAGE;
+   // Send SPI data using double buffered write
+   NSS1 = 0;                           // drive NSS low
+   SPIF1 = 0;                          // clear SPIF
+   SPI1DAT = (reg | 0x80);             // write reg address
+   while(!TXBMT1);                     // wait on TXBMT
+   SPI1DAT = value;                    // write value
+   while(!TXBMT1);                     // wait on TXBMT
+   while((SPI1CFG & 0x80) == 0x80);    // wait on SPIBSY
+
+   SPIF1 = 0;                          // leave SPIF cleared
+   NSS1 = 1;                           // drive NSS high
+
+   SFRPAGE = restoreSFRPAGE;
+}
+
+//-----------------------------------------------------------------------------
+// Function Name SweepPhyRead()
 //
-// Equation for input power derived from linear trend line of figure in data
-// sheet.
-//                      10
-// inputPower = rssi * ---- - 127
-//                      19
+// Same as phyRead(), used only by Sweep_ISR().
 //-----------------------------------------------------------------------------
-S16   calcInputPower (U8 rssi)
+U8 SweepPhyRead (U8 reg)
 {
-   S16 value;
+   U8 value;
+   U8 restoreSFRPAGE;
+   restoreSFRPAGE = SFRPAGE;
 
-   value = rssi;
-   value *= 10;
-   value /= 19;
-   value -=127;
+   SFRPAGE = SPI1_PAGE;
+   // Send SPI data using double buffered write
+   NSS1 = 0;                           // drive NSS low
+   SPIF1 = 0;                          // clear SPIF
+   SPI1DAT = ( reg );                  // write reg address
+   while(!TXBMT1);                     // wait on TXBMT
+   SPI1DAT = 0x00;                     // write anything
+   while(!TXBMT1);                     // wait on TXBMT
+   while((SPI1CFG & 0x80) == 0x80);    // wait on SPIBSY
+   value = SPI1DAT;                    // read value
+   SPIF1 = 0;                          // leave SPIF cleared
+   NSS1 = 1;                           // drive NSS high
 
-   if(value< -120)
-      value = -120;
-   else if (value > 0)
-      value = 0;
+   SFRPAGE = restoreSFRPAGE;
 
    return value;
 }